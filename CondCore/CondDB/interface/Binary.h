@@ -20,6 +20,9 @@ namespace cond {
 
     explicit Binary(const coral::Blob& data);
 
+    // a read-only view of memory owned elsewhere, e.g. a file mapped in memory; 'owner' keeps it alive
+    Binary(std::shared_ptr<const void> owner, const void* data, size_t size);
+
     Binary(const Binary& rhs);
 
     Binary& operator=(const Binary& rhs);
@@ -30,12 +33,19 @@ namespace cond {
 
     const void* data() const;
 
+    // a view is copied to a buffer of its own before being modified
     void* data();
 
     size_t size() const;
 
+    // keeps the data alive, for the payloads using it in place
+    std::shared_ptr<const void> share() const;
+
   private:
-    std::shared_ptr<coral::Blob> m_data;
+    // the copy made for get() when the data is a view, published with the atomic shared_ptr functions
+    mutable std::shared_ptr<coral::Blob> m_data;
+    std::shared_ptr<const void> m_view;
+    size_t m_viewSize = 0;
   };
 
 }  // namespace cond
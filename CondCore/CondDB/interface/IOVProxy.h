@@ -91,6 +91,10 @@ namespace cond {
                      const cond::Time_t& end,
                      const boost::posix_time::ptime& snapshottime);
 
+      // loads in one query the iovs valid in [begin, end], whole groups, after a load( tag ) of the groups.
+      // find does not issue new queries for the target times in the range, until a target outside is requested.
+      void prefetch(cond::Time_t begin, cond::Time_t end);
+
       // reset the data in memory and execute again the queries for the current tag
       void reload();
 
@@ -144,6 +148,9 @@ namespace cond {
       // for reporting
       size_t numberOfQueries() const;
 
+      // for reporting: the time spent in the iov queries, in seconds
+      double queryTime() const;
+
       // for debugging
       std::pair<cond::Time_t, cond::Time_t> loadedGroup() const;
 
@@ -23,6 +23,7 @@
 // temporarely
 
 #include "CondFormats/Serialization/interface/Archive.h"
+#include "CondFormats/Serialization/interface/FlatTable.h"
 
 namespace cond {
 
@@ -54,16 +55,21 @@ namespace cond {
     static constexpr char const* ARCH_LABEL = "architecture";
     //
     static constexpr char const* TECHNOLOGY = "boost/serialization";
+    // the payloads deriving from cond::serialization::FlatTable, used in place
+    static constexpr char const* FLAT_TECHNOLOGY = "cms/flat";
+    static constexpr char const* FLAT_TECH_VERSION = "1";
     static std::string techVersion();
     static std::string jsonString();
+    static std::string jsonString(const std::string& technology, const std::string& version);
+    // the technology used for a stored payload, TECHNOLOGY if not specified
+    static std::string technology(const Binary& streamerInfoData);
   };
 
   typedef cond::serialization::InputArchive CondInputArchive;
   typedef cond::serialization::OutputArchive CondOutputArchive;
 
-  // call for the serialization.
   template <typename T>
-  std::pair<Binary, Binary> serialize(const T& payload) {
+  std::pair<Binary, Binary> default_serialize(const T& payload) {
     std::pair<Binary, Binary> ret;
     std::string streamerInfo(StreamerInfo::jsonString());
     try {
@@ -81,6 +87,25 @@ namespace cond {
     return ret;
   }
 
+  // the payload is stored as the block read in place by flat_deserialize
+  template <typename T>
+  std::pair<Binary, Binary> flat_serialize(const T& payload) {
+    std::pair<Binary, Binary> ret;
+    ret.first.copy(payload.toBinary());
+    ret.second.copy(StreamerInfo::jsonString(StreamerInfo::FLAT_TECHNOLOGY, StreamerInfo::FLAT_TECH_VERSION));
+    return ret;
+  }
+
+  // call for the serialization.
+  template <typename T>
+  std::pair<Binary, Binary> serialize(const T& payload) {
+    if constexpr (serialization::is_flat<T>::value) {
+      return flat_serialize(payload);
+    } else {
+      return default_serialize(payload);
+    }
+  }
+
   // generates an instance of T from the binary serialized data.
   template <typename T>
   std::unique_ptr<T> default_deserialize(const std::string& payloadType,
@@ -116,12 +141,34 @@ namespace cond {
     return payload;
   }
 
+  // generates an instance of T using the binary data in place: the payload keeps the data alive
+  template <typename T>
+  std::unique_ptr<T> flat_deserialize(const std::string& payloadType,
+                                      const Binary& payloadData,
+                                      const Binary& streamerInfoData) {
+    std::unique_ptr<T> payload(createPayload<T>(payloadType));
+    if (!payload->fromBinary(payloadData.share(), payloadData.size()))
+      throwException("De-serialization failed: the layout of the values of the Class " + payloadType +
+                         " has been changed with respect to the layout used in the upload.",
+                     "flat_deserialize");
+    return payload;
+  }
+
   // default specialization
   template <typename T>
   std::unique_ptr<T> deserialize(const std::string& payloadType,
                                  const Binary& payloadData,
                                  const Binary& streamerInfoData) {
-    return default_deserialize<T>(payloadType, payloadData, streamerInfoData);
+    bool flat = StreamerInfo::technology(streamerInfoData) == StreamerInfo::FLAT_TECHNOLOGY;
+    if (flat != serialization::is_flat<T>::value)
+      throwException("De-serialization failed: the payload of type " + payloadType + " has been stored with " +
+                         StreamerInfo::technology(streamerInfoData) + ", which is not the technology of the Class.",
+                     "deserialize");
+    if constexpr (serialization::is_flat<T>::value) {
+      return flat_deserialize<T>(payloadType, payloadData, streamerInfoData);
+    } else {
+      return default_deserialize<T>(payloadType, payloadData, streamerInfoData);
+    }
   }
 
 }  // namespace cond
@@ -18,35 +18,71 @@ cond::Binary::Binary(const coral::Blob& data) : m_data(new coral::Blob(data.size
   ::memcpy(m_data->startingAddress(), data.startingAddress(), data.size());
 }
 
-cond::Binary::Binary(const Binary& rhs) : m_data(rhs.m_data) {}
+cond::Binary::Binary(std::shared_ptr<const void> owner, const void* data, size_t size)
+    : m_data(), m_view(std::move(owner), data), m_viewSize(size) {}
+
+cond::Binary::Binary(const Binary& rhs)
+    : m_data(std::atomic_load(&rhs.m_data)), m_view(rhs.m_view), m_viewSize(rhs.m_viewSize) {}
 
 cond::Binary& cond::Binary::operator=(const Binary& rhs) {
   if (this != &rhs) {
-    m_data = rhs.m_data;
+    m_data = std::atomic_load(&rhs.m_data);
+    m_view = rhs.m_view;
+    m_viewSize = rhs.m_viewSize;
   }
   return *this;
 }
 
-const coral::Blob& cond::Binary::get() const { return *m_data; }
+const coral::Blob& cond::Binary::get() const {
+  // a const Binary may be shared by several threads: the copy of a view is published atomically, and the
+  // threads racing to make it keep the first one published
+  std::shared_ptr<coral::Blob> blob = std::atomic_load(&m_data);
+  if (m_view.get() && !blob.get()) {
+    auto copy = std::make_shared<coral::Blob>(m_viewSize);
+    ::memcpy(copy->startingAddress(), m_view.get(), m_viewSize);
+    if (std::atomic_compare_exchange_strong(&m_data, &blob, copy))
+      blob = copy;
+  }
+  return *blob;
+}
 
 void cond::Binary::copy(const std::string& source) {
   m_data.reset(new coral::Blob(source.size()));
   ::memcpy(m_data->startingAddress(), source.c_str(), source.size());
+  m_view.reset();
+  m_viewSize = 0;
 }
 
 const void* cond::Binary::data() const {
+  if (m_view.get())
+    return m_view.get();
   if (!m_data.get())
     throwException("Binary data can't be accessed.", "Binary::data");
   return m_data->startingAddress();
 }
 void* cond::Binary::data() {
+  if (m_view.get()) {
+    get();
+    m_view.reset();
+    m_viewSize = 0;
+  }
   if (!m_data.get())
     throwException("Binary data can't be accessed.", "Binary::data");
   return m_data->startingAddress();
 }
 
 size_t cond::Binary::size() const {
+  if (m_view.get())
+    return m_viewSize;
   if (!m_data.get())
     throwException("Binary data can't be accessed.", "Binary::size");
   return m_data->size();
 }
+
+std::shared_ptr<const void> cond::Binary::share() const {
+  if (m_view.get())
+    return m_view;
+  if (!m_data.get())
+    throwException("Binary data can't be accessed.", "Binary::share");
+  return std::shared_ptr<const void>(m_data, m_data->startingAddress());
+}
@@ -1,5 +1,7 @@
 #include "CondCore/CondDB/interface/IOVProxy.h"
 #include "SessionImpl.h"
+//
+#include <chrono>
 
 namespace cond {
 
@@ -27,6 +29,7 @@ namespace cond {
       bool full = false;
       bool range = false;
       size_t numberOfQueries = 0;
+      double queryTime = 0.;
     };
 
     IOVProxy::Iterator::Iterator()
@@ -210,6 +213,7 @@ namespace cond {
         m_data->sinceGroups.clear();
         m_data->iovSequence.clear();
         m_data->numberOfQueries = 0;
+        m_data->queryTime = 0.;
         m_data->full = false;
         m_data->range = false;
       }
@@ -256,6 +260,7 @@ namespace cond {
     }
 
     void IOVProxy::fetchSequence(cond::Time_t lowerGroup, cond::Time_t higherGroup) {
+      auto start = std::chrono::steady_clock::now();
       m_data->iovSequence.clear();
       m_session->iovSchema().iovTable().select(
           m_data->tag, lowerGroup, higherGroup, m_data->snapshotTime, m_data->iovSequence);
@@ -277,6 +282,7 @@ namespace cond {
       }
 
       m_data->numberOfQueries++;
+      m_data->queryTime += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
     }
 
     IOVProxy::Iterator IOVProxy::begin() const {
@@ -319,6 +325,24 @@ namespace cond {
       return (p != container.begin()) ? p - 1 : container.end();
     }
 
+    void IOVProxy::prefetch(cond::Time_t begin, cond::Time_t end) {
+      if (!m_data.get() || m_data->full || m_data->range)
+        return;
+      checkTransaction("IOVProxy::prefetch");
+      if (m_data->sinceGroups.empty() || end < begin)
+        return;
+      // from the group containing begin to the first group starting after end
+      cond::Time_t lowG = cond::time::MIN_VAL;
+      auto iGLow = search(begin, m_data->sinceGroups);
+      if (iGLow != m_data->sinceGroups.end())
+        lowG = *iGLow;
+      cond::Time_t highG = cond::time::MAX_VAL;
+      auto iGHigh = std::upper_bound(m_data->sinceGroups.begin(), m_data->sinceGroups.end(), end);
+      if (iGHigh != m_data->sinceGroups.end())
+        highG = *iGHigh;
+      fetchSequence(lowG, highG);
+    }
+
     IOVProxy::Iterator IOVProxy::find(cond::Time_t time) {
       checkTransaction("IOVProxy::find");
       // organize iovs in pages...
@@ -380,6 +404,8 @@ namespace cond {
 
     size_t IOVProxy::numberOfQueries() const { return m_data.get() ? m_data->numberOfQueries : 0; }
 
+    double IOVProxy::queryTime() const { return m_data.get() ? m_data->queryTime : 0.; }
+
     std::pair<cond::Time_t, cond::Time_t> IOVProxy::loadedGroup() const {
       return m_data.get() ? std::make_pair(m_data->groupLowerIov, m_data->groupHigherIov)
                           : std::make_pair(cond::time::MAX_VAL, cond::time::MIN_VAL);
@@ -5,13 +5,30 @@
 
 std::string cond::StreamerInfo::techVersion() { return BOOST_LIB_VERSION; }
 
-std::string cond::StreamerInfo::jsonString() {
+std::string cond::StreamerInfo::jsonString() { return jsonString(TECHNOLOGY, techVersion()); }
+
+std::string cond::StreamerInfo::jsonString(const std::string& technology, const std::string& version) {
   std::stringstream ss;
   ss << " {" << std::endl;
   ss << "\"" << CMSSW_VERSION_LABEL << "\": \"" << currentCMSSWVersion() << "\"," << std::endl;
   ss << "\"" << ARCH_LABEL << "\": \"" << currentArchitecture() << "\"," << std::endl;
-  ss << "\"" << TECH_LABEL << "\": \"" << TECHNOLOGY << "\"," << std::endl;
-  ss << "\"" << TECH_VERSION_LABEL << "\": \"" << techVersion() << "\"" << std::endl;
+  ss << "\"" << TECH_LABEL << "\": \"" << technology << "\"," << std::endl;
+  ss << "\"" << TECH_VERSION_LABEL << "\": \"" << version << "\"" << std::endl;
   ss << " }" << std::endl;
   return ss.str();
 }
+
+std::string cond::StreamerInfo::technology(const Binary& streamerInfoData) {
+  if (streamerInfoData.size() == 0)
+    return TECHNOLOGY;
+  std::string streamerInfo(static_cast<const char*>(streamerInfoData.data()), streamerInfoData.size());
+  std::string key = std::string("\"") + TECH_LABEL + "\": \"";
+  size_t begin = streamerInfo.find(key);
+  if (begin == std::string::npos)
+    return TECHNOLOGY;
+  begin += key.size();
+  size_t end = streamerInfo.find('"', begin);
+  if (end == std::string::npos)
+    return TECHNOLOGY;
+  return streamerInfo.substr(begin, end - begin);
+}
@@ -0,0 +1,158 @@
+// Compares the time and the memory needed to load a large per-channel payload
+// stored with boost serialization and stored as a flat table: read from a
+// buffer, as returned by the database, and read from a file mapped in memory,
+// used through a Binary view. Each way runs in a process of its own, and
+// reports the resident memory added, split into the private memory and the
+// memory shared with the other processes reading the same file.
+//
+//   flatPayloadBenchmark [channels]
+
+#include "CondCore/CondDB/interface/Serialization.h"
+//
+#include <boost/serialization/nvp.hpp>
+#include <boost/serialization/vector.hpp>
+//
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+  // e.g. the pedestals and gains of the gain ranges of a calorimeter channel
+  struct ChannelRecord {
+    float values[12];
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int) {
+      ar& BOOST_SERIALIZATION_NVP(values);
+    }
+  };
+
+}  // namespace
+
+template <>
+struct cond::serialization::is_packed<ChannelRecord>
+    : std::bool_constant<cond::serialization::isPacked(&ChannelRecord::values)> {};
+
+namespace {
+  class BoostChannelTable {
+  public:
+    std::vector<uint32_t> ids;
+    std::vector<ChannelRecord> values;
+
+    template <class Archive>
+    void serialize(Archive& ar, const unsigned int) {
+      ar& BOOST_SERIALIZATION_NVP(ids);
+      ar& BOOST_SERIALIZATION_NVP(values);
+    }
+  };
+
+  class FlatChannelTable : public cond::serialization::FlatTable<ChannelRecord> {
+  public:
+    FlatChannelTable() {}
+    FlatChannelTable(const std::vector<uint32_t>& ids, const std::vector<ChannelRecord>& values)
+        : cond::serialization::FlatTable<ChannelRecord>(ids, values) {}
+  };
+
+  // the resident and the shared memory, in MB
+  std::pair<double, double> memory() {
+    long size = 0, resident = 0, shared = 0;
+    std::ifstream statm("/proc/self/statm");
+    statm >> size >> resident >> shared;
+    double page = ::sysconf(_SC_PAGESIZE) / (1024. * 1024.);
+    return std::make_pair(resident * page, shared * page);
+  }
+
+  cond::Binary readFile(const std::string& fileName, bool mapped) {
+    int fd = ::open(fileName.c_str(), O_RDONLY);
+    struct stat status;
+    ::fstat(fd, &status);
+    size_t size = status.st_size;
+    if (!mapped) {
+      std::vector<char> buffer(size);
+      if (::read(fd, buffer.data(), size) != static_cast<ssize_t>(size))
+        std::cerr << "Cannot read " << fileName << std::endl;
+      ::close(fd);
+      return cond::Binary(buffer.data(), size);
+    }
+    void* address = ::mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    std::shared_ptr<const void> mapping(address, [size](const void* a) { ::munmap(const_cast<void*>(a), size); });
+    return cond::Binary(mapping, address, size);
+  }
+
+  template <typename T>
+  void load(const std::string& name, const std::string& fileName, const cond::Binary& streamerInfo, bool mapped) {
+    auto before = memory();
+    auto start = std::chrono::steady_clock::now();
+    cond::Binary data = readFile(fileName, mapped);
+    std::unique_ptr<T> payload = cond::deserialize<T>(cond::demangledName(typeid(T)), data, streamerInfo);
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    // what a job does with the payload: look at every channel once
+    double sum = 0;
+    if constexpr (cond::serialization::is_flat<T>::value) {
+      for (const auto& v : *payload)
+        sum += v.values[0];
+    } else {
+      for (const auto& v : payload->values)
+        sum += v.values[0];
+    }
+    auto after = memory();
+    double shared = after.second - before.second;
+    std::cout << name << ": " << seconds * 1000. << " ms, " << after.first - before.first - shared << " MB private, "
+              << shared << " MB shared (checksum " << sum << ")" << std::endl;
+  }
+}  // namespace
+
+int main(int argc, char** argv) {
+  unsigned int nChannels = argc > 1 ? std::stoul(argv[1]) : 1000000;
+
+  std::vector<uint32_t> ids;
+  std::vector<ChannelRecord> values;
+  for (unsigned int i = 0; i < nChannels; ++i) {
+    ids.push_back(0x14000000 + i);
+    ChannelRecord r;
+    for (unsigned int j = 0; j < 12; ++j)
+      r.values[j] = i * 0.001f + j;
+    values.push_back(r);
+  }
+  BoostChannelTable boostTable{ids, values};
+  std::pair<cond::Binary, cond::Binary> boostData = cond::serialize(boostTable);
+  std::pair<cond::Binary, cond::Binary> flatData = cond::serialize(FlatChannelTable(ids, values));
+  ids.clear();
+  ids.shrink_to_fit();
+  values.clear();
+  values.shrink_to_fit();
+
+  std::string boostFile = "flatPayloadBenchmark_boost.bin";
+  std::string flatFile = "flatPayloadBenchmark_flat.bin";
+  std::ofstream(boostFile, std::ios::binary)
+      .write(static_cast<const char*>(boostData.first.data()), boostData.first.size());
+  std::ofstream(flatFile, std::ios::binary)
+      .write(static_cast<const char*>(flatData.first.data()), flatData.first.size());
+  std::cout << nChannels << " channels, " << boostData.first.size() / (1024. * 1024.) << " MB with boost, "
+            << flatData.first.size() / (1024. * 1024.) << " MB flat" << std::endl;
+
+  for (int mode = 0; mode < 3; ++mode) {
+    pid_t pid = ::fork();
+    if (pid == 0) {
+      if (mode == 0)
+        load<BoostChannelTable>("boost serialization", boostFile, boostData.second, false);
+      else if (mode == 1)
+        load<FlatChannelTable>("flat from a buffer  ", flatFile, flatData.second, false);
+      else
+        load<FlatChannelTable>("flat mapped in place", flatFile, flatData.second, true);
+      ::_exit(0);
+    }
+    ::waitpid(pid, nullptr, 0);
+  }
+  std::remove(boostFile.c_str());
+  std::remove(flatFile.c_str());
+  return 0;
+}
@@ -0,0 +1,148 @@
+#include "CondCore/CondDB/interface/Serialization.h"
+//
+#include "MyTestData.h"
+//
+#include <cstring>
+#include <iostream>
+#include <memory>
+#include <new>
+
+namespace {
+  struct ChannelRecord {
+    float mean;
+    float rms;
+    uint16_t status;
+    uint16_t spare;
+  };
+
+  // has padding after 'status'
+  struct PaddedRecord {
+    float mean;
+    uint16_t status;
+  };
+}  // namespace
+
+template <>
+struct cond::serialization::is_packed<ChannelRecord>
+    : std::bool_constant<cond::serialization::isPacked(
+          &ChannelRecord::mean, &ChannelRecord::rms, &ChannelRecord::status, &ChannelRecord::spare)> {};
+
+static_assert(cond::serialization::is_packed<ChannelRecord>::value);
+static_assert(not cond::serialization::isPacked(&PaddedRecord::mean, &PaddedRecord::status));
+static_assert(not cond::serialization::isPacked(&ChannelRecord::mean, &ChannelRecord::rms));
+
+namespace {
+  class ChannelTable : public cond::serialization::FlatTable<ChannelRecord> {
+  public:
+    ChannelTable() {}
+    ChannelTable(const std::vector<uint32_t>& ids, const std::vector<ChannelRecord>& values)
+        : cond::serialization::FlatTable<ChannelRecord>(ids, values) {}
+  };
+}  // namespace
+
+int main() {
+  int nFail = 0;
+  try {
+    std::vector<uint32_t> ids;
+    std::vector<ChannelRecord> values;
+    for (uint32_t i = 0; i < 1000; i++) {
+      ids.push_back(838860800 + 7 * (1000 - i));
+      values.push_back(ChannelRecord{float(i), 0.5f * i, uint16_t(i % 3), 0});
+    }
+    ChannelTable table(ids, values);
+    std::pair<cond::Binary, cond::Binary> data = cond::serialize(table);
+    if (cond::StreamerInfo::technology(data.second) != cond::StreamerInfo::FLAT_TECHNOLOGY) {
+      nFail++;
+      std::cout << "ERROR: the table has been stored with " << cond::StreamerInfo::technology(data.second)
+                << std::endl;
+    }
+
+    std::string type = cond::demangledName(typeid(ChannelTable));
+    std::unique_ptr<ChannelTable> read = cond::deserialize<ChannelTable>(type, data.first, data.second);
+    // the values are used in place
+    const char* begin = static_cast<const char*>(data.first.data());
+    if (reinterpret_cast<const char*>(read->values()) < begin ||
+        reinterpret_cast<const char*>(read->values() + read->size()) > begin + data.first.size()) {
+      nFail++;
+      std::cout << "ERROR: the values have been copied" << std::endl;
+    }
+    if (read->size() != ids.size()) {
+      nFail++;
+      std::cout << "ERROR: " << read->size() << " values read, " << ids.size() << " expected" << std::endl;
+    }
+    for (uint32_t i = 0; i < ids.size(); i++) {
+      const ChannelRecord* r = read->find(ids[i]);
+      if (!r || r->mean != values[i].mean || r->rms != values[i].rms || r->status != values[i].status) {
+        nFail++;
+        std::cout << "ERROR: wrong value for the id " << ids[i] << std::endl;
+      }
+    }
+    if (read->find(1) != nullptr) {
+      nFail++;
+      std::cout << "ERROR: value found for a missing id" << std::endl;
+    }
+
+    // a misaligned block is copied; a view is used, since the Binary owning its data would align it
+    std::string block = table.toBinary();
+    auto shifted = std::make_shared<std::string>(" " + block);
+    cond::Binary misaligned(shifted, shifted->data() + 1, block.size());
+    read = cond::deserialize<ChannelTable>(type, misaligned, data.second);
+    if (read->size() != ids.size() || read->find(ids[10])->mean != values[10].mean) {
+      nFail++;
+      std::cout << "ERROR: wrong values read from a misaligned block" << std::endl;
+    }
+
+    // equal tables give the same block, which the hash of the payload is computed from, whatever
+    // the memory the values were built in held before
+    std::vector<ChannelRecord> dirtyValues[2];
+    for (int pattern = 0; pattern < 2; pattern++) {
+      for (const ChannelRecord& value : values) {
+        alignas(ChannelRecord) unsigned char memory[sizeof(ChannelRecord)];
+        std::memset(memory, pattern == 0 ? 0x00 : 0xff, sizeof(memory));
+        ChannelRecord* dirty = new (memory) ChannelRecord;
+        dirty->mean = value.mean;
+        dirty->rms = value.rms;
+        dirty->status = value.status;
+        dirty->spare = value.spare;
+        dirtyValues[pattern].push_back(*dirty);
+      }
+    }
+    std::pair<cond::Binary, cond::Binary> data0 = cond::serialize(ChannelTable(ids, dirtyValues[0]));
+    std::pair<cond::Binary, cond::Binary> data1 = cond::serialize(ChannelTable(ids, dirtyValues[1]));
+    if (data0.first.size() != data1.first.size() ||
+        std::memcmp(data0.first.data(), data1.first.data(), data0.first.size()) != 0 ||
+        data0.first.size() != data.first.size() ||
+        std::memcmp(data0.first.data(), data.first.data(), data.first.size()) != 0) {
+      nFail++;
+      std::cout << "ERROR: equal tables have been serialized differently" << std::endl;
+    }
+
+    // the technologies cannot be mixed
+    bool flatThrown = false;
+    try {
+      cond::deserialize<MyTestData>("MyTestData", data.first, data.second);
+    } catch (const cond::Exception& e) {
+      flatThrown = true;
+    }
+    bool boostThrown = false;
+    std::pair<cond::Binary, cond::Binary> boostData = cond::serialize(MyTestData(17));
+    try {
+      cond::deserialize<ChannelTable>(type, boostData.first, boostData.second);
+    } catch (const cond::Exception& e) {
+      boostThrown = true;
+    }
+    if (!flatThrown || !boostThrown) {
+      nFail++;
+      std::cout << "ERROR: a payload has been read with the wrong technology" << std::endl;
+    }
+  } catch (const std::exception& e) {
+    std::cout << "ERROR: " << e.what() << std::endl;
+    return -1;
+  }
+  if (nFail) {
+    std::cout << "## " << nFail << " failures." << std::endl;
+    return -1;
+  }
+  std::cout << "## Run successfully completed." << std::endl;
+  return 0;
+}
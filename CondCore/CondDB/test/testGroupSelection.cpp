@@ -119,6 +119,18 @@ int run(const std::string& csWrite, const std::string& csRead) {
     cond::Iov_t iov8 = reader.getInterval(tg8);
     std::cout << "tg8: since " << iov8.since << " till " << iov8.till << " nqueries " << reader.numberOfQueries()
               << std::endl;
+    // the same lookups, after prefetching the range: one query only
+    IOVProxy prefetched = session.readIov(tag);
+    prefetched.prefetch(tg0, tg8);
+    for (auto tg : {tg0, tg1, tg2, tg3, tg4, tg5, tg6, tg7, tg8}) {
+      cond::Iov_t iov = prefetched.getInterval(tg);
+      std::cout << "prefetched: since " << iov.since << " till " << iov.till << " nqueries "
+                << prefetched.numberOfQueries() << std::endl;
+    }
+    if (prefetched.numberOfQueries() != 1) {
+      std::cout << "ERROR: the prefetched lookups issued " << prefetched.numberOfQueries() << " queries" << std::endl;
+      return -1;
+    }
     session.transaction().commit();
   } catch (const std::exception& e) {
     std::cout << "ERROR: " << e.what() << std::endl;
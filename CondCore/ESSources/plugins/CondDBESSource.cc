@@ -24,6 +24,7 @@
 #include "CondCore/CondDB/interface/PayloadProxy.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include <chrono>
 #include <exception>
 
 #include <iomanip>
@@ -77,6 +78,8 @@ namespace {
         //	<< ", load " << proxy.proxy()->stats.nLoad
         ;
     //if ( proxy.proxy()->stats.nLoad>0) {
+    out << "IOV queries: " << proxy.iovProxy().numberOfQueries() << " in " << proxy.iovProxy().queryTime() << " s"
+        << std::endl;
     out << "Time look up, payloadIds:" << std::endl;
     const auto& pids = *proxy.requests();
     for (auto id : pids)
@@ -92,6 +95,8 @@ namespace {
  *  DBParameters: configuration set of the connection
  *  globaltag: The GlobalTag
  *  toGet: list of record label tag connection-string to add/overwrite the content of the global-tag
+ *  prefetchIOVs: load at the start the IOVs of all the tags valid in the run range of the job, unless a refresh or
+ *                reconnect policy is set
  */
 CondDBESSource::CondDBESSource(const edm::ParameterSet& iConfig)
     : m_connection(),
@@ -258,6 +263,10 @@ CondDBESSource::CondDBESSource(const edm::ParameterSet& iConfig)
     proxy->lateInit(nsess, tag, tagSnapshotTime, it->second.recordLabel(), connStr);
   }
 
+  if (iConfig.exists("prefetchIOVs")) {
+    prefetchIOVs(iConfig.getUntrackedParameter<edm::ParameterSet>("prefetchIOVs"));
+  }
+
   // one loaded expose all other tags to the Proxy!
   CondGetterFromESSource visitor(m_proxies);
   ProxyMap::iterator b = m_proxies.begin();
@@ -653,6 +662,54 @@ void CondDBESSource::fillTagCollectionFromDB(const std::vector<std::string>& con
   }
 }
 
+// Loads the IOVs of all the tags valid in [firstRun, lastRun] with one query per tag, instead of one query at each
+// run or lumi section boundary where a tag changes group. The time stamp tags are left to the lookups on demand.
+void CondDBESSource::prefetchIOVs(const edm::ParameterSet& prefetchPset) {
+  // with these policies the tags are reloaded at each run or at each interval lookup, dropping the IOVs loaded here
+  if (m_policy != NOREFRESH) {
+    edm::LogWarning("CondDBESSource") << "\"prefetchIOVs\" is ignored with the RefreshAlways, RefreshOpenIOVs, "
+                                         "RefreshEachRun and ReconnectEachRun options";
+    return;
+  }
+
+  cond::Time_t firstRun = prefetchPset.getUntrackedParameter<unsigned int>("firstRun");
+  cond::Time_t lastRun = prefetchPset.getUntrackedParameter<unsigned int>("lastRun");
+
+  size_t nTags = 0;
+  size_t nIOVs = 0;
+  size_t nQueries = 0;
+  double queryTime = 0.;
+  auto start = std::chrono::steady_clock::now();
+  for (auto& p : m_proxies) {
+    cond::DataProxyWrapperBase& proxy = *p.second;
+    cond::Time_t begin = firstRun;
+    cond::Time_t end = lastRun;
+    if (proxy.timeType() == cond::lumiid) {
+      begin = firstRun << 32;
+      end = (lastRun << 32) | 0xFFFFFFFF;
+    } else if (proxy.timeType() != cond::runnumber) {
+      continue;
+    }
+    cond::persistency::IOVProxy& iovs = proxy.iovProxy();
+    size_t queries = iovs.numberOfQueries();
+    double time = iovs.queryTime();
+    cond::persistency::TransactionScope transaction(proxy.session().transaction());
+    transaction.start(true);
+    iovs.prefetch(begin, end);
+    transaction.commit();
+    nTags++;
+    nIOVs += iovs.loadedSize();
+    nQueries += iovs.numberOfQueries() - queries;
+    queryTime += iovs.queryTime() - time;
+  }
+
+  edm::LogInfo("CondDBESSource") << "Prefetched " << nIOVs << " IOVs of " << nTags << " tags for the runs " << firstRun
+                                 << " to " << lastRun << " with " << nQueries << " queries, " << queryTime
+                                 << " s in the queries, "
+                                 << std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count()
+                                 << " s in total";
+}
+
 // backward compatibility for configuration files
 class PoolDBESSource : public CondDBESSource {
 public:
@@ -131,5 +131,7 @@ private:
                                const std::vector<std::string>& roottagList,
                                std::map<std::string, cond::GTEntry_t>& replacement,
                                cond::GTMetadata_t& gtMetadata);
+
+  void prefetchIOVs(const edm::ParameterSet& prefetchPset);
 };
 #endif
@@ -0,0 +1,26 @@
+#!/bin/sh
+
+function die { echo $1: status $2 ;  exit $2; }
+
+pushd ${LOCAL_TMP_DIR}
+
+CFG=${LOCAL_TEST_DIR}/TestPrefetchIOVsCondCore_cfg.py
+REF=${LOCAL_TEST_DIR}/unit_test_outputs/TestConcurrentIOVsCondCore.log
+
+LOG=TestPrefetchIOVsCondCore
+echo cmsRun TestPrefetchIOVsCondCore_cfg.py
+cmsRun $CFG > $LOG.log 2> $LOG.err || die 'Failed in TestPrefetchIOVsCondCore_cfg.py' $?
+diff $REF $LOG.log || die "comparing $LOG.log" $?
+grep -q "Prefetched" $LOG.err || die "no prefetch in $LOG.err" $?
+
+# the refresh and reconnect policies reload the tags, so the prefetch is skipped with a warning
+for policy in RefreshAlways RefreshOpenIOVs RefreshEachRun ReconnectEachRun; do
+  LOG=TestPrefetchIOVsCondCore_$policy
+  echo cmsRun TestPrefetchIOVsCondCore_cfg.py $policy
+  cmsRun $CFG $policy > $LOG.log 2> $LOG.err || die "Failed in TestPrefetchIOVsCondCore_cfg.py $policy" $?
+  diff $REF $LOG.log || die "comparing $LOG.log" $?
+  grep -q '"prefetchIOVs" is ignored' $LOG.err || die "no warning in $LOG.err" $?
+  grep -q "Prefetched" $LOG.err && die "prefetch done in $LOG.err" 1
+done
+
+popd
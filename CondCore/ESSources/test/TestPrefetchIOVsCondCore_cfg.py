@@ -0,0 +1,57 @@
+# This configuration tests the prefetchIOVs option of CondDBESSource.
+# It reads the same BeamSpot data as TestConcurrentIOVsCondCore_cfg.py,
+# with multiple IOVs in the same run, after loading at the start the
+# IOVs of the run. The values printed to standard out are compared to
+# the same reference file, so the prefetched IOVs must deliver the same
+# data objects as the lookups on demand. With a refresh or reconnect
+# option, given as the argument, the prefetch is skipped with a warning.
+
+import sys
+import FWCore.ParameterSet.Config as cms
+
+policy = sys.argv[2] if len(sys.argv) > 2 else ''
+
+process = cms.Process("TEST")
+
+process.load("FWCore.MessageService.MessageLogger_cfi")
+process.MessageLogger.cerr.CondDBESSource = cms.untracked.PSet(limit = cms.untracked.int32(-1))
+
+process.source = cms.Source("EmptySource",
+    firstRun = cms.untracked.uint32(132598),
+    firstLuminosityBlock = cms.untracked.uint32(1),
+    firstEvent = cms.untracked.uint32(1),
+    numberEventsInRun = cms.untracked.uint32(1000000),
+    numberEventsInLuminosityBlock = cms.untracked.uint32(1)
+)
+
+process.maxEvents = cms.untracked.PSet(
+  input = cms.untracked.int32(200)
+)
+
+process.GlobalTag = cms.ESSource("PoolDBESSource",
+    DBParameters = cms.PSet(
+        authenticationPath = cms.untracked.string(''),
+        authenticationSystem = cms.untracked.int32(0),
+        messageLevel = cms.untracked.int32(0),
+        security = cms.untracked.string('')
+    ),
+    DumpStat = cms.untracked.bool(False),
+    ReconnectEachRun = cms.untracked.bool(policy == 'ReconnectEachRun'),
+    RefreshAlways = cms.untracked.bool(policy == 'RefreshAlways'),
+    RefreshEachRun = cms.untracked.bool(policy == 'RefreshEachRun'),
+    RefreshOpenIOVs = cms.untracked.bool(policy == 'RefreshOpenIOVs'),
+    connect = cms.string('frontier://FrontierProd/CMS_CONDITIONS'),
+    globaltag = cms.string('110X_dataRun2_v5'),
+    pfnPostfix = cms.untracked.string(''),
+    pfnPrefix = cms.untracked.string(''),
+    snapshotTime = cms.string(''),
+    toGet = cms.VPSet(),
+    prefetchIOVs = cms.untracked.PSet(
+        firstRun = cms.untracked.uint32(132598),
+        lastRun = cms.untracked.uint32(132598)
+    )
+)
+
+process.test = cms.EDAnalyzer("TestConcurrentIOVsCondCore")
+
+process.p = cms.Path(process.test)
@@ -0,0 +1,185 @@
+#ifndef CondFormats_Serialization_FlatTable_h
+#define CondFormats_Serialization_FlatTable_h
+
+// A table of fixed-layout values indexed by a 32 bits id (e.g. a DetId), stored
+// by the Conditions Database as one aligned binary block instead of a boost archive.
+// The block is used in place when read back: a payload deriving from FlatTable is not
+// deserialized, it points into the memory holding the block, which may be a file
+// mapped in memory and shared by all the processes of a node.
+//
+// The values must be trivially copyable, and must not change layout once uploaded:
+// the size of the values is checked when reading, the meaning of their members is not.
+// They are stored byte for byte, so they must not have padding: its bytes are indeterminate
+// and would change the hash of the payload, defeating its deduplication. The compiler only
+// proves it for values without floating point members; the others declare their members:
+//
+//   struct PedestalRecord { float mean; float rms; };
+//   template <>
+//   struct cond::serialization::is_packed<PedestalRecord>
+//       : std::bool_constant<cond::serialization::isPacked(&PedestalRecord::mean, &PedestalRecord::rms)> {};
+//   class Pedestals : public cond::serialization::FlatTable<PedestalRecord> { ... };
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace cond {
+  namespace serialization {
+
+    // the layout of the binary block: the header, then the ids, then the values
+    struct FlatHeader {
+      static constexpr char MAGIC[8] = {'C', 'M', 'S', 'F', 'L', 'A', 'T', '1'};
+      // the alignment of the values in the block, and of the block itself for being used in place
+      static constexpr size_t ALIGNMENT = 64;
+
+      char magic[8];
+      uint32_t valueSize;
+      uint32_t valueAlignment;
+      uint64_t size;
+      uint64_t idsOffset;
+      uint64_t valuesOffset;
+    };
+
+    // true for the types without padding bits
+    template <typename T>
+    struct is_packed : std::bool_constant<std::has_unique_object_representations_v<T>> {};
+
+    // true if the members, which must be all the members of T, fill T and have no padding themselves;
+    // floating point members are accepted although they have several representations of a value
+    template <typename T, typename... M>
+    constexpr bool isPacked(M T::*...) {
+      return sizeof(T) == (sizeof(M) + ... + 0) &&
+             ((std::is_floating_point_v<std::remove_all_extents_t<M>> ||
+               is_packed<std::remove_all_extents_t<M>>::value) &&
+              ...);
+    }
+
+    template <typename T>
+    class FlatTable {
+      static_assert(std::is_trivially_copyable<T>::value, "the values of a FlatTable must be trivially copyable");
+      static_assert(is_packed<T>::value, "the values of a FlatTable must not have padding, see is_packed");
+      static_assert(alignof(T) <= FlatHeader::ALIGNMENT, "the values of a FlatTable are over-aligned");
+
+    public:
+      typedef T flat_value_type;
+
+      FlatTable() : ids_(nullptr), values_(nullptr), size_(0) {}
+
+      // the ids must be unique, the table is sorted by id
+      FlatTable(const std::vector<uint32_t>& ids, const std::vector<T>& values) : FlatTable() {
+        std::vector<size_t> order(std::min(ids.size(), values.size()));
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&ids](size_t i, size_t j) { return ids[i] < ids[j]; });
+        auto storage = std::make_shared<Storage>();
+        storage->ids.reserve(order.size());
+        storage->values.reserve(order.size());
+        for (size_t i : order) {
+          storage->ids.push_back(ids[i]);
+          storage->values.push_back(values[i]);
+        }
+        ids_ = storage->ids.data();
+        values_ = storage->values.data();
+        size_ = order.size();
+        owner_ = std::move(storage);
+      }
+
+      size_t size() const { return size_; }
+      bool empty() const { return size_ == 0; }
+
+      const uint32_t* ids() const { return ids_; }
+      const T* values() const { return values_; }
+
+      const T* begin() const { return values_; }
+      const T* end() const { return values_ + size_; }
+      const T& operator[](size_t i) const { return values_[i]; }
+
+      // nullptr if the id is not in the table
+      const T* find(uint32_t id) const {
+        const uint32_t* p = std::lower_bound(ids_, ids_ + size_, id);
+        return (p != ids_ + size_ && *p == id) ? values_ + (p - ids_) : nullptr;
+      }
+
+      // the binary block, starting at an address aligned to FlatHeader::ALIGNMENT
+      std::string toBinary() const {
+        FlatHeader header;
+        std::copy(FlatHeader::MAGIC, FlatHeader::MAGIC + 8, header.magic);
+        header.valueSize = sizeof(T);
+        header.valueAlignment = alignof(T);
+        header.size = size_;
+        header.idsOffset = sizeof(FlatHeader);
+        header.valuesOffset = align(header.idsOffset + size_ * sizeof(uint32_t));
+        std::string block(header.valuesOffset + size_ * sizeof(T), '\0');
+        std::memcpy(&block[0], &header, sizeof(FlatHeader));
+        if (size_ > 0) {
+          std::memcpy(&block[header.idsOffset], ids_, size_ * sizeof(uint32_t));
+          std::memcpy(&block[header.valuesOffset], values_, size_ * sizeof(T));
+        }
+        return block;
+      }
+
+      // uses the binary block in place, keeping 'block' alive, or copies it if it is misaligned;
+      // false if the block is not a FlatTable of values of this size
+      bool fromBinary(std::shared_ptr<const void> block, size_t blockSize) {
+        FlatHeader header;
+        if (blockSize < sizeof(FlatHeader))
+          return false;
+        std::memcpy(&header, block.get(), sizeof(FlatHeader));
+        if (!std::equal(FlatHeader::MAGIC, FlatHeader::MAGIC + 8, header.magic) || header.valueSize != sizeof(T) ||
+            header.valueAlignment != alignof(T) || header.idsOffset + header.size * sizeof(uint32_t) > blockSize ||
+            header.valuesOffset + header.size * sizeof(T) > blockSize || header.idsOffset % alignof(uint32_t) != 0 ||
+            header.valuesOffset % alignof(T) != 0)
+          return false;
+        const char* begin = static_cast<const char*>(block.get());
+        if (reinterpret_cast<uintptr_t>(begin) % alignof(T) != 0 ||
+            reinterpret_cast<uintptr_t>(begin) % alignof(uint32_t) != 0) {
+          auto storage = std::make_shared<Storage>();
+          storage->ids.resize(header.size);
+          storage->values.resize(header.size);
+          std::memcpy(storage->ids.data(), begin + header.idsOffset, header.size * sizeof(uint32_t));
+          std::memcpy(storage->values.data(), begin + header.valuesOffset, header.size * sizeof(T));
+          ids_ = storage->ids.data();
+          values_ = storage->values.data();
+          owner_ = std::move(storage);
+        } else {
+          ids_ = reinterpret_cast<const uint32_t*>(begin + header.idsOffset);
+          values_ = reinterpret_cast<const T*>(begin + header.valuesOffset);
+          owner_ = std::move(block);
+        }
+        size_ = header.size;
+        return true;
+      }
+
+    private:
+      struct Storage {
+        std::vector<uint32_t> ids;
+        std::vector<T> values;
+      };
+
+      static uint64_t align(uint64_t offset) {
+        return (offset + FlatHeader::ALIGNMENT - 1) / FlatHeader::ALIGNMENT * FlatHeader::ALIGNMENT;
+      }
+
+      // the memory holding ids_ and values_, never modified once set: the copies of a table share it
+      std::shared_ptr<const void> owner_;
+      const uint32_t* ids_;
+      const T* values_;
+      size_t size_;
+    };
+
+    // true for the payloads stored as one binary block
+    template <typename T, typename Enabled = void>
+    struct is_flat : std::false_type {};
+
+    template <typename T>
+    struct is_flat<T, std::enable_if_t<std::is_base_of<FlatTable<typename T::flat_value_type>, T>::value>>
+        : std::true_type {};
+
+  }  // namespace serialization
+}  // namespace cond
+
+#endif
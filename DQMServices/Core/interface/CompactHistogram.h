@@ -0,0 +1,96 @@
+#ifndef DQMServices_Core_CompactHistogram_h
+#define DQMServices_Core_CompactHistogram_h
+
+#include "DataFormats/Histograms/interface/MonitorElementCollection.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <variant>
+#include <vector>
+
+class TH1;
+
+namespace dqm::impl {
+
+  /** Flat storage for the content of a fixed binning TH1F/S/D or TH2F/S/D,
+   * used by the MonitorElement in place of the ROOT object until the ROOT
+   * object itself is needed (e.g. to save it or to set a bin label).
+   * The bins follow the ROOT global bin numbering, under- and overflows
+   * included, and fills update the contents and statistics the same way
+   * TH1::Fill does, so that the ROOT object made by toROOT() is the same as
+   * if it had been filled directly. */
+  class CompactHistogram {
+  public:
+    using Kind = MonitorElementData::Kind;
+
+    struct Axis {
+      int nbins_ = 0;
+      double low_ = 0.;
+      double high_ = 0.;
+      std::string title_;
+
+      int findBin(double x) const {
+        if (x < low_)
+          return 0;
+        if (not(x < high_))
+          return nbins_ + 1;
+        return 1 + int(nbins_ * (x - low_) / (high_ - low_));
+      }
+    };
+
+    /// nullptr if the histogram uses features that are not kept here
+    /// (variable binning, labels, functions, style changes, ...)
+    static std::unique_ptr<CompactHistogram> fromROOT(Kind kind, TH1 const& h);
+    std::unique_ptr<TH1> toROOT() const;
+
+    int dimension() const { return kind_ >= Kind::TH2F ? 2 : 1; }
+
+    void fill(double x, double w);
+    void fill(double x, double y, double w);
+    void add(CompactHistogram const& other);
+    void reset();
+
+    double entries() const { return entries_; }
+    double binContent(int bin) const;
+    double binContent(int binx, int biny) const { return binContent(globalBin(binx, biny)); }
+    double binError(int bin) const;
+    double binError(int binx, int biny) const { return binError(globalBin(binx, biny)); }
+
+    Axis const& xAxis() const { return x_; }
+    Axis const& yAxis() const { return y_; }
+    std::string const& title() const { return title_; }
+    void setTitle(std::string const& title) { title_ = title; }
+    void setAxisTitle(int axis, std::string const& title) { (axis == 1 ? x_ : y_).title_ = title; }
+
+  private:
+    CompactHistogram() = default;
+
+    int globalBin(int binx, int biny) const { return binx + (x_.nbins_ + 2) * biny; }
+    int ncells() const { return (x_.nbins_ + 2) * (dimension() == 2 ? y_.nbins_ + 2 : 1); }
+    void addBinContent(int bin, double w);
+    void enableSumw2();
+
+    Kind kind_ = Kind::INVALID;
+    std::string name_;
+    std::string title_;
+    std::string option_;
+    Axis x_;
+    Axis y_;
+    // the bin counters have the same type as in the corresponding ROOT class
+    std::variant<std::vector<float>, std::vector<int16_t>, std::vector<double>> contents_;
+    std::vector<double> sumw2_;  // empty unless the sum of the squares of the weights is stored
+    bool statOverflows_ = false;  // the under- and overflows count in the statistics
+    double entries_ = 0.;
+    double tsumw_ = 0.;
+    double tsumw2_ = 0.;
+    double tsumwx_ = 0.;
+    double tsumwx2_ = 0.;
+    double tsumwy_ = 0.;
+    double tsumwy2_ = 0.;
+    double tsumwxy_ = 0.;
+  };
+
+}  // namespace dqm::impl
+
+#endif  // DQMServices_Core_CompactHistogram_h
@@ -310,6 +310,8 @@ namespace dqm::dqmstoreimpl {
         run_ = run;
         moduleId_ = 0;
         canSaveByLumi_ = false;
+        // these MEs are filled concurrently by all streams
+        shardFill_ = enableShardedFill_;
       }
       IBooker booker(this);
       f(booker);
@@ -319,6 +321,7 @@ namespace dqm::dqmstoreimpl {
         run_ = 0;
         moduleId_ = 0;
         canSaveByLumi_ = false;
+        shardFill_ = false;
       }
     }
 
@@ -584,6 +587,9 @@ namespace dqm::dqmstoreimpl {
 
     void deleteUnusedLumiHistograms(uint32_t run, uint32_t lumi);
 
+    // fold the per-thread shards of the global MEs of a run into the MEs
+    void mergeShards(uint32_t run);
+
     DQMStore(DQMStore const&) = delete;
     DQMStore& operator=(DQMStore const&) = delete;
 
@@ -593,6 +599,8 @@ namespace dqm::dqmstoreimpl {
     void reset();
     void forceReset();
     void postGlobalBeginLumi(const edm::GlobalContext&);
+    void preGlobalEndLumi(const edm::GlobalContext&);
+    void preGlobalEndRun(const edm::GlobalContext&);
 
     bool extract(TObject* obj, std::string const& dir, bool overwrite, bool collateHistograms);
     TObject* extractNextObject(TBufferFile&) const;
@@ -677,6 +685,12 @@ namespace dqm::dqmstoreimpl {
     bool canSaveByLumi_{false};
     // set to true in configuration if per-lumi saving is requested.
     bool doSaveByLumi_{false};
+    // set to true in configuration if concurrently filled MEs should use per-thread shards.
+    bool enableShardedFill_{false};
+    // set to true in configuration if plain histograms should be kept in flat arrays until they are saved.
+    bool enableCompactHistograms_{false};
+    // set to true in the transaction if the MEs being booked are filled by all streams.
+    bool shardFill_{false};
     std::unique_ptr<std::ostream> stream_{nullptr};
 
     std::string pwd_{};
@@ -6,6 +6,7 @@
 #define DQM_DEPRECATED
 #endif
 
+#include "DQMServices/Core/interface/CompactHistogram.h"
 #include "DQMServices/Core/interface/DQMNet.h"
 #include "DQMServices/Core/interface/QReport.h"
 
@@ -28,6 +29,7 @@
 
 #include <mutex>
 #include <string>
+#include <vector>
 #include <atomic>
 #include <sstream>
 #include <iomanip>
@@ -35,6 +37,7 @@
 #include <cstdint>
 #include <sys/time.h>
 #include <tbb/spin_mutex.h>
+#include <tbb/enumerable_thread_specific.h>
 
 class QCriterion;
 class DQMService;
@@ -53,19 +56,45 @@ namespace dqm::impl {
     std::unique_lock<dqmmutex> guard_;
     MonitorElementData::Key const &key;
     MonitorElementData::Value const &value;
+    // set if the histogram may be kept in a CompactHistogram instead of value.object_
+    std::unique_ptr<CompactHistogram> *compact = nullptr;
+    CompactHistogram *compactHistogram() const { return compact ? compact->get() : nullptr; }
   };
   // TODO: can this be the same type, just const?
   struct AccessMut {
     std::unique_lock<dqmmutex> guard_;
     MonitorElementData::Key const &key;
     MonitorElementData::Value &value;
+    std::unique_ptr<CompactHistogram> *compact = nullptr;
+    CompactHistogram *compactHistogram() const { return compact ? compact->get() : nullptr; }
+  };
+
+  // A per-thread copy of the histogram of a sharded ME. The lock is only
+  // contended when the shards are merged back or reset.
+  struct MonitorElementShard {
+    dqmmutex lock_;
+    MonitorElementData::Value value_;
+    std::unique_ptr<CompactHistogram> compact_;
+  };
+  // The shards of a ME. A filling thread finds its own shard through local_,
+  // while mergeShards() and Reset() visit them through all_: iterating local_
+  // while another thread adds its shard to it is a data race. A shard is
+  // added to all_, under lock_, once it holds its copy of the histogram.
+  struct MonitorElementShards {
+    tbb::enumerable_thread_specific<MonitorElementShard> local_;
+    std::mutex lock_;
+    std::vector<MonitorElementShard *> all_;
   };
 
   struct MutableMonitorElementData {
     MonitorElementData data_;
     dqmmutex lock_;
-    Access access() { return Access{std::unique_lock<dqmmutex>(lock_), data_.key_, data_.value_}; }
-    AccessMut accessMut() { return AccessMut{std::unique_lock<dqmmutex>(lock_), data_.key_, data_.value_}; }
+    std::unique_ptr<MonitorElementShards> shards_;  // only set if Fill() goes to per-thread shards
+    std::unique_ptr<CompactHistogram> compact_;     // only set if the histogram is not a ROOT object (yet)
+    Access access() { return Access{std::unique_lock<dqmmutex>(lock_), data_.key_, data_.value_, &compact_}; }
+    AccessMut accessMut() {
+      return AccessMut{std::unique_lock<dqmmutex>(lock_), data_.key_, data_.value_, &compact_};
+    }
   };
 
   /** The base class for all MonitorElements (ME) */
@@ -158,6 +187,48 @@ namespace dqm::impl {
       // products once all processing is done (logically, this is safe).
     }
 
+    /**
+     * Like accessMut(), but used by the Fill() methods: if the ME is sharded
+     * (see enableFillShards()), the fill goes to a private copy of the
+     * histogram owned by the calling thread. The copy is made on the first
+     * fill from each thread, with the lock on the main object held only while
+     * cloning it. The shards are folded back into the main object by
+     * mergeShards(), which takes the locks in the order main -> list of
+     * shards -> shard; since a filling thread never holds two of them, there
+     * is no deadlock.
+     */
+    AccessMut accessFill() {
+      auto mut = mutable_.load();
+      if (not mut or not mut->shards_) {
+        return accessMut();
+      }
+      this->update();
+      bool exists = false;
+      MonitorElementShard &shard = mut->shards_->local_.local(exists);
+      if (not exists) {
+        std::unique_ptr<TH1> clone;
+        std::unique_ptr<CompactHistogram> compactClone;
+        {
+          auto access = mut->access();
+          if (auto compact = access.compactHistogram()) {
+            compactClone = std::make_unique<CompactHistogram>(*compact);
+            compactClone->reset();
+          } else {
+            clone = std::unique_ptr<TH1>(static_cast<TH1 *>(access.value.object_->Clone()));
+            clone->Reset();
+          }
+        }
+        {
+          std::lock_guard<dqmmutex> guard(shard.lock_);
+          shard.value_.object_ = std::move(clone);
+          shard.compact_ = std::move(compactClone);
+        }
+        std::lock_guard<std::mutex> guard(mut->shards_->lock_);
+        mut->shards_->all_.push_back(&shard);
+      }
+      return AccessMut{std::unique_lock<dqmmutex>(shard.lock_), mut->data_.key_, shard.value_, &shard.compact_};
+    }
+
     //TODO:  to be dropped.
     TH1 *reference_;                 //< Current ROOT reference object.
     TH1 *refvalue_;                  //< Soft reference if any.
@@ -292,6 +363,23 @@ namespace dqm::impl {
 
     virtual void Reset();
 
+    /// Fill() per-thread copies of the histogram instead of taking the lock
+    /// on the shared one; only effective for histogram MEs. The content seen
+    /// through the getters only includes the fills up to the last mergeShards().
+    void enableFillShards();
+    /// true if Fill() goes to per-thread copies of the histogram
+    bool hasFillShards() const;
+    /// Add the per-thread copies into the main histogram and reset them.
+    void mergeShards();
+
+    /// Keep the content of a plain 1D or 2D histogram in flat arrays instead
+    /// of the ROOT object, which is only made once something needs it (e.g. to
+    /// save the ME, or to set a bin label). Fills, resets, bin contents,
+    /// entries and titles do not need the ROOT object.
+    void enableCompactStorage();
+    /// true if the histogram is currently kept in flat arrays
+    bool hasCompactStorage() const;
+
     // mostly used for IO, should be private.
     std::string valueString() const;
     std::string tagString() const;
@@ -403,6 +491,7 @@ namespace dqm::impl {
 
   protected:
     void incompatible(const char *func) const;
+    void materialize(MonitorElementData::Value const &value, std::unique_ptr<CompactHistogram> *compact) const;
     TH1 const *accessRootObject(Access const &access, const char *func, int reqdim) const;
     TH1 *accessRootObject(AccessMut const &, const char *func, int reqdim) const;
 
@@ -14,4 +14,10 @@ DQMStore = cms.Service("DQMStore",
     # similar to LSBasedMode but for offline. Explicitly sets LumiFLag on all
     # MEs/modules that allow it (canSaveByLumi)
     saveByLumi = cms.untracked.bool(False),
+    # MEs booked by global modules and services are filled through per-thread
+    # copies, merged at the end of each lumisection and run.
+    enableShardedFill = cms.untracked.bool(False),
+    # plain 1D and 2D histograms are kept in flat arrays, and only turned into
+    # ROOT objects when something (e.g. saving them) needs the ROOT object.
+    enableCompactHistograms = cms.untracked.bool(False),
 )
@@ -0,0 +1,278 @@
+#include "DQMServices/Core/interface/CompactHistogram.h"
+
+#include "TArrayD.h"
+#include "TArrayF.h"
+#include "TArrayS.h"
+#include "TAxis.h"
+#include "TH1D.h"
+#include "TH1F.h"
+#include "TH1S.h"
+#include "TH2D.h"
+#include "TH2F.h"
+#include "TH2S.h"
+#include "TList.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace dqm::impl {
+
+  namespace {
+    std::unique_ptr<TH1> makeROOT(MonitorElementData::Kind kind,
+                                  std::string const& name,
+                                  std::string const& title,
+                                  CompactHistogram::Axis const& x,
+                                  CompactHistogram::Axis const& y) {
+      using Kind = MonitorElementData::Kind;
+      TH1* h = nullptr;
+      switch (kind) {
+        case Kind::TH1F:
+          h = new TH1F(name.c_str(), title.c_str(), x.nbins_, x.low_, x.high_);
+          break;
+        case Kind::TH1S:
+          h = new TH1S(name.c_str(), title.c_str(), x.nbins_, x.low_, x.high_);
+          break;
+        case Kind::TH1D:
+          h = new TH1D(name.c_str(), title.c_str(), x.nbins_, x.low_, x.high_);
+          break;
+        case Kind::TH2F:
+          h = new TH2F(name.c_str(), title.c_str(), x.nbins_, x.low_, x.high_, y.nbins_, y.low_, y.high_);
+          break;
+        case Kind::TH2S:
+          h = new TH2S(name.c_str(), title.c_str(), x.nbins_, x.low_, x.high_, y.nbins_, y.low_, y.high_);
+          break;
+        case Kind::TH2D:
+          h = new TH2D(name.c_str(), title.c_str(), x.nbins_, x.low_, x.high_, y.nbins_, y.low_, y.high_);
+          break;
+        default:
+          return nullptr;
+      }
+      h->SetDirectory(nullptr);
+      return std::unique_ptr<TH1>(h);
+    }
+
+    bool isPlainAxis(TAxis const* a, TAxis const* fresh) {
+      return a->GetXbins()->GetSize() == 0 and a->GetLabels() == nullptr and not a->GetTimeDisplay() and
+             not a->TestBit(TAxis::kAxisRange) and a->GetNdivisions() == fresh->GetNdivisions() and
+             a->GetTitleOffset() == fresh->GetTitleOffset() and a->GetTitleSize() == fresh->GetTitleSize() and
+             a->GetLabelSize() == fresh->GetLabelSize() and a->GetLabelOffset() == fresh->GetLabelOffset() and
+             a->TestBit(TAxis::kCenterTitle) == fresh->TestBit(TAxis::kCenterTitle) and
+             a->TestBit(TAxis::kMoreLogLabels) == fresh->TestBit(TAxis::kMoreLogLabels);
+    }
+
+    // Only the content, the titles and the draw option are kept, so anything
+    // else that differs from a newly booked histogram rules out the compact storage.
+    bool isPlain(TH1 const& h, TH1 const& fresh) {
+      return not h.CanExtendAllAxes() and h.GetBufferSize() == 0 and
+             (h.GetListOfFunctions() == nullptr or h.GetListOfFunctions()->GetSize() == 0) and
+             not h.TestBit(TH1::kIsNotW) and h.TestBit(TH1::kNoStats) == fresh.TestBit(TH1::kNoStats) and
+             h.GetBinErrorOption() == TH1::kNormal and h.GetNormFactor() == fresh.GetNormFactor() and
+             h.GetStatOverflowsBehaviour() == fresh.GetStatOverflowsBehaviour() and
+             h.GetMinimumStored() == fresh.GetMinimumStored() and h.GetMaximumStored() == fresh.GetMaximumStored() and
+             h.GetBarOffset() == fresh.GetBarOffset() and h.GetBarWidth() == fresh.GetBarWidth() and
+             h.GetLineColor() == fresh.GetLineColor() and h.GetLineStyle() == fresh.GetLineStyle() and
+             h.GetLineWidth() == fresh.GetLineWidth() and h.GetFillColor() == fresh.GetFillColor() and
+             h.GetFillStyle() == fresh.GetFillStyle() and h.GetMarkerColor() == fresh.GetMarkerColor() and
+             h.GetMarkerStyle() == fresh.GetMarkerStyle() and h.GetMarkerSize() == fresh.GetMarkerSize() and
+             isPlainAxis(h.GetXaxis(), fresh.GetXaxis()) and isPlainAxis(h.GetYaxis(), fresh.GetYaxis());
+    }
+
+    template <typename T, typename A>
+    void copyFromArray(std::vector<T>& into, TH1 const& h) {
+      auto const* a = dynamic_cast<A const*>(&h);
+      into.assign(a->GetArray(), a->GetArray() + a->GetSize());
+    }
+
+    template <typename T, typename A>
+    void copyToArray(std::vector<T> const& from, TH1& h) {
+      auto* a = dynamic_cast<A*>(&h);
+      std::copy(from.begin(), from.end(), a->GetArray());
+    }
+  }  // namespace
+
+  std::unique_ptr<CompactHistogram> CompactHistogram::fromROOT(Kind kind, TH1 const& h) {
+    std::unique_ptr<CompactHistogram> compact(new CompactHistogram());
+    compact->kind_ = kind;
+    compact->name_ = h.GetName();
+    compact->title_ = h.GetTitle();
+    compact->option_ = h.GetOption();
+    compact->x_ = Axis{h.GetNbinsX(), h.GetXaxis()->GetXmin(), h.GetXaxis()->GetXmax(), h.GetXaxis()->GetTitle()};
+    if (compact->dimension() == 2)
+      compact->y_ = Axis{h.GetNbinsY(), h.GetYaxis()->GetXmin(), h.GetYaxis()->GetXmax(), h.GetYaxis()->GetTitle()};
+    else
+      compact->y_.title_ = h.GetYaxis()->GetTitle();
+
+    auto fresh = makeROOT(kind, compact->name_, compact->title_, compact->x_, compact->y_);
+    if (not fresh or h.GetDimension() != compact->dimension() or not isPlain(h, *fresh))
+      return nullptr;
+    compact->statOverflows_ = h.GetStatOverflowsBehaviour();
+
+    switch (kind) {
+      case Kind::TH1F:
+      case Kind::TH2F:
+        copyFromArray<float, TArrayF>(compact->contents_.emplace<std::vector<float>>(), h);
+        break;
+      case Kind::TH1S:
+      case Kind::TH2S:
+        copyFromArray<int16_t, TArrayS>(compact->contents_.emplace<std::vector<int16_t>>(), h);
+        break;
+      default:
+        copyFromArray<double, TArrayD>(compact->contents_.emplace<std::vector<double>>(), h);
+        break;
+    }
+    if (h.GetSumw2N() > 0)
+      compact->sumw2_.assign(h.GetSumw2()->GetArray(), h.GetSumw2()->GetArray() + h.GetSumw2N());
+
+    double stats[TH1::kNstat] = {};
+    h.GetStats(stats);
+    compact->entries_ = h.GetEntries();
+    compact->tsumw_ = stats[0];
+    compact->tsumw2_ = stats[1];
+    compact->tsumwx_ = stats[2];
+    compact->tsumwx2_ = stats[3];
+    if (compact->dimension() == 2) {
+      compact->tsumwy_ = stats[4];
+      compact->tsumwy2_ = stats[5];
+      compact->tsumwxy_ = stats[6];
+    }
+    return compact;
+  }
+
+  std::unique_ptr<TH1> CompactHistogram::toROOT() const {
+    auto h = makeROOT(kind_, name_, title_, x_, y_);
+    h->GetXaxis()->SetTitle(x_.title_.c_str());
+    h->GetYaxis()->SetTitle(y_.title_.c_str());
+    if (not option_.empty())
+      h->SetOption(option_.c_str());
+
+    switch (contents_.index()) {
+      case 0:
+        copyToArray<float, TArrayF>(std::get<0>(contents_), *h);
+        break;
+      case 1:
+        copyToArray<int16_t, TArrayS>(std::get<1>(contents_), *h);
+        break;
+      default:
+        copyToArray<double, TArrayD>(std::get<2>(contents_), *h);
+        break;
+    }
+    if (not sumw2_.empty()) {
+      if (h->GetSumw2N() == 0)
+        h->Sumw2();
+      h->GetSumw2()->Set(ncells(), sumw2_.data());
+    }
+
+    double stats[TH1::kNstat] = {tsumw_, tsumw2_, tsumwx_, tsumwx2_, tsumwy_, tsumwy2_, tsumwxy_};
+    h->PutStats(stats);
+    h->SetEntries(entries_);
+    return h;
+  }
+
+  void CompactHistogram::addBinContent(int bin, double w) {
+    switch (contents_.index()) {
+      case 0:
+        std::get<0>(contents_)[bin] += float(w);
+        break;
+      case 1: {
+        // saturate as TH1S::AddBinContent does
+        auto& content = std::get<1>(contents_)[bin];
+        int value = content + int(w);
+        content = std::clamp(value, -32767, 32767);
+        break;
+      }
+      default:
+        std::get<2>(contents_)[bin] += w;
+        break;
+    }
+  }
+
+  void CompactHistogram::enableSumw2() {
+    std::visit(
+        [this](auto const& contents) {
+          sumw2_.resize(contents.size());
+          for (size_t i = 0; i < contents.size(); ++i)
+            sumw2_[i] = std::abs(double(contents[i]));
+        },
+        contents_);
+  }
+
+  void CompactHistogram::fill(double x, double w) {
+    entries_ += 1;
+    int bin = x_.findBin(x);
+    if (sumw2_.empty() and w != 1.)
+      enableSumw2();
+    if (not sumw2_.empty())
+      sumw2_[bin] += w * w;
+    addBinContent(bin, w);
+    if ((bin == 0 or bin > x_.nbins_) and not statOverflows_)
+      return;
+    tsumw_ += w;
+    tsumw2_ += w * w;
+    tsumwx_ += w * x;
+    tsumwx2_ += w * x * x;
+  }
+
+  void CompactHistogram::fill(double x, double y, double w) {
+    entries_ += 1;
+    int binx = x_.findBin(x);
+    int biny = y_.findBin(y);
+    int bin = globalBin(binx, biny);
+    if (sumw2_.empty() and w != 1.)
+      enableSumw2();
+    if (not sumw2_.empty())
+      sumw2_[bin] += w * w;
+    addBinContent(bin, w);
+    if ((binx == 0 or binx > x_.nbins_ or biny == 0 or biny > y_.nbins_) and not statOverflows_)
+      return;
+    tsumw_ += w;
+    tsumw2_ += w * w;
+    tsumwx_ += w * x;
+    tsumwx2_ += w * x * x;
+    tsumwy_ += w * y;
+    tsumwy2_ += w * y * y;
+    tsumwxy_ += w * x * y;
+  }
+
+  void CompactHistogram::add(CompactHistogram const& other) {
+    if (sumw2_.empty() and not other.sumw2_.empty())
+      enableSumw2();
+    std::visit(
+        [this, &other](auto const& contents) {
+          using Contents = std::decay_t<decltype(contents)>;
+          auto const& others = std::get<Contents>(other.contents_);
+          for (size_t i = 0; i < others.size(); ++i) {
+            if (not sumw2_.empty())
+              sumw2_[i] += other.sumw2_.empty() ? std::abs(double(others[i])) : other.sumw2_[i];
+            addBinContent(i, others[i]);
+          }
+        },
+        contents_);
+    entries_ += other.entries_;
+    tsumw_ += other.tsumw_;
+    tsumw2_ += other.tsumw2_;
+    tsumwx_ += other.tsumwx_;
+    tsumwx2_ += other.tsumwx2_;
+    tsumwy_ += other.tsumwy_;
+    tsumwy2_ += other.tsumwy2_;
+    tsumwxy_ += other.tsumwxy_;
+  }
+
+  void CompactHistogram::reset() {
+    std::visit([](auto& contents) { std::fill(contents.begin(), contents.end(), 0); }, contents_);
+    std::fill(sumw2_.begin(), sumw2_.end(), 0.);
+    entries_ = tsumw_ = tsumw2_ = tsumwx_ = tsumwx2_ = tsumwy_ = tsumwy2_ = tsumwxy_ = 0.;
+  }
+
+  double CompactHistogram::binContent(int bin) const {
+    int i = std::clamp(bin, 0, ncells() - 1);
+    return std::visit([i](auto const& contents) { return double(contents[i]); }, contents_);
+  }
+
+  double CompactHistogram::binError(int bin) const {
+    int i = std::clamp(bin, 0, ncells() - 1);
+    if (not sumw2_.empty())
+      return std::sqrt(sumw2_[i]);
+    return std::sqrt(std::abs(binContent(i)));
+  }
+
+}  // namespace dqm::impl
@@ -477,6 +477,10 @@ namespace dqm::dqmstoreimpl {
 #endif
     }
     ar.watchPostGlobalBeginLumi(this, &DQMStore::postGlobalBeginLumi);
+    if (enableShardedFill_) {
+      ar.watchPreGlobalEndLumi(this, &DQMStore::preGlobalEndLumi);
+      ar.watchPreGlobalEndRun(this, &DQMStore::preGlobalEndRun);
+    }
   }
 
   DQMStore::DQMStore(edm::ParameterSet const& pset) { initializeFrom(pset); }
@@ -510,6 +514,14 @@ namespace dqm::dqmstoreimpl {
     if (enableMultiThread_)
       std::cout << "DQMStore: MultiThread option is enabled\n";
 
+    enableShardedFill_ = pset.getUntrackedParameter<bool>("enableShardedFill", false);
+    if (enableShardedFill_)
+      std::cout << "DQMStore: ShardedFill option is enabled\n";
+
+    enableCompactHistograms_ = pset.getUntrackedParameter<bool>("enableCompactHistograms", false);
+    if (enableCompactHistograms_)
+      std::cout << "DQMStore: CompactHistograms option is enabled\n";
+
     LSbasedMode_ = pset.getUntrackedParameter<bool>("LSbasedMode", false);
     if (LSbasedMode_)
       std::cout << "DQMStore: LSbasedMode option is enabled\n";
@@ -1000,6 +1012,10 @@ namespace dqm::dqmstoreimpl {
       }
       me = (MonitorElement*)const_cast<MonitorElement&>(*data_.insert(std::move(proto)).first)
                .initialise((MonitorElement::Kind)kind, h);
+      if (enableCompactHistograms_)
+        me->enableCompactStorage();
+      if (shardFill_)
+        me->enableFillShards();
 
       // Initialise quality test information.
       for (auto const& q : qtestspecs_) {
@@ -1743,6 +1759,35 @@ namespace dqm::dqmstoreimpl {
     }
   }
 
+  //////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////
+  //////////////////////////////////////////////////////////////////////
+  /** Called before any globalEndLuminosityBlock and globalEndRun,
+ * once all streams are done with the transition: merge the per-thread
+ * shards of the global MEs, so that the modules and the output modules
+ * see the complete content.
+ */
+  void DQMStore::preGlobalEndLumi(edm::GlobalContext const& gc) { mergeShards(gc.luminosityBlockID().run()); }
+
+  void DQMStore::preGlobalEndRun(edm::GlobalContext const& gc) { mergeShards(gc.luminosityBlockID().run()); }
+
+  void DQMStore::mergeShards(uint32_t const run) {
+    static const std::string null_str("");
+
+    // acquire the global lock since this accesses the undelying data structure
+    std::lock_guard<std::mutex> guard(book_mutex_);
+
+    // sharded MEs are global: run != 0, lumi == 0, stream id == 0, module id == 0
+    const MonitorElement begin(&null_str, null_str, run, 0);
+    const MonitorElement end(&null_str, null_str, run, 1);
+    auto i = data_.lower_bound(begin);
+    const auto e = data_.lower_bound(end);
+    for (; i != e; ++i) {
+      if (i->hasFillShards())
+        const_cast<MonitorElement&>(*i).mergeShards();
+    }
+  }
+
   //////////////////////////////////////////////////////////////////////
   //////////////////////////////////////////////////////////////////////
   //////////////////////////////////////////////////////////////////////
@@ -206,6 +206,8 @@ namespace dqm::impl {
     auto xaccess = x.access();
     if (xaccess.value.object_)
       access.value.object_ = std::unique_ptr<TH1>(static_cast<TH1 *>(xaccess.value.object_->Clone()));
+    if (auto compact = xaccess.compactHistogram())
+      *access.compact = std::make_unique<CompactHistogram>(*compact);
     access.value.scalar_ = xaccess.value.scalar_;
 
     if (x.refvalue_)
@@ -257,8 +259,10 @@ namespace dqm::impl {
 
   /// "Fill" ME methods for double
   void MonitorElement::Fill(double x) {
-    auto access = this->accessMut();
+    auto access = this->accessFill();
     update();
+    if (auto compact = access.compactHistogram(); compact and compact->dimension() == 1)
+      return compact->fill(x, 1);
     if (kind() == Kind::INT)
       access.value.scalar_.num = static_cast<int64_t>(x);
     else if (kind() == Kind::REAL)
@@ -275,8 +279,10 @@ namespace dqm::impl {
 
   /// "Fill" ME method for int64_t
   void MonitorElement::doFill(int64_t x) {
-    auto access = this->accessMut();
+    auto access = this->accessFill();
     update();
+    if (auto compact = access.compactHistogram(); compact and compact->dimension() == 1)
+      return compact->fill(static_cast<double>(x), 1);
     if (kind() == Kind::INT)
       access.value.scalar_.num = static_cast<int64_t>(x);
     else if (kind() == Kind::REAL)
@@ -293,8 +299,10 @@ namespace dqm::impl {
 
   /// can be used with 2D (x,y) or 1D (x, w) histograms
   void MonitorElement::Fill(double x, double yw) {
-    auto access = this->accessMut();
+    auto access = this->accessFill();
     update();
+    if (auto compact = access.compactHistogram())
+      return compact->dimension() == 1 ? compact->fill(x, yw) : compact->fill(x, yw, 1);
     if (kind() == Kind::TH1F)
       accessRootObject(access, __PRETTY_FUNCTION__, 1)->Fill(x, yw);
     else if (kind() == Kind::TH1S)
@@ -383,8 +391,10 @@ namespace dqm::impl {
   }
   /// can be used with 3D (x, y, z) or 2D (x, y, w) histograms
   void MonitorElement::Fill(double x, double y, double zw) {
-    auto access = this->accessMut();
+    auto access = this->accessFill();
     update();
+    if (auto compact = access.compactHistogram(); compact and compact->dimension() == 2)
+      return compact->fill(x, y, zw);
     if (kind() == Kind::TH2F)
       static_cast<TH2F *>(accessRootObject(access, __PRETTY_FUNCTION__, 2))->Fill(x, y, zw);
     else if (kind() == Kind::TH2S)
@@ -403,7 +413,7 @@ namespace dqm::impl {
 
   /// can be used with 3D (x, y, z, w) histograms
   void MonitorElement::Fill(double x, double y, double z, double w) {
-    auto access = this->accessMut();
+    auto access = this->accessFill();
     update();
     if (kind() == Kind::TH3F)
       static_cast<TH3F *>(accessRootObject(access, __PRETTY_FUNCTION__, 2))->Fill(x, y, z, w);
@@ -423,8 +433,97 @@ namespace dqm::impl {
       access.value.scalar_.real = 0;
     else if (kind() == Kind::STRING)
       access.value.scalar_.str.clear();
-    else
-      return accessRootObject(access, __PRETTY_FUNCTION__, 1)->Reset();
+    else {
+      if (auto compact = access.compactHistogram())
+        compact->reset();
+      else
+        accessRootObject(access, __PRETTY_FUNCTION__, 1)->Reset();
+      auto mut = mutable_.load();
+      if (mut and mut->shards_) {
+        std::lock_guard<std::mutex> shards(mut->shards_->lock_);
+        for (auto shard : mut->shards_->all_) {
+          std::lock_guard<dqmmutex> guard(shard->lock_);
+          if (shard->compact_)
+            shard->compact_->reset();
+          if (shard->value_.object_)
+            shard->value_.object_->Reset();
+        }
+      }
+    }
+  }
+
+  void MonitorElement::enableFillShards() {
+    auto mut = mutable_.load();
+    if (not mut or mut->shards_)
+      return;
+    // scalars keep their "last value wins" semantics, and are never sharded
+    if (kind() < Kind::TH1F)
+      return;
+    mut->shards_ = std::make_unique<MonitorElementShards>();
+  }
+
+  bool MonitorElement::hasFillShards() const {
+    auto mut = mutable_.load();
+    return mut and mut->shards_;
+  }
+
+  void MonitorElement::mergeShards() {
+    auto mut = mutable_.load();
+    if (not mut or not mut->shards_)
+      return;
+    auto access = mut->accessMut();
+    std::lock_guard<std::mutex> shards(mut->shards_->lock_);
+    for (auto shard : mut->shards_->all_) {
+      std::lock_guard<dqmmutex> guard(shard->lock_);
+      if (shard->compact_ and shard->compact_->entries() > 0) {
+        if (auto compact = access.compactHistogram())
+          compact->add(*shard->compact_);
+        else
+          accessRootObject(access, __PRETTY_FUNCTION__, 1)->Add(shard->compact_->toROOT().get());
+        shard->compact_->reset();
+      }
+      if (shard->value_.object_ and shard->value_.object_->GetEntries() > 0) {
+        accessRootObject(access, __PRETTY_FUNCTION__, 1)->Add(shard->value_.object_.get());
+        shard->value_.object_->Reset();
+      }
+    }
+  }
+
+  void MonitorElement::enableCompactStorage() {
+    auto access = this->accessMut();
+    if (not access.compact or *access.compact or not access.value.object_)
+      return;
+    switch (kind()) {
+      case Kind::TH1F:
+      case Kind::TH1S:
+      case Kind::TH1D:
+      case Kind::TH2F:
+      case Kind::TH2S:
+      case Kind::TH2D:
+        break;
+      default:
+        return;
+    }
+    if (auto compact = CompactHistogram::fromROOT(kind(), *access.value.object_.get())) {
+      *access.compact = std::move(compact);
+      access.value.object_ = std::unique_ptr<TH1>();
+    }
+  }
+
+  bool MonitorElement::hasCompactStorage() const {
+    auto access = this->access();
+    return access.compactHistogram() != nullptr;
+  }
+
+  /// make the ROOT object out of the compact storage, if any; the caller holds the lock.
+  /// This is one way: the pointers to the ROOT object handed out by getTH1() must stay valid.
+  void MonitorElement::materialize(MonitorElementData::Value const &value,
+                                   std::unique_ptr<CompactHistogram> *compact) const {
+    if (not compact or not *compact)
+      return;
+    // the value is owned by the mutable data (or a shard) guarded by the caller's lock
+    const_cast<MonitorElementData::Value &>(value).object_ = (*compact)->toROOT();
+    compact->reset();
   }
 
   /// convert scalar data into a string.
@@ -607,6 +706,7 @@ namespace dqm::impl {
                     " element '%s' because it is not a root object",
                     func,
                     data_.objname.c_str());
+    materialize(access.value, access.compact);
     return access.value.object_.get();
   }
   TH1 *MonitorElement::accessRootObject(AccessMut const &access, const char *func, int reqdim) const {
@@ -616,6 +716,7 @@ namespace dqm::impl {
                     " element '%s' because it is not a root object",
                     func,
                     data_.objname.c_str());
+    materialize(access.value, access.compact);
     return checkRootObject(data_.objname, access.value.object_.get(), func, reqdim);
   }
 
@@ -649,12 +750,16 @@ namespace dqm::impl {
   /// get # of bins in X-axis
   int MonitorElement::getNbinsX() const {
     auto access = this->access();
+    if (auto compact = access.compactHistogram())
+      return compact->xAxis().nbins_;
     return accessRootObject(access, __PRETTY_FUNCTION__, 1)->GetNbinsX();
   }
 
   /// get # of bins in Y-axis
   int MonitorElement::getNbinsY() const {
     auto access = this->access();
+    if (auto compact = access.compactHistogram())
+      return compact->dimension() == 2 ? compact->yAxis().nbins_ : 1;
     return accessRootObject(access, __PRETTY_FUNCTION__, 2)->GetNbinsY();
   }
 
@@ -667,12 +772,16 @@ namespace dqm::impl {
   /// get content of bin (1-D)
   double MonitorElement::getBinContent(int binx) const {
     auto access = this->access();
+    if (auto compact = access.compactHistogram())
+      return compact->binContent(binx);
     return accessRootObject(access, __PRETTY_FUNCTION__, 1)->GetBinContent(binx);
   }
 
   /// get content of bin (2-D)
   double MonitorElement::getBinContent(int binx, int biny) const {
     auto access = this->access();
+    if (auto compact = access.compactHistogram(); compact and compact->dimension() == 2)
+      return compact->binContent(binx, biny);
     return accessRootObject(access, __PRETTY_FUNCTION__, 2)->GetBinContent(binx, biny);
   }
 
@@ -685,12 +794,16 @@ namespace dqm::impl {
   /// get uncertainty on content of bin (1-D) - See TH1::GetBinError for details
   double MonitorElement::getBinError(int binx) const {
     auto access = this->access();
+    if (auto compact = access.compactHistogram())
+      return compact->binError(binx);
     return accessRootObject(access, __PRETTY_FUNCTION__, 1)->GetBinError(binx);
   }
 
   /// get uncertainty on content of bin (2-D) - See TH1::GetBinError for details
   double MonitorElement::getBinError(int binx, int biny) const {
     auto access = this->access();
+    if (auto compact = access.compactHistogram(); compact and compact->dimension() == 2)
+      return compact->binError(binx, biny);
     return accessRootObject(access, __PRETTY_FUNCTION__, 2)->GetBinError(binx, biny);
   }
 
@@ -703,6 +816,8 @@ namespace dqm::impl {
   /// get # of entries
   double MonitorElement::getEntries() const {
     auto access = this->access();
+    if (auto compact = access.compactHistogram())
+      return compact->entries();
     return accessRootObject(access, __PRETTY_FUNCTION__, 1)->GetEntries();
   }
 
@@ -722,12 +837,16 @@ namespace dqm::impl {
   /// get x-, y- or z-axis title (axis=1, 2, 3 respectively)
   std::string MonitorElement::getAxisTitle(int axis /* = 1 */) const {
     auto access = this->access();
+    if (auto compact = access.compactHistogram(); compact and (axis == 1 or axis == 2))
+      return axis == 1 ? compact->xAxis().title_ : compact->yAxis().title_;
     return getAxis(access, __PRETTY_FUNCTION__, axis)->GetTitle();
   }
 
   /// get MonitorElement title
   std::string MonitorElement::getTitle() const {
     auto access = this->access();
+    if (auto compact = access.compactHistogram())
+      return compact->title();
     return accessRootObject(access, __PRETTY_FUNCTION__, 1)->GetTitle();
   }
 
@@ -812,6 +931,8 @@ namespace dqm::impl {
   /// set x-, y- or z-axis title (axis=1, 2, 3 respectively)
   void MonitorElement::setAxisTitle(const std::string &title, int axis /* = 1 */) {
     auto access = this->accessMut();
+    if (auto compact = access.compactHistogram(); compact and (axis == 1 or axis == 2))
+      return compact->setAxisTitle(axis, title);
     getAxis(access, __PRETTY_FUNCTION__, axis)->SetTitle(title.c_str());
   }
 
@@ -836,6 +957,8 @@ namespace dqm::impl {
   /// set (ie. change) histogram/profile title
   void MonitorElement::setTitle(const std::string &title) {
     auto access = this->accessMut();
+    if (auto compact = access.compactHistogram())
+      return compact->setTitle(title);
     accessRootObject(access, __PRETTY_FUNCTION__, 1)->SetTitle(title.c_str());
   }
 
@@ -884,23 +1007,29 @@ namespace dqm::impl {
   void MonitorElement::setXTitle(std::string const &title) {
     auto access = this->accessMut();
     update();
+    if (auto compact = access.compactHistogram())
+      return compact->setAxisTitle(1, title);
     access.value.object_->SetXTitle(title.c_str());
   }
   void MonitorElement::setYTitle(std::string const &title) {
     auto access = this->accessMut();
     update();
+    if (auto compact = access.compactHistogram())
+      return compact->setAxisTitle(2, title);
     access.value.object_->SetYTitle(title.c_str());
   }
 
   void MonitorElement::enableSumw2() {
     auto access = this->accessMut();
     update();
+    materialize(access.value, access.compact);
     access.value.object_->Sumw2();
   }
 
   void MonitorElement::disableAlphanumeric() {
     auto access = this->accessMut();
     update();
+    materialize(access.value, access.compact);
     access.value.object_->GetXaxis()->SetNoAlphanumeric(false);
     access.value.object_->GetYaxis()->SetNoAlphanumeric(false);
   }
@@ -908,6 +1037,7 @@ namespace dqm::impl {
   void MonitorElement::setOption(const char *option) {
     auto access = this->accessMut();
     update();
+    materialize(access.value, access.compact);
     access.value.object_->SetOption(option);
   }
   double MonitorElement::getAxisMin(int axis) const {
@@ -922,11 +1052,13 @@ namespace dqm::impl {
 
   void MonitorElement::setCanExtend(unsigned int value) {
     auto access = this->accessMut();
+    materialize(access.value, access.compact);
     access.value.object_->SetCanExtend(value);
   }
 
   void MonitorElement::setStatOverflows(unsigned int value) {
     auto access = this->accessMut();
+    materialize(access.value, access.compact);
     access.value.object_->StatOverflows(value);
   }
 
@@ -1146,6 +1278,7 @@ namespace dqm::impl {
   // TODO: all of these are UNSAFE and have to be NON-const.
   TObject const *MonitorElement::getRootObject() const {
     auto access = this->access();
+    materialize(access.value, access.compact);
     return access.value.object_.get();
   }
 
@@ -0,0 +1,89 @@
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+/*
+ * Measures the MonitorElement::Fill throughput of N threads filling the
+ * same global MEs, with and without per-thread shards and compact storage,
+ * and checks that the merged shards and the ROOT objects made from the
+ * compact storage hold all the entries.
+ *
+ * usage: DQMFillBenchmark [threads] [fills per thread] [MEs]
+ */
+using namespace dqm::dqmstoreimpl;
+
+namespace {
+  double runBenchmark(
+      bool sharded, bool compact, unsigned int nThreads, unsigned int nFills, unsigned int nMEs, bool& ok) {
+    edm::ParameterSet pset;
+    pset.addUntrackedParameter<bool>("enableMultiThread", true);
+    pset.addUntrackedParameter<bool>("enableShardedFill", sharded);
+    pset.addUntrackedParameter<bool>("enableCompactHistograms", compact);
+    DQMStore store(pset);
+
+    uint32_t const run = 1;
+    std::vector<MonitorElement*> mes;
+    store.bookConcurrentTransaction(
+        [&](DQMStore::IBooker& booker) {
+          booker.setCurrentFolder("Benchmark");
+          for (unsigned int i = 0; i < nMEs; ++i) {
+            auto name = "h" + std::to_string(i);
+            mes.push_back(booker.book1D(name, name, 100, 0., 100.));
+          }
+        },
+        run);
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < nThreads; ++t) {
+      threads.emplace_back([&, t]() {
+        for (unsigned int i = 0; i < nFills; ++i) {
+          mes[(i + t) % nMEs]->Fill(static_cast<double>((i * 7 + t) % 100));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    store.mergeShards(run);
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+
+    double entries = 0.;
+    double rootEntries = 0.;
+    for (auto me : mes) {
+      entries += me->getEntries();
+      rootEntries += me->getTH1()->GetEntries();
+    }
+    ok = (entries == static_cast<double>(nThreads) * nFills and rootEntries == entries);
+    if (not ok) {
+      std::cout << "Error: expected " << static_cast<double>(nThreads) * nFills << " entries, found " << entries
+                << " (" << rootEntries << " in the ROOT objects)" << std::endl;
+    }
+    return static_cast<double>(nThreads) * nFills / elapsed.count();
+  }
+}  // namespace
+
+int main(int argc, char** argv) {
+  unsigned int nThreads = argc > 1 ? std::atoi(argv[1]) : 4;
+  unsigned int nFills = argc > 2 ? std::atoi(argv[2]) : 1000000;
+  unsigned int nMEs = argc > 3 ? std::atoi(argv[3]) : 10;
+
+  bool ok = true;
+  for (bool compact : {false, true}) {
+    for (bool sharded : {false, true}) {
+      bool modeOk = false;
+      double rate = runBenchmark(sharded, compact, nThreads, nFills, nMEs, modeOk);
+      std::cout << (sharded ? "sharded" : "locked ") << (compact ? " compact" : " ROOT   ") << " fill: " << nThreads
+                << " threads, " << nMEs << " MEs, " << rate << " fills/s" << std::endl;
+      ok = ok and modeOk;
+    }
+  }
+
+  return ok ? 0 : 1;
+}
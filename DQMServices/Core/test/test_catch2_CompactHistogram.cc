@@ -0,0 +1,150 @@
+#include "DQMServices/Core/interface/CompactHistogram.h"
+
+#include "catch.hpp"
+
+#include "TArrayD.h"
+#include "TH1D.h"
+#include "TH1F.h"
+#include "TH1S.h"
+#include "TH2D.h"
+#include "TH2F.h"
+#include "TH2S.h"
+
+#include <memory>
+
+using dqm::impl::CompactHistogram;
+using Kind = CompactHistogram::Kind;
+
+namespace {
+  // the ROOT object made from the compact storage must be the one filled directly
+  void compare(TH1 const& expected, TH1 const& made) {
+    REQUIRE(made.GetNcells() == expected.GetNcells());
+    for (int bin = 0; bin < expected.GetNcells(); ++bin) {
+      INFO("bin " << bin);
+      REQUIRE(made.GetBinContent(bin) == expected.GetBinContent(bin));
+      REQUIRE(made.GetBinError(bin) == Approx(expected.GetBinError(bin)));
+    }
+    REQUIRE(made.GetSumw2N() == expected.GetSumw2N());
+    for (int bin = 0; bin < expected.GetSumw2N(); ++bin) {
+      INFO("bin " << bin);
+      REQUIRE(made.GetSumw2()->At(bin) == Approx(expected.GetSumw2()->At(bin)));
+    }
+    REQUIRE(made.GetEntries() == expected.GetEntries());
+    double expectedStats[TH1::kNstat] = {};
+    double madeStats[TH1::kNstat] = {};
+    expected.GetStats(expectedStats);
+    made.GetStats(madeStats);
+    for (int i = 0; i < TH1::kNstat; ++i) {
+      INFO("statistic " << i);
+      REQUIRE(madeStats[i] == Approx(expectedStats[i]));
+    }
+    REQUIRE(made.GetMean() == Approx(expected.GetMean()));
+    REQUIRE(made.GetRMS() == Approx(expected.GetRMS()));
+  }
+
+  // unit weights first, then weights which turn on the Sumw2, with under- and overflows
+  template <typename H>
+  void fill1D(H& h, CompactHistogram& compact) {
+    for (int i = 0; i < 1000; ++i) {
+      double x = -15. + 0.13 * i;
+      h.Fill(x);
+      compact.fill(x, 1.);
+    }
+    for (int i = 0; i < 1000; ++i) {
+      double x = -15. + 0.11 * i;
+      double w = 0.5 + (i % 7) * 0.25;
+      h.Fill(x, w);
+      compact.fill(x, w);
+    }
+  }
+
+  template <typename H>
+  void fill2D(H& h, CompactHistogram& compact) {
+    for (int i = 0; i < 1000; ++i) {
+      double x = -15. + 0.13 * i;
+      double y = 120. - 0.17 * i;
+      h.Fill(x, y);
+      compact.fill(x, y, 1.);
+    }
+    for (int i = 0; i < 1000; ++i) {
+      double x = -15. + 0.11 * i;
+      double y = -30. + 0.19 * i;
+      double w = 0.5 + (i % 7) * 0.25;
+      h.Fill(x, y, w);
+      compact.fill(x, y, w);
+    }
+  }
+}  // namespace
+
+TEST_CASE("CompactHistogram", "[CompactHistogram]") {
+  TH1::AddDirectory(false);
+
+  SECTION("TH1F") {
+    TH1F h("h", "h", 50, 0., 100.);
+    auto compact = CompactHistogram::fromROOT(Kind::TH1F, h);
+    REQUIRE(compact);
+    fill1D(h, *compact);
+    compare(h, *compact->toROOT());
+  }
+
+  SECTION("TH1D") {
+    TH1D h("h", "h", 50, 0., 100.);
+    auto compact = CompactHistogram::fromROOT(Kind::TH1D, h);
+    REQUIRE(compact);
+    fill1D(h, *compact);
+    compare(h, *compact->toROOT());
+  }
+
+  SECTION("TH2F") {
+    TH2F h("h", "h", 20, 0., 100., 10, 0., 100.);
+    auto compact = CompactHistogram::fromROOT(Kind::TH2F, h);
+    REQUIRE(compact);
+    fill2D(h, *compact);
+    compare(h, *compact->toROOT());
+  }
+
+  SECTION("TH2D") {
+    TH2D h("h", "h", 20, 0., 100., 10, 0., 100.);
+    auto compact = CompactHistogram::fromROOT(Kind::TH2D, h);
+    REQUIRE(compact);
+    fill2D(h, *compact);
+    compare(h, *compact->toROOT());
+  }
+
+  SECTION("TH1S saturates") {
+    TH1S h("h", "h", 10, 0., 10.);
+    auto compact = CompactHistogram::fromROOT(Kind::TH1S, h);
+    REQUIRE(compact);
+    for (int i = 0; i < 40000; ++i) {
+      h.Fill(2.5);
+      compact->fill(2.5, 1.);
+      h.Fill(7.5, -1.);
+      compact->fill(7.5, -1.);
+    }
+    REQUIRE(h.GetBinContent(3) == 32767);
+    REQUIRE(h.GetBinContent(8) == -32767);
+    compare(h, *compact->toROOT());
+  }
+
+  SECTION("TH2S saturates") {
+    TH2S h("h", "h", 10, 0., 10., 10, 0., 10.);
+    auto compact = CompactHistogram::fromROOT(Kind::TH2S, h);
+    REQUIRE(compact);
+    for (int i = 0; i < 40000; ++i) {
+      h.Fill(2.5, 3.5);
+      compact->fill(2.5, 3.5, 1.);
+    }
+    REQUIRE(h.GetBinContent(3, 4) == 32767);
+    compare(h, *compact->toROOT());
+  }
+
+  SECTION("filled before the compact storage") {
+    TH1F h("h", "h", 50, 0., 100.);
+    h.Fill(42., 2.);
+    h.Fill(142.);
+    auto compact = CompactHistogram::fromROOT(Kind::TH1F, h);
+    REQUIRE(compact);
+    fill1D(h, *compact);
+    compare(h, *compact->toROOT());
+  }
+}
@@ -0,0 +1,102 @@
+#include "DQMServices/Core/interface/DQMStore.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include "catch.hpp"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace dqm::dqmstoreimpl;
+
+namespace {
+  constexpr unsigned int kThreads = 4;
+  constexpr unsigned int kFills = 20000;
+  constexpr unsigned int kMEs = 3;
+  constexpr uint32_t kRun = 1;
+
+  std::vector<MonitorElement*> bookMEs(DQMStore& store) {
+    std::vector<MonitorElement*> mes;
+    store.bookConcurrentTransaction(
+        [&](DQMStore::IBooker& booker) {
+          booker.setCurrentFolder("Shards");
+          for (unsigned int i = 0; i < kMEs; ++i) {
+            auto name = "h" + std::to_string(i);
+            mes.push_back(booker.book1D(name, name, 100, 0., 100.));
+          }
+        },
+        kRun);
+    return mes;
+  }
+
+  // fill from kThreads threads, started one after the other so that shards
+  // are added while the other threads fill and the action runs
+  template <typename F>
+  void fillWhile(std::vector<MonitorElement*> const& mes, unsigned int nFills, F action) {
+    std::atomic<bool> done{false};
+    std::thread other([&]() {
+      while (not done.load()) {
+        action();
+      }
+    });
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&, t]() {
+        for (unsigned int i = 0; i < nFills; ++i) {
+          mes[(i + t) % kMEs]->Fill(static_cast<double>((i * 7 + t) % 100));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    done = true;
+    other.join();
+  }
+
+  double entries(std::vector<MonitorElement*> const& mes) {
+    double sum = 0.;
+    for (auto me : mes) {
+      sum += me->getEntries();
+    }
+    return sum;
+  }
+}  // namespace
+
+TEST_CASE("MonitorElement fill shards", "[MonitorElement]") {
+  auto compact = GENERATE(false, true);
+  edm::ParameterSet pset;
+  pset.addUntrackedParameter<bool>("enableMultiThread", true);
+  pset.addUntrackedParameter<bool>("enableShardedFill", true);
+  pset.addUntrackedParameter<bool>("enableCompactHistograms", compact);
+  DQMStore store(pset);
+  auto mes = bookMEs(store);
+  for (auto me : mes) {
+    REQUIRE(me->hasFillShards());
+  }
+
+  SECTION("merge while filling") {
+    fillWhile(mes, kFills, [&]() { store.mergeShards(kRun); });
+    store.mergeShards(kRun);
+    REQUIRE(entries(mes) == static_cast<double>(kThreads) * kFills);
+  }
+
+  SECTION("reset while filling") {
+    fillWhile(mes, kFills, [&]() {
+      for (auto me : mes) {
+        me->Reset();
+      }
+    });
+    for (auto me : mes) {
+      me->Reset();
+    }
+    store.mergeShards(kRun);
+    REQUIRE(entries(mes) == 0.);
+
+    // the shards made while resetting are still filled and merged
+    fillWhile(mes, kFills, []() {});
+    store.mergeShards(kRun);
+    REQUIRE(entries(mes) == static_cast<double>(kThreads) * kFills);
+  }
+}
@@ -13,6 +13,7 @@ PSet script.   See notes in EventProcessor.cpp for details about it.
 #include "FWCore/ParameterSet/interface/ProcessDesc.h"
 #include "FWCore/ParameterSet/interface/validateTopLevelParameterSets.h"
 #include "FWCore/PluginManager/interface/PluginManager.h"
+#include "FWCore/PluginManager/interface/PluginPreloader.h"
 #include "FWCore/PluginManager/interface/PresenceFactory.h"
 #include "FWCore/PluginManager/interface/standard.h"
 #include "FWCore/ParameterSetReader/interface/ParameterSetReader.h"
@@ -56,6 +57,8 @@ static char const* const kSizeOfStackForThreadOpt = "sizeOfStackForThreadsInKB";
 static char const* const kHelpOpt = "help";
 static char const* const kHelpCommandOpt = "help,h";
 static char const* const kStrictOpt = "strict";
+static char const* const kConfigCacheOpt = "configCache";
+static char const* const kPreloadPluginsOpt = "preloadPlugins";
 
 constexpr unsigned int kDefaultSizeOfStackForThreadsInKB = 10 * 1024;  //10MB
 // -----------------------------------------------
@@ -130,6 +133,7 @@ int main(int argc, char* argv[]) {
   std::shared_ptr<edm::Presence> theMessageServicePresence;
   std::unique_ptr<std::ofstream> jobReportStreamPtr;
   std::shared_ptr<edm::serviceregistry::ServiceWrapper<edm::JobReport> > jobRep;
+  std::unique_ptr<edmplugin::PluginPreloader> pluginPreloader;
   EventProcessorWithSentry proc;
 
   try {
@@ -198,7 +202,15 @@ int main(int argc, char* argv[]) {
           boost::program_options::value<unsigned int>(),
           "Size of stack in KB to use for extra threads (0 is use system default size)")(
           kMultiThreadMessageLoggerOpt, "MessageLogger handles multiple threads - default is single-thread")(
-          kStrictOpt, "strict parsing");
+          kStrictOpt, "strict parsing")(
+          kConfigCacheOpt,
+          boost::program_options::value<std::string>(),
+          "file caching the configuration: reused, without running python, while the configuration, the "
+          "arguments and the files and environment variables it reads do not change")(
+          kPreloadPluginsOpt,
+          boost::program_options::value<std::string>(),
+          "file recording the plugins the job uses: those recorded by an earlier job are loaded while the "
+          "configuration is processed");
 
       // anything at the end will be ignored, and sent to python
       boost::program_options::positional_options_description p;
@@ -265,11 +277,28 @@ int main(int argc, char* argv[]) {
       jobRep.reset(new edm::serviceregistry::ServiceWrapper<edm::JobReport>(std::move(jobRepPtr)));
       edm::ServiceToken jobReportToken = edm::ServiceRegistry::createContaining(jobRep);
 
+      if (vm.count(kPreloadPluginsOpt)) {
+        context = "Starting to preload plugins";
+        pluginPreloader =
+            std::make_unique<edmplugin::PluginPreloader>(vm[kPreloadPluginsOpt].as<std::string>());
+      }
+
       context = "Processing the python configuration file named ";
       context += fileName;
       std::shared_ptr<edm::ProcessDesc> processDesc;
       try {
-        std::unique_ptr<edm::ParameterSet> parameterSet = edm::readConfig(fileName, argc, argv);
+        std::unique_ptr<edm::ParameterSet> parameterSet;
+        if (vm.count(kConfigCacheOpt)) {
+          bool readFromCache = false;
+          parameterSet =
+              edm::readConfig(fileName, argc, argv, vm[kConfigCacheOpt].as<std::string>(), readFromCache);
+          if (readFromCache) {
+            edm::LogInfo("CommandLineProcessing")
+                << "cmsRun: Read the configuration from the cache " << vm[kConfigCacheOpt].as<std::string>();
+          }
+        } else {
+          parameterSet = edm::readConfig(fileName, argc, argv);
+        }
         processDesc.reset(new edm::ProcessDesc(std::move(parameterSet)));
       } catch (cms::Exception& iException) {
         edm::Exception e(edm::errors::ConfigFileReadError, "", iException);
@@ -339,6 +368,17 @@ int main(int argc, char* argv[]) {
         edm::MessageDrop::instance()->jobMode = jobMode;
       }
 
+      if (pluginPreloader) {
+        //services connect to the PluginManager signals while the EventProcessor is constructed
+        context = "Waiting for the plugins to be preloaded";
+        pluginPreloader->wait();
+        for (auto const& plugin : pluginPreloader->notLoaded()) {
+          edm::LogWarning("PluginPreloader") << "The plugin '" << plugin.second << "' of category '" << plugin.first
+                                             << "' listed in " << vm[kPreloadPluginsOpt].as<std::string>()
+                                             << " could not be preloaded";
+        }
+      }
+
       context = "Constructing the EventProcessor";
       EventProcessorWithSentry procTmp(
           std::make_unique<edm::EventProcessor>(processDesc, jobReportToken, edm::serviceregistry::kTokenOverrides));
@@ -360,6 +400,11 @@ int main(int argc, char* argv[]) {
 
       context = "Calling endJob";
       proc->endJob();
+
+      if (pluginPreloader) {
+        context = "Recording the plugins to preload";
+        pluginPreloader->writeRecord();
+      }
       return returnCode;
     });
   }
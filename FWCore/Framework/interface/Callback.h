@@ -11,6 +11,7 @@
 
  Usage:
     <usage>
+    The producer's method is called while holding the producer's callMutex().
 
 */
 //
@@ -19,6 +20,8 @@
 //
 
 // system include files
+#include <array>
+#include <mutex>
 #include <vector>
 #include <type_traits>
 // user include files
@@ -27,6 +30,10 @@
 #include "FWCore/Utilities/interface/ESIndices.h"
 
 namespace edm {
+  class EventSetupImpl;
+  class ServiceToken;
+  class WaitingTask;
+
   namespace eventsetup {
 
     // The default decorator that does nothing
@@ -59,6 +66,7 @@ namespace edm {
       const Callback& operator=(const Callback&) = delete;
 
       void operator()(const TRecord& iRecord) {
+        std::lock_guard<std::recursive_mutex> guard(callMutex());
         if (!wasCalledForThisRecord_) {
           producer_->updateFromMayConsumes(id_, iRecord);
           decorator_.pre(iRecord);
@@ -93,6 +101,13 @@ namespace edm {
       unsigned int transitionID() const { return id_; }
       ESProxyIndex const* getTokenIndices() const { return producer_->getTokenIndices(id_); }
 
+      ///iTask is run once the data declared as consumed by the method has been prefetched
+      void prefetchInputsAsync(WaitingTask* iTask, EventSetupImpl const* iEventSetupImpl, ServiceToken const& iToken) {
+        producer_->prefetchAsync(iTask, id_, iEventSetupImpl, iToken);
+      }
+
+      std::recursive_mutex& callMutex() { return producer_->callMutex(); }
+
     private:
       std::array<void*, produce::size<TReturn>::value> proxyData_;
       edm::propagate_const<T*> producer_;
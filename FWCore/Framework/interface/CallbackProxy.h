@@ -12,6 +12,9 @@
  Usage:
     This class is primarily used by ESProducer to allow the EventSetup system
  to call a particular method of ESProducer where data is being requested.
+ When prefetched, the data the method declared it consumes is prefetched
+ first. The method is then called while holding the mutex of the producer,
+ which is the global EventSetup mutex unless the producer allows concurrent calls.
 
 */
 //
@@ -28,6 +31,8 @@
 #include "FWCore/Framework/interface/EventSetupRecord.h"
 
 #include "FWCore/Framework/interface/produce_helpers.h"
+#include "FWCore/Concurrency/interface/WaitingTask.h"
+#include "FWCore/ServiceRegistry/interface/ServiceRegistry.h"
 #include "FWCore/Utilities/interface/propagate_const.h"
 
 // forward declarations
@@ -62,6 +67,29 @@ namespace edm::eventsetup {
       return smart_pointer_traits::getPointer(data_);
     }
 
+    void prefetchAsyncImpl(WaitingTaskHolder iWaitTask,
+                           const EventSetupRecordImpl& iRecord,
+                           const DataKey& iKey,
+                           ActivityRegistry const* iRegistry,
+                           EventSetupImpl const* iEventSetupImpl,
+                           ServiceToken const& iToken) override {
+      assert(iRecord.key() == RecordT::keyForClass());
+      auto runTask = make_waiting_task(
+          tbb::task::allocate_root(),
+          [this, holder = std::move(iWaitTask), &iRecord, &iKey, iRegistry, iEventSetupImpl, iToken](
+              std::exception_ptr const* iExcept) mutable {
+            if (iExcept) {
+              holder.doneWaiting(*iExcept);
+              return;
+            }
+            ServiceRegistry::Operate guard(iToken);
+            DataProxy::prefetchAsyncImpl(std::move(holder), iRecord, iKey, iRegistry, iEventSetupImpl, iToken);
+          });
+      callback_->prefetchInputsAsync(runTask, iEventSetupImpl, iToken);
+    }
+
+    std::recursive_mutex& prefetchMutex() override { return callback_->callMutex(); }
+
     void invalidateCache() override {
       data_ = DataT{};
       callback_->newRecordComing();
@@ -13,6 +13,11 @@
     This class defines the interface used to handle retrieving data from an
  EventSetup Record.
 
+    The data can also be prefetched asynchronously with prefetchAsync, which
+ is only used when the concurrent prefetching of the EventSetup is enabled.
+ All the tasks asking for the data before it is available wait in the same
+ WaitingTaskList. If making the data fails, the next request tries again.
+
 */
 //
 // Author:      Chris Jones
@@ -21,14 +26,20 @@
 
 // system include files
 #include <atomic>
+#include <memory>
+#include <mutex>
 
 // user include files
+#include "FWCore/Concurrency/interface/WaitingTaskList.h"
+#include "FWCore/Concurrency/interface/WaitingTaskHolder.h"
 #include "FWCore/Utilities/interface/thread_safety_macros.h"
 
 // forward declarations
 namespace edm {
   class ActivityRegistry;
   class EventSetupImpl;
+  class ServiceToken;
+  class WaitingTask;
 
   namespace eventsetup {
     struct ComponentDescription;
@@ -56,6 +67,14 @@ namespace edm {
                       ActivityRegistry const*,
                       EventSetupImpl const*) const;
 
+      ///iTask is run once the data is available, or making it failed
+      void prefetchAsync(WaitingTask* iTask,
+                         EventSetupRecordImpl const&,
+                         DataKey const&,
+                         ActivityRegistry const*,
+                         EventSetupImpl const*,
+                         ServiceToken const&) const;
+
       ///returns the description of the DataProxyProvider which owns this Proxy
       ComponentDescription const* providerDescription() const { return description_; }
 
@@ -80,6 +99,17 @@ namespace edm {
           */
       virtual void const* getImpl(EventSetupRecordImpl const&, DataKey const& iKey, EventSetupImpl const*) = 0;
 
+      /** Makes the data and passes the result to setCache before calling doneWaiting on iTask.
+          The default calls getImpl in the calling thread while holding prefetchMutex().
+          It is called again after a failure.
+          */
+      virtual void prefetchAsyncImpl(WaitingTaskHolder iTask,
+                                     EventSetupRecordImpl const&,
+                                     DataKey const& iKey,
+                                     ActivityRegistry const*,
+                                     EventSetupImpl const*,
+                                     ServiceToken const&);
+
       /** indicates that the Proxy should invalidate any cached information
           as that information has 'expired' (i.e. we have moved to a new IOV)
           */
@@ -92,13 +122,23 @@ namespace edm {
           */
       virtual void invalidateTransientCache();
 
+      /** The mutex held by the default prefetchAsyncImpl while calling getImpl. The default is
+          the global EventSetup mutex, which is also held by get.
+          */
+      virtual std::recursive_mutex& prefetchMutex();
+
       void clearCacheIsValid();
 
     private:
+      void setCache(void const* iData);
+
       // ---------- member data --------------------------------
       ComponentDescription const* description_;
-      CMS_THREAD_SAFE mutable void const* cache_;  //protected by a global mutex
+      CMS_THREAD_SAFE mutable void const* cache_;  //only set under the global mutex, before cacheIsValid_
       mutable std::atomic<bool> cacheIsValid_;
+      //the tasks waiting for a prefetch in progress, null if none is
+      mutable std::mutex prefetchTasksMutex_;
+      CMS_THREAD_GUARD(prefetchTasksMutex_) mutable std::shared_ptr<WaitingTaskList> prefetchTasks_;
 
       // While implementing the set of code changes that enabled support
       // for concurrent IOVs, I have gone to some effort to maintain
@@ -75,6 +75,9 @@ namespace edm {
     // ---------- const member functions ---------------------
     ProductResolverIndexAndSkipBit indexFrom(EDGetToken, BranchType, TypeID const&) const;
     ProductResolverIndexAndSkipBit uncheckedIndexFrom(EDGetToken) const;
+    ///\return the index of the ProductResolver that holds the data, skipping the resolvers
+    /// that only forward a lookup without process name to the one process having the product
+    ProductResolverIndexAndSkipBit directIndexFrom(EDGetToken, BranchType, TypeID const&) const;
 
     void itemsToGet(BranchType, std::vector<ProductResolverIndexAndSkipBit>&) const;
     void itemsMayGet(BranchType, std::vector<ProductResolverIndexAndSkipBit>&) const;
@@ -115,6 +118,15 @@ namespace edm {
       return &(esItemsToGetFromTransition_[static_cast<unsigned int>(iTrans)].front());
     }
 
+    std::vector<ESProxyIndex> const& esGetTokenIndicesVector(edm::Transition iTrans) const {
+      return esItemsToGetFromTransition_[static_cast<unsigned int>(iTrans)];
+    }
+
+    ///the record of each entry of esGetTokenIndicesVector
+    std::vector<ESRecordIndex> const& esGetTokenRecordIndicesVector(edm::Transition iTrans) const {
+      return esRecordsToGetFromTransition_[static_cast<unsigned int>(iTrans)];
+    }
+
   protected:
     friend class ConsumesCollector;
     template <typename T>
@@ -200,9 +212,10 @@ namespace edm {
 
     struct TokenLookupInfo {
       TokenLookupInfo(edm::TypeID const& iID, ProductResolverIndex iIndex, bool skipCurrentProcess, BranchType iBranch)
-          : m_type(iID), m_index(iIndex, skipCurrentProcess), m_branchType(iBranch) {}
+          : m_type(iID), m_index(iIndex, skipCurrentProcess), m_directIndex(iIndex), m_branchType(iBranch) {}
       edm::TypeID m_type;
       ProductResolverIndexAndSkipBit m_index;
+      ProductResolverIndex m_directIndex;
       BranchType m_branchType;
     };
 
@@ -247,6 +260,8 @@ namespace edm {
     edm::SoATuple<ESTokenLookupInfo, ESProxyIndex> m_esTokenInfo;
     std::array<std::vector<ESProxyIndex>, static_cast<unsigned int>(edm::Transition::NumberOfTransitions)>
         esItemsToGetFromTransition_;
+    std::array<std::vector<ESRecordIndex>, static_cast<unsigned int>(edm::Transition::NumberOfTransitions)>
+        esRecordsToGetFromTransition_;
     bool frozen_;
     bool containsCurrentProcessAlias_;
   };
@@ -70,6 +70,7 @@ Example: two algorithms each creating only one objects
 
 // system include files
 #include <memory>
+#include <mutex>
 #include <string>
 
 // user include files
@@ -86,6 +87,10 @@ Example: two algorithms each creating only one objects
 
 // forward declarations
 namespace edm {
+  class EventSetupImpl;
+  class ServiceToken;
+  class WaitingTask;
+
   namespace eventsetup {
 
     class ESRecordsToProxyIndices;
@@ -129,7 +134,24 @@ namespace edm {
       }
     }
 
+    ///prefetches the data declared as consumed by the iIndex'th setWhatProduced, iTask is run once all is done
+    void prefetchAsync(WaitingTask* iTask,
+                       unsigned int iIndex,
+                       EventSetupImpl const*,
+                       ServiceToken const&) const;
+
+    ///the methods of this producer are called while holding this mutex
+    std::recursive_mutex& callMutex();
+
   protected:
+    /** Lets the methods of this producer run while other ESProducers run theirs, instead of
+        holding the global EventSetup mutex. This only has an effect when the concurrent
+        prefetching of the EventSetup is enabled. The methods must get all their data through
+        the tokens declared with setConsumes and must not use resources shared with other
+        modules, such as DD. A producer using mayConsumes always holds the global mutex.
+    */
+    void allowConcurrentCalls();
+
     /** \param iThis the 'this' pointer to an inheriting class instance
         The method determines the Record argument and return value of the 'produce'
         method in order to do the registration with the EventSetup
@@ -234,9 +256,11 @@ namespace edm {
 
     std::vector<std::unique_ptr<ESConsumesInfo>> consumesInfos_;
     std::vector<std::vector<ESProxyIndex>> itemsToGetFromRecords_;
-    //need another structure to say which record to get the data from in
-    // order to make prefetching work
+    //the record to get the data from for each entry of itemsToGetFromRecords_,
+    // needed in order to make prefetching work
     std::vector<std::vector<ESRecordIndex>> recordsUsedDuringGet_;
+    //only set if the methods may run concurrently with those of other producers
+    std::unique_ptr<std::recursive_mutex> ownMutex_;
   };
 }  // namespace edm
 #endif
@@ -95,6 +95,9 @@ namespace edm {
     ///\return The id for the particular Stream processing the Event
     StreamID streamID() const { return streamID_; }
 
+    ///\return Memory of the Stream given back after the products of this Event are deleted, see EventArena
+    EventArena& arena() const;
+
     LuminosityBlock const& getLuminosityBlock() const {
       if (not luminosityBlock_) {
         fillLuminosityBlock();
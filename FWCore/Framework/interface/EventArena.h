@@ -0,0 +1,117 @@
+#ifndef FWCore_Framework_EventArena_h
+#define FWCore_Framework_EventArena_h
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     EventArena
+//
+/**\class EventArena EventArena.h "FWCore/Framework/interface/EventArena.h"
+
+ Description: Memory which lives as long as the products of one Event
+
+ Usage:
+    Each Stream has its own EventArena, obtained from edm::Event::arena().
+ Memory is taken from it by bumping a pointer, and is given back all at once
+ after the products of the Event have been deleted. Asking for memory is
+ thread safe, since modules working on the same Event can run concurrently.
+ The arena takes no memory until it is first used.
+
+    The simplest use is through EventArenaAllocator with the standard
+ containers, e.g. for data made and thrown away many times while processing
+ an Event
+ \code
+    std::vector<TrackingHit, edm::EventArenaAllocator<TrackingHit>> hits{
+        edm::EventArenaAllocator<TrackingHit>(iEvent.arena())};
+ \endcode
+ The containers still call the destructors of their elements, only the
+ memory is not given back to the system. Transient products may use the
+ arena, but nothing written to a file or kept beyond the Event may.
+
+*/
+
+// system include files
+#include <atomic>
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <vector>
+
+// user include files
+
+// forward declarations
+
+namespace edm {
+  class EventArena {
+  public:
+    EventArena();
+    ~EventArena();
+
+    EventArena(EventArena const&) = delete;             // stop default
+    EventArena& operator=(EventArena const&) = delete;  // stop default
+
+    // ---------- member functions ---------------------------
+    ///iAlignment must be a power of 2, throws std::bad_alloc on failure
+    void* allocate(std::size_t iBytes, std::size_t iAlignment = alignof(std::max_align_t));
+
+    ///the memory is only given back by reset()
+    void deallocate(void*, std::size_t) noexcept {}
+
+    /**Makes all the memory available again. Must only be called when nothing uses the memory.
+       If more than one block of memory was needed, they are replaced by one block of their
+       combined size so the next Events are served without asking the system.*/
+    void reset();
+
+    // ---------- const member functions ---------------------
+    ///the memory taken from the system, not to be called while memory is being allocated
+    std::size_t capacity() const;
+
+  private:
+    class Block;
+
+    void* allocateFromNewBlock(std::size_t iBytes, std::size_t iAlignment, Block* iFull);
+
+    // ---------- member data --------------------------------
+    std::atomic<Block*> current_;
+    //guards all below
+    std::mutex mutex_;
+    std::vector<std::unique_ptr<Block>> blocks_;
+    std::size_t nextBlockSize_;
+  };
+
+  template <typename T>
+  class EventArenaAllocator {
+  public:
+    typedef T value_type;
+
+    explicit EventArenaAllocator(EventArena& iArena) noexcept : arena_(&iArena) {}
+    template <typename U>
+    EventArenaAllocator(EventArenaAllocator<U> const& iOther) noexcept : arena_(iOther.arena()) {}
+
+    T* allocate(std::size_t iN) {
+      if (iN > std::numeric_limits<std::size_t>::max() / sizeof(T)) {
+        throw std::bad_array_new_length();
+      }
+      return static_cast<T*>(arena_->allocate(iN * sizeof(T), alignof(T)));
+    }
+    void deallocate(T* iPtr, std::size_t iN) noexcept { arena_->deallocate(iPtr, iN * sizeof(T)); }
+
+    EventArena* arena() const noexcept { return arena_; }
+
+  private:
+    EventArena* arena_;
+  };
+
+  template <typename T, typename U>
+  bool operator==(EventArenaAllocator<T> const& iLHS, EventArenaAllocator<U> const& iRHS) noexcept {
+    return iLHS.arena() == iRHS.arena();
+  }
+
+  template <typename T, typename U>
+  bool operator!=(EventArenaAllocator<T> const& iLHS, EventArenaAllocator<U> const& iRHS) noexcept {
+    return not(iLHS == iRHS);
+  }
+}  // namespace edm
+
+#endif
@@ -20,6 +20,8 @@ is the DataBlock.
 #include "FWCore/Utilities/interface/StreamID.h"
 #include "FWCore/Utilities/interface/Signal.h"
 #include "FWCore/Utilities/interface/get_underlying_safe.h"
+#include "FWCore/Utilities/interface/thread_safety_macros.h"
+#include "FWCore/Framework/interface/EventArena.h"
 #include "FWCore/Framework/interface/Principal.h"
 
 #include <map>
@@ -105,6 +107,9 @@ namespace edm {
 
     StreamID streamID() const { return streamID_; }
 
+    ///reset when the Event is cleared, after its products are deleted
+    EventArena& arena() const { return arena_; }
+
     LuminosityBlockNumber_t luminosityBlock() const { return id().luminosityBlock(); }
 
     RunNumber_t run() const { return id().run(); }
@@ -175,6 +180,9 @@ namespace edm {
     std::map<BranchListIndex, ProcessIndex> branchListIndexToProcessIndex_;
 
     StreamID streamID_;
+
+    //the arena is thread safe
+    CMS_THREAD_SAFE mutable EventArena arena_;
   };
 
   inline bool isSameEvent(EventPrincipal const& a, EventPrincipal const& b) { return isSameEvent(a.aux(), b.aux()); }
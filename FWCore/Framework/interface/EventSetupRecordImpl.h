@@ -65,6 +65,8 @@ namespace edm {
   class ESHandleExceptionFactory;
   class ESInputTag;
   class EventSetupImpl;
+  class ServiceToken;
+  class WaitingTask;
 
   namespace eventsetup {
     struct ComponentDescription;
@@ -90,6 +92,9 @@ namespace edm {
           */
       bool wasGotten(DataKey const& aKey) const;
 
+      ///iTask is run once the data of the proxy is available, or making it failed
+      void prefetchAsync(WaitingTask* iTask, ESProxyIndex, EventSetupImpl const*, ServiceToken const&) const;
+
       /**returns the ComponentDescription for the module which creates the data or 0
           if no module has been registered for the data. This does not cause the data to
           actually be constructed.
@@ -18,6 +18,7 @@ namespace edm {
   class EDLooper;
   class EDProducer;
   class Event;
+  class EventArena;
   class EventForOutput;
   class EventPrincipal;
   class EventSetup;
@@ -21,10 +21,16 @@
   If the high-level pset contains an "options" pset, then the
   following optional parameter can be present:
   bool wantSummary = true/false   # default false
+  bool prioritizeCriticalPath = true/false   # default false
 
   wantSummary indicates whether or not the pass/fail/error stats
   for modules and paths should be printed at the end-of-job.
 
+  prioritizeCriticalPath makes the modules prefetch first the products
+  at the end of the longest running chains of dependencies, as measured
+  while processing, and prints at the end-of-job how the critical path
+  of each event compares with the time the event took.
+
   A TriggerResults object will always be inserted into the event
   for any schedule.  The producer of the TriggerResults EDProduct
   is always the first module in the endpath.  The TriggerResultInserter
@@ -69,6 +75,7 @@
 #include "FWCore/Framework/src/GlobalSchedule.h"
 #include "FWCore/Framework/src/StreamSchedule.h"
 #include "FWCore/Framework/src/SystemTimeKeeper.h"
+#include "FWCore/Framework/src/CriticalPathKeeper.h"
 #include "FWCore/Framework/src/PreallocationConfiguration.h"
 #include "FWCore/MessageLogger/interface/ExceptionMessages.h"
 #include "FWCore/MessageLogger/interface/JobReport.h"
@@ -306,6 +313,7 @@ namespace edm {
     PreallocationConfiguration preallocConfig_;
 
     edm::propagate_const<std::unique_ptr<SystemTimeKeeper>> summaryTimeKeeper_;
+    edm::propagate_const<std::unique_ptr<CriticalPathKeeper>> criticalPathKeeper_;
 
     std::vector<std::string> const* pathNames_;
     std::vector<std::string> const* endPathNames_;
@@ -0,0 +1,352 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     CriticalPathKeeper
+//
+// Implementation:
+//     The module run times of an Event are only touched by the stream
+//     processing the Event. The accumulated run times are also read by the
+//     other streams when they update their priorities, so they are atomics
+//     with a single writer.
+//
+
+// system include files
+#include <algorithm>
+#include <iomanip>
+#include <map>
+
+// user include files
+#include "DataFormats/Provenance/interface/BranchDescription.h"
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "DataFormats/Provenance/interface/ProductRegistry.h"
+#include "DataFormats/Provenance/interface/ProductResolverIndexHelper.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/PathsAndConsumesOfModulesBase.h"
+#include "FWCore/ServiceRegistry/interface/StreamContext.h"
+#include "FWCore/Utilities/interface/ProductKindOfType.h"
+#include "FWCore/Utilities/interface/StreamID.h"
+#include "FWCore/Framework/src/Worker.h"
+#include "CriticalPathKeeper.h"
+
+using namespace edm;
+
+namespace {
+  double seconds(std::chrono::steady_clock::duration iDuration) {
+    return std::chrono::duration<double>(iDuration).count();
+  }
+
+  enum class Mark { kNone, kVisiting, kDone };
+
+  //depth first, so that a module comes after all its dependencies; a cycle is broken where it is found
+  void sortTopologically(unsigned int iSlot,
+                         std::vector<std::vector<unsigned int>>& ioDependencies,
+                         std::vector<Mark>& ioMarks,
+                         std::vector<unsigned int>& oOrder) {
+    if (ioMarks[iSlot] != Mark::kNone) {
+      return;
+    }
+    ioMarks[iSlot] = Mark::kVisiting;
+    auto& dependencies = ioDependencies[iSlot];
+    for (auto dependency : dependencies) {
+      sortTopologically(dependency, ioDependencies, ioMarks, oOrder);
+    }
+    dependencies.erase(
+        std::remove_if(dependencies.begin(),
+                       dependencies.end(),
+                       [&ioMarks](unsigned int iDependency) { return ioMarks[iDependency] == Mark::kVisiting; }),
+        dependencies.end());
+    ioMarks[iSlot] = Mark::kDone;
+    oOrder.push_back(iSlot);
+  }
+}  // namespace
+
+//
+// constructors and destructor
+//
+CriticalPathKeeper::CriticalPathKeeper(std::vector<std::vector<Worker*>> iStreamWorkers,
+                                       ProductRegistry const& iRegistry,
+                                       ProcessContext const* iProcessContext)
+    : m_streamWorkers(std::move(iStreamWorkers)),
+      m_streams(m_streamWorkers.size()),
+      m_registry(&iRegistry),
+      m_processContext(iProcessContext),
+      m_minModuleID(0),
+      m_numberOfModuleSlots(0) {
+  if (m_streamWorkers.empty() or m_streamWorkers.front().empty()) {
+    return;
+  }
+  auto const& workers = m_streamWorkers.front();
+  auto minMax = std::minmax_element(workers.begin(), workers.end(), [](Worker const* iLHS, Worker const* iRHS) {
+    return iLHS->description().id() < iRHS->description().id();
+  });
+  m_minModuleID = (*minMax.first)->description().id();
+  m_numberOfModuleSlots = (*minMax.second)->description().id() - m_minModuleID + 1;
+  for (auto& stream : m_streams) {
+    stream.m_modules = std::vector<ModuleTiming>(m_numberOfModuleSlots);
+    stream.m_lengths.resize(m_numberOfModuleSlots);
+  }
+}
+
+//
+// member functions
+//
+//NOTE: as in SystemTimeKeeper, check the bounds because a module of this
+// process can be run on behalf of a SubProcess
+inline bool CriticalPathKeeper::checkBounds(unsigned int id) const {
+  return id >= m_minModuleID and id < m_minModuleID + m_numberOfModuleSlots;
+}
+
+CriticalPathKeeper::ModuleTiming* CriticalPathKeeper::moduleTiming(StreamContext const& iStream,
+                                                                    ModuleCallingContext const& iModule) {
+  auto id = iModule.moduleDescription()->id();
+  if (not checkBounds(id)) {
+    return nullptr;
+  }
+  return &m_streams[iStream.streamID().value()].m_modules[id - m_minModuleID];
+}
+
+void CriticalPathKeeper::beginJob(PathsAndConsumesOfModulesBase const& iPnC, ProcessContext const& iContext) {
+  if (&iContext != m_processContext) {
+    return;
+  }
+  m_dependencies.assign(m_numberOfModuleSlots, std::vector<unsigned int>());
+  m_labels.assign(m_numberOfModuleSlots, nullptr);
+
+  std::map<std::string, unsigned int> labelToSlot;
+  for (auto const* description : iPnC.allModules()) {
+    if (not checkBounds(description->id())) {
+      continue;
+    }
+    unsigned int slot = description->id() - m_minModuleID;
+    m_labels[slot] = &description->moduleLabel();
+    labelToSlot[description->moduleLabel()] = slot;
+    for (auto const* producer : iPnC.modulesWhoseProductsAreConsumedBy(description->id())) {
+      if (checkBounds(producer->id())) {
+        m_dependencies[slot].push_back(producer->id() - m_minModuleID);
+      }
+    }
+  }
+
+  //the modules on a Path run one after the other
+  auto addPath = [this](std::vector<ModuleDescription const*> const& iModules) {
+    for (unsigned int i = 1; i < iModules.size(); ++i) {
+      if (checkBounds(iModules[i]->id()) and checkBounds(iModules[i - 1]->id())) {
+        m_dependencies[iModules[i]->id() - m_minModuleID].push_back(iModules[i - 1]->id() - m_minModuleID);
+      }
+    }
+  };
+  for (unsigned int i = 0; i < iPnC.paths().size(); ++i) {
+    addPath(iPnC.modulesOnPath(i));
+  }
+  for (unsigned int i = 0; i < iPnC.endPaths().size(); ++i) {
+    addPath(iPnC.modulesOnEndPath(i));
+  }
+  for (auto& dependencies : m_dependencies) {
+    std::sort(dependencies.begin(), dependencies.end());
+    dependencies.erase(std::unique(dependencies.begin(), dependencies.end()), dependencies.end());
+  }
+
+  m_topologicalOrder.clear();
+  m_topologicalOrder.reserve(m_numberOfModuleSlots);
+  std::vector<Mark> marks(m_numberOfModuleSlots, Mark::kNone);
+  for (unsigned int slot = 0; slot < m_numberOfModuleSlots; ++slot) {
+    sortTopologically(slot, m_dependencies, marks, m_topologicalOrder);
+  }
+
+  //Both the lookup with and without the process name lead to the producer in this process
+  auto lookup = m_registry->productLookup(InEvent);
+  m_producerOfIndex.assign(lookup->nextIndexValue(), -1);
+  for (auto const& product : m_registry->productList()) {
+    BranchDescription const& description = product.second;
+    if (description.branchType() != InEvent or not description.produced()) {
+      continue;
+    }
+    auto itFound = labelToSlot.find(description.moduleLabel());
+    if (itFound == labelToSlot.end()) {
+      continue;
+    }
+    for (char const* process : {description.processName().c_str(), static_cast<char const*>(nullptr)}) {
+      ProductResolverIndex index = lookup->index(PRODUCT_TYPE,
+                                                 description.unwrappedTypeID(),
+                                                 description.moduleLabel().c_str(),
+                                                 description.productInstanceName().c_str(),
+                                                 process);
+      if (index < m_producerOfIndex.size()) {
+        m_producerOfIndex[index] = itFound->second;
+      }
+    }
+  }
+}
+
+void CriticalPathKeeper::longestChains(std::vector<double> const& iTimes, std::vector<double>& oLengths) const {
+  for (auto slot : m_topologicalOrder) {
+    double longest = 0.;
+    for (auto dependency : m_dependencies[slot]) {
+      longest = std::max(longest, oLengths[dependency]);
+    }
+    oLengths[slot] = longest + iTimes[slot];
+  }
+}
+
+std::vector<double> CriticalPathKeeper::averageTimes() const {
+  std::vector<double> averages(m_numberOfModuleSlots, 0.);
+  for (unsigned int slot = 0; slot < m_numberOfModuleSlots; ++slot) {
+    double total = 0.;
+    unsigned int timesRun = 0;
+    for (auto const& stream : m_streams) {
+      total += stream.m_modules[slot].m_totalTime.load(std::memory_order_relaxed);
+      timesRun += stream.m_modules[slot].m_timesRun.load(std::memory_order_relaxed);
+    }
+    if (timesRun != 0) {
+      averages[slot] = total / timesRun;
+    }
+  }
+  return averages;
+}
+
+void CriticalPathKeeper::updatePriorities(unsigned int iStream) {
+  auto& stream = m_streams[iStream];
+  longestChains(averageTimes(), stream.m_lengths);
+
+  stream.m_priorities.assign(m_producerOfIndex.size(), 0.);
+  for (unsigned int index = 0; index < m_producerOfIndex.size(); ++index) {
+    if (m_producerOfIndex[index] >= 0) {
+      stream.m_priorities[index] = stream.m_lengths[m_producerOfIndex[index]];
+    }
+  }
+  //The Event is done, so none of the Workers of the stream is prefetching
+  for (auto* worker : m_streamWorkers[iStream]) {
+    worker->setEventPrefetchPriorities(stream.m_priorities);
+  }
+}
+
+void CriticalPathKeeper::startEvent(StreamContext const& iStream) {
+  if (iStream.processContext() != m_processContext) {
+    return;
+  }
+  auto& stream = m_streams[iStream.streamID().value()];
+  for (auto& module : stream.m_modules) {
+    module.m_eventTime = 0.;
+  }
+  stream.m_eventStart = Clock::now();
+}
+
+void CriticalPathKeeper::stopEvent(StreamContext const& iStream) {
+  if (iStream.processContext() != m_processContext) {
+    return;
+  }
+  auto& stream = m_streams[iStream.streamID().value()];
+  double latency = seconds(Clock::now() - stream.m_eventStart);
+
+  stream.m_times.clear();
+  for (auto const& module : stream.m_modules) {
+    stream.m_times.push_back(module.m_eventTime);
+  }
+  longestChains(stream.m_times, stream.m_lengths);
+  double criticalPath = 0.;
+  for (auto length : stream.m_lengths) {
+    criticalPath = std::max(criticalPath, length);
+  }
+
+  ++stream.m_events;
+  stream.m_sumCriticalPath += criticalPath;
+  stream.m_sumLatency += latency;
+  stream.m_maxCriticalPath = std::max(stream.m_maxCriticalPath, criticalPath);
+  stream.m_maxLatency = std::max(stream.m_maxLatency, latency);
+
+  if (++stream.m_eventsSinceUpdate >= kEventsBetweenUpdates) {
+    stream.m_eventsSinceUpdate = 0;
+    updatePriorities(iStream.streamID().value());
+  }
+}
+
+void CriticalPathKeeper::startModuleEvent(StreamContext const& iStream, ModuleCallingContext const& iModule) {
+  if (auto* module = moduleTiming(iStream, iModule)) {
+    module->m_start = Clock::now();
+  }
+}
+
+void CriticalPathKeeper::stopModuleEvent(StreamContext const& iStream, ModuleCallingContext const& iModule) {
+  if (auto* module = moduleTiming(iStream, iModule)) {
+    pauseModuleEvent(iStream, iModule);
+    module->m_timesRun.store(module->m_timesRun.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+  }
+}
+
+void CriticalPathKeeper::pauseModuleEvent(StreamContext const& iStream, ModuleCallingContext const& iModule) {
+  if (auto* module = moduleTiming(iStream, iModule)) {
+    double time = seconds(Clock::now() - module->m_start);
+    module->m_eventTime += time;
+    module->m_totalTime.store(module->m_totalTime.load(std::memory_order_relaxed) + time, std::memory_order_relaxed);
+  }
+}
+
+void CriticalPathKeeper::restartModuleEvent(StreamContext const& iStream, ModuleCallingContext const& iModule) {
+  startModuleEvent(iStream, iModule);
+}
+
+//
+// const member functions
+//
+void CriticalPathKeeper::printReport() const {
+  unsigned int events = 0;
+  double sumCriticalPath = 0.;
+  double sumLatency = 0.;
+  double maxCriticalPath = 0.;
+  double maxLatency = 0.;
+  for (auto const& stream : m_streams) {
+    events += stream.m_events;
+    sumCriticalPath += stream.m_sumCriticalPath;
+    sumLatency += stream.m_sumLatency;
+    maxCriticalPath = std::max(maxCriticalPath, stream.m_maxCriticalPath);
+    maxLatency = std::max(maxLatency, stream.m_maxLatency);
+  }
+  if (events == 0) {
+    return;
+  }
+
+  LogVerbatim("FwkSummary") << "";
+  LogVerbatim("FwkSummary") << "CriticalPath ---------- Event  Summary ------------";
+  LogVerbatim("FwkSummary") << "CriticalPath Events total = " << events;
+  LogVerbatim("FwkSummary") << "CriticalPath " << std::right << std::setw(10) << "" << std::setw(15) << "critical path"
+                            << std::setw(15) << "latency" << std::setw(10) << "ratio";
+  LogVerbatim("FwkSummary") << "CriticalPath " << std::right << std::setw(10) << "average" << std::setprecision(6)
+                            << std::fixed << std::setw(15) << sumCriticalPath / events << std::setw(15)
+                            << sumLatency / events << std::setprecision(2) << std::setw(10)
+                            << (sumCriticalPath > 0. ? sumLatency / sumCriticalPath : 0.);
+  LogVerbatim("FwkSummary") << "CriticalPath " << std::right << std::setw(10) << "maximum" << std::setprecision(6)
+                            << std::fixed << std::setw(15) << maxCriticalPath << std::setw(15) << maxLatency;
+
+  //walk back from the end of the longest chain of the average run times
+  auto averages = averageTimes();
+  std::vector<double> lengths(m_numberOfModuleSlots, 0.);
+  longestChains(averages, lengths);
+  std::vector<unsigned int> chain;
+  if (not lengths.empty()) {
+    unsigned int slot = std::max_element(lengths.begin(), lengths.end()) - lengths.begin();
+    while (lengths[slot] > 0.) {
+      chain.push_back(slot);
+      auto const& dependencies = m_dependencies[slot];
+      auto itLongest = std::max_element(
+          dependencies.begin(), dependencies.end(), [&lengths](unsigned int iLHS, unsigned int iRHS) {
+            return lengths[iLHS] < lengths[iRHS];
+          });
+      if (itLongest == dependencies.end()) {
+        break;
+      }
+      slot = *itLongest;
+    }
+  }
+
+  LogVerbatim("FwkSummary") << "";
+  LogVerbatim("FwkSummary") << "CriticalPath ---------- Modules on the critical path of the average times ------------";
+  LogVerbatim("FwkSummary") << "CriticalPath " << std::right << std::setw(15) << "per module run" << std::setw(15)
+                            << "chain" << std::setw(4) << ""
+                            << "Name";
+  for (auto it = chain.rbegin(), itEnd = chain.rend(); it != itEnd; ++it) {
+    LogVerbatim("FwkSummary") << "CriticalPath " << std::setprecision(6) << std::fixed << std::right << std::setw(15)
+                              << averages[*it] << std::setw(15) << lengths[*it] << std::setw(4) << ""
+                              << (m_labels.empty() or m_labels[*it] == nullptr ? std::string("?") : *m_labels[*it]);
+  }
+}
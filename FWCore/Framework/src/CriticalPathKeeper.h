@@ -0,0 +1,123 @@
+#ifndef FWCore_Framework_CriticalPathKeeper_h
+#define FWCore_Framework_CriticalPathKeeper_h
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     CriticalPathKeeper
+//
+/**\class CriticalPathKeeper CriticalPathKeeper.h "CriticalPathKeeper.h"
+
+ Description: Prefetches the products of the longest running dependency chains first
+
+ Usage:
+    Enabled by options.prioritizeCriticalPath. The run time of each module
+ is measured for every Event. The dependencies between the modules are the
+ data dependencies and the order of the modules on the Paths, as given by
+ PathsAndConsumesOfModules. Every few Events each stream computes, from the
+ average run times, the length of the longest dependency chain ending with
+ each module and gives each Worker of the stream the length of the chain of
+ the producer of each product it consumes, so that the Worker prefetches the
+ products on the longest chains first.
+
+    For every Event the length of the critical path, i.e. the longest chain
+ using the run times of that Event, is compared with the time the Event
+ actually took. The summary is printed at the end of the job.
+
+*/
+//
+
+// system include files
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+// user include files
+
+// forward declarations
+
+namespace edm {
+  class ModuleCallingContext;
+  class PathsAndConsumesOfModulesBase;
+  class ProcessContext;
+  class ProductRegistry;
+  class StreamContext;
+  class Worker;
+
+  class CriticalPathKeeper {
+  public:
+    ///The Events between two updates of the prefetching priorities of a stream
+    static constexpr unsigned int kEventsBetweenUpdates = 100;
+
+    CriticalPathKeeper(std::vector<std::vector<Worker*>> iStreamWorkers,
+                       ProductRegistry const& iRegistry,
+                       ProcessContext const* iProcessContext);
+
+    CriticalPathKeeper(const CriticalPathKeeper&) = delete;                   // stop default
+    const CriticalPathKeeper& operator=(const CriticalPathKeeper&) = delete;  // stop default
+
+    // ---------- const member functions ---------------------
+    void printReport() const;
+
+    // ---------- member functions ---------------------------
+    void beginJob(PathsAndConsumesOfModulesBase const&, ProcessContext const&);
+
+    void startEvent(StreamContext const&);
+    void stopEvent(StreamContext const&);
+
+    void startModuleEvent(StreamContext const&, ModuleCallingContext const&);
+    void stopModuleEvent(StreamContext const&, ModuleCallingContext const&);
+    void pauseModuleEvent(StreamContext const&, ModuleCallingContext const&);
+    void restartModuleEvent(StreamContext const&, ModuleCallingContext const&);
+
+  private:
+    using Clock = std::chrono::steady_clock;
+
+    struct ModuleTiming {
+      Clock::time_point m_start;
+      double m_eventTime = 0.;
+      //only written by the stream, read by the other streams for the priorities
+      std::atomic<double> m_totalTime{0.};
+      std::atomic<unsigned int> m_timesRun{0};
+    };
+
+    struct StreamTiming {
+      std::vector<ModuleTiming> m_modules;
+      Clock::time_point m_eventStart;
+      std::vector<double> m_times;
+      std::vector<double> m_lengths;
+      std::vector<double> m_priorities;
+      unsigned int m_eventsSinceUpdate = 0;
+      unsigned int m_events = 0;
+      double m_sumCriticalPath = 0.;
+      double m_sumLatency = 0.;
+      double m_maxCriticalPath = 0.;
+      double m_maxLatency = 0.;
+    };
+
+    bool checkBounds(unsigned int id) const;
+    ModuleTiming* moduleTiming(StreamContext const&, ModuleCallingContext const&);
+    void longestChains(std::vector<double> const& iTimes, std::vector<double>& oLengths) const;
+    std::vector<double> averageTimes() const;
+    void updatePriorities(unsigned int iStream);
+
+    // ---------- member data --------------------------------
+    std::vector<std::vector<Worker*>> m_streamWorkers;
+    std::vector<StreamTiming> m_streams;
+    ProductRegistry const* m_registry;
+    ProcessContext const* m_processContext;
+
+    unsigned int m_minModuleID;
+    unsigned int m_numberOfModuleSlots;
+
+    //indexed by module slot, i.e. the module ID minus m_minModuleID
+    std::vector<std::vector<unsigned int>> m_dependencies;
+    std::vector<unsigned int> m_topologicalOrder;
+    std::vector<std::string const*> m_labels;
+
+    //module slot of the producer of the Event product with a given ProductResolverIndex, or -1
+    std::vector<int> m_producerOfIndex;
+  };
+}  // namespace edm
+
+#endif
@@ -19,6 +19,7 @@
 #include "FWCore/Framework/interface/MakeDataException.h"
 #include "FWCore/Framework/interface/EventSetupRecord.h"
 #include "FWCore/Framework/src/ESGlobalMutex.h"
+#include "FWCore/Concurrency/interface/WaitingTask.h"
 #include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
 
 namespace edm {
@@ -41,8 +42,22 @@ namespace edm {
       cacheIsValid_.store(false, std::memory_order_release);
       nonTransientAccessRequested_.store(false, std::memory_order_release);
       cache_ = nullptr;
+      //only called between IOVs, when no task can be waiting for the data
+      std::lock_guard<std::mutex> guard(prefetchTasksMutex_);
+      prefetchTasks_.reset();
     }
 
+    void DataProxy::setCache(void const* iData) {
+      //get may be making the same data while holding the global mutex
+      std::lock_guard<std::recursive_mutex> guard(esGlobalMutex());
+      if (!cacheIsValid()) {
+        cache_ = iData;
+        cacheIsValid_.store(true, std::memory_order_release);
+      }
+    }
+
+    std::recursive_mutex& DataProxy::prefetchMutex() { return esGlobalMutex(); }
+
     void DataProxy::resetIfTransient() {
       if (!nonTransientAccessRequested_.load(std::memory_order_acquire)) {
         clearCacheIsValid();
@@ -90,6 +105,71 @@ namespace edm {
       };
     }  // namespace
 
+    void DataProxy::prefetchAsync(WaitingTask* iTask,
+                                  EventSetupRecordImpl const& iRecord,
+                                  DataKey const& iKey,
+                                  ActivityRegistry const* activityRegistry,
+                                  EventSetupImpl const* iEventSetupImpl,
+                                  ServiceToken const& iToken) const {
+      if (cacheIsValid()) {
+        return;
+      }
+      std::shared_ptr<WaitingTaskList> tasks;
+      bool doPrefetch = false;
+      {
+        std::lock_guard<std::mutex> guard(prefetchTasksMutex_);
+        if (!prefetchTasks_) {
+          prefetchTasks_ = std::make_shared<WaitingTaskList>();
+          doPrefetch = true;
+        }
+        tasks = prefetchTasks_;
+      }
+      tasks->add(iTask);
+      if (doPrefetch) {
+        auto doneTask =
+            make_waiting_task(tbb::task::allocate_root(), [this, tasks](std::exception_ptr const* iExcept) {
+              if (iExcept) {
+                //a failure is not kept, the next request tries again
+                std::lock_guard<std::mutex> guard(prefetchTasksMutex_);
+                if (prefetchTasks_ == tasks) {
+                  prefetchTasks_.reset();
+                }
+              }
+              tasks->doneWaiting(iExcept ? *iExcept : std::exception_ptr{});
+            });
+        const_cast<DataProxy*>(this)->prefetchAsyncImpl(
+            WaitingTaskHolder(doneTask), iRecord, iKey, activityRegistry, iEventSetupImpl, iToken);
+      }
+    }
+
+    void DataProxy::prefetchAsyncImpl(WaitingTaskHolder iTask,
+                                      EventSetupRecordImpl const& iRecord,
+                                      DataKey const& iKey,
+                                      ActivityRegistry const* activityRegistry,
+                                      EventSetupImpl const* iEventSetupImpl,
+                                      ServiceToken const&) {
+      std::exception_ptr exceptPtr;
+      try {
+        void const* data = nullptr;
+        bool made = false;
+        {
+          ESSignalSentry signalSentry(iRecord, iKey, providerDescription(), activityRegistry);
+          std::lock_guard<std::recursive_mutex> guard(prefetchMutex());
+          signalSentry.sendPostLockSignal();
+          if (!cacheIsValid()) {
+            data = getImpl(iRecord, iKey, iEventSetupImpl);
+            made = true;
+          }
+        }
+        if (made) {
+          setCache(data);
+        }
+      } catch (...) {
+        exceptPtr = std::current_exception();
+      }
+      iTask.doneWaiting(exceptPtr);
+    }
+
     const void* DataProxy::get(const EventSetupRecordImpl& iRecord,
                                const DataKey& iKey,
                                bool iTransiently,
@@ -133,6 +133,37 @@ unsigned int EDConsumerBase::recordConsumes(BranchType iBranch,
   return index;
 }
 
+namespace {
+  // A lookup without a process name matching the product of only one process
+  // is served by a SingleChoiceNoProcessProductResolver (see the Principal
+  // constructor), which forwards every call to the resolver of that product.
+  // Returns the index of that resolver, so that gets can go to it directly.
+  ProductResolverIndex directIndex(ProductResolverIndexHelper const& iHelper,
+                                   KindOfType iKind,
+                                   TypeID const& iType,
+                                   char const* iModuleLabel,
+                                   char const* iInstance,
+                                   char const* iProcess,
+                                   ProductResolverIndex iIndex) {
+    if (*iProcess != '\0' or iIndex == ProductResolverIndexInvalid or iIndex == ProductResolverIndexAmbiguous) {
+      return iIndex;
+    }
+    auto matches = iHelper.relatedIndexes(iKind, iType, iModuleLabel, iInstance);
+    unsigned int numberOfProcesses = 0;
+    ProductResolverIndex lastMatchIndex = ProductResolverIndexInvalid;
+    for (unsigned int i = 0; i != matches.numberOfMatches(); ++i) {
+      if (matches.isFullyResolved(i)) {
+        ++numberOfProcesses;
+        lastMatchIndex = matches.index(i);
+      }
+    }
+    if (numberOfProcesses == 1 and lastMatchIndex != ProductResolverIndexAmbiguous) {
+      return lastMatchIndex;
+    }
+    return iIndex;
+  }
+}  // namespace
+
 void EDConsumerBase::updateLookup(BranchType iBranchType,
                                   ProductResolverIndexHelper const& iHelper,
                                   bool iPrefetchMayGet) {
@@ -152,6 +183,13 @@ void EDConsumerBase::updateLookup(BranchType iBranchType,
                                                                        moduleLabel + itLabels->m_deltaToProductInstance,
                                                                        moduleLabel + itLabels->m_deltaToProcessName),
                                                          itInfo->m_index.skipCurrentProcess());
+        itInfo->m_directIndex = directIndex(iHelper,
+                                            *itKind,
+                                            itInfo->m_type,
+                                            moduleLabel,
+                                            moduleLabel + itLabels->m_deltaToProductInstance,
+                                            moduleLabel + itLabels->m_deltaToProcessName,
+                                            itInfo->m_index.productResolverIndex());
       }
     }
   }
@@ -212,10 +250,12 @@ void EDConsumerBase::updateLookup(eventsetup::ESRecordsToProxyIndices const& iPI
     m_esTokenInfo.get<kESProxyIndex>(index) = indexInRecord;
 
     int negIndex = -1 * (index + 1);
-    for (auto& items : esItemsToGetFromTransition_) {
-      for (auto& itemIndex : items) {
-        if (itemIndex.value() == negIndex) {
-          itemIndex = indexInRecord;
+    for (unsigned int iTrans = 0; iTrans < esItemsToGetFromTransition_.size(); ++iTrans) {
+      auto& items = esItemsToGetFromTransition_[iTrans];
+      for (unsigned int i = 0; i < items.size(); ++i) {
+        if (items[i].value() == negIndex) {
+          items[i] = indexInRecord;
+          esRecordsToGetFromTransition_[iTrans][i] = iPI.recordIndexFor(it->m_record);
           negIndex = 1;
           break;
         }
@@ -251,6 +291,8 @@ ESTokenIndex EDConsumerBase::recordESConsumes(Transition iTrans,
       ESProxyIndex{-1});
   auto indexForToken = esItemsToGetFromTransition_[static_cast<unsigned int>(iTrans)].size();
   esItemsToGetFromTransition_[static_cast<unsigned int>(iTrans)].push_back(ESProxyIndex{-1 * (index + 1)});
+  esRecordsToGetFromTransition_[static_cast<unsigned int>(iTrans)].push_back(
+      eventsetup::ESRecordsToProxyIndices::missingRecordIndex());
   return ESTokenIndex{static_cast<ESTokenIndex::Value_t>(indexForToken)};
 }
 
@@ -276,6 +318,25 @@ ProductResolverIndexAndSkipBit EDConsumerBase::indexFrom(EDGetToken iToken,
   return ProductResolverIndexAndSkipBit(edm::ProductResolverIndexInvalid, false);
 }
 
+ProductResolverIndexAndSkipBit EDConsumerBase::directIndexFrom(EDGetToken iToken,
+                                                               BranchType iBranch,
+                                                               TypeID const& iType) const {
+  if (UNLIKELY(iToken.index() >= m_tokenInfo.size())) {
+    throwBadToken(iType, iToken);
+  }
+  const auto& info = m_tokenInfo.get<kLookupInfo>(iToken.index());
+  if (LIKELY(iBranch == info.m_branchType)) {
+    if (LIKELY(iType == info.m_type)) {
+      return ProductResolverIndexAndSkipBit(info.m_directIndex, info.m_index.skipCurrentProcess());
+    } else {
+      throwTypeMismatch(iType, iToken);
+    }
+  } else {
+    throwBranchMismatch(iBranch, iToken);
+  }
+  return ProductResolverIndexAndSkipBit(edm::ProductResolverIndexInvalid, false);
+}
+
 ProductResolverIndexAndSkipBit EDConsumerBase::uncheckedIndexFrom(EDGetToken iToken) const {
   return m_tokenInfo.get<kLookupInfo>(iToken.index()).m_index;
 }
@@ -10,8 +10,13 @@ Description: This should only be used by the parts of the Framework
 supporting the EventSetup system.  It is used in the functions:
 
     edm::eventsetup::DataProxy::get
+    edm::eventsetup::DataProxy::prefetchAsyncImpl
+    edm::ESProducer::callMutex
     edm::EventSetupRecordIntervalFinder::findIntervalFor
 
+When the EventSetup is prefetched concurrently, the ESProducers
+which call allowConcurrentCalls hold their own mutex instead.
+
 This protects activity that can't be safely run concurrently.
 For example, database transactions in CondDBESSource (aka
 PoolDBESSource).
@@ -15,6 +15,10 @@
 // user include files
 #include "FWCore/Framework/interface/ESProducer.h"
 #include "FWCore/Framework/interface/ESRecordsToProxyIndices.h"
+#include "FWCore/Framework/interface/EventSetupImpl.h"
+#include "FWCore/Framework/interface/EventSetupRecordImpl.h"
+#include "FWCore/Concurrency/interface/WaitingTask.h"
+#include "FWCore/Framework/src/ESGlobalMutex.h"
 
 //
 // constants, enums and typedefs
@@ -51,6 +55,10 @@ namespace edm {
   //
   // member functions
   //
+  void ESProducer::allowConcurrentCalls() { ownMutex_ = std::make_unique<std::recursive_mutex>(); }
+
+  std::recursive_mutex& ESProducer::callMutex() { return ownMutex_ ? *ownMutex_ : esGlobalMutex(); }
+
   void ESProducer::updateLookup(eventsetup::ESRecordsToProxyIndices const& iProxyToIndices) {
     itemsToGetFromRecords_.reserve(consumesInfos_.size());
     recordsUsedDuringGet_.reserve(consumesInfos_.size());
@@ -67,9 +75,14 @@ namespace edm {
       for (auto& proxyInfo : *info) {
         //check for mayConsumes
         if (auto chooser = proxyInfo.chooser_.get()) {
+          //the data chosen is gotten while holding the producer's mutex, which would otherwise
+          // be locked both before and after the global mutex
+          ownMutex_.reset();
           auto tagGetter = iProxyToIndices.makeTagGetter(chooser->recordKey(), chooser->productType());
           if (not tagGetter.hasNothingToGet()) {
             records.push_back(iProxyToIndices.recordIndexFor(chooser->recordKey()));
+          } else {
+            records.push_back(eventsetup::ESRecordsToProxyIndices::missingRecordIndex());
           }
           chooser->setTagGetter(std::move(tagGetter));
           items.push_back(eventsetup::ESRecordsToProxyIndices::missingProxyIndex());
@@ -94,6 +107,8 @@ namespace edm {
           items.push_back(index);
           if (index != eventsetup::ESRecordsToProxyIndices::missingProxyIndex()) {
             records.push_back(iProxyToIndices.recordIndexFor(proxyInfo.recordKey_));
+          } else {
+            records.push_back(eventsetup::ESRecordsToProxyIndices::missingRecordIndex());
           }
         }
       }
@@ -103,6 +118,32 @@ namespace edm {
   //
   // const member functions
   //
+  void ESProducer::prefetchAsync(WaitingTask* iTask,
+                                 unsigned int iIndex,
+                                 EventSetupImpl const* iImpl,
+                                 ServiceToken const& iToken) const {
+    //Need to be sure the ref count isn't set to 0 immediately
+    iTask->increment_ref_count();
+    if (iImpl != nullptr and iIndex < itemsToGetFromRecords_.size()) {
+      auto const& items = itemsToGetFromRecords_[iIndex];
+      auto const& records = recordsUsedDuringGet_[iIndex];
+      for (size_t i = 0; i < items.size(); ++i) {
+        //the choices of the mayConsumes are made while holding the producer's mutex
+        if ((*consumesInfos_[iIndex])[i].chooser_ or
+            items[i] == eventsetup::ESRecordsToProxyIndices::missingProxyIndex() or
+            records[i] == eventsetup::ESRecordsToProxyIndices::missingRecordIndex()) {
+          continue;
+        }
+        if (auto recordImpl = iImpl->findImpl(records[i])) {
+          recordImpl->prefetchAsync(iTask, items[i], iImpl, iToken);
+        }
+      }
+    }
+    if (0 == iTask->decrement_ref_count()) {
+      //if everything finishes before we leave this routine, we need to launch the task
+      tbb::task::spawn(*iTask);
+    }
+  }
 
   //
   // static member functions
@@ -101,6 +101,8 @@ namespace edm {
 
   EDProductGetter const& Event::productGetter() const { return provRecorder_.principal(); }
 
+  EventArena& Event::arena() const { return eventPrincipal().arena(); }
+
   ProductID Event::makeProductID(BranchDescription const& desc) const {
     return eventPrincipal().branchIDToProductID(desc.originalBranchID());
   }
@@ -0,0 +1,119 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/Framework
+// Class  :     EventArena
+//
+// Implementation:
+//     The memory is taken from the current Block by atomically moving its
+//  fill mark, so no lock is needed until the Block is full. Requests larger
+//  than half a Block get a Block of their own which does not become the
+//  current one, so the space left in the current Block is not wasted.
+//
+
+// system include files
+#include <algorithm>
+#include <cstdint>
+
+// user include files
+#include "FWCore/Framework/interface/EventArena.h"
+
+namespace edm {
+  namespace {
+    constexpr std::size_t kFirstBlockSize = 64 * 1024;
+    constexpr std::size_t kMaxBlockSize = 16 * 1024 * 1024;
+  }  // namespace
+
+  class EventArena::Block {
+  public:
+    explicit Block(std::size_t iSize) : memory_(new char[iSize]), size_(iSize), used_(0) {}
+
+    void* allocate(std::size_t iBytes, std::size_t iAlignment) {
+      auto const begin = reinterpret_cast<std::uintptr_t>(memory_.get());
+      std::size_t used = used_.load(std::memory_order_relaxed);
+      while (true) {
+        auto const start = ((begin + used + iAlignment - 1) & ~(iAlignment - 1)) - begin;
+        if (start + iBytes > size_ or start + iBytes < start) {
+          return nullptr;
+        }
+        if (used_.compare_exchange_weak(used, start + iBytes, std::memory_order_relaxed)) {
+          return memory_.get() + start;
+        }
+      }
+    }
+
+    void clear() { used_.store(0, std::memory_order_relaxed); }
+    std::size_t size() const { return size_; }
+
+  private:
+    std::unique_ptr<char[]> memory_;
+    std::size_t size_;
+    std::atomic<std::size_t> used_;
+  };
+
+  //
+  // constructors and destructor
+  //
+  EventArena::EventArena() : current_(nullptr), nextBlockSize_(kFirstBlockSize) {}
+
+  EventArena::~EventArena() = default;
+
+  //
+  // member functions
+  //
+  void* EventArena::allocate(std::size_t iBytes, std::size_t iAlignment) {
+    Block* block = current_.load(std::memory_order_acquire);
+    if (block) {
+      if (void* memory = block->allocate(iBytes, iAlignment)) {
+        return memory;
+      }
+    }
+    return allocateFromNewBlock(iBytes, iAlignment, block);
+  }
+
+  void* EventArena::allocateFromNewBlock(std::size_t iBytes, std::size_t iAlignment, Block* iFull) {
+    std::lock_guard<std::mutex> guard(mutex_);
+    Block* current = current_.load(std::memory_order_acquire);
+    if (current != iFull) {
+      //another thread already added a Block
+      if (void* memory = current->allocate(iBytes, iAlignment)) {
+        return memory;
+      }
+    }
+    if (iBytes > nextBlockSize_ / 2) {
+      blocks_.push_back(std::make_unique<Block>(iBytes + iAlignment));
+      if (void* memory = blocks_.back()->allocate(iBytes, iAlignment)) {
+        return memory;
+      }
+      throw std::bad_alloc();
+    }
+    blocks_.push_back(std::make_unique<Block>(nextBlockSize_));
+    nextBlockSize_ = std::min(2 * nextBlockSize_, kMaxBlockSize);
+    void* memory = blocks_.back()->allocate(iBytes, iAlignment);
+    current_.store(blocks_.back().get(), std::memory_order_release);
+    return memory;
+  }
+
+  void EventArena::reset() {
+    std::lock_guard<std::mutex> guard(mutex_);
+    if (blocks_.size() > 1) {
+      std::size_t size = capacity();
+      blocks_.clear();
+      blocks_.push_back(std::make_unique<Block>(size));
+      nextBlockSize_ = std::max(nextBlockSize_, std::min(size, kMaxBlockSize));
+    } else if (not blocks_.empty()) {
+      blocks_.front()->clear();
+    }
+    current_.store(blocks_.empty() ? nullptr : blocks_.front().get(), std::memory_order_release);
+  }
+
+  //
+  // const member functions
+  //
+  std::size_t EventArena::capacity() const {
+    std::size_t size = 0;
+    for (auto const& block : blocks_) {
+      size += block->size();
+    }
+    return size;
+  }
+}  // namespace edm
@@ -54,6 +54,8 @@ namespace edm {
     // it is only connected at beginLumi transition
     provRetrieverPtr_->reset();
     branchListIndexToProcessIndex_.clear();
+    //the products which may have used the arena are gone
+    arena_.reset();
   }
 
   void EventPrincipal::fillEventPrincipal(EventAuxiliary const& aux,
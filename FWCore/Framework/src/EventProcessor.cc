@@ -422,6 +422,11 @@ namespace edm {
     // initialize the looper, if any
     looper_ = fillLooper(*espController_, *esp_, *parameterSet);
     if (looper_) {
+      if (optionsPset.getUntrackedParameter<bool>("deleteEarlyAutomatically")) {
+        throw Exception(errors::Configuration)
+            << "The option 'deleteEarlyAutomatically' can not be used with an EDLooper since the looper may read any "
+               "product of the Event.";
+      }
       looper_->setActionTable(items.act_table_.get());
       looper_->attachTo(*items.actReg_);
 
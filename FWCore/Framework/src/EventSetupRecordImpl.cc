@@ -230,6 +230,21 @@ namespace edm {
       return hold;
     }
 
+    void EventSetupRecordImpl::prefetchAsync(WaitingTask* iTask,
+                                             ESProxyIndex iProxyIndex,
+                                             EventSetupImpl const* iEventSetupImpl,
+                                             ServiceToken const& iToken) const {
+      if (iProxyIndex.value() < 0 or iProxyIndex.value() >= static_cast<ESProxyIndex::Value_t>(proxies_.size())) {
+        return;
+      }
+
+      const DataProxy* proxy = proxies_[iProxyIndex.value()];
+      if (nullptr != proxy) {
+        auto const& key = keysForProxies_[iProxyIndex.value()];
+        proxy->prefetchAsync(iTask, *this, key, activityRegistry_, iEventSetupImpl, iToken);
+      }
+    }
+
     const DataProxy* EventSetupRecordImpl::find(const DataKey& iKey) const {
       auto lb = std::lower_bound(keysForProxies_.begin(), keysForProxies_.end(), iKey);
       if ((lb == keysForProxies_.end()) or (*lb != iKey)) {
@@ -782,6 +782,39 @@ namespace edm {
       //});
     }
 
+    ParameterSet const& opts = proc_pset.getUntrackedParameterSet("options", ParameterSet());
+    if (opts.getUntrackedParameterSet("eventSetup", ParameterSet())
+            .getUntrackedParameter<bool>("concurrentPrefetching", false)) {
+      for (auto const& stream : streamSchedules_) {
+        for (auto worker : stream->allWorkers()) {
+          worker->setConcurrentESPrefetching(true);
+        }
+      }
+    }
+
+    if (opts.getUntrackedParameter<bool>("prioritizeCriticalPath", false)) {
+      std::vector<std::vector<Worker*>> streamWorkers;
+      streamWorkers.reserve(streamSchedules_.size());
+      for (auto const& stream : streamSchedules_) {
+        streamWorkers.push_back(stream->allWorkers());
+      }
+
+      // propagate_const<T> has no reset() function
+      criticalPathKeeper_ = std::make_unique<CriticalPathKeeper>(std::move(streamWorkers), preg, processContext);
+      auto keeperPtr = criticalPathKeeper_.get();
+
+      areg->watchPreBeginJob(keeperPtr, &CriticalPathKeeper::beginJob);
+
+      areg->watchPreModuleEvent(keeperPtr, &CriticalPathKeeper::startModuleEvent);
+      areg->watchPostModuleEvent(keeperPtr, &CriticalPathKeeper::stopModuleEvent);
+      areg->watchPreModuleEventAcquire(keeperPtr, &CriticalPathKeeper::restartModuleEvent);
+      areg->watchPostModuleEventAcquire(keeperPtr, &CriticalPathKeeper::pauseModuleEvent);
+      areg->watchPreModuleEventDelayedGet(keeperPtr, &CriticalPathKeeper::pauseModuleEvent);
+      areg->watchPostModuleEventDelayedGet(keeperPtr, &CriticalPathKeeper::restartModuleEvent);
+
+      areg->watchPreEvent(keeperPtr, &CriticalPathKeeper::startEvent);
+      areg->watchPostEvent(keeperPtr, &CriticalPathKeeper::stopEvent);
+    }
   }  // Schedule::Schedule
 
   void Schedule::limitOutput(ParameterSet const& proc_pset,
@@ -846,6 +879,10 @@ namespace edm {
       return;
     }
 
+    if (criticalPathKeeper_) {
+      criticalPathKeeper_->printReport();
+    }
+
     if (wantSummary_ == false)
       return;
     {
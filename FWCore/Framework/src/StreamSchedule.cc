@@ -24,6 +24,7 @@
 #include "FWCore/Utilities/interface/Algorithms.h"
 #include "FWCore/Utilities/interface/ConvertException.h"
 #include "FWCore/Utilities/interface/ExceptionCollector.h"
+#include "FWCore/Utilities/interface/InputTag.h"
 #include "FWCore/Concurrency/interface/WaitingTaskHolder.h"
 
 #include "LuminosityBlockProcessingStatus.h"
@@ -126,6 +127,91 @@ namespace edm {
         }
       }
     }
+
+    typedef std::map<std::string, std::vector<BranchDescription const*>> LabelToBranches;
+
+    // The Event products made in this process which can be deleted once all the modules which
+    // consume them have run. Aliases, and products with an alias, are left alone as are the
+    // products the framework itself makes for the paths.
+    void initializeAutomaticDeleteEarly(ProductRegistry const& preg,
+                                        std::multimap<std::string, Worker*>& branchToReadingWorker,
+                                        LabelToBranches& candidates,
+                                        std::set<std::string>& automaticBranches) {
+      std::set<BranchID> aliased;
+      for (auto const& item : preg.productList()) {
+        BranchDescription const& desc = item.second;
+        if (desc.isAlias()) {
+          aliased.insert(desc.aliasForBranchID());
+        } else if (desc.isSwitchAlias()) {
+          aliased.insert(desc.switchAliasForBranchID());
+        }
+      }
+      for (auto const& item : preg.productList()) {
+        BranchDescription const& desc = item.second;
+        if (desc.branchType() != InEvent or not desc.produced() or desc.isAnyAlias() or
+            aliased.find(desc.branchID()) != aliased.end()) {
+          continue;
+        }
+        if (desc.moduleName() == "TriggerResultInserter" or desc.moduleName() == "PathStatusInserter" or
+            desc.moduleName() == "EndPathStatusInserter") {
+          continue;
+        }
+        //the branch names all end with a period, which we do not want to compare with
+        std::string branch = desc.branchName();
+        branch.resize(branch.size() - 1);
+        if (branchToReadingWorker.find(branch) != branchToReadingWorker.end()) {
+          //already asked for in 'canDeleteEarly'
+          continue;
+        }
+        branchToReadingWorker.insert(std::make_pair(branch, static_cast<Worker*>(nullptr)));
+        automaticBranches.insert(branch);
+        candidates[desc.moduleLabel()].push_back(&desc);
+      }
+    }
+
+    // Adds to oBranches those of the candidates iWorker might get according to what it consumes.
+    // When it is not certain which products a get will find, all the possible ones are added
+    // which only delays their deletion.
+    void branchesFromConsumes(Worker const& iWorker,
+                              std::string const& iProcessName,
+                              LabelToBranches const& iCandidates,
+                              std::set<std::string>& oBranches) {
+      auto add = [&oBranches](BranchDescription const& iDesc) {
+        std::string branch = iDesc.branchName();
+        branch.resize(branch.size() - 1);
+        oBranches.insert(branch);
+      };
+      for (auto const& info : iWorker.consumesInfo()) {
+        //the lookups have not been updated yet so '@currentProcess' is still unresolved
+        if (info.branchType() != InEvent or info.skipCurrentProcess() or
+            (not info.process().empty() and info.process() != iProcessName and
+             info.process() != InputTag::kCurrentProcess)) {
+          continue;
+        }
+        //for a View the type of the product is not the consumed one
+        bool const checkType = info.kindOfType() == PRODUCT_TYPE;
+        if (info.label().empty()) {
+          //consumesMany
+          for (auto const& labelAndBranches : iCandidates) {
+            for (auto desc : labelAndBranches.second) {
+              if (not checkType or info.type() == desc->unwrappedTypeID()) {
+                add(*desc);
+              }
+            }
+          }
+        } else {
+          auto found = iCandidates.find(info.label());
+          if (found != iCandidates.end()) {
+            for (auto desc : found->second) {
+              if (info.instance() == desc->productInstanceName() and
+                  (not checkType or info.type() == desc->unwrappedTypeID())) {
+                add(*desc);
+              }
+            }
+          }
+        }
+      }
+    }
   }  // namespace
 
   // -----------------------------
@@ -236,13 +322,14 @@ namespace edm {
     }
     number_of_unscheduled_modules_ = unscheduledLabels.size();
 
-    initializeEarlyDelete(*modReg, opts, preg, allowEarlyDelete);
+    initializeEarlyDelete(*modReg, opts, preg, processConfiguration->processName(), allowEarlyDelete);
 
   }  // StreamSchedule::StreamSchedule
 
   void StreamSchedule::initializeEarlyDelete(ModuleRegistry& modReg,
                                              edm::ParameterSet const& opts,
                                              edm::ProductRegistry const& preg,
+                                             std::string const& processName,
                                              bool allowEarlyDelete) {
     //for now, if have a subProcess, don't allow early delete
     // In the future we should use the SubProcess's 'keep list' to decide what can be kept
@@ -254,6 +341,14 @@ namespace edm {
     std::multimap<std::string, Worker*> branchToReadingWorker;
     initializeBranchToReadingWorker(opts, preg, branchToReadingWorker);
 
+    //the products found from what the modules consume rather than from 'mightGet'
+    bool const deleteEarlyAutomatically = opts.getUntrackedParameter<bool>("deleteEarlyAutomatically");
+    LabelToBranches automaticCandidates;
+    std::set<std::string> automaticBranches;
+    if (deleteEarlyAutomatically) {
+      initializeAutomaticDeleteEarly(preg, branchToReadingWorker, automaticCandidates, automaticBranches);
+    }
+
     //If no delete early items have been specified we don't have to do anything
     if (branchToReadingWorker.empty()) {
       return;
@@ -274,7 +369,10 @@ namespace edm {
           SelectedProductsForBranchType const& kept = comm->keptProducts();
           for (auto const& item : kept[InEvent]) {
             BranchDescription const& desc = *item.first;
-            auto found = branchToReadingWorker.equal_range(desc.branchName());
+            //the keys do not have the trailing period of the branch name
+            std::string branch = desc.branchName();
+            branch.resize(branch.size() - 1);
+            auto found = branchToReadingWorker.equal_range(branch);
             if (found.first != found.second) {
               --nUniqueBranchesToDelete;
               branchToReadingWorker.erase(found.first, found.second);
@@ -290,22 +388,27 @@ namespace edm {
 
     for (auto w : allWorkers()) {
       //determine if this module could read a branch we want to delete early
+      std::set<std::string> branches;
       auto pset = pset::Registry::instance()->getMapped(w->description().parameterSetID());
       if (nullptr != pset) {
-        auto branches = pset->getUntrackedParameter<std::vector<std::string>>("mightGet", kEmpty);
-        if (not branches.empty()) {
-          ++upperLimitOnReadingWorker;
-        }
-        for (auto const& branch : branches) {
-          auto found = branchToReadingWorker.equal_range(branch);
-          if (found.first != found.second) {
-            ++upperLimitOnIndicies;
-            ++reserveSizeForWorker[w];
-            if (nullptr == found.first->second) {
-              found.first->second = w;
-            } else {
-              branchToReadingWorker.insert(make_pair(found.first->first, w));
-            }
+        auto mightGet = pset->getUntrackedParameter<std::vector<std::string>>("mightGet", kEmpty);
+        branches.insert(mightGet.begin(), mightGet.end());
+      }
+      if (deleteEarlyAutomatically) {
+        branchesFromConsumes(*w, processName, automaticCandidates, branches);
+      }
+      if (not branches.empty()) {
+        ++upperLimitOnReadingWorker;
+      }
+      for (auto const& branch : branches) {
+        auto found = branchToReadingWorker.equal_range(branch);
+        if (found.first != found.second) {
+          ++upperLimitOnIndicies;
+          ++reserveSizeForWorker[w];
+          if (nullptr == found.first->second) {
+            found.first->second = w;
+          } else {
+            branchToReadingWorker.insert(make_pair(found.first->first, w));
           }
         }
       }
@@ -315,7 +418,10 @@ namespace edm {
       std::vector<std::string> unusedBranches;
       while (it != branchToReadingWorker.end()) {
         if (it->second == nullptr) {
-          unusedBranches.push_back(it->first);
+          //a product found automatically may simply not be consumed
+          if (automaticBranches.find(it->first) == automaticBranches.end()) {
+            unusedBranches.push_back(it->first);
+          }
           //erasing the object invalidates the iterator so must advance it first
           auto temp = it;
           ++it;
@@ -333,6 +439,18 @@ namespace edm {
         }
       }
     }
+    if (deleteEarlyAutomatically and streamID_.value() == 0) {
+      LogInfo l("DeleteEarlyAutomatically");
+      l << "The following products will be deleted once the last module consuming them has run.";
+      std::string lastBranchName;
+      for (auto const& branchAndWorker : branchToReadingWorker) {
+        if (branchAndWorker.first != lastBranchName and
+            automaticBranches.find(branchAndWorker.first) != automaticBranches.end()) {
+          l << "\n " << branchAndWorker.first;
+          lastBranchName = branchAndWorker.first;
+        }
+      }
+    }
     if (!branchToReadingWorker.empty()) {
       earlyDeleteHelpers_.reserve(upperLimitOnReadingWorker);
       earlyDeleteHelperToBranchIndicies_.resize(upperLimitOnIndicies, 0);
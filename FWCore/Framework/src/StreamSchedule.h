@@ -322,6 +322,7 @@ namespace edm {
     void initializeEarlyDelete(ModuleRegistry& modReg,
                                edm::ParameterSet const& opts,
                                edm::ProductRegistry const& preg,
+                               std::string const& processName,
                                bool allowEarlyDelete);
 
     TrigResConstPtr results() const { return get_underlying_safe(results_); }
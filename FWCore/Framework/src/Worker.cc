@@ -4,10 +4,17 @@
 
 #include "FWCore/Framework/src/Worker.h"
 #include "FWCore/Framework/src/EarlyDeleteHelper.h"
+#include "FWCore/Framework/interface/EventSetupImpl.h"
+#include "FWCore/Framework/interface/EventSetupRecordImpl.h"
+#include "FWCore/Framework/interface/ESRecordsToProxyIndices.h"
 #include "FWCore/ServiceRegistry/interface/StreamContext.h"
 #include "FWCore/Concurrency/interface/WaitingTask.h"
 #include "FWCore/Concurrency/interface/WaitingTaskHolder.h"
 
+#include <algorithm>
+#include <cassert>
+#include <numeric>
+
 namespace edm {
   namespace {
     class ModuleBeginJobSignalSentry {
@@ -95,7 +102,8 @@ namespace edm {
         actReg_(),
         earlyDeleteHelper_(nullptr),
         workStarted_(false),
-        ranAcquireWithoutException_(false) {}
+        ranAcquireWithoutException_(false),
+        concurrentESPrefetching_(false) {}
 
   Worker::~Worker() {}
 
@@ -199,7 +207,8 @@ namespace edm {
   void Worker::prefetchAsync(WaitingTask* iTask,
                              ServiceToken const& token,
                              ParentContext const& parentContext,
-                             Principal const& iPrincipal) {
+                             Principal const& iPrincipal,
+                             EventSetupImpl const& iImpl) {
     // Prefetch products the module declares it consumes (not including the products it maybe consumes)
     std::vector<ProductResolverIndexAndSkipBit> const& items = itemsToGetFrom(iPrincipal.branchType());
 
@@ -211,15 +220,28 @@ namespace edm {
 
     //Need to be sure the ref count isn't set to 0 immediately
     iTask->increment_ref_count();
-    for (auto const& item : items) {
+    auto prefetch = [&](ProductResolverIndexAndSkipBit const& item) {
       ProductResolverIndex productResolverIndex = item.productResolverIndex();
       bool skipCurrentProcess = item.skipCurrentProcess();
       if (productResolverIndex != ProductResolverIndexAmbiguous) {
         iPrincipal.prefetchAsync(iTask, productResolverIndex, skipCurrentProcess, token, &moduleCallingContext_);
       }
+    };
+    if (iPrincipal.branchType() == InEvent and eventPrefetchOrder_.size() == items.size()) {
+      //As for the Paths in StreamSchedule, the work requested last is the first this thread picks up
+      for (auto index : eventPrefetchOrder_) {
+        prefetch(items[index]);
+      }
+    } else {
+      for (auto const& item : items) {
+        prefetch(item);
+      }
     }
 
     if (iPrincipal.branchType() == InEvent) {
+      if (concurrentESPrefetching_) {
+        esPrefetchAsync(iTask, iImpl, Transition::Event, token);
+      }
       preActionBeforeRunEventAsync(iTask, moduleCallingContext_, iPrincipal);
     }
 
@@ -229,6 +251,57 @@ namespace edm {
     }
   }
 
+  void Worker::esPrefetchAsync(WaitingTask* iTask,
+                               EventSetupImpl const& iImpl,
+                               Transition iTrans,
+                               ServiceToken const& iToken) {
+    auto const& recs = esRecordsToGetFrom(iTrans);
+    auto const& items = esItemsToGetFrom(iTrans);
+    assert(items.size() == recs.size());
+    if (items.empty()) {
+      return;
+    }
+
+    //A failure is not reported here, the module gets the same exception,
+    // with the context of the request, when it gets the data
+    iTask->increment_ref_count();
+    auto doneTask = make_waiting_task(tbb::task::allocate_root(), [iTask](std::exception_ptr const*) {
+      if (0 == iTask->decrement_ref_count()) {
+        tbb::task::spawn(*iTask);
+      }
+    });
+    doneTask->increment_ref_count();
+    for (size_t i = 0; i != items.size(); ++i) {
+      if (recs[i] != eventsetup::ESRecordsToProxyIndices::missingRecordIndex() and
+          items[i] != eventsetup::ESRecordsToProxyIndices::missingProxyIndex()) {
+        if (auto recordImpl = iImpl.findImpl(recs[i])) {
+          recordImpl->prefetchAsync(doneTask, items[i], &iImpl, iToken);
+        }
+      }
+    }
+    if (0 == doneTask->decrement_ref_count()) {
+      tbb::task::spawn(*doneTask);
+    }
+  }
+
+  void Worker::setEventPrefetchPriorities(std::vector<double> const& iPriorityOfIndex) {
+    std::vector<ProductResolverIndexAndSkipBit> const& items = itemsToGetFrom(InEvent);
+    std::vector<double> priorities;
+    priorities.reserve(items.size());
+    for (auto const& item : items) {
+      ProductResolverIndex index = item.productResolverIndex();
+      //products from earlier processes are already available
+      bool known = index < iPriorityOfIndex.size() and not item.skipCurrentProcess();
+      priorities.push_back(known ? iPriorityOfIndex[index] : 0.);
+    }
+    eventPrefetchOrder_.resize(items.size());
+    std::iota(eventPrefetchOrder_.begin(), eventPrefetchOrder_.end(), 0U);
+    std::stable_sort(
+        eventPrefetchOrder_.begin(), eventPrefetchOrder_.end(), [&priorities](unsigned int iLHS, unsigned int iRHS) {
+          return priorities[iLHS] < priorities[iRHS];
+        });
+  }
+
   void Worker::prePrefetchSelectionAsync(WaitingTask* successTask,
                                          ServiceToken const& token,
                                          StreamID id,
@@ -46,10 +46,12 @@ the worker is reset().
 #include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/Utilities/interface/ConvertException.h"
 #include "FWCore/Utilities/interface/BranchType.h"
+#include "FWCore/Utilities/interface/ESIndices.h"
 #include "FWCore/Utilities/interface/ProductResolverIndex.h"
 #include "FWCore/Utilities/interface/StreamID.h"
 #include "FWCore/Utilities/interface/propagate_const.h"
 #include "FWCore/Utilities/interface/thread_safety_macros.h"
+#include "FWCore/Utilities/interface/Transition.h"
 
 #include "FWCore/Framework/interface/Frameworkfwd.h"
 
@@ -195,6 +197,13 @@ namespace edm {
 
     void setEarlyDeleteHelper(EarlyDeleteHelper* iHelper);
 
+    ///Orders the prefetching of the Event products by increasing priority, given per ProductResolverIndex.
+    /// Must only be called while the Worker is not processing an Event.
+    void setEventPrefetchPriorities(std::vector<double> const& iPriorityOfIndex);
+
+    ///Prefetches the EventSetup data consumed for the Event transition together with the Event products.
+    void setConcurrentESPrefetching(bool iConcurrent) { concurrentESPrefetching_ = iConcurrent; }
+
     //Used to make EDGetToken work
     virtual void updateLookup(BranchType iBranchType, ProductResolverIndexHelper const&) = 0;
     virtual void updateLookup(eventsetup::ESRecordsToProxyIndices const&) = 0;
@@ -296,6 +305,9 @@ namespace edm {
 
     virtual std::vector<ProductResolverIndexAndSkipBit> const& itemsToGetFrom(BranchType) const = 0;
 
+    virtual std::vector<ESProxyIndex> const& esItemsToGetFrom(Transition) const = 0;
+    virtual std::vector<ESRecordIndex> const& esRecordsToGetFrom(Transition) const = 0;
+
     virtual std::vector<ProductResolverIndex> const& itemsShouldPutInEvent() const = 0;
 
     virtual void preActionBeforeRunEventAsync(WaitingTask* iTask,
@@ -369,7 +381,13 @@ namespace edm {
       return cached_exception_;
     }
 
-    void prefetchAsync(WaitingTask*, ServiceToken const&, ParentContext const& parentContext, Principal const&);
+    void prefetchAsync(WaitingTask*,
+                       ServiceToken const&,
+                       ParentContext const& parentContext,
+                       Principal const&,
+                       EventSetupImpl const&);
+
+    void esPrefetchAsync(WaitingTask*, EventSetupImpl const&, Transition, ServiceToken const&);
 
     void emitPostModuleEventPrefetchingSignal() {
       actReg_->postModuleEventPrefetchingSignal_.emit(*moduleCallingContext_.getStreamContext(), moduleCallingContext_);
@@ -618,6 +636,10 @@ namespace edm {
     edm::WaitingTaskList waitingTasks_;
     std::atomic<bool> workStarted_;
     bool ranAcquireWithoutException_;
+
+    //positions in itemsToGetFrom(InEvent) in the order they are prefetched, empty to use that order
+    std::vector<unsigned int> eventPrefetchOrder_;
+    bool concurrentESPrefetching_;
   };
 
   namespace {
@@ -874,9 +896,9 @@ namespace edm {
         auto ownRunTask = std::make_shared<DestroyTask>(runTask);
         auto selectionTask =
             make_waiting_task(tbb::task::allocate_root(),
-                              [ownRunTask, parentContext, &ep, token, this](std::exception_ptr const*) mutable {
+                              [ownRunTask, parentContext, &ep, &es, token, this](std::exception_ptr const*) mutable {
                                 ServiceRegistry::Operate guard(token);
-                                prefetchAsync(ownRunTask->release(), token, parentContext, ep);
+                                prefetchAsync(ownRunTask->release(), token, parentContext, ep, es);
                               });
         prePrefetchSelectionAsync(selectionTask, token, streamID, &ep);
       } else {
@@ -888,7 +910,7 @@ namespace edm {
           moduleTask = new (tbb::task::allocate_root())
               AcquireTask<T>(this, ep, es, token, parentContext, std::move(runTaskHolder));
         }
-        prefetchAsync(moduleTask, token, parentContext, ep);
+        prefetchAsync(moduleTask, token, parentContext, ep, es);
       }
     }
   }
@@ -1036,7 +1058,7 @@ namespace edm {
         //set count to 2 since wait_for_all requires value to not go to 0
         waitTask->set_ref_count(2);
 
-        prefetchAsync(waitTask.get(), ServiceRegistry::instance().presentToken(), parentContext, ep);
+        prefetchAsync(waitTask.get(), ServiceRegistry::instance().presentToken(), parentContext, ep, es);
         waitTask->decrement_ref_count();
         waitTask->wait_for_all();
       }
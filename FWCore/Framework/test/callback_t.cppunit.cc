@@ -12,6 +12,7 @@
 #include "FWCore/Framework/interface/Callback.h"
 #include "FWCore/Framework/interface/ESProducts.h"
 #include <cassert>
+#include <mutex>
 
 namespace callbacktest {
   struct Data {
@@ -33,6 +34,8 @@ namespace callbacktest {
   struct Base {
     template <typename A, typename B>
     void updateFromMayConsumes(A const&, B const&) {}
+    std::recursive_mutex& callMutex() { return mutex_; }
+    std::recursive_mutex mutex_;
   };
 
   struct UniquePtrProd : public Base {
@@ -38,6 +38,7 @@ public:
   CPPUNIT_TEST(testViewType);
   CPPUNIT_TEST(testMany);
   CPPUNIT_TEST(testMay);
+  CPPUNIT_TEST(testDirectIndex);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -48,6 +49,7 @@ public:
   void testViewType();
   void testMany();
   void testMay();
+  void testDirectIndex();
 };
 
 ///registration of the test so that the runner can find it
@@ -618,3 +620,60 @@ void TestEDConsumerBase::testMay() {
                    consumer.indexFrom(consumer.m_mayTokens[0], edm::InEvent, typeID_vint));
   }
 }
+
+void TestEDConsumerBase::testDirectIndex() {
+  edm::ProductResolverIndexHelper helper;
+
+  edm::TypeID typeIDEventID(typeid(edm::EventID));
+  edm::TypeID typeIDVectorInt(typeid(std::vector<int>));
+
+  helper.insert(typeIDVectorInt, "labelC", "instanceC", "processC");  // 0, 1, 2
+  helper.insert(typeIDEventID, "labelB", "instanceB", "processB");    // 3, 4
+  helper.insert(typeIDEventID, "labelB", "instanceB", "processB1");   // 5, 4
+
+  helper.setFrozen();
+
+  edm::TypeID typeID_vint(typeid(std::vector<int>));
+  const auto vint_c = helper.index(edm::PRODUCT_TYPE, typeID_vint, "labelC", "instanceC", "processC");
+  const auto vint_c_no_proc = helper.index(edm::PRODUCT_TYPE, typeID_vint, "labelC", "instanceC", 0);
+  const auto eventID_b_no_proc = helper.index(edm::PRODUCT_TYPE, typeIDEventID, "labelB", "instanceB", 0);
+
+  {
+    //only one process has the product, so a get without process goes to it directly
+    std::vector<edm::InputTag> vTags = {{"labelC", "instanceC"},
+                                        {"labelC", "instanceC", "processC"},
+                                        {"labelC", "instanceC", "@skipCurrentProcess"},
+                                        {"notHere"}};
+    IntsConsumer intConsumer{vTags};
+    intConsumer.updateLookup(edm::InEvent, helper, false);
+
+    CPPUNIT_ASSERT(edm::ProductResolverIndexAndSkipBit(vint_c_no_proc, false) ==
+                   intConsumer.indexFrom(intConsumer.m_tokens[0], edm::InEvent, typeID_vint));
+    CPPUNIT_ASSERT(edm::ProductResolverIndexAndSkipBit(vint_c, false) ==
+                   intConsumer.directIndexFrom(intConsumer.m_tokens[0], edm::InEvent, typeID_vint));
+    CPPUNIT_ASSERT(edm::ProductResolverIndexAndSkipBit(vint_c, false) ==
+                   intConsumer.directIndexFrom(intConsumer.m_tokens[1], edm::InEvent, typeID_vint));
+    CPPUNIT_ASSERT(edm::ProductResolverIndexAndSkipBit(vint_c, true) ==
+                   intConsumer.directIndexFrom(intConsumer.m_tokens[2], edm::InEvent, typeID_vint));
+    CPPUNIT_ASSERT(edm::ProductResolverIndexInvalid ==
+                   intConsumer.directIndexFrom(intConsumer.m_tokens[3], edm::InEvent, typeID_vint)
+                       .productResolverIndex());
+
+    //prefetching still uses the lookup of the consumed labels
+    std::vector<edm::ProductResolverIndexAndSkipBit> indices;
+    intConsumer.itemsToGet(edm::InEvent, indices);
+    CPPUNIT_ASSERT(indices.end() != std::find(indices.begin(),
+                                              indices.end(),
+                                              edm::ProductResolverIndexAndSkipBit(vint_c_no_proc, false)));
+  }
+  {
+    //two processes have the product, the most recent one is searched for each event
+    std::vector<std::pair<edm::TypeToGet, edm::InputTag>> vTags = {
+        {edm::TypeToGet::make<edm::EventID>(), {"labelB", "instanceB"}}};
+    TypeToGetConsumer consumer{vTags};
+    consumer.updateLookup(edm::InEvent, helper, false);
+
+    CPPUNIT_ASSERT(edm::ProductResolverIndexAndSkipBit(eventID_b_no_proc, false) ==
+                   consumer.directIndexFrom(consumer.m_tokens[0], edm::InEvent, typeIDEventID));
+  }
+}
@@ -16,6 +16,8 @@
 #include "FWCore/Framework/test/DepRecord.h"
 #include "FWCore/Framework/interface/DataProxy.h"
 #include "FWCore/Framework/interface/EventSetup.h"
+#include "FWCore/Framework/interface/EventSetupImpl.h"
+#include "FWCore/Framework/interface/EventSetupRecordImpl.h"
 #include "FWCore/Framework/interface/EventSetupProvider.h"
 #include "FWCore/Framework/interface/EventSetupRecordKey.h"
 #include "FWCore/Framework/src/EventSetupsController.h"
@@ -23,14 +25,19 @@
 #include "FWCore/Framework/interface/ESHandle.h"
 #include "FWCore/Framework/interface/ESProducts.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Concurrency/interface/WaitingTaskList.h"
 #include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/ServiceToken.h"
 #include "FWCore/Utilities/interface/do_nothing_deleter.h"
 #include "FWCore/Utilities/interface/Exception.h"
 
 #include "tbb/task_scheduler_init.h"
 
+#include <atomic>
+#include <chrono>
 #include <memory>
 #include <optional>
+#include <thread>
 
 using edm::eventsetup::test::DummyData;
 using namespace edm::eventsetup;
@@ -59,6 +66,9 @@ class testEsproducer : public CppUnit::TestFixture {
   CPPUNIT_TEST(getfromOptionalTest);
   CPPUNIT_TEST(decoratorTest);
   CPPUNIT_TEST(dependsOnTest);
+  CPPUNIT_TEST(consumesChainTest);
+  CPPUNIT_TEST(failureRetryTest);
+  CPPUNIT_TEST(concurrentCallsTest);
   CPPUNIT_TEST(labelTest);
   CPPUNIT_TEST_EXCEPTION(failMultipleRegistration, cms::Exception);
   CPPUNIT_TEST(forceCacheClearTest);
@@ -77,6 +87,9 @@ public:
   void getfromOptionalTest();
   void decoratorTest();
   void dependsOnTest();
+  void consumesChainTest();
+  void failureRetryTest();
+  void concurrentCallsTest();
   void labelTest();
   void failMultipleRegistration();
   void forceCacheClearTest();
@@ -414,6 +427,201 @@ void testEsproducer::dependsOnTest() {
   }
 }
 
+namespace {
+  //counts how often its data is made, the data is used by ChainEndProducer
+  class ChainStartProducer : public ESProducer {
+  public:
+    ChainStartProducer() { setWhatProduced(this, "start"); }
+    std::unique_ptr<DummyData> produce(const DummyRecord&) { return std::make_unique<DummyData>(++calls_); }
+    int calls_ = 0;
+  };
+
+  class ChainEndProducer : public ESProducer {
+  public:
+    ChainEndProducer() {
+      setWhatProduced(this, "end").setConsumes(token_, edm::ESInputTag("", "start"));
+    }
+    std::unique_ptr<DummyData> produce(const DepRecord& iRecord) {
+      return std::make_unique<DummyData>(10 * iRecord.get(token_).value_);
+    }
+
+  private:
+    edm::ESGetToken<DummyData, DummyRecord> token_;
+  };
+}  // namespace
+
+void testEsproducer::consumesChainTest() {
+  EventSetupsController controller;
+  edm::ParameterSet pset = createDummyPset();
+  EventSetupProvider& provider = *controller.makeProvider(pset, &activityRegistry);
+
+  auto start = std::make_shared<ChainStartProducer>();
+  provider.add(start);
+  provider.add(std::make_shared<ChainEndProducer>());
+
+  auto pFinder = std::make_shared<DummyFinder>();
+  provider.add(std::shared_ptr<EventSetupRecordIntervalFinder>(pFinder));
+
+  for (int iTime = 1; iTime != 4; ++iTime) {
+    const edm::Timestamp time(iTime);
+    pFinder->setInterval(edm::ValidityInterval(edm::IOVSyncValue(time), edm::IOVSyncValue(time)));
+    controller.eventSetupForInstance(edm::IOVSyncValue(time));
+    const edm::EventSetup eventSetup(provider.eventSetupImpl(), 0, nullptr, false);
+
+    //the data of the other record is gotten by ChainEndProducer::produce
+    edm::ESHandle<DummyData> pEnd;
+    eventSetup.get<DepRecord>().get("end", pEnd);
+    CPPUNIT_ASSERT(0 != pEnd.product());
+    CPPUNIT_ASSERT(10 * iTime == pEnd->value_);
+
+    edm::ESHandle<DummyData> pStart;
+    eventSetup.get<DummyRecord>().get("start", pStart);
+    CPPUNIT_ASSERT(iTime == pStart->value_);
+    CPPUNIT_ASSERT(iTime == start->calls_);
+  }
+}
+
+namespace {
+  //fails when asked to, the next call succeeds
+  class FailingProducer : public ESProducer {
+  public:
+    FailingProducer() { setWhatProduced(this, "failing"); }
+    std::unique_ptr<DummyData> produce(const DummyRecord&) {
+      ++calls_;
+      if (fail_) {
+        fail_ = false;
+        throw cms::Exception("Test") << "asked to fail";
+      }
+      return std::make_unique<DummyData>(calls_);
+    }
+    bool fail_ = false;
+    int calls_ = 0;
+  };
+
+  //waits for the other producer of the pair to be called as well, or gives up after a while
+  class RendezvousProducer : public ESProducer {
+  public:
+    RendezvousProducer(const char* iLabel, std::atomic<int>& iArrived) : arrived_(iArrived) {
+      allowConcurrentCalls();
+      setWhatProduced(this, iLabel);
+    }
+    std::unique_ptr<DummyData> produce(const DummyRecord&) {
+      ++calls_;
+      ++arrived_;
+      auto const giveUp = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+      while (arrived_ < 2 and std::chrono::steady_clock::now() < giveUp) {
+        std::this_thread::yield();
+      }
+      return std::make_unique<DummyData>(arrived_.load());
+    }
+    std::atomic<int> calls_{0};
+
+  private:
+    std::atomic<int>& arrived_;
+  };
+
+  //prefetches the data of DummyRecord iRequests times and waits for it, returns the failure if any
+  std::exception_ptr prefetchAndWait(edm::EventSetupImpl const& iImpl, DataKey const& iKey, int iRequests = 1) {
+    auto recordImpl = iImpl.findImpl(EventSetupRecordKey::makeKey<DummyRecord>());
+    CPPUNIT_ASSERT(nullptr != recordImpl);
+    auto proxy = recordImpl->find(iKey);
+    CPPUNIT_ASSERT(nullptr != proxy);
+
+    auto waitTask = edm::make_empty_waiting_task();
+    //set count to 2 since wait_for_all requires value to not go to 0
+    waitTask->set_ref_count(2);
+    for (int i = 0; i != iRequests; ++i) {
+      proxy->prefetchAsync(waitTask.get(), *recordImpl, iKey, &activityRegistry, &iImpl, edm::ServiceToken());
+    }
+    waitTask->decrement_ref_count();
+    waitTask->wait_for_all();
+    return waitTask->exceptionPtr() ? *waitTask->exceptionPtr() : std::exception_ptr{};
+  }
+}  // namespace
+
+void testEsproducer::failureRetryTest() {
+  EventSetupsController controller;
+  edm::ParameterSet pset = createDummyPset();
+  EventSetupProvider& provider = *controller.makeProvider(pset, &activityRegistry);
+
+  auto failing = std::make_shared<FailingProducer>();
+  provider.add(failing);
+
+  auto pFinder = std::make_shared<DummyFinder>();
+  provider.add(std::shared_ptr<EventSetupRecordIntervalFinder>(pFinder));
+
+  const DataKey key(DataKey::makeTypeTag<DummyData>(), "failing");
+  {
+    const edm::Timestamp time(1);
+    pFinder->setInterval(edm::ValidityInterval(edm::IOVSyncValue(time), edm::IOVSyncValue(time)));
+    controller.eventSetupForInstance(edm::IOVSyncValue(time));
+    const edm::EventSetup eventSetup(provider.eventSetupImpl(), 0, nullptr, false);
+
+    failing->fail_ = true;
+    edm::ESHandle<DummyData> pData;
+    CPPUNIT_ASSERT_THROW(eventSetup.get<DummyRecord>().get("failing", pData), cms::Exception);
+    eventSetup.get<DummyRecord>().get("failing", pData);
+    CPPUNIT_ASSERT(2 == pData->value_);
+  }
+  {
+    const edm::Timestamp time(2);
+    pFinder->setInterval(edm::ValidityInterval(edm::IOVSyncValue(time), edm::IOVSyncValue(time)));
+    controller.eventSetupForInstance(edm::IOVSyncValue(time));
+
+    failing->fail_ = true;
+    CPPUNIT_ASSERT(prefetchAndWait(provider.eventSetupImpl(), key));
+    CPPUNIT_ASSERT(not prefetchAndWait(provider.eventSetupImpl(), key));
+    CPPUNIT_ASSERT(4 == failing->calls_);
+
+    const edm::EventSetup eventSetup(provider.eventSetupImpl(), 0, nullptr, false);
+    edm::ESHandle<DummyData> pData;
+    eventSetup.get<DummyRecord>().get("failing", pData);
+    CPPUNIT_ASSERT(4 == pData->value_);
+    CPPUNIT_ASSERT(4 == failing->calls_);
+  }
+}
+
+void testEsproducer::concurrentCallsTest() {
+  EventSetupsController controller;
+  edm::ParameterSet pset = createDummyPset();
+  EventSetupProvider& provider = *controller.makeProvider(pset, &activityRegistry);
+
+  std::atomic<int> arrived{0};
+  auto first = std::make_shared<RendezvousProducer>("first", arrived);
+  auto second = std::make_shared<RendezvousProducer>("second", arrived);
+  provider.add(first);
+  provider.add(second);
+
+  auto pFinder = std::make_shared<DummyFinder>();
+  provider.add(std::shared_ptr<EventSetupRecordIntervalFinder>(pFinder));
+
+  const edm::Timestamp time(1);
+  pFinder->setInterval(edm::ValidityInterval(edm::IOVSyncValue(time), edm::IOVSyncValue(time)));
+  controller.eventSetupForInstance(edm::IOVSyncValue(time));
+
+  //each thread runs the tasks it spawns while waiting, the producers only meet if
+  // neither holds a mutex the other needs
+  const DataKey firstKey(DataKey::makeTypeTag<DummyData>(), "first");
+  const DataKey secondKey(DataKey::makeTypeTag<DummyData>(), "second");
+  std::exception_ptr firstFailure, secondFailure;
+  std::thread firstThread([&]() { firstFailure = prefetchAndWait(provider.eventSetupImpl(), firstKey, 3); });
+  std::thread secondThread([&]() { secondFailure = prefetchAndWait(provider.eventSetupImpl(), secondKey, 3); });
+  firstThread.join();
+  secondThread.join();
+  CPPUNIT_ASSERT(not firstFailure);
+  CPPUNIT_ASSERT(not secondFailure);
+
+  const edm::EventSetup eventSetup(provider.eventSetupImpl(), 0, nullptr, false);
+  edm::ESHandle<DummyData> pFirst;
+  eventSetup.get<DummyRecord>().get("first", pFirst);
+  edm::ESHandle<DummyData> pSecond;
+  eventSetup.get<DummyRecord>().get("second", pSecond);
+  CPPUNIT_ASSERT(2 == pFirst->value_);
+  CPPUNIT_ASSERT(2 == pSecond->value_);
+  CPPUNIT_ASSERT(1 == first->calls_);
+  CPPUNIT_ASSERT(1 == second->calls_);
+}
+
 void testEsproducer::failMultipleRegistration() { MultiRegisterProducer dummy; }
 
 void testEsproducer::forceCacheClearTest() {
@@ -0,0 +1,113 @@
+// Compares the memory of the system allocator with the one of an EventArena
+// for a workload resembling track finding: many small hits, trajectories
+// growing one hit at a time, and candidates which are mostly thrown away.
+// Each thread plays the role of a Stream and resets its arena after each
+// event, as the framework does.
+//
+//   eventArenaBenchmark [threads] [events per thread]
+
+#include "FWCore/Framework/interface/EventArena.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <list>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  struct Hit {
+    float x_, y_, z_;
+    std::uint32_t detector_;
+  };
+
+  struct Candidate {
+    float chi2_;
+    float parameters_[5];
+  };
+
+  //a simple, reproducible random sequence
+  struct Random {
+    std::uint32_t state_;
+    std::uint32_t operator()() {
+      state_ = state_ * 1664525u + 1013904223u;
+      return state_ >> 8;
+    }
+  };
+
+  template <typename A>
+  std::uint64_t processEvent(A const& iAllocator, std::uint32_t iSeed) {
+    using HitAllocator = typename std::allocator_traits<A>::template rebind_alloc<Hit>;
+    using HitPtrAllocator = typename std::allocator_traits<A>::template rebind_alloc<Hit const*>;
+    using CandidateAllocator = typename std::allocator_traits<A>::template rebind_alloc<Candidate>;
+    using Trajectory = std::vector<Hit const*, HitPtrAllocator>;
+    using TrajectoryAllocator = typename std::allocator_traits<A>::template rebind_alloc<Trajectory>;
+
+    Random random{iSeed};
+    std::vector<Hit, HitAllocator> hits{HitAllocator(iAllocator)};
+    unsigned int const nHits = 20000 + random() % 5000;
+    for (unsigned int i = 0; i < nHits; ++i) {
+      hits.push_back(Hit{float(random() % 1000), float(random() % 1000), float(random() % 1000), random() % 64});
+    }
+
+    std::uint64_t kept = 0;
+    std::list<Trajectory, TrajectoryAllocator> trajectories{TrajectoryAllocator(iAllocator)};
+    for (unsigned int seed = 0; seed < 2000; ++seed) {
+      std::list<Candidate, CandidateAllocator> candidates{CandidateAllocator(iAllocator)};
+      Trajectory trajectory{HitPtrAllocator(iAllocator)};
+      for (unsigned int layer = 0; layer < 12; ++layer) {
+        trajectory.push_back(&hits[random() % hits.size()]);
+        for (unsigned int c = 0; c < 4; ++c) {
+          candidates.push_back(Candidate{float(random() % 100), {0.f, 1.f, 2.f, 3.f, 4.f}});
+        }
+        candidates.remove_if([](Candidate const& iCandidate) { return iCandidate.chi2_ > 30.f; });
+      }
+      if (candidates.size() > 8) {
+        trajectories.push_back(std::move(trajectory));
+      }
+    }
+    for (auto const& trajectory : trajectories) {
+      kept += trajectory.size();
+    }
+    return kept;
+  }
+
+  template <typename F>
+  void run(std::string const& iName, unsigned int iThreads, unsigned int iEvents, F iProcessEvent) {
+    std::atomic<std::uint64_t> kept{0};
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < iThreads; ++t) {
+      threads.emplace_back([t, iEvents, &kept, &iProcessEvent]() {
+        edm::EventArena arena;
+        for (unsigned int e = 0; e < iEvents; ++e) {
+          kept += iProcessEvent(arena, t * iEvents + e);
+          arena.reset();
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    double seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    std::cout << iName << ": " << seconds / (double(iThreads) * iEvents) * 1000. << " ms per event, " << kept
+              << " hits kept" << std::endl;
+  }
+}  // namespace
+
+int main(int argc, char** argv) {
+  unsigned int nThreads = argc > 1 ? std::stoul(argv[1]) : 4;
+  unsigned int nEvents = argc > 2 ? std::stoul(argv[2]) : 100;
+
+  std::cout << nThreads << " threads each processing " << nEvents << " events" << std::endl;
+  run("system allocator", nThreads, nEvents, [](edm::EventArena&, std::uint32_t iSeed) {
+    return processEvent(std::allocator<char>(), iSeed);
+  });
+  run("event arena", nThreads, nEvents, [](edm::EventArena& iArena, std::uint32_t iSeed) {
+    return processEvent(edm::EventArenaAllocator<char>(iArena), iSeed);
+  });
+  return 0;
+}
@@ -52,6 +52,19 @@ namespace edmtest {
     edm::InputTag m_tag;
   };
 
+  class DeleteEarlyConsumesManyReader : public edm::EDAnalyzer {
+  public:
+    DeleteEarlyConsumesManyReader(edm::ParameterSet const&) { consumesMany<DeleteEarly>(); }
+
+    virtual void analyze(edm::Event const& e, edm::EventSetup const&) {
+      std::vector<edm::Handle<DeleteEarly>> handles;
+      e.getManyByType(handles);
+      if (handles.empty()) {
+        throw cms::Exception("DeleteEarlyError") << "No DeleteEarly product was found";
+      }
+    }
+  };
+
   class DeleteEarlyCheckDeleteAnalyzer : public edm::EDAnalyzer {
   public:
     DeleteEarlyCheckDeleteAnalyzer(edm::ParameterSet const& pset)
@@ -74,4 +87,5 @@ namespace edmtest {
 using namespace edmtest;
 DEFINE_FWK_MODULE(DeleteEarlyProducer);
 DEFINE_FWK_MODULE(DeleteEarlyReader);
+DEFINE_FWK_MODULE(DeleteEarlyConsumesManyReader);
 DEFINE_FWK_MODULE(DeleteEarlyCheckDeleteAnalyzer);
@@ -14,12 +14,17 @@ Toy EDAnalyzers for testing purposes only.
 #include "FWCore/Framework/interface/one/EDAnalyzer.h"
 #include "FWCore/Framework/interface/global/EDAnalyzer.h"
 #include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/EventArena.h"
 #include "FWCore/Framework/interface/MakerMacros.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/Utilities/interface/Exception.h"
 #include "FWCore/Utilities/interface/InputTag.h"
 //
+#include <atomic>
 #include <cassert>
+#include <chrono>
+#include <cstring>
+#include <iostream>
 #include <string>
 #include <vector>
 
@@ -95,6 +100,57 @@ namespace edmtest {
     std::vector<edm::EDGetTokenT<IntProduct>> m_tokens;
   };
 
+  //--------------------------------------------------------------------
+  //
+  // Measures the time spent in getByToken, as a module doing many gets
+  // per event sees it, and prints the average at the end of the job.
+  class GetByTokenBenchmarkAnalyzer : public edm::global::EDAnalyzer<> {
+  public:
+    GetByTokenBenchmarkAnalyzer(edm::ParameterSet const& iPSet)
+        : m_repeat(iPSet.getUntrackedParameter<unsigned int>("repeat")), m_gets(0), m_time(0) {
+      auto const& tags = iPSet.getUntrackedParameter<std::vector<edm::InputTag>>("getFromModules");
+      for (auto const& tag : tags) {
+        m_tokens.emplace_back(consumes<IntProduct>(tag));
+      }
+    }
+
+    void analyze(edm::StreamID, edm::Event const& iEvent, edm::EventSetup const&) const override {
+      int sum = 0;
+      auto start = std::chrono::steady_clock::now();
+      for (unsigned int i = 0; i < m_repeat; ++i) {
+        for (auto const& token : m_tokens) {
+          sum += iEvent.get(token).value;
+        }
+      }
+      std::chrono::nanoseconds time = std::chrono::steady_clock::now() - start;
+      if (sum == 0 and not m_tokens.empty() and m_repeat > 0) {
+        throw cms::Exception("ValueMissMatch") << "All the IntProducts read have the value 0";
+      }
+      m_gets += m_repeat * m_tokens.size();
+      m_time += time.count();
+    }
+
+    void endJob() override {
+      if (m_gets > 0) {
+        std::cout << "GetByTokenBenchmarkAnalyzer: " << m_gets << " gets, "
+                  << static_cast<double>(m_time) / static_cast<double>(m_gets) << " ns per get" << std::endl;
+      }
+    }
+
+    static void fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
+      edm::ParameterSetDescription desc;
+      desc.addUntracked<std::vector<edm::InputTag>>("getFromModules");
+      desc.addUntracked<unsigned int>("repeat", 100)->setComment("Number of times each product is read per event");
+      descriptions.addDefault(desc);
+    }
+
+  private:
+    std::vector<edm::EDGetTokenT<IntProduct>> m_tokens;
+    unsigned int const m_repeat;
+    mutable std::atomic<unsigned long long> m_gets;
+    mutable std::atomic<unsigned long long> m_time;  // ns
+  };
+
   //--------------------------------------------------------------------
   //
   class IntConsumingAnalyzer : public edm::global::EDAnalyzer<> {
@@ -151,6 +207,53 @@ namespace edmtest {
     edm::InputTag moduleLabel_;
   };
 
+  //--------------------------------------------------------------------
+  //
+  // Takes memory from the EventArena of its Stream for every Event and checks
+  // that the memory of the previous Event is used again: the capacity of the
+  // arena stops growing once the blocks of the first Event have been merged.
+  class EventArenaReuseAnalyzer : public edm::stream::EDAnalyzer<> {
+  public:
+    EventArenaReuseAnalyzer(edm::ParameterSet const& iPSet)
+        : bytesPerEvent_(iPSet.getUntrackedParameter<unsigned int>("bytesPerEvent")),
+          bytesPerAllocation_(iPSet.getUntrackedParameter<unsigned int>("bytesPerAllocation")) {}
+
+    void analyze(edm::Event const& iEvent, edm::EventSetup const&) {
+      edm::EventArena& arena = iEvent.arena();
+      void* first = nullptr;
+      for (unsigned int bytes = 0; bytes < bytesPerEvent_; bytes += bytesPerAllocation_) {
+        void* memory = arena.allocate(bytesPerAllocation_);
+        std::memset(memory, 0xff, bytesPerAllocation_);
+        if (first == nullptr) {
+          first = memory;
+        }
+      }
+      std::size_t capacity = arena.capacity();
+      //the first Event of the Stream may need several blocks, which are replaced by one after it
+      if (events_ >= 2) {
+        if (capacity != capacity_) {
+          throw cms::Exception("EventArenaNotReclaimed")
+              << "The capacity of the arena went from " << capacity_ << " to " << capacity << " bytes on Event "
+              << iEvent.id();
+        }
+        if (first != first_) {
+          throw cms::Exception("EventArenaNotReclaimed")
+              << "The memory of the previous Event was not used again on Event " << iEvent.id();
+        }
+      }
+      capacity_ = capacity;
+      first_ = first;
+      ++events_;
+    }
+
+  private:
+    unsigned int bytesPerEvent_;
+    unsigned int bytesPerAllocation_;
+    unsigned int events_ = 0;
+    std::size_t capacity_ = 0;
+    void const* first_ = nullptr;
+  };
+
   //--------------------------------------------------------------------
   //
   class ConsumingOneSharedResourceAnalyzer : public edm::one::EDAnalyzer<edm::one::SharedResources> {
@@ -276,6 +379,8 @@ namespace edmtest {
 using edmtest::ConsumingOneSharedResourceAnalyzer;
 using edmtest::ConsumingStreamAnalyzer;
 using edmtest::DSVAnalyzer;
+using edmtest::EventArenaReuseAnalyzer;
+using edmtest::GetByTokenBenchmarkAnalyzer;
 using edmtest::IntConsumingAnalyzer;
 using edmtest::IntTestAnalyzer;
 using edmtest::MultipleIntsAnalyzer;
@@ -284,9 +389,11 @@ using edmtest::SCSimpleAnalyzer;
 DEFINE_FWK_MODULE(NonAnalyzer);
 DEFINE_FWK_MODULE(IntTestAnalyzer);
 DEFINE_FWK_MODULE(MultipleIntsAnalyzer);
+DEFINE_FWK_MODULE(GetByTokenBenchmarkAnalyzer);
 DEFINE_FWK_MODULE(IntConsumingAnalyzer);
 DEFINE_FWK_MODULE(edmtest::IntFromRunConsumingAnalyzer);
 DEFINE_FWK_MODULE(ConsumingStreamAnalyzer);
 DEFINE_FWK_MODULE(ConsumingOneSharedResourceAnalyzer);
 DEFINE_FWK_MODULE(SCSimpleAnalyzer);
 DEFINE_FWK_MODULE(DSVAnalyzer);
+DEFINE_FWK_MODULE(EventArenaReuseAnalyzer);
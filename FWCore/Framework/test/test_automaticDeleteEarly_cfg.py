@@ -0,0 +1,35 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(3))
+
+process.options = cms.untracked.PSet(
+        deleteEarlyAutomatically = cms.untracked.bool(True))
+
+
+process.maker = cms.EDProducer("DeleteEarlyProducer")
+
+process.reader = cms.EDAnalyzer("DeleteEarlyReader",tag = cms.untracked.InputTag("maker") )
+
+# reads 'maker' through consumesMany after 'reader', so it fails if the product was deleted after 'reader'
+process.manyReader = cms.EDAnalyzer("DeleteEarlyConsumesManyReader")
+
+# reads 'maker' with the '@currentProcess' process name after all the other readers
+process.currentProcessReader = cms.EDAnalyzer("DeleteEarlyReader",
+                                              tag = cms.untracked.InputTag("maker", "", "@currentProcess"))
+
+process.tester = cms.EDAnalyzer("DeleteEarlyCheckDeleteAnalyzer",
+                                expectedValues = cms.untracked.vuint32(2,4,6))
+
+# 'viewReader' reads 'intvec' as a View after 'vectorReader' read it directly
+process.intvec = cms.EDProducer("IntVectorProducer", ivalue = cms.int32(1), count = cms.int32(10))
+
+process.vectorReader = cms.EDProducer("IntVecRefVectorProducer", target = cms.InputTag("intvec"))
+
+process.viewReader = cms.EDProducer("IntVecPtrVectorProducer", target = cms.InputTag("intvec"))
+
+process.p = cms.Path(process.maker+process.reader+process.manyReader+process.currentProcessReader+process.tester+
+                     process.intvec+process.vectorReader+process.viewReader)
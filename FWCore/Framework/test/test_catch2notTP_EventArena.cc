@@ -0,0 +1,95 @@
+#include "catch.hpp"
+
+#include "FWCore/Framework/interface/EventArena.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <list>
+#include <thread>
+#include <vector>
+
+TEST_CASE("test EventArena", "[EventArena]") {
+  SECTION("alignment") {
+    edm::EventArena arena;
+    arena.allocate(1, 1);
+    for (std::size_t alignment : {1, 2, 8, 16, 64, 4096}) {
+      auto address = reinterpret_cast<std::uintptr_t>(arena.allocate(3, alignment));
+      REQUIRE(address % alignment == 0);
+    }
+  }
+
+  SECTION("reset reuses the memory") {
+    edm::EventArena arena;
+    REQUIRE(arena.capacity() == 0);
+    void* first = arena.allocate(100);
+    arena.reset();
+    REQUIRE(arena.allocate(100) == first);
+
+    //needs several blocks
+    for (unsigned int i = 0; i < 1000; ++i) {
+      arena.allocate(1000);
+    }
+    auto capacity = arena.capacity();
+    REQUIRE(capacity >= 1000 * 1000);
+    arena.reset();
+    REQUIRE(arena.capacity() == capacity);
+    for (unsigned int i = 0; i < 1000; ++i) {
+      arena.allocate(1000);
+    }
+    REQUIRE(arena.capacity() == capacity);
+  }
+
+  SECTION("large allocations") {
+    edm::EventArena arena;
+    char* small = static_cast<char*>(arena.allocate(10));
+    char* large = static_cast<char*>(arena.allocate(10 * 1024 * 1024));
+    std::fill(large, large + 10 * 1024 * 1024, 1);
+    //the block of the small allocation is still used
+    char* small2 = static_cast<char*>(arena.allocate(10));
+    REQUIRE(small2 > small);
+    REQUIRE(small2 < small + 1024);
+  }
+
+  SECTION("concurrent allocations do not overlap") {
+    edm::EventArena arena;
+    constexpr unsigned int kThreads = 4;
+    constexpr unsigned int kAllocations = 10000;
+    std::vector<std::vector<std::uintptr_t>> addresses(kThreads);
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < kThreads; ++t) {
+      threads.emplace_back([&arena, &addresses, t]() {
+        for (unsigned int i = 0; i < kAllocations; ++i) {
+          addresses[t].push_back(reinterpret_cast<std::uintptr_t>(arena.allocate(24, 8)));
+        }
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    std::vector<std::uintptr_t> all;
+    for (auto const& a : addresses) {
+      all.insert(all.end(), a.begin(), a.end());
+    }
+    std::sort(all.begin(), all.end());
+    for (unsigned int i = 1; i < all.size(); ++i) {
+      REQUIRE(all[i] - all[i - 1] >= 24);
+    }
+  }
+
+  SECTION("allocator") {
+    edm::EventArena arena;
+    edm::EventArenaAllocator<int> allocator(arena);
+    std::vector<int, edm::EventArenaAllocator<int>> v(allocator);
+    for (int i = 0; i < 10000; ++i) {
+      v.push_back(i);
+    }
+    REQUIRE(v[9999] == 9999);
+    std::list<double, edm::EventArenaAllocator<double>> l(allocator);
+    l.push_back(1.);
+    REQUIRE(l.get_allocator() == allocator);
+    REQUIRE(arena.capacity() != 0);
+
+    edm::EventArena other;
+    REQUIRE(edm::EventArenaAllocator<int>(other) != allocator);
+  }
+}
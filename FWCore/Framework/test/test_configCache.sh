@@ -0,0 +1,51 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+WORK=configCache
+rm -rf $WORK
+mkdir $WORK || die "Failure creating $WORK" $?
+cp ${LOCAL_TEST_DIR}/test_configCache_cfg.py $WORK/
+echo "value = 1" > $WORK/configCacheHelper.py
+echo '{"1": [[1, 10]]}' > $WORK/configCacheMask.json
+export PYTHONPATH=${PWD}/$WORK:${PYTHONPATH}
+export CONFIG_CACHE_TEST=first
+
+# prints hit if the configuration was read from the cache, miss if python read it
+function run {
+  cmsRun --configCache $WORK/cache $WORK/test_configCache_cfg.py "$@" >& $WORK/log || die "Failure running cmsRun $*" $?
+  grep -q "python read the configuration" $WORK/log && echo miss || echo hit
+}
+
+# expect hit|miss when
+function expect {
+  local result=$(run "${@:3}")
+  [ "$result" = "$1" ] || die "Expected a cache $1 $2, got: $result" 1
+}
+
+expect miss "without a cache"
+[ -f $WORK/cache ] || die "No cache written" 1
+expect hit "with nothing changed"
+
+echo "value = 22" > $WORK/configCacheHelper.py
+expect miss "after a python module changed"
+expect hit "after the cache was rewritten"
+
+echo '{"1": [[1, 20]]}' > $WORK/configCacheMask.json
+expect miss "after the JSON file changed"
+expect hit "after the JSON file change was cached"
+
+export CONFIG_CACHE_TEST=second
+expect miss "after an environment variable changed"
+unset CONFIG_CACHE_TEST
+expect miss "after an environment variable was unset"
+expect hit "after the environment change was cached"
+
+expect miss "with another argument" extra
+
+echo "corrupt" > $WORK/cache
+expect miss "with a corrupt cache"
+expect hit "after the corrupt cache was rewritten"
+
+rm -rf $WORK
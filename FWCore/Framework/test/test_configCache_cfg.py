@@ -0,0 +1,28 @@
+# Used by test_configCache.sh. The configuration depends on a python module, a
+# JSON file and an environment variable. It prints "python read the configuration"
+# so the test can tell when the cache was not used.
+
+import FWCore.ParameterSet.Config as cms
+import json
+import os
+
+import configCacheHelper
+
+print("python read the configuration")
+
+with open(os.path.join(os.path.dirname(configCacheHelper.__file__), "configCacheMask.json")) as mask:
+    lumisToProcess = json.load(mask)
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(1)
+)
+
+process.inputs = cms.PSet(
+    value = cms.int32(configCacheHelper.value),
+    lumisToProcess = cms.string(json.dumps(lumisToProcess)),
+    environment = cms.string(os.environ.get("CONFIG_CACHE_TEST", ""))
+)
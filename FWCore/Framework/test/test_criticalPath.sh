@@ -0,0 +1,20 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/test_criticalPath_cfg.py
+
+cmsRun $F1 >& criticalPath.log || die "Failure using $F1" $?
+grep "CriticalPath Events total = 300" criticalPath.log || die "No critical path report" $?
+grep "CriticalPath .* slow$" criticalPath.log || die "slow is not on the critical path" $?
+grep "CriticalPath .* fast$" criticalPath.log && die "fast is on the critical path" 1
+
+# On a single thread the work requested last starts first. The first Event uses the order of the
+# consumes, which starts 'fast' first; the priorities computed after 100 Events start 'slow' first.
+cmsRun $F1 order >& criticalPathOrder.log || die "Failure using $F1 order" $?
+grep "starting: processing event for module: .* label = '\(fast\|slow\)'" criticalPathOrder.log > criticalPathStarts.log
+head -n 1 criticalPathStarts.log | grep "label = 'fast'" || die "fast does not start first without priorities" $?
+tail -n 2 criticalPathStarts.log | head -n 1 | grep "label = 'slow'" || die "slow does not start first with priorities" $?
+
+rm -f criticalPath.log criticalPathOrder.log criticalPathStarts.log
@@ -0,0 +1,40 @@
+import FWCore.ParameterSet.Config as cms
+import sys
+
+# with the 'order' argument the job runs on a single thread and traces the start of the modules,
+# whose order is then deterministic
+traceOrder = len(sys.argv) > 2 and sys.argv[2] == "order"
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(110 if traceOrder else 300)
+)
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(1 if traceOrder else 2),
+    numberOfStreams = cms.untracked.uint32(1 if traceOrder else 2),
+    prioritizeCriticalPath = cms.untracked.bool(True)
+)
+
+# 'sum' waits for a chain of two slow producers and for a fast one. It consumes the chain first so that,
+# until the priorities are computed, the fast producer is the first to run.
+process.fast = cms.EDProducer("BusyWaitIntProducer", ivalue = cms.int32(1), iterations = cms.uint32(10))
+process.slow = cms.EDProducer("BusyWaitIntProducer", ivalue = cms.int32(2), iterations = cms.uint32(200000))
+process.afterSlow = cms.EDProducer("AddIntsProducer", labels = cms.vstring("slow"))
+process.sum = cms.EDProducer("AddIntsProducer", labels = cms.vstring("afterSlow", "fast"))
+
+process.p = cms.Path(process.sum, cms.Task(process.fast, process.slow, process.afterSlow))
+
+if traceOrder:
+    process.Tracer = cms.Service("Tracer")
+    process.MessageLogger = cms.Service("MessageLogger",
+        destinations = cms.untracked.vstring("cout"),
+        categories = cms.untracked.vstring("Tracer"),
+        cout = cms.untracked.PSet(
+            default = cms.untracked.PSet(limit = cms.untracked.int32(0)),
+            Tracer = cms.untracked.PSet(limit = cms.untracked.int32(100000000))
+        )
+    )
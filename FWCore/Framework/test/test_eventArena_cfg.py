@@ -0,0 +1,20 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(20))
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(2),
+    numberOfStreams = cms.untracked.uint32(2)
+)
+
+# 4 MB per Event, more than the first block of the arena; without the reset between the Events the
+# arena of each Stream would keep growing
+process.arena = cms.EDAnalyzer("EventArenaReuseAnalyzer",
+                               bytesPerEvent = cms.untracked.uint32(4*1024*1024),
+                               bytesPerAllocation = cms.untracked.uint32(16*1024))
+
+process.p = cms.Path(process.arena)
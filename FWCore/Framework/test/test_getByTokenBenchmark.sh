@@ -0,0 +1,8 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/test_getByTokenBenchmark_cfg.py
+
+(cmsRun $F1 maxEvents=10 repeat=10) | grep "GetByTokenBenchmarkAnalyzer: 7500 gets" || die "Failure using $F1" $?
@@ -0,0 +1,41 @@
+# Measures the latency of Event::getByToken for a module reading many
+# products per event; GetByTokenBenchmarkAnalyzer prints the average time
+# per get at the end of the job.
+#
+# Usage: cmsRun test_getByTokenBenchmark_cfg.py [maxEvents=1000] [nProducts=50] [repeat=100]
+
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+options = VarParsing.VarParsing()
+options.register('maxEvents', 1000, VarParsing.VarParsing.multiplicity.singleton, VarParsing.VarParsing.varType.int,
+                 "Number of events")
+options.register('nProducts', 50, VarParsing.VarParsing.multiplicity.singleton, VarParsing.VarParsing.varType.int,
+                 "Number of products read by the analyzer")
+options.register('repeat', 100, VarParsing.VarParsing.multiplicity.singleton, VarParsing.VarParsing.varType.int,
+                 "Number of times each product is read per event")
+options.parseArguments()
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(options.maxEvents))
+
+process.t = cms.Task()
+tags = []
+for i in range(options.nProducts):
+    label = "int%d" % i
+    setattr(process, label, cms.EDProducer("IntProducer", ivalue = cms.int32(i + 1)))
+    process.t.add(getattr(process, label))
+    tags.append(cms.InputTag(label))
+
+# half of the gets name the process, as when reading from a given step
+for i in range(0, options.nProducts, 2):
+    tags.append(cms.InputTag(tags[i].getModuleLabel(), "", "TEST"))
+
+process.benchmark = cms.EDAnalyzer("GetByTokenBenchmarkAnalyzer",
+    getFromModules = cms.untracked.VInputTag(tags),
+    repeat = cms.untracked.uint32(options.repeat)
+)
+
+process.p = cms.Path(process.benchmark, process.t)
@@ -0,0 +1,29 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(3))
+
+process.options = cms.untracked.PSet(
+        canDeleteEarly = cms.untracked.vstring("edmtestDeleteEarly_maker__TEST"))
+
+
+process.maker = cms.EDProducer("DeleteEarlyProducer")
+
+process.reader = cms.EDAnalyzer("DeleteEarlyReader",
+                                tag = cms.untracked.InputTag("maker"),
+                                mightGet = cms.untracked.vstring("edmtestDeleteEarly_maker__TEST"))
+
+# the product is kept by the OutputModule so it must not be deleted early
+process.tester = cms.EDAnalyzer("DeleteEarlyCheckDeleteAnalyzer",
+                                expectedValues = cms.untracked.vuint32(1,3,5))
+
+process.out = cms.OutputModule("SewerModule",
+                               name = cms.string("keepMaker"),
+                               shouldPass = cms.int32(3),
+                               outputCommands = cms.untracked.vstring("drop *", "keep *_maker_*_*"))
+
+process.p = cms.Path(process.maker+process.reader+process.tester)
+process.e = cms.EndPath(process.out)
@@ -39,7 +39,11 @@ namespace edmtest {
     edm::ESGetToken<IOVTestInfo, ESTestRecordI> token_;
   };
 
-  ConcurrentIOVESProducer::ConcurrentIOVESProducer(edm::ParameterSet const&) {
+  ConcurrentIOVESProducer::ConcurrentIOVESProducer(edm::ParameterSet const& pset) {
+    //produce gets all its data through token_
+    if (pset.getUntrackedParameter<bool>("allowConcurrentCalls")) {
+      allowConcurrentCalls();
+    }
     //auto collector = setWhatProduced(this);
     auto collector = setWhatProduced(this, "fromESProducer");
     token_ = collector.consumes<IOVTestInfo>(edm::ESInputTag{"", ""});
@@ -63,6 +67,7 @@ namespace edmtest {
 
   void ConcurrentIOVESProducer::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
     edm::ParameterSetDescription desc;
+    desc.addUntracked<bool>("allowConcurrentCalls", false);
     descriptions.add("concurrentIOVESProducer", desc);
   }
 }  // namespace edmtest
@@ -30,4 +30,15 @@ cmsRun --parameter-set ${LOCAL_TEST_DIR}/testEventSetupRunLumi_cfg.py || die 'Fa
 echo testConcurrentIOVsESSource_cfg.py
 cmsRun --parameter-set ${LOCAL_TEST_DIR}/testConcurrentIOVsESSource_cfg.py || die 'Failed in testConcurrentIOVsESSource_cfg.py' $?
 
+echo testConcurrentESPrefetching_cfg.py
+# With one thread, the prefetched data is made before the analyzer starts processing the Event
+cmsRun ${LOCAL_TEST_DIR}/testConcurrentESPrefetching_cfg.py > testConcurrentESPrefetching.log 2>&1 || die 'Failed in testConcurrentESPrefetching_cfg.py' $?
+cmsRun ${LOCAL_TEST_DIR}/testConcurrentESPrefetching_cfg.py legacy > testConcurrentESPrefetchingLegacy.log 2>&1 || die 'Failed in testConcurrentESPrefetching_cfg.py legacy' $?
+madeBeforeProcessing() {
+  awk '/postEventSetupGet .*fromESProducer/ { print (processing ? "after" : "before"); exit }
+       /starting: processing event for module: stream = 0 label = .test./ { processing = 1 }' $1
+}
+[ "$(madeBeforeProcessing testConcurrentESPrefetching.log)" = "before" ] || die 'EventSetup data not prefetched' 1
+[ "$(madeBeforeProcessing testConcurrentESPrefetchingLegacy.log)" = "after" ] || die 'EventSetup data prefetched in legacy mode' 1
+
 popd
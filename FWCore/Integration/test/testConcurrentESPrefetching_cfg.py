@@ -0,0 +1,58 @@
+# Runs one stream with the concurrent prefetching of the EventSetup enabled.
+# The Tracer output shows whether the data the analyzer consumes from
+# ConcurrentIOVESProducer is made while the analyzer prefetches its inputs,
+# which eventSetupTest.sh checks. Pass "legacy" to disable the prefetching.
+
+import FWCore.ParameterSet.Config as cms
+import sys
+
+legacy = "legacy" in sys.argv
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource",
+    firstRun = cms.untracked.uint32(1),
+    firstLuminosityBlock = cms.untracked.uint32(1),
+    firstEvent = cms.untracked.uint32(1),
+    numberEventsInLuminosityBlock = cms.untracked.uint32(1),
+    numberEventsInRun = cms.untracked.uint32(100)
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(8)
+)
+
+process.options = dict(
+    numberOfThreads = 1,
+    numberOfStreams = 1,
+    eventSetup = dict(
+        concurrentPrefetching = not legacy
+    )
+)
+
+process.Tracer = cms.Service('Tracer',
+    dumpEventSetupInfo = cms.untracked.bool(True)
+)
+
+process.emptyESSourceI = cms.ESSource("EmptyESSource",
+    recordName = cms.string("ESTestRecordI"),
+    firstValid = cms.vuint32(1,100),
+    iovIsRunNotTime = cms.bool(True)
+)
+
+process.concurrentIOVESSource = cms.ESSource("ConcurrentIOVESSource",
+    iovIsRunNotTime = cms.bool(True),
+    firstValidLumis = cms.vuint32(1, 4, 6, 7, 8, 9),
+    invalidLumis = cms.vuint32(),
+    concurrentFinder = cms.bool(True)
+)
+
+process.concurrentIOVESProducer = cms.ESProducer("ConcurrentIOVESProducer",
+    allowConcurrentCalls = cms.untracked.bool(True)
+)
+
+process.test = cms.EDAnalyzer("ConcurrentIOVAnalyzer",
+                              checkExpectedValues = cms.untracked.bool(True)
+)
+
+process.p1 = cms.Path(process.test)
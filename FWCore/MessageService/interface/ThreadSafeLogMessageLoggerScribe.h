@@ -19,6 +19,9 @@
 
 #include <iostream>
 #include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
 #include "tbb/concurrent_queue.h"
 
 namespace edm {
@@ -30,6 +33,10 @@ namespace edm {
     //
     // OpCodeLOG_A_MESSAGE messages can be handled from multiple threads
     //
+    // With the asynchronous parameter set, a thread logging a message only
+    // appends it to a buffer of its own, and a separate thread routes the
+    // buffered messages, in the order they were created, to the destinations.
+    //
     // -----------------------------------------------------------------------
 
     class ELadministrator;
@@ -58,6 +65,18 @@ namespace edm {
 
       // --- log one consumed message
       void log(ErrorObj* errorobj_p);
+      // --- send one message to the destinations of each of its categories
+      void route(ErrorObj& errorobj);
+
+      // --- asynchronous logging
+      class ThreadBuffer;
+      ThreadBuffer& threadBuffer();
+      void startAsynchronousLogging();
+      void stopAsynchronousLogging();
+      // must be called with m_drainMutex held, returns false if there was nothing to route
+      bool drainThreadBuffers();
+      // --- block until the full buffer has room again
+      void waitForSpace(ThreadBuffer& buffer);
 
       // --- cause statistics destinations to output
       void triggerStatisticsSummaries();
@@ -107,6 +126,19 @@ namespace edm {
       tbb::concurrent_queue<ErrorObj*> m_waitingMessages;
       size_t m_waitingThreshold;
       std::atomic<unsigned long> m_tooManyWaitingMessagesCount;
+      std::atomic<bool> m_asynchronous;
+      unsigned int m_threadBufferSize;
+      unsigned int const m_id;
+      std::mutex m_threadBuffersMutex;
+      std::vector<std::shared_ptr<ThreadBuffer>> m_threadBuffers;
+      std::mutex m_drainMutex;
+      std::vector<ErrorObj*> m_drainerMessages;
+      std::mutex m_wakeUpMutex;
+      std::condition_variable m_wakeUp;
+      std::condition_variable m_spaceAvailable;
+      bool m_drainRequested;
+      bool m_stopDraining;
+      std::thread m_drainingThread;
 
     };  // ThreadSafeLogMessageLoggerScribe
 
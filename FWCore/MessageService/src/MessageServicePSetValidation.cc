@@ -54,11 +54,13 @@ namespace edm {
       // General Parameters
 
       check<bool>(pset, "MessageLogger", "messageSummaryToJobReport");
+      check<bool>(pset, "MessageLogger", "asynchronous");
       std::string dumps = check<std::string>(pset, "MessageLogger", "generate_preconfiguration_message");
       std::string thresh = check<std::string>(pset, "MessageLogger", "threshold");
       if (!thresh.empty())
         validateThreshold(thresh, "MessageLogger");
       check<unsigned int>(pset, "MessageLogger", "waiting_threshold");
+      check<unsigned int>(pset, "MessageLogger", "asynchronous_buffer_size");
 
       // Nested PSets
 
@@ -75,8 +77,9 @@ namespace edm {
       // Nothing else -- look for int, unsigned int, bool, float, double, string
 
       noneExcept<int>(pset, "MessageLogger", "int");
-      noneExcept<unsigned int>(pset, "MessageLogger", "unsigned int", "waiting_threshold");
-      noneExcept<bool>(pset, "MessageLogger", "bool", "messageSummaryToJobReport");
+      noneExcept<unsigned int>(
+          pset, "MessageLogger", "unsigned int", vString{"waiting_threshold", "asynchronous_buffer_size"});
+      noneExcept<bool>(pset, "MessageLogger", "bool", vString{"messageSummaryToJobReport", "asynchronous"});
       // Note - at this, the upper MessageLogger PSet level, the use of
       // optionalPSet makes no sense, so we are OK letting that be a flaw
       noneExcept<float>(pset, "MessageLogger", "float");
@@ -26,6 +26,7 @@
 
 #include <algorithm>
 #include <cassert>
+#include <chrono>
 #include <fstream>
 #include <string>
 #include <csignal>
@@ -35,6 +36,114 @@ using std::cerr;
 namespace edm {
   namespace service {
 
+    namespace {
+      // Single producer, single consumer ring of messages
+      class MessageRing {
+      public:
+        explicit MessageRing(unsigned int iSize) : messages_(iSize, nullptr), head_(0), tail_(0) {}
+
+        bool push(ErrorObj* iMessage) {
+          auto tail = tail_.load(std::memory_order_relaxed);
+          if (tail - head_.load(std::memory_order_acquire) == messages_.size()) {
+            return false;
+          }
+          messages_[tail % messages_.size()] = iMessage;
+          tail_.store(tail + 1, std::memory_order_release);
+          return true;
+        }
+
+        bool full() const {
+          return tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_acquire) == messages_.size();
+        }
+
+        template <typename F>
+        void popAll(F iFunc) {
+          auto head = head_.load(std::memory_order_relaxed);
+          auto tail = tail_.load(std::memory_order_acquire);
+          for (; head != tail; ++head) {
+            iFunc(messages_[head % messages_.size()]);
+          }
+          head_.store(tail, std::memory_order_release);
+        }
+
+      private:
+        std::vector<ErrorObj*> messages_;
+        //kept apart so the producer and the consumer do not share a cache line
+        alignas(64) std::atomic<unsigned long> head_;
+        alignas(64) std::atomic<unsigned long> tail_;
+      };
+
+      std::atomic<unsigned int> s_nextScribeID{0};
+
+      struct ThreadBufferOwner {
+        unsigned int scribeID = 0;
+        std::shared_ptr<void> buffer;
+      };
+      thread_local ThreadBufferOwner t_threadBuffer;
+
+      //set while the thread holds m_drainMutex
+      thread_local bool t_draining = false;
+
+      // Holds m_drainMutex. A message the same thread logs meanwhile, e.g. while
+      // configuring, waits in m_drainerMessages rather than in the thread's buffer,
+      // which could be full with no other thread able to empty it.
+      class DrainGuard {
+      public:
+        explicit DrainGuard(std::mutex& iMutex) : guard_(iMutex) { t_draining = true; }
+        ~DrainGuard() { t_draining = false; }
+
+      private:
+        std::lock_guard<std::mutex> guard_;
+      };
+
+      //how long the draining thread sleeps when no buffer is full; the period doubles
+      //each time a pass finds nothing to route so an idle job is not woken up needlessly
+      constexpr std::chrono::milliseconds kMinDrainPeriod{2};
+      constexpr std::chrono::milliseconds kMaxDrainPeriod{256};
+
+      template <typename F>
+      void catchLogExceptions(std::atomic<int>& count, std::atomic<bool>& purge_mode, F iLog) {
+        try {
+          iLog();
+        } catch (cms::Exception& e) {
+          ++count;
+          std::cerr << "ThreadSafeLogMessageLoggerScribe caught " << count << " cms::Exceptions, text = \n"
+                    << e.what() << "\n";
+
+          if (count > 25) {
+            cerr << "MessageLogger will no longer be processing "
+                 << "messages due to errors (entering purge mode).\n";
+            purge_mode = true;
+          }
+        } catch (...) {
+          std::cerr << "ThreadSafeLogMessageLoggerScribe caught an unknown exception and "
+                    << "will no longer be processing "
+                    << "messages. (entering purge mode)\n";
+          purge_mode = true;
+        }
+      }
+    }  // namespace
+
+    // The messages logged by one thread. The thread puts them in logged_ and
+    // whoever holds m_drainMutex takes them out. Once routed they are handed
+    // back through routed_, so the memory is freed by the thread which
+    // allocated it rather than by the draining thread.
+    class ThreadSafeLogMessageLoggerScribe::ThreadBuffer {
+    public:
+      explicit ThreadBuffer(unsigned int iSize) : logged_(iSize), routed_(iSize) {}
+      ~ThreadBuffer() {
+        logged_.popAll([](ErrorObj* iMessage) { delete iMessage; });
+        freeRouted();
+      }
+
+      void freeRouted() {
+        routed_.popAll([](ErrorObj* iMessage) { delete iMessage; });
+      }
+
+      MessageRing logged_;
+      MessageRing routed_;
+    };
+
     ThreadSafeLogMessageLoggerScribe::ThreadSafeLogMessageLoggerScribe()
         : admin_p(new ELadministrator()),
           early_dest(admin_p->attach(std::make_shared<ELoutput>(std::cerr, false))),
@@ -48,20 +157,21 @@ namespace edm {
           ,
           m_messageBeingSent(false),
           m_waitingThreshold(100),
-          m_tooManyWaitingMessagesCount(0) {}
+          m_tooManyWaitingMessagesCount(0),
+          m_asynchronous(false),
+          m_threadBufferSize(1024),
+          m_id(++s_nextScribeID),
+          m_drainRequested(false),
+          m_stopDraining(false) {}
 
     ThreadSafeLogMessageLoggerScribe::~ThreadSafeLogMessageLoggerScribe() {
+      stopAsynchronousLogging();
+
       //if there are any waiting message, finish them off
       ErrorObj* errorobj_p = nullptr;
-      std::vector<std::string> categories;
       while (m_waitingMessages.try_pop(errorobj_p)) {
         if (not purge_mode) {
-          categories.clear();
-          parseCategories(errorobj_p->xid().id, categories);
-          for (unsigned int icat = 0; icat < categories.size(); ++icat) {
-            errorobj_p->setID(categories[icat]);
-            admin_p->log(*errorobj_p);  // route the message text
-          }
+          route(*errorobj_p);
         }
         delete errorobj_p;
       }
@@ -82,37 +192,53 @@ namespace edm {
         }
         case MessageLoggerQ::LOG_A_MESSAGE: {
           ErrorObj* errorobj_p = static_cast<ErrorObj*>(operand);
-          try {
-            if (active && !purge_mode) {
-              log(errorobj_p);
+          if (m_asynchronous.load()) {
+            if (t_draining) {
+              m_drainerMessages.push_back(errorobj_p);
+              break;
             }
-          } catch (cms::Exception& e) {
-            ++count;
-            std::cerr << "ThreadSafeLogMessageLoggerScribe caught " << count << " cms::Exceptions, text = \n"
-                      << e.what() << "\n";
-
-            if (count > 25) {
-              cerr << "MessageLogger will no longer be processing "
-                   << "messages due to errors (entering purge mode).\n";
-              purge_mode = true;
+            ThreadBuffer& buffer = threadBuffer();
+            buffer.freeRouted();
+            while (not buffer.logged_.push(errorobj_p)) {
+              waitForSpace(buffer);
             }
-          } catch (...) {
-            std::cerr << "ThreadSafeLogMessageLoggerScribe caught an unknown exception and "
-                      << "will no longer be processing "
-                      << "messages. (entering purge mode)\n";
-            purge_mode = true;
+            //pairs with the fence in stopAsynchronousLogging: either the final drain
+            // there sees the message or this thread sees the logging is synchronous again
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (not m_asynchronous.load()) {
+              DrainGuard guard(m_drainMutex);
+              drainThreadBuffers();
+            }
+            break;
           }
+          catchLogExceptions(count, purge_mode, [this, errorobj_p]() {
+            if (active && !purge_mode) {
+              log(errorobj_p);
+            }
+          });
           break;
         }
         case MessageLoggerQ::CONFIGURE: {  // changelog 17
-          job_pset_p =
-              std::shared_ptr<PSet>(static_cast<PSet*>(operand));  // propagate_const<T> has no reset() function
-          configure_errorlog();
+          {
+            //a reconfiguration must not change the destinations under the draining thread
+            DrainGuard guard(m_drainMutex);
+            job_pset_p =
+                std::shared_ptr<PSet>(static_cast<PSet*>(operand));  // propagate_const<T> has no reset() function
+            configure_errorlog();
+          }
+          //the draining thread takes m_drainMutex, so it is started and stopped without it
+          if (getAparameter<bool>(*job_pset_p, "asynchronous", false)) {
+            startAsynchronousLogging();
+          } else {
+            stopAsynchronousLogging();
+          }
           break;
         }
         case MessageLoggerQ::SUMMARIZE: {
           assert(operand == nullptr);
           try {
+            DrainGuard guard(m_drainMutex);
+            drainThreadBuffers();
             triggerStatisticsSummaries();
           } catch (cms::Exception& e) {
             std::cerr << "ThreadSafeLogMessageLoggerScribe caught exception "
@@ -137,10 +263,22 @@ namespace edm {
         }
         case MessageLoggerQ::SHUT_UP: {
           assert(operand == nullptr);
+          {
+            //the buffered messages, e.g. the reason for halting, are still written
+            DrainGuard guard(m_drainMutex);
+            drainThreadBuffers();
+          }
           active = false;
           break;
         }
         case MessageLoggerQ::FLUSH_LOG_Q: {  // changelog 26
+          //only the asynchronous mode buffers messages; a thread already routing
+          //messages holds m_drainMutex
+          if (t_draining or not m_asynchronous.load()) {
+            break;
+          }
+          DrainGuard guard(m_drainMutex);
+          drainThreadBuffers();
           break;
         }
         case MessageLoggerQ::GROUP_STATS: {  // change log 27
@@ -151,6 +289,8 @@ namespace edm {
         }
         case MessageLoggerQ::FJR_SUMMARY: {  // changelog 29
           std::map<std::string, double>* smp = static_cast<std::map<std::string, double>*>(operand);
+          DrainGuard guard(m_drainMutex);
+          drainThreadBuffers();
           triggerFJRmessageSummary(*smp);
           break;
         }
@@ -162,22 +302,12 @@ namespace edm {
       bool expected = false;
       std::unique_ptr<ErrorObj> obj(errorobj_p);
       if (m_messageBeingSent.compare_exchange_strong(expected, true)) {
-        std::vector<std::string> categories;
-        parseCategories(errorobj_p->xid().id, categories);
-        for (unsigned int icat = 0; icat < categories.size(); ++icat) {
-          errorobj_p->setID(categories[icat]);
-          admin_p->log(*errorobj_p);  // route the message text
-        }
+        route(*errorobj_p);
         //process any waiting messages
         errorobj_p = nullptr;
         while (not purge_mode and m_waitingMessages.try_pop(errorobj_p)) {
           obj.reset(errorobj_p);
-          categories.clear();
-          parseCategories(errorobj_p->xid().id, categories);
-          for (unsigned int icat = 0; icat < categories.size(); ++icat) {
-            errorobj_p->setID(categories[icat]);
-            admin_p->log(*errorobj_p);  // route the message text
-          }
+          route(*errorobj_p);
         }
         m_messageBeingSent.store(false);
       } else {
@@ -190,6 +320,122 @@ namespace edm {
       }
     }
 
+    void ThreadSafeLogMessageLoggerScribe::route(ErrorObj& errorobj) {
+      std::vector<std::string> categories;
+      parseCategories(errorobj.xid().id, categories);
+      for (unsigned int icat = 0; icat < categories.size(); ++icat) {
+        errorobj.setID(categories[icat]);
+        admin_p->log(errorobj);  // route the message text
+      }
+    }
+
+    ThreadSafeLogMessageLoggerScribe::ThreadBuffer& ThreadSafeLogMessageLoggerScribe::threadBuffer() {
+      if (t_threadBuffer.scribeID != m_id) {
+        auto buffer = std::make_shared<ThreadBuffer>(m_threadBufferSize);
+        {
+          std::lock_guard<std::mutex> guard(m_threadBuffersMutex);
+          m_threadBuffers.push_back(buffer);
+        }
+        t_threadBuffer.scribeID = m_id;
+        t_threadBuffer.buffer = buffer;
+      }
+      return *static_cast<ThreadBuffer*>(t_threadBuffer.buffer.get());
+    }
+
+    bool ThreadSafeLogMessageLoggerScribe::drainThreadBuffers() {
+      std::vector<std::pair<ErrorObj*, ThreadBuffer*>> messages;
+      {
+        std::lock_guard<std::mutex> guard(m_threadBuffersMutex);
+        for (auto& buffer : m_threadBuffers) {
+          buffer->logged_.popAll(
+              [&messages, &buffer](ErrorObj* iMessage) { messages.emplace_back(iMessage, buffer.get()); });
+        }
+      }
+      for (auto message : m_drainerMessages) {
+        messages.emplace_back(message, nullptr);
+      }
+      m_drainerMessages.clear();
+      if (messages.empty()) {
+        return false;
+      }
+      {
+        //wake up the threads waiting for room in their buffer
+        std::lock_guard<std::mutex> guard(m_wakeUpMutex);
+        m_spaceAvailable.notify_all();
+      }
+      //messages from different threads are interleaved as they were created
+      std::sort(messages.begin(), messages.end(), [](auto const& iLHS, auto const& iRHS) {
+        return iLHS.first->serial() < iRHS.first->serial();
+      });
+      for (auto const& message : messages) {
+        catchLogExceptions(count, purge_mode, [this, &message]() {
+          if (active && !purge_mode) {
+            route(*message.first);
+          }
+        });
+        if (message.second == nullptr or not message.second->routed_.push(message.first)) {
+          delete message.first;
+        }
+      }
+      return true;
+    }
+
+    void ThreadSafeLogMessageLoggerScribe::waitForSpace(ThreadBuffer& buffer) {
+      std::unique_lock<std::mutex> lock(m_wakeUpMutex);
+      m_drainRequested = true;
+      m_wakeUp.notify_one();
+      m_spaceAvailable.wait(lock, [this, &buffer]() { return not buffer.logged_.full() or not m_asynchronous; });
+      if (buffer.logged_.full()) {
+        //there is no draining thread any more
+        lock.unlock();
+        DrainGuard guard(m_drainMutex);
+        drainThreadBuffers();
+      }
+    }
+
+    void ThreadSafeLogMessageLoggerScribe::startAsynchronousLogging() {
+      if (m_drainingThread.joinable()) {
+        return;
+      }
+      m_stopDraining = false;
+      m_drainingThread = std::thread([this]() {
+        std::unique_lock<std::mutex> lock(m_wakeUpMutex);
+        auto period = kMinDrainPeriod;
+        while (not m_stopDraining) {
+          lock.unlock();
+          bool routed;
+          {
+            DrainGuard guard(m_drainMutex);
+            routed = drainThreadBuffers();
+          }
+          period = routed ? kMinDrainPeriod : std::min(2 * period, kMaxDrainPeriod);
+          lock.lock();
+          m_wakeUp.wait_for(lock, period, [this]() { return m_stopDraining or m_drainRequested; });
+          m_drainRequested = false;
+        }
+      });
+      m_asynchronous.store(true);
+    }
+
+    void ThreadSafeLogMessageLoggerScribe::stopAsynchronousLogging() {
+      if (not m_drainingThread.joinable()) {
+        return;
+      }
+      {
+        std::lock_guard<std::mutex> guard(m_wakeUpMutex);
+        m_asynchronous.store(false);
+        m_stopDraining = true;
+      }
+      //pairs with the fence after a message is put in a thread's buffer
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      m_wakeUp.notify_one();
+      m_spaceAvailable.notify_all();
+      m_drainingThread.join();
+      //messages buffered after the last pass of the draining thread
+      DrainGuard guard(m_drainMutex);
+      drainThreadBuffers();
+    }
+
     void ThreadSafeLogMessageLoggerScribe::configure_errorlog() {
       vString empty_vString;
       String empty_String;
@@ -212,6 +458,7 @@ namespace edm {
         clean_slate_configuration = false;  // Change Log 22
       }
       m_waitingThreshold = getAparameter<unsigned int>(*job_pset_p, "waiting_threshold", 100);
+      m_threadBufferSize = std::max(1u, getAparameter<unsigned int>(*job_pset_p, "asynchronous_buffer_size", 1024));
       configure_ordinary_destinations();  // Change Log 16
       configure_statistics();             // Change Log 16
     }                                     // ThreadSafeLogMessageLoggerScribe::configure_errorlog()
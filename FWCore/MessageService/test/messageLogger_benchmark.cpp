@@ -0,0 +1,94 @@
+// Times the cost of a LogInfo to the thread issuing it, with the messages
+// routed to the destination by that thread and with the asynchronous
+// logging, where a separate thread does the routing. The time until the
+// messages have all been written is given as well.
+//
+//   messageLoggerBenchmark [threads] [messages per thread]
+//
+// The messages go to messageLoggerBenchmark_synchronous.log and
+// messageLoggerBenchmark_asynchronous.log.
+
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/MessageLogger/interface/MessageLoggerQ.h"
+#include "FWCore/MessageService/interface/ThreadSafeLogMessageLoggerScribe.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  double secondsSince(Clock::time_point iStart) {
+    return std::chrono::duration<double>(Clock::now() - iStart).count();
+  }
+
+  void run(bool iAsynchronous, unsigned int iThreads, unsigned int iMessages) {
+    std::string const name =
+        std::string("messageLoggerBenchmark_") + (iAsynchronous ? "asynchronous" : "synchronous");
+
+    auto scribe = std::make_shared<edm::service::ThreadSafeLogMessageLoggerScribe>();
+    edm::MessageLoggerQ::setMLscribe_ptr(scribe);
+    //the scribe takes ownership of the operands
+    scribe->runCommand(edm::MessageLoggerQ::JOBMODE, new std::string("grid"));
+    auto pset = std::make_unique<edm::ParameterSet>();
+    pset->addUntrackedParameter<std::vector<std::string>>("destinations", std::vector<std::string>(1, name));
+    pset->addUntrackedParameter<std::vector<std::string>>("categories", std::vector<std::string>(1, "Benchmark"));
+    edm::ParameterSet destination;
+    destination.addUntrackedParameter<std::string>("threshold", "INFO");
+    edm::ParameterSet unlimited;
+    unlimited.addUntrackedParameter<int>("limit", -1);
+    destination.addUntrackedParameter<edm::ParameterSet>("default", unlimited);
+    destination.addUntrackedParameter<edm::ParameterSet>("Benchmark", unlimited);
+    pset->addUntrackedParameter<edm::ParameterSet>(name, destination);
+    pset->addUntrackedParameter<bool>("asynchronous", iAsynchronous);
+    scribe->runCommand(edm::MessageLoggerQ::CONFIGURE, pset.release());
+
+    std::atomic<long long> hotPathNanoseconds{0};
+    auto start = Clock::now();
+    std::vector<std::thread> threads;
+    for (unsigned int t = 0; t < iThreads; ++t) {
+      threads.emplace_back([t, iMessages, &hotPathNanoseconds]() {
+        auto threadStart = Clock::now();
+        for (unsigned int i = 0; i < iMessages; ++i) {
+          edm::LogInfo("Benchmark") << "message " << i << " from thread " << t << " value " << 0.5 * i;
+        }
+        hotPathNanoseconds +=
+            std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now() - threadStart).count();
+      });
+    }
+    for (auto& thread : threads) {
+      thread.join();
+    }
+    double loggedTime = secondsSince(start);
+    scribe->runCommand(edm::MessageLoggerQ::FLUSH_LOG_Q, nullptr);
+    double writtenTime = secondsSince(start);
+
+    edm::MessageLoggerQ::setMLscribe_ptr(std::shared_ptr<edm::service::AbstractMLscribe>());
+    scribe.reset();
+
+    double messages = double(iThreads) * iMessages;
+    std::cout << (iAsynchronous ? "asynchronous" : "synchronous") << ": " << hotPathNanoseconds / messages
+              << " ns per message in the logging thread, all logged after " << loggedTime << " s, written after "
+              << writtenTime << " s" << std::endl;
+  }
+}  // namespace
+
+int main(int argc, char** argv) try {
+  unsigned int nThreads = argc > 1 ? std::stoul(argv[1]) : 4;
+  unsigned int nMessages = argc > 2 ? std::stoul(argv[2]) : 100000;
+
+  std::cout << nThreads << " threads each logging " << nMessages << " messages" << std::endl;
+  run(false, nThreads, nMessages);
+  run(true, nThreads, nMessages);
+  return 0;
+} catch (cms::Exception const& e) {
+  std::cerr << e.explainSelf() << std::endl;
+  return 1;
+}
@@ -0,0 +1,47 @@
+#!/bin/bash
+
+#sed on Linux and OS X have different command line options
+case `uname` in Darwin) SED_OPT="-i '' -E";;*) SED_OPT="-i -r";; esac ;
+
+pushd $LOCAL_TMP_DIR
+
+status=0
+
+for mode in synchronous asynchronous
+do
+  rm -f u37_messages.log u37_statistics.log u37_${mode}_messages.log u37_${mode}_statistics.log
+
+  cmsRun $LOCAL_TEST_DIR/u37_cfg.py $mode || exit $?
+
+  for file in u37_messages.log u37_statistics.log
+  do
+    sed $SED_OPT -f $LOCAL_TEST_DIR/filter-timestamps.sed $file
+    mv $file ${file/u37_/u37_${mode}_}
+  done
+done
+
+# same messages, in the same order, and the same summaries
+for file in messages.log statistics.log
+do
+  diff u37_synchronous_$file u37_asynchronous_$file
+  if [ $? -ne 0 ]
+  then
+    echo The above discrepancies concern u37_$file
+    status=1
+  fi
+done
+
+# the statistics summaries were written, and include the messages logged just before them
+for total in 4 9 15
+do
+  grep -q "^Error *$total *$total\$" u37_asynchronous_statistics.log
+  if [ $? -ne 0 ]
+  then
+    echo u37_asynchronous_statistics.log lacks a summary with $total errors
+    status=1
+  fi
+done
+
+popd
+
+exit $status
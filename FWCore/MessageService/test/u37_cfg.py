@@ -0,0 +1,49 @@
+# Unit test configuration file for MessageLogger service:
+# asynchronous logging: run once with the argument 'asynchronous' and once
+# without, the destinations and the statistics must be identical.
+# The per-thread buffer holds only two messages, so the logging thread
+# also has to wait for the draining thread.
+
+import sys
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+import FWCore.Framework.test.cmsExceptionsFatal_cff
+process.options = FWCore.Framework.test.cmsExceptionsFatal_cff.options
+
+process.load("FWCore.MessageService.test.Services_cff")
+
+process.MessageLogger = cms.Service("MessageLogger",
+    asynchronous = cms.untracked.bool('asynchronous' in sys.argv),
+    asynchronous_buffer_size = cms.untracked.uint32(2),
+    u37_messages = cms.untracked.PSet(
+        threshold = cms.untracked.string('DEBUG'),
+        noTimeStamps = cms.untracked.bool(True),
+        FwkJob = cms.untracked.PSet(
+            limit = cms.untracked.int32(0)
+        ),
+        preEventProcessing = cms.untracked.PSet(
+            limit = cms.untracked.int32(0)
+        )
+    ),
+    u37_statistics = cms.untracked.PSet(
+        reset = cms.untracked.bool(False)
+    ),
+    statistics = cms.untracked.vstring('u37_statistics'),
+    debugModules = cms.untracked.vstring('*'),
+    categories = cms.untracked.vstring('preEventProcessing', 
+        'FwkJob'),
+    destinations = cms.untracked.vstring('u37_messages')
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(3)
+)
+
+process.source = cms.Source("EmptySource")
+
+process.sendSomeMessages = cms.EDAnalyzer("UnitTestClient_A")
+process.sendStatistics = cms.EDAnalyzer("UnitTestClient_B")
+
+process.p = cms.Path(process.sendSomeMessages*process.sendStatistics)
@@ -178,13 +178,25 @@ namespace edm {
     friend std::ostream& operator<<(std::ostream& ost, Entry const& entry);
 
   private:
+    // the decoded value of a parameter of a scalar type, so that it is not
+    // decoded again from rep each time it is read
+    union Scalar {
+      bool b;
+      int i32;
+      unsigned u32;
+      long long i64;
+      unsigned long long u64;
+      double d;
+    };
+
     std::string name_;
     std::string rep;
     char type;
     char tracked;
+    Scalar value_ = {};
 
-    // verify class invariant
-    void validate() const;
+    // verify class invariant, and decode the value of a scalar
+    void validate();
 
     // decode
     bool fromString(std::string::const_iterator b, std::string::const_iterator e);
@@ -15,6 +15,7 @@
 #include "FWCore/ParameterSet/interface/Entry.h"
 #include "FWCore/ParameterSet/interface/FileInPath.h"
 #include "FWCore/ParameterSet/interface/ParameterSetEntry.h"
+#include "FWCore/ParameterSet/interface/ParameterSetTable.h"
 #include "FWCore/ParameterSet/interface/VParameterSetEntry.h"
 
 #include <iosfwd>
@@ -218,13 +219,13 @@ namespace edm {
 
     std::vector<ParameterSet> popVParameterSet(std::string const& name);
 
-    typedef std::map<std::string, Entry> table;
+    typedef ParameterSetTable<Entry> table;
     table const& tbl() const { return tbl_; }
 
-    typedef std::map<std::string, ParameterSetEntry> psettable;
+    typedef ParameterSetTable<ParameterSetEntry> psettable;
     psettable const& psetTable() const { return psetTable_; }
 
-    typedef std::map<std::string, VParameterSetEntry> vpsettable;
+    typedef ParameterSetTable<VParameterSetEntry> vpsettable;
     vpsettable const& vpsetTable() const { return vpsetTable_; }
 
     ParameterSet* getPSetForUpdate(std::string const& name, bool& isTracked);
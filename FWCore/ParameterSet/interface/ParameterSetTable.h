@@ -0,0 +1,99 @@
+#ifndef FWCore_ParameterSet_ParameterSetTable_h
+#define FWCore_ParameterSet_ParameterSetTable_h
+// -*- C++ -*-
+//
+// Package:     FWCore/ParameterSet
+// Class  :     ParameterSetTable
+//
+/**\class edm::ParameterSetTable ParameterSetTable.h "FWCore/ParameterSet/interface/ParameterSetTable.h"
+
+ Description: Storage of the parameters of a ParameterSet, kept sorted by name
+
+ Usage:
+    Has the part of the std::map interface used with the tables of a
+ ParameterSet, and iterates over the parameters in the same order as a
+ std::map<std::string, T> would, so the string encoding and the
+ ParameterSetID do not depend on the storage. The parameters are held in
+ one contiguous vector, which makes a lookup a binary search over adjacent
+ memory and a copy of a ParameterSet a few allocations instead of one per
+ parameter.
+
+    Unlike a std::map, inserting or erasing a parameter invalidates the
+ iterators and the pointers to the other parameters of the same table.
+
+*/
+
+// system include files
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// user include files
+
+// forward declarations
+
+namespace edm {
+  template <typename T>
+  class ParameterSetTable {
+  public:
+    typedef std::pair<std::string, T> value_type;
+    typedef typename std::vector<value_type>::iterator iterator;
+    typedef typename std::vector<value_type>::const_iterator const_iterator;
+    typedef typename std::vector<value_type>::size_type size_type;
+
+    // ---------- const member functions ---------------------
+    const_iterator begin() const { return entries_.begin(); }
+    const_iterator end() const { return entries_.end(); }
+    size_type size() const { return entries_.size(); }
+    bool empty() const { return entries_.empty(); }
+
+    const_iterator find(std::string_view iName) const {
+      auto it = lowerBound(entries_, iName);
+      return (it != entries_.end() and it->first == iName) ? it : entries_.end();
+    }
+
+    // ---------- member functions ---------------------------
+    iterator begin() { return entries_.begin(); }
+    iterator end() { return entries_.end(); }
+
+    iterator find(std::string_view iName) {
+      auto it = lowerBound(entries_, iName);
+      return (it != entries_.end() and it->first == iName) ? it : entries_.end();
+    }
+
+    ///does not replace an existing parameter with the same name, as std::map::insert
+    std::pair<iterator, bool> insert(value_type iValue) {
+      //parameters often come already sorted, e.g. when copied or decoded
+      if (entries_.empty() or entries_.back().first < iValue.first) {
+        entries_.push_back(std::move(iValue));
+        return std::make_pair(entries_.end() - 1, true);
+      }
+      auto it = lowerBound(entries_, iValue.first);
+      if (it->first == iValue.first) {
+        return std::make_pair(it, false);
+      }
+      return std::make_pair(entries_.insert(it, std::move(iValue)), true);
+    }
+
+    iterator erase(const_iterator iIt) { return entries_.erase(iIt); }
+
+    void clear() { entries_.clear(); }
+    void swap(ParameterSetTable& iOther) { entries_.swap(iOther.entries_); }
+
+  private:
+    template <typename V>
+    static auto lowerBound(V& iEntries, std::string_view iName) {
+      return std::lower_bound(
+          iEntries.begin(), iEntries.end(), iName, [](value_type const& iEntry, std::string_view iN) {
+            return std::string_view(iEntry.first) < iN;
+          });
+    }
+
+    // ---------- member data --------------------------------
+    std::vector<value_type> entries_;
+  };
+}  // namespace edm
+
+#endif
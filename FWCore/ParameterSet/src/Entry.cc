@@ -207,7 +207,7 @@ namespace edm {
   // consistency-checker
   // ----------------------------------------------------------------------
 
-  void Entry::validate() const {
+  void Entry::validate() {
     // tracked
     assert(tracked == '+' || tracked == '-');
     //     if(tracked != '+' && tracked != '-')
@@ -216,8 +216,7 @@ namespace edm {
     // type and rep
     switch (type) {
       case kTbool: {  // Bool
-        bool val;
-        if (!decode(val, rep))
+        if (!decode(value_.b, rep))
           throwEntryError("bool", rep);
         break;
       }
@@ -228,8 +227,7 @@ namespace edm {
         break;
       }
       case kTint32: {  // Int32
-        int val;
-        if (!decode(val, rep))
+        if (!decode(value_.i32, rep))
           throwEntryError("int", rep);
         break;
       }
@@ -240,8 +238,7 @@ namespace edm {
         break;
       }
       case kTuint32: {  // Uint32
-        unsigned val;
-        if (!decode(val, rep))
+        if (!decode(value_.u32, rep))
           throwEntryError("unsigned int", rep);
         break;
       }
@@ -252,8 +249,7 @@ namespace edm {
         break;
       }
       case kTint64: {  // Int64
-        int val;
-        if (!decode(val, rep))
+        if (!decode(value_.i64, rep))
           throwEntryError("int64", rep);
         break;
       }
@@ -264,8 +260,7 @@ namespace edm {
         break;
       }
       case kTuint64: {  // Uint64
-        unsigned val;
-        if (!decode(val, rep))
+        if (!decode(value_.u64, rep))
           throwEntryError("unsigned int64", rep);
         break;
       }
@@ -342,8 +337,7 @@ namespace edm {
         break;
       }
       case kTdouble: {  // Double
-        double val;
-        if (!decode(val, rep))
+        if (!decode(value_.d, rep))
           throwEntryError("double", rep);
         break;
       }
@@ -782,10 +776,7 @@ namespace edm {
   bool Entry::getBool() const {
     if (type != kTbool)
       throwValueError("bool");
-    bool val;
-    if (!decode(val, rep))
-      throwEntryError("bool", rep);
-    return val;
+    return value_.b;
   }
 
   // ----------------------------------------------------------------------
@@ -794,10 +785,7 @@ namespace edm {
   int Entry::getInt32() const {
     if (type != kTint32)
       throwValueError("int");
-    int val;
-    if (!decode(val, rep))
-      throwEntryError("int", rep);
-    return val;
+    return value_.i32;
   }
 
   // ----------------------------------------------------------------------
@@ -818,10 +806,7 @@ namespace edm {
   long long Entry::getInt64() const {
     if (type != kTint64)
       throwValueError("int64");
-    long long val;
-    if (!decode(val, rep))
-      throwEntryError("int64", rep);
-    return val;
+    return value_.i64;
   }
 
   // ----------------------------------------------------------------------
@@ -842,10 +827,7 @@ namespace edm {
   unsigned Entry::getUInt32() const {
     if (type != kTuint32)
       throwValueError("unsigned int");
-    unsigned val;
-    if (!decode(val, rep))
-      throwEntryError("unsigned int", rep);
-    return val;
+    return value_.u32;
   }
 
   // ----------------------------------------------------------------------
@@ -866,10 +848,7 @@ namespace edm {
   unsigned long long Entry::getUInt64() const {
     if (type != kTuint64)
       throwValueError("uint64");
-    unsigned long long val;
-    if (!decode(val, rep))
-      throwEntryError("uint64", rep);
-    return val;
+    return value_.u64;
   }
 
   // ----------------------------------------------------------------------
@@ -890,10 +869,7 @@ namespace edm {
   double Entry::getDouble() const {
     if (type != kTdouble)
       throwValueError("double");
-    double val;
-    if (!decode(val, rep))
-      throwEntryError("double", rep);
-    return val;
+    return value_.d;
   }
 
   // ----------------------------------------------------------------------
@@ -22,6 +22,7 @@
 #include <iostream>
 #include <sstream>
 #include <cassert>
+#include <type_traits>
 
 // ----------------------------------------------------------------------
 // class invariant checker
@@ -29,6 +30,12 @@
 
 namespace edm {
 
+  // getPSetForUpdate hands out pointers to nested ParameterSets, which must
+  // stay where they are when the entries of the table move
+  static_assert(std::is_nothrow_move_constructible<ParameterSetEntry>::value and
+                    std::is_nothrow_move_assignable<ParameterSetEntry>::value,
+                "ParameterSetEntry must be moved, not copied, when the table grows");
+
   void ParameterSet::invalidateRegistration(std::string const& nameOfTracked) {
     // We have added a new parameter.  Invalidate the ID.
     if (isRegistered()) {
@@ -659,15 +666,15 @@ namespace edm {
     std::transform(tbl_.begin(),
                    tbl_.end(),
                    back_inserter(returnValue),
-                   std::bind(&std::pair<std::string const, Entry>::first, _1));
+                   std::bind(&table::value_type::first, _1));
     std::transform(psetTable_.begin(),
                    psetTable_.end(),
                    back_inserter(returnValue),
-                   std::bind(&std::pair<std::string const, ParameterSetEntry>::first, _1));
+                   std::bind(&psettable::value_type::first, _1));
     std::transform(vpsetTable_.begin(),
                    vpsetTable_.end(),
                    back_inserter(returnValue),
-                   std::bind(&std::pair<std::string const, VParameterSetEntry>::first, _1));
+                   std::bind(&vpsettable::value_type::first, _1));
     return returnValue;
   }
 
@@ -709,7 +716,7 @@ namespace edm {
   ParameterSet::getAllParameterSetNames(std::vector<std::string>& output) const {
     using std::placeholders::_1;
     std::transform(psetTable_.begin(), psetTable_.end(), back_inserter(output),
-                   std::bind(&std::pair<std::string const, ParameterSetEntry>::first, _1));
+                   std::bind(&psettable::value_type::first, _1));
     return output.size();
   }
 */
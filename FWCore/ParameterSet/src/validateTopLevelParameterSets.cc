@@ -30,6 +30,10 @@ namespace edm {
         "Parameter names should be record names and the values are the number of concurrent IOVS for each record."
         " Overrides all other methods of setting number of concurrent IOVs.");
     eventSetupDescription.addUntracked<edm::ParameterSetDescription>("forceNumberOfConcurrentIOVs", nestedDescription);
+    eventSetupDescription.addUntracked<bool>("concurrentPrefetching", false)
+        ->setComment(
+            "Set true to prefetch the EventSetup data consumed by the modules together with the Event products "
+            "and to run concurrently the ESProducers which allow it");
     description.addUntracked<edm::ParameterSetDescription>("eventSetup", eventSetupDescription);
 
     description.addUntracked<bool>("wantSummary", false)
@@ -40,6 +44,10 @@ namespace edm {
     description.addUntracked<bool>("throwIfIllegalParameter", true)
         ->setComment("Set false to disable exception throws when configuration validation detects illegal parameters");
     description.addUntracked<bool>("printDependencies", false)->setComment("Print data dependencies between modules");
+    description.addUntracked<bool>("prioritizeCriticalPath", false)
+        ->setComment(
+            "Set true to prefetch first the products on the longest running chains of dependencies between modules,"
+            " and to print a report on the critical path of the events");
 
     // No default for this one because the parameter value is
     // actually used in the main function in cmsRun.cpp before
@@ -55,6 +63,11 @@ namespace edm {
 
     description.addUntracked<std::vector<std::string>>("canDeleteEarly", emptyVector)
         ->setComment("Branch names of products that the Framework can try to delete before the end of the Event");
+    description.addUntracked<bool>("deleteEarlyAutomatically", false)
+        ->setComment(
+            "If True, Event products made in this process which are not written by an OutputModule are deleted "
+            "once the last module consuming them has run. Products gotten without a consumes call, or pointed to by "
+            "a Ref, must not be deleted this way.");
 
     description.addOptionalUntracked<bool>("allowUnscheduled")
         ->setComment(
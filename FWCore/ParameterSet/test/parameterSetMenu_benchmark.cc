@@ -0,0 +1,125 @@
+// Times the ParameterSet operations done while a large trigger menu is
+// constructed: filling the process ParameterSet, registering it, and each
+// module copying its ParameterSet and reading its parameters. The reads of
+// a few parameters for every event, as some modules do, are timed as well.
+//
+//   parameterSetMenuBenchmark [modules] [events]
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include "FWCore/Utilities/interface/InputTag.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+  using Clock = std::chrono::steady_clock;
+
+  double secondsSince(Clock::time_point iStart) {
+    return std::chrono::duration<double>(Clock::now() - iStart).count();
+  }
+
+  // about the size of the ParameterSet of an HLT filter
+  edm::ParameterSet makeModule(unsigned int iModule) {
+    edm::ParameterSet pset;
+    pset.addParameter<std::string>("@module_type", "HLTBenchmarkFilter");
+    pset.addParameter<std::string>("@module_edm_type", "EDFilter");
+    pset.addParameter<std::string>("@module_label", "module" + std::to_string(iModule));
+    for (unsigned int i = 0; i < 8; ++i) {
+      auto index = std::to_string(i);
+      pset.addParameter<int>("minN" + index, i);
+      pset.addParameter<double>("minPt" + index, 0.5 * i + iModule);
+      pset.addParameter<std::string>("label" + index, "candidates" + index);
+      pset.addParameter<edm::InputTag>("inputTag" + index, edm::InputTag("hltProducer" + index, "", "HLT"));
+    }
+    pset.addParameter<std::vector<double>>("etaBins", std::vector<double>{0., 0.9, 1.2, 2.1, 2.4});
+    pset.addUntrackedParameter<bool>("verbose", false);
+
+    edm::ParameterSet nested;
+    for (unsigned int i = 0; i < 10; ++i) {
+      nested.addParameter<double>("cut" + std::to_string(i), 0.1 * i);
+    }
+    pset.addParameter<edm::ParameterSet>("cuts", nested);
+    pset.addParameter<std::vector<edm::ParameterSet>>("regions", std::vector<edm::ParameterSet>(3, nested));
+    return pset;
+  }
+
+  double readModule(edm::ParameterSet const& iPSet) {
+    double sum = 0.;
+    for (unsigned int i = 0; i < 8; ++i) {
+      auto index = std::to_string(i);
+      sum += iPSet.getParameter<int>("minN" + index);
+      sum += iPSet.getParameter<double>("minPt" + index);
+      sum += iPSet.getParameter<std::string>("label" + index).size();
+      sum += iPSet.getParameter<edm::InputTag>("inputTag" + index).label().size();
+    }
+    sum += iPSet.getParameter<std::vector<double>>("etaBins").size();
+    sum += iPSet.getUntrackedParameter<bool>("verbose", true);
+    auto const& cuts = iPSet.getParameterSet("cuts");
+    for (unsigned int i = 0; i < 10; ++i) {
+      sum += cuts.getParameter<double>("cut" + std::to_string(i));
+    }
+    sum += iPSet.getParameter<std::vector<edm::ParameterSet>>("regions").size();
+    return sum;
+  }
+}  // namespace
+
+int main(int argc, char** argv) try {
+  unsigned int nModules = argc > 1 ? std::stoul(argv[1]) : 2000;
+  unsigned int nEvents = argc > 2 ? std::stoul(argv[2]) : 100;
+
+  std::vector<edm::ParameterSet> modules;
+  modules.reserve(nModules);
+  for (unsigned int i = 0; i < nModules; ++i) {
+    modules.push_back(makeModule(i));
+  }
+  // python hands the modules over in no particular order
+  std::vector<unsigned int> order(nModules);
+  for (unsigned int i = 0; i < nModules; ++i) {
+    order[i] = i;
+  }
+  std::shuffle(order.begin(), order.end(), std::mt19937(12345));
+
+  auto start = Clock::now();
+  edm::ParameterSet process;
+  for (auto i : order) {
+    process.addParameter<edm::ParameterSet>("module" + std::to_string(i), modules[i]);
+  }
+  double fillTime = secondsSince(start);
+
+  start = Clock::now();
+  process.registerIt();
+  double registerTime = secondsSince(start);
+
+  start = Clock::now();
+  double sum = 0.;
+  for (unsigned int i = 0; i < nModules; ++i) {
+    auto pset = process.getParameter<edm::ParameterSet>("module" + std::to_string(i));
+    sum += readModule(pset);
+  }
+  double constructTime = secondsSince(start);
+
+  start = Clock::now();
+  for (unsigned int event = 0; event < nEvents; ++event) {
+    for (auto const& pset : modules) {
+      sum += pset.getParameter<double>("minPt0");
+      sum += pset.getParameter<int>("minN7");
+      sum += pset.getParameter<edm::InputTag>("inputTag3").instance().size();
+    }
+  }
+  double eventTime = secondsSince(start);
+
+  std::cout << nModules << " modules, checksum " << sum << "\n"
+            << "fill the process ParameterSet: " << fillTime << " s\n"
+            << "register it: " << registerTime << " s\n"
+            << "copy and read the module ParameterSets: " << constructTime << " s\n"
+            << "read 3 parameters per module for " << nEvents << " events: " << eventTime << " s" << std::endl;
+  return 0;
+} catch (cms::Exception const& e) {
+  std::cerr << e.explainSelf() << std::endl;
+  return 1;
+}
@@ -37,6 +37,7 @@ class testps : public CppUnit::TestFixture {
   CPPUNIT_TEST(testCopyFrom);
   CPPUNIT_TEST(testGetParameterAsString);
   CPPUNIT_TEST(calculateIDTest);
+  CPPUNIT_TEST(insertionOrderTest);
   CPPUNIT_TEST_SUITE_END();
 
 public:
@@ -63,6 +64,7 @@ public:
   void testCopyFrom();
   void testGetParameterAsString();
   void calculateIDTest();
+  void insertionOrderTest();
   // Still more to do...
 private:
 };
@@ -596,4 +598,40 @@ void testps::testGetParameterAsString() {
   CPPUNIT_ASSERT(vpsetStr == vpsetStr2);
 }
 
+void testps::insertionOrderTest() {
+  std::vector<std::string> names = {"m", "b", "y", "a", "zz", "c", "aa", "n"};
+  edm::ParameterSet forward;
+  edm::ParameterSet backward;
+  for (unsigned int i = 0; i < names.size(); ++i) {
+    forward.addParameter<int>(names[i], i);
+    forward.addParameter<edm::ParameterSet>("pset_" + names[i], edm::ParameterSet());
+  }
+  for (unsigned int i = names.size(); i != 0; --i) {
+    backward.addParameter<edm::ParameterSet>("pset_" + names[i - 1], edm::ParameterSet());
+    backward.addParameter<int>(names[i - 1], i - 1);
+  }
+  CPPUNIT_ASSERT(isTransientEqual(forward, backward));
+  CPPUNIT_ASSERT(forward.getParameterNames() == backward.getParameterNames());
+  std::vector<std::string> sorted = forward.getParameterNames();
+  CPPUNIT_ASSERT(std::is_sorted(sorted.begin(), sorted.begin() + names.size()));
+  forward.registerIt();
+  backward.registerIt();
+  CPPUNIT_ASSERT(forward.id() == backward.id());
+  CPPUNIT_ASSERT(forward.toString() == backward.toString());
+  for (unsigned int i = 0; i < names.size(); ++i) {
+    CPPUNIT_ASSERT(backward.getParameter<int>(names[i]) == static_cast<int>(i));
+  }
+
+  // a nested ParameterSet stays in place while the table around it grows
+  edm::ParameterSet outer;
+  outer.addParameter<edm::ParameterSet>("m", edm::ParameterSet());
+  edm::ParameterSet* nested = outer.getPSetForUpdate("m");
+  nested->addParameter<long long>("big", 1LL << 40);
+  for (auto const& name : names) {
+    outer.addParameter<edm::ParameterSet>(name, edm::ParameterSet());
+  }
+  CPPUNIT_ASSERT(nested == outer.getPSetForUpdate("m"));
+  CPPUNIT_ASSERT(outer.getParameterSet("m").getParameter<long long>("big") == 1LL << 40);
+}
+
 #include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
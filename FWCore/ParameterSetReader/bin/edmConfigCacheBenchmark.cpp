@@ -0,0 +1,65 @@
+// Measures the time to make the top level ParameterSet of a configuration,
+// e.g. a full HLT menu, with python and from the binary cache used by
+// 'cmsRun --configCache', and checks that both give the same ParameterSet.
+//
+//   edmConfigCacheBenchmark config.py [cacheFile] [repetitions]
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSetReader/interface/ParameterSetReader.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <chrono>
+#include <cstdio>
+#include <iostream>
+#include <memory>
+#include <string>
+
+int main(int argc, char** argv) try {
+  if (argc < 2 or argc > 4) {
+    std::cout << "usage: " << argv[0] << " config.py [cacheFile] [repetitions]" << std::endl;
+    return 1;
+  }
+  std::string config(argv[1]);
+  std::string cacheFile = argc > 2 ? std::string(argv[2]) : std::string("edmConfigCacheBenchmark.cache");
+  unsigned int repetitions = argc > 3 ? std::stoul(argv[3]) : 10;
+
+  // python sees only the name of the configuration, as with a plain 'cmsRun config.py'
+  char* pythonArgv[] = {argv[0], argv[1]};
+  std::remove(cacheFile.c_str());
+
+  using Clock = std::chrono::steady_clock;
+  bool readFromCache = false;
+  auto start = Clock::now();
+  auto fromPython = edm::readConfig(config, 2, pythonArgv, cacheFile, readFromCache);
+  std::chrono::duration<double> pythonTime = Clock::now() - start;
+  if (readFromCache) {
+    std::cout << "the cache " << cacheFile << " could not be removed" << std::endl;
+    return 1;
+  }
+
+  std::chrono::duration<double> cacheTime{0.};
+  for (unsigned int i = 0; i < repetitions; ++i) {
+    start = Clock::now();
+    auto fromCache = edm::readConfig(config, 2, pythonArgv, cacheFile, readFromCache);
+    cacheTime += Clock::now() - start;
+    if (not readFromCache) {
+      std::cout << "the configuration was not read from the cache " << cacheFile << std::endl;
+      return 1;
+    }
+    if (not edm::isTransientEqual(*fromPython, *fromCache)) {
+      std::cout << "the ParameterSet read from the cache differs from the one made by python" << std::endl;
+      return 1;
+    }
+  }
+
+  std::cout << "python and writing the cache: " << pythonTime.count() << " s\n"
+            << "reading the cache: " << cacheTime.count() / repetitions << " s (average of " << repetitions
+            << ")" << std::endl;
+  return 0;
+} catch (cms::Exception const& e) {
+  std::cout << e.explainSelf() << std::endl;
+  return 1;
+} catch (std::exception const& e) {
+  std::cout << e.what() << std::endl;
+  return 1;
+}
@@ -11,6 +11,12 @@ namespace edm {
 
   std::unique_ptr<edm::ParameterSet> readConfig(std::string const& config);
 
+  // As above, but uses the ParameterSet stored in cacheFile when the configuration, the
+  // arguments and the files and environment variables it reads did not change; otherwise
+  // reads the configuration with python and stores the result in cacheFile.
+  std::unique_ptr<edm::ParameterSet> readConfig(
+      std::string const& config, int argc, char* argv[], std::string const& cacheFile, bool& readFromCache);
+
   void makeParameterSets(std::string const& configtext, std::unique_ptr<ParameterSet>& main);
 
   std::unique_ptr<edm::ParameterSet> readPSetsFrom(std::string const& fileOrString);
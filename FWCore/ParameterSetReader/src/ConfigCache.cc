@@ -0,0 +1,285 @@
+// -*- C++ -*-
+//
+// Package:     FWCore/ParameterSetReader
+// Class  :     ConfigCache
+//
+
+// system include files
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// user include files
+#include "ConfigCache.h"
+#include "FWCore/ParameterSet/interface/Entry.h"
+#include "FWCore/ParameterSet/interface/ParameterSetEntry.h"
+#include "FWCore/ParameterSet/interface/VParameterSetEntry.h"
+#include "FWCore/Utilities/interface/Digest.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+
+namespace {
+  //changes whenever the layout of the file changes
+  constexpr char const* const kMagic = "edmConfigCache 2";
+  //protects against a corrupt file asking for an absurd nesting
+  constexpr unsigned int kMaxDepth = 1000;
+
+  void writeSize(std::string& oBuffer, std::uint64_t iSize) {
+    oBuffer.append(reinterpret_cast<char const*>(&iSize), sizeof(iSize));
+  }
+
+  void writeString(std::string& oBuffer, std::string const& iString) {
+    writeSize(oBuffer, iString.size());
+    oBuffer.append(iString);
+  }
+
+  void writePSet(std::string& oBuffer, edm::ParameterSet const& iPSet) {
+    writeSize(oBuffer, iPSet.tbl().size());
+    std::string code;
+    for (auto const& entry : iPSet.tbl()) {
+      writeString(oBuffer, entry.first);
+      code.clear();
+      entry.second.toString(code);
+      writeString(oBuffer, code);
+    }
+    writeSize(oBuffer, iPSet.psetTable().size());
+    for (auto const& entry : iPSet.psetTable()) {
+      writeString(oBuffer, entry.first);
+      oBuffer.push_back(entry.second.isTracked() ? '+' : '-');
+      writePSet(oBuffer, entry.second.pset());
+    }
+    writeSize(oBuffer, iPSet.vpsetTable().size());
+    for (auto const& entry : iPSet.vpsetTable()) {
+      writeString(oBuffer, entry.first);
+      oBuffer.push_back(entry.second.isTracked() ? '+' : '-');
+      auto const& vpset = entry.second.vpset();
+      writeSize(oBuffer, vpset.size());
+      for (auto const& pset : vpset) {
+        writePSet(oBuffer, pset);
+      }
+    }
+  }
+
+  class Reader {
+  public:
+    explicit Reader(std::string const& iBuffer) : buffer_(iBuffer), pos_(0) {}
+
+    bool atEnd() const { return pos_ == buffer_.size(); }
+
+    std::uint64_t readSize() {
+      std::uint64_t size;
+      check(sizeof(size));
+      std::memcpy(&size, buffer_.data() + pos_, sizeof(size));
+      pos_ += sizeof(size);
+      return size;
+    }
+
+    std::string readString() {
+      auto size = readSize();
+      check(size);
+      std::string value(buffer_, pos_, size);
+      pos_ += size;
+      return value;
+    }
+
+    bool readTracked() {
+      check(1);
+      char tracked = buffer_[pos_++];
+      if (tracked != '+' and tracked != '-') {
+        corrupt();
+      }
+      return tracked == '+';
+    }
+
+    void readPSet(edm::ParameterSet& oPSet, unsigned int iDepth) {
+      if (iDepth > kMaxDepth) {
+        corrupt();
+      }
+      for (auto n = readSize(); n != 0; --n) {
+        auto name = readString();
+        oPSet.insert(true, name, edm::Entry(name, readString()));
+      }
+      for (auto n = readSize(); n != 0; --n) {
+        auto name = readString();
+        bool tracked = readTracked();
+        edm::ParameterSet pset;
+        readPSet(pset, iDepth + 1);
+        oPSet.insertParameterSet(true, name, edm::ParameterSetEntry(pset, tracked));
+      }
+      for (auto n = readSize(); n != 0; --n) {
+        auto name = readString();
+        bool tracked = readTracked();
+        auto size = readSize();
+        //each ParameterSet takes at least its three table sizes
+        if (size > (buffer_.size() - pos_) / (3 * sizeof(std::uint64_t))) {
+          corrupt();
+        }
+        std::vector<edm::ParameterSet> vpset(size);
+        for (auto& pset : vpset) {
+          readPSet(pset, iDepth + 1);
+        }
+        oPSet.insertVParameterSet(true, name, edm::VParameterSetEntry(vpset, tracked));
+      }
+    }
+
+  private:
+    void check(std::uint64_t iSize) const {
+      if (iSize > buffer_.size() - pos_) {
+        corrupt();
+      }
+    }
+
+    [[noreturn]] static void corrupt() {
+      throw edm::Exception(edm::errors::Configuration) << "The cached configuration is corrupt.";
+    }
+
+    std::string const& buffer_;
+    std::string::size_type pos_;
+  };
+
+  //a file which does not exist has all values 0
+  struct FileStamp {
+    std::uint64_t exists_ = 0;
+    std::uint64_t size_ = 0;
+    std::uint64_t seconds_ = 0;
+    std::uint64_t nanoseconds_ = 0;
+
+    bool operator==(FileStamp const& iOther) const {
+      return exists_ == iOther.exists_ and size_ == iOther.size_ and seconds_ == iOther.seconds_ and
+             nanoseconds_ == iOther.nanoseconds_;
+    }
+  };
+
+  FileStamp stampOf(std::string const& iFile) {
+    FileStamp stamp;
+    struct stat status;
+    if (0 == ::stat(iFile.c_str(), &status)) {
+      stamp.exists_ = 1;
+      stamp.size_ = status.st_size;
+#ifdef __APPLE__
+      stamp.seconds_ = status.st_mtimespec.tv_sec;
+      stamp.nanoseconds_ = status.st_mtimespec.tv_nsec;
+#else
+      stamp.seconds_ = status.st_mtim.tv_sec;
+      stamp.nanoseconds_ = status.st_mtim.tv_nsec;
+#endif
+    }
+    return stamp;
+  }
+
+  bool readFile(std::string const& iFile, std::string& oContent) {
+    std::ifstream file(iFile, std::ios::binary);
+    if (not file) {
+      return false;
+    }
+    oContent.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    return not file.bad();
+  }
+}  // namespace
+
+namespace edm {
+  ConfigCache::ConfigCache(std::string const& iCacheFile, std::string const& iConfig, int argc, char* argv[])
+      : cacheFile_(iCacheFile) {
+    cms::Digest digest(kMagic);
+    std::string content;
+    //the same test as PyBind11ProcessDesc uses to tell a file from a string
+    if (iConfig.size() >= 3 and iConfig.substr(iConfig.size() - 3) == ".py" and readFile(iConfig, content)) {
+      digest.append(content);
+    } else {
+      digest.append(iConfig);
+    }
+    for (int i = 1; i < argc; ++i) {
+      digest.append(argv[i], std::strlen(argv[i]) + 1);
+    }
+    if (char const* pythonPath = std::getenv("PYTHONPATH")) {
+      digest.append(pythonPath);
+    }
+    key_ = digest.digest().toString();
+  }
+
+  std::unique_ptr<ParameterSet> ConfigCache::read() const {
+    std::string buffer;
+    if (not readFile(cacheFile_, buffer)) {
+      return std::unique_ptr<ParameterSet>();
+    }
+    try {
+      Reader reader(buffer);
+      if (reader.readString() != kMagic or reader.readString() != key_) {
+        return std::unique_ptr<ParameterSet>();
+      }
+      for (auto n = reader.readSize(); n != 0; --n) {
+        auto file = reader.readString();
+        FileStamp stamp;
+        stamp.exists_ = reader.readSize();
+        stamp.size_ = reader.readSize();
+        stamp.seconds_ = reader.readSize();
+        stamp.nanoseconds_ = reader.readSize();
+        if (not(stamp == stampOf(file))) {
+          return std::unique_ptr<ParameterSet>();
+        }
+      }
+      for (auto n = reader.readSize(); n != 0; --n) {
+        auto name = reader.readString();
+        bool isSet = reader.readTracked();
+        auto value = reader.readString();
+        char const* current = std::getenv(name.c_str());
+        if (isSet != (current != nullptr) or (isSet and value != current)) {
+          return std::unique_ptr<ParameterSet>();
+        }
+      }
+      auto pset = std::make_unique<ParameterSet>();
+      reader.readPSet(*pset, 0);
+      if (not reader.atEnd()) {
+        return std::unique_ptr<ParameterSet>();
+      }
+      return pset;
+    } catch (cms::Exception const&) {
+      //a corrupt cache is the same as no cache
+      return std::unique_ptr<ParameterSet>();
+    }
+  }
+
+  void ConfigCache::write(ParameterSet const& iPSet,
+                          std::vector<std::string> const& iFiles,
+                          Environment const& iEnvironment) const {
+    std::string buffer;
+    writeString(buffer, kMagic);
+    writeString(buffer, key_);
+    writeSize(buffer, iFiles.size());
+    for (auto const& file : iFiles) {
+      auto stamp = stampOf(file);
+      writeString(buffer, file);
+      writeSize(buffer, stamp.exists_);
+      writeSize(buffer, stamp.size_);
+      writeSize(buffer, stamp.seconds_);
+      writeSize(buffer, stamp.nanoseconds_);
+    }
+    writeSize(buffer, iEnvironment.size());
+    for (auto const& variable : iEnvironment) {
+      writeString(buffer, variable.first);
+      //stored like the tracked flag of a ParameterSet
+      buffer.push_back(variable.second ? '+' : '-');
+      writeString(buffer, variable.second.value_or(std::string()));
+    }
+    writePSet(buffer, iPSet);
+
+    //write to a temporary file first so a concurrent job never reads half a cache
+    std::string temporary = cacheFile_ + ".tmp" + std::to_string(::getpid());
+    {
+      std::ofstream file(temporary, std::ios::binary | std::ios::trunc);
+      file.write(buffer.data(), buffer.size());
+      file.close();
+      if (not file) {
+        std::remove(temporary.c_str());
+        return;
+      }
+    }
+    if (0 != std::rename(temporary.c_str(), cacheFile_.c_str())) {
+      std::remove(temporary.c_str());
+    }
+  }
+}  // namespace edm
@@ -0,0 +1,63 @@
+#ifndef FWCore_ParameterSetReader_ConfigCache_h
+#define FWCore_ParameterSetReader_ConfigCache_h
+// -*- C++ -*-
+//
+// Package:     FWCore/ParameterSetReader
+// Class  :     ConfigCache
+//
+/**\class edm::ConfigCache ConfigCache.h "ConfigCache.h"
+
+ Description: Binary cache of the ParameterSet made from a python configuration
+
+ Usage:
+    The cache file holds a key, the inputs of the configuration, and the
+ fully expanded top level ParameterSet. The key is the MD5 digest of the
+ configuration (the content of the file, or the string itself), of the
+ command line arguments given to python and of PYTHONPATH. The inputs are
+ the files read while processing the configuration, e.g. python modules,
+ JSON lumi masks or file lists, the directories it listed and the
+ environment variables it looked at. The cache is used only if the key
+ matches, none of the files or directories appeared, disappeared or changed
+ size or modification time, and the environment variables have the same
+ values; otherwise the configuration is read by python again and the cache
+ is rewritten.
+
+    The ParameterSet is stored with the string form of each Entry, while the
+ nested ParameterSets are stored in full, so that a ParameterSet can be
+ rebuilt without the registry and without the python interpreter.
+
+*/
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace edm {
+  class ConfigCache {
+  public:
+    ConfigCache(std::string const& iCacheFile, std::string const& iConfig, int argc, char* argv[]);
+
+    ///the cached ParameterSet, or nullptr if the cache is missing, out of date or unreadable
+    std::unique_ptr<ParameterSet> read() const;
+
+    ///the environment variables read, with their values or nothing if they were not set
+    using Environment = std::vector<std::pair<std::string, std::optional<std::string>>>;
+
+    ///stores iPSet together with the inputs it was made from, ignoring failures
+    void write(ParameterSet const& iPSet,
+               std::vector<std::string> const& iFiles,
+               Environment const& iEnvironment) const;
+
+    std::string const& key() const { return key_; }
+
+  private:
+    std::string cacheFile_;
+    std::string key_;
+  };
+}  // namespace edm
+
+#endif
@@ -1,6 +1,7 @@
 #include "FWCore/ParameterSetReader/interface/ParameterSetReader.h"
 #include "FWCore/PythonParameterSet/interface/PyBind11ProcessDesc.h"
 #include "FWCore/PythonParameterSet/interface/MakePyBind11ParameterSets.h"
+#include "ConfigCache.h"
 
 std::unique_ptr<edm::ParameterSet> edm::getPSetFromConfig(const std::string& config) {
   return PyBind11ProcessDesc(config).parameterSet();
@@ -16,6 +17,22 @@ std::unique_ptr<edm::ParameterSet> edm::readConfig(std::string const& config) {
   return edm::cmspybind11::readConfig(config);
 }
 
+std::unique_ptr<edm::ParameterSet> edm::readConfig(
+    std::string const& config, int argc, char* argv[], std::string const& cacheFile, bool& readFromCache) {
+  ConfigCache cache(cacheFile, config, argc, argv);
+  auto pset = cache.read();
+  readFromCache = bool(pset);
+  if (not readFromCache) {
+    PyBind11ProcessDesc pythonProcessDesc(config, argc, argv, true);
+    pset = pythonProcessDesc.parameterSet();
+    //without python 3.8 the cache could not tell when the inputs change
+    if (pythonProcessDesc.inputsRecorded()) {
+      cache.write(*pset, pythonProcessDesc.inputFiles(), pythonProcessDesc.inputEnvironment());
+    }
+  }
+  return pset;
+}
+
 void edm::makeParameterSets(std::string const& configtext, std::unique_ptr<ParameterSet>& main) {
   edm::cmspybind11::makeParameterSets(configtext, main);
 }
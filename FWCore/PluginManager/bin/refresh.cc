@@ -2,6 +2,7 @@
 #include "FWCore/PluginManager/interface/PluginCapabilities.h"
 #include "FWCore/PluginManager/interface/PluginFactoryBase.h"
 #include "FWCore/PluginManager/interface/PluginFactoryManager.h"
+#include "FWCore/PluginManager/interface/PluginIndex.h"
 #include "FWCore/PluginManager/interface/SharedLibrary.h"
 #include "FWCore/PluginManager/interface/standard.h"
 
@@ -12,6 +13,7 @@
 #include <boost/program_options.hpp>
 
 #include <algorithm>
+#include <cstdio>
 #include <cstdlib>
 #include <fstream>
 #include <functional>
@@ -323,7 +325,32 @@ int main(int argc, char** argv) try {
                                         "Please check permissions on the file.";
     }
     CacheParser::write(old, fcf);
+    fcf.close();
     rename(temporaryFilename.c_str(), cacheFile.string().c_str());
+
+    // The index records the size and time of the cache it was made from, so
+    // it must be written after the cache is in place.
+    edmplugin::PluginIndex::FileStamp cacheStamp;
+    if (edmplugin::PluginIndex::stampOf(cacheFile, cacheStamp)) {
+      path indexFile(directory);
+      indexFile /= edmplugin::standard::indexfileName();
+      std::string temporaryIndexFilename = (indexFile.string() + ".tmp");
+      std::ofstream ixf(temporaryIndexFilename.c_str(), std::ios::binary | std::ios::trunc);
+      if (!ixf) {
+        throw cms::Exception("FailedToOpen") << "unable to open file '" << temporaryIndexFilename
+                                             << "' for writing.\n"
+                                                "Please check permissions on the file.";
+      }
+      edmplugin::PluginIndex::write(old, cacheStamp, ixf);
+      ixf.close();
+      if (!ixf) {
+        //without an index the PluginManager reads the cache file instead
+        std::cerr << "failed to write '" << temporaryIndexFilename << "', no plugin index made" << std::endl;
+        std::remove(temporaryIndexFilename.c_str());
+      } else {
+        rename(temporaryIndexFilename.c_str(), indexFile.string().c_str());
+      }
+    }
   } catch (std::exception& iException) {
     std::cerr << "Caught exception " << iException.what() << std::endl;
     returnValue = EXIT_FAILURE;
@@ -0,0 +1,100 @@
+#ifndef FWCore_PluginManager_PluginIndex_h
+#define FWCore_PluginManager_PluginIndex_h
+// -*- C++ -*-
+//
+// Package:     PluginManager
+// Class  :     PluginIndex
+//
+/**\class PluginIndex PluginIndex.h FWCore/PluginManager/interface/PluginIndex.h
+
+ Description: Memory mapped binary form of the plugin cache of a directory
+
+ Usage:
+    edmPluginRefresh writes the index next to the text cache file. The index
+ holds the same (plugin type, plugin name, file name) triplets as the cache,
+ sorted by plugin type then plugin name, plus the size and modification time
+ of the cache file it was made from. The PluginManager maps the index instead
+ of parsing the text cache, and only makes the PluginInfos of a plugin type
+ when that type is first asked for. If the cache file changed since the
+ index was written, the index is not used.
+
+    The layout is
+      Header
+      Entry[Header::nEntries_]
+      char[Header::stringsSize_]   null terminated strings the Entries point to
+ in the byte order of the machine which wrote it.
+
+*/
+
+// system include files
+#include <cstdint>
+#include <iosfwd>
+#include <set>
+#include <string>
+#include <vector>
+#include <boost/filesystem/path.hpp>
+
+// user include files
+#include "FWCore/PluginManager/interface/CacheParser.h"
+#include "FWCore/PluginManager/interface/PluginInfo.h"
+
+// forward declarations
+
+namespace edmplugin {
+  class PluginIndex {
+  public:
+    struct FileStamp {
+      std::uint64_t size_ = 0;
+      std::int64_t seconds_ = 0;
+      std::int64_t nanoseconds_ = 0;
+
+      bool operator==(const FileStamp& iOther) const {
+        return size_ == iOther.size_ and seconds_ == iOther.seconds_ and nanoseconds_ == iOther.nanoseconds_;
+      }
+    };
+
+    ///throws a cms::Exception if iIndexFile can not be mapped or is not a valid index
+    explicit PluginIndex(const boost::filesystem::path& iIndexFile);
+    ~PluginIndex();
+
+    // ---------- const member functions ---------------------
+    ///the stamp of the cache file the index was made from
+    const FileStamp& cacheStamp() const;
+
+    bool hasCategory(const std::string& iCategory) const;
+
+    /**Appends the plugins of iCategory to oInfos, with their loadables in iDirectory, ordered by name
+        and for the same name in the order CacheParser::read would give.
+        */
+    void fillCategory(const std::string& iCategory,
+                      const boost::filesystem::path& iDirectory,
+                      std::vector<PluginInfo>& oInfos) const;
+
+    void categories(std::set<std::string>& oCategories) const;
+
+    // ---------- static member functions --------------------
+    ///returns false if the file does not exist
+    static bool stampOf(const boost::filesystem::path& iFile, FileStamp& oStamp);
+
+    static void write(const CacheParser::LoadableToPlugins& iIn, const FileStamp& iCacheStamp, std::ostream& oOut);
+
+  private:
+    struct Header;
+    struct Entry;
+
+    PluginIndex(const PluginIndex&) = delete;                   // stop default
+    const PluginIndex& operator=(const PluginIndex&) = delete;  // stop default
+
+    const Header& header() const;
+    const Entry* beginEntries() const;
+    const Entry* endEntries() const;
+    const char* string(std::uint32_t iOffset) const;
+    std::pair<const Entry*, const Entry*> categoryRange(const std::string& iCategory) const;
+
+    // ---------- member data --------------------------------
+    void* address_;
+    std::size_t size_;
+  };
+
+}  // namespace edmplugin
+#endif
@@ -31,6 +31,7 @@
 // user include files
 #include "FWCore/Utilities/interface/Signal.h"
 #include "FWCore/PluginManager/interface/SharedLibrary.h"
+#include "FWCore/PluginManager/interface/PluginIndex.h"
 #include "FWCore/PluginManager/interface/PluginInfo.h"
 
 // forward declarations
@@ -78,9 +79,11 @@ namespace edmplugin {
     const boost::filesystem::path& loadableFor(const std::string& iCategory, const std::string& iPlugin);
 
     /**The container is ordered by category, then plugin name and then by precidence order of the plugin files.
-        Therefore the first match on category and plugin name will be the proper file to load
+        Therefore the first match on category and plugin name will be the proper file to load.
+        The plugins of a category are otherwise only looked up the first time the category is used,
+        so the first call has to read in every category.
         */
-    const CategoryToInfos& categoryToInfos() const { return categoryToInfos_; }
+    const CategoryToInfos& categoryToInfos() const;
 
     //If can not find iPlugin in category iCategory return null pointer, any other failure will cause a throw
     const SharedLibrary* tryToLoad(const std::string& iCategory, const std::string& iPlugin);
@@ -114,6 +117,9 @@ namespace edmplugin {
 
     std::recursive_mutex& pluginLoadMutex() { return pluginLoadMutex_; }
 
+    ///returns nullptr if no plugin of the category is known
+    const Infos* infosFor(const std::string& iCategory) const;
+
     const boost::filesystem::path& loadableFor_(const std::string& iCategory,
                                                 const std::string& iPlugin,
                                                 bool& ioThrowIfFailElseSucceedStatus);
@@ -122,7 +128,18 @@ namespace edmplugin {
     tbb::concurrent_unordered_map<boost::filesystem::path, std::shared_ptr<SharedLibrary>, PluginManagerPathHasher>
         loadables_;
 
-    CategoryToInfos categoryToInfos_;
+    //one per cache file, in precidence order, each read either from its index or from the cache itself
+    struct CacheSource {
+      std::unique_ptr<PluginIndex> index_;
+      boost::filesystem::path directory_;
+      CategoryToInfos infos_;
+    };
+    std::vector<CacheSource> sources_;
+
+    //filled from sources_ one category at a time
+    mutable CategoryToInfos categoryToInfos_;
+    mutable bool madeAllCategories_ = false;
+    mutable std::mutex categoryMutex_;
     std::recursive_mutex pluginLoadMutex_;
   };
 
@@ -0,0 +1,73 @@
+#ifndef FWCore_PluginManager_PluginPreloader_h
+#define FWCore_PluginManager_PluginPreloader_h
+// -*- C++ -*-
+//
+// Package:     PluginManager
+// Class  :     PluginPreloader
+//
+/**\class PluginPreloader PluginPreloader.h FWCore/PluginManager/interface/PluginPreloader.h
+
+ Description: Loads in a separate thread the plugins an earlier job asked for
+
+ Usage:
+    The record file lists the plugins asked for from the PluginManager by an
+ earlier job, one 'category<TAB>plugin' per line. On construction the
+ plugins in the file are loaded from a separate thread while the creating
+ thread goes on, e.g. processing the python configuration. Plugins which
+ can not be found or loaded are skipped, the job will ask for them again.
+ From construction on the PluginManager requests of the job are recorded,
+ and writeRecord() replaces the file with them and the plugins which were
+ preloaded.
+
+    The PluginManager signals are not safe to connect to while the thread
+ runs, so wait() must be called before anything else connects to them.
+ After wait(), notLoaded() lists the plugins of the file which were skipped.
+
+*/
+
+// system include files
+#include <memory>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
+
+// user include files
+
+// forward declarations
+
+namespace edmplugin {
+  class PluginPreloader {
+  public:
+    ///the PluginManager must already be configured
+    explicit PluginPreloader(std::string const& iRecordFile);
+    ~PluginPreloader();
+
+    // ---------- member functions ---------------------------
+    ///waits for all the plugins to be loaded
+    void wait();
+
+    ///writes the plugins asked for since construction, ignoring failures
+    void writeRecord() const;
+
+    // ---------- const member functions ---------------------
+    ///the category and name of the plugins of the file which could not be found or loaded, only valid after wait()
+    std::vector<std::pair<std::string, std::string>> const& notLoaded() const { return notLoaded_; }
+
+  private:
+    struct Record;
+
+    PluginPreloader(const PluginPreloader&) = delete;                   // stop default
+    const PluginPreloader& operator=(const PluginPreloader&) = delete;  // stop default
+
+    // ---------- member data --------------------------------
+    std::string recordFile_;
+    //shared with the PluginManager signal, which can not be disconnected
+    std::shared_ptr<Record> record_;
+    std::thread thread_;
+    //only written by thread_
+    std::vector<std::pair<std::string, std::string>> notLoaded_;
+  };
+}  // namespace edmplugin
+
+#endif
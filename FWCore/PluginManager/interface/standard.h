@@ -34,6 +34,7 @@ namespace edmplugin {
 
     const boost::filesystem::path& cachefileName();
     const boost::filesystem::path& poisonedCachefileName();
+    const boost::filesystem::path& indexfileName();
 
     const std::string& pluginPrefix();
   }  // namespace standard
@@ -0,0 +1,200 @@
+// -*- C++ -*-
+//
+// Package:     PluginManager
+// Class  :     PluginIndex
+//
+
+// system include files
+#include <algorithm>
+#include <cstring>
+#include <map>
+#include <ostream>
+#include <tuple>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+// user include files
+#include "FWCore/PluginManager/interface/PluginIndex.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+namespace edmplugin {
+  //
+  // constants, enums and typedefs
+  //
+  namespace {
+    //changes whenever the layout of the file changes
+    constexpr char kMagic[8] = {'E', 'D', 'M', 'P', 'L', 'G', 'I', '1'};
+  }  // namespace
+
+  struct PluginIndex::Header {
+    char magic_[8];
+    FileStamp cacheStamp_;
+    std::uint32_t nEntries_;
+    std::uint32_t stringsSize_;
+  };
+
+  struct PluginIndex::Entry {
+    std::uint32_t category_;
+    std::uint32_t name_;
+    std::uint32_t loadable_;
+  };
+
+  //
+  // constructors and destructor
+  //
+  PluginIndex::PluginIndex(const boost::filesystem::path& iIndexFile) : address_(nullptr), size_(0) {
+    int fd = ::open(iIndexFile.string().c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw cms::Exception("PluginIndexProblem")
+          << "Unable to open the plugin index '" << iIndexFile.string() << "'. Please check permissions on file";
+    }
+    struct stat status;
+    if (0 != ::fstat(fd, &status) or status.st_size < static_cast<off_t>(sizeof(Header))) {
+      ::close(fd);
+      throw cms::Exception("PluginIndexProblem") << "The plugin index '" << iIndexFile.string() << "' is truncated";
+    }
+    size_ = status.st_size;
+    void* address = ::mmap(nullptr, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+    //the mapping stays valid after the file is closed
+    ::close(fd);
+    if (address == MAP_FAILED) {
+      throw cms::Exception("PluginIndexProblem") << "Unable to map the plugin index '" << iIndexFile.string() << "'";
+    }
+    address_ = address;
+
+    //check everything the lookups rely on so they need no checks of their own
+    const Header& h = header();
+    bool valid = 0 == std::memcmp(h.magic_, kMagic, sizeof(kMagic)) and
+                 size_ == sizeof(Header) + std::uint64_t(h.nEntries_) * sizeof(Entry) + h.stringsSize_ and
+                 (h.nEntries_ == 0 or (h.stringsSize_ != 0 and string(0)[h.stringsSize_ - 1] == '\0'));
+    for (const Entry* it = beginEntries(); valid and it != endEntries(); ++it) {
+      valid = it->category_ < h.stringsSize_ and it->name_ < h.stringsSize_ and it->loadable_ < h.stringsSize_;
+    }
+    if (not valid) {
+      ::munmap(address_, size_);
+      throw cms::Exception("PluginIndexProblem")
+          << "The plugin index '" << iIndexFile.string()
+          << "' is corrupt. Please rerun edmPluginRefresh on its directory";
+    }
+  }
+
+  PluginIndex::~PluginIndex() { ::munmap(address_, size_); }
+
+  //
+  // const member functions
+  //
+  const PluginIndex::Header& PluginIndex::header() const { return *static_cast<const Header*>(address_); }
+
+  const PluginIndex::Entry* PluginIndex::beginEntries() const {
+    return reinterpret_cast<const Entry*>(static_cast<const char*>(address_) + sizeof(Header));
+  }
+
+  const PluginIndex::Entry* PluginIndex::endEntries() const { return beginEntries() + header().nEntries_; }
+
+  const char* PluginIndex::string(std::uint32_t iOffset) const {
+    return reinterpret_cast<const char*>(endEntries()) + iOffset;
+  }
+
+  const PluginIndex::FileStamp& PluginIndex::cacheStamp() const { return header().cacheStamp_; }
+
+  std::pair<const PluginIndex::Entry*, const PluginIndex::Entry*> PluginIndex::categoryRange(
+      const std::string& iCategory) const {
+    auto begin =
+        std::lower_bound(beginEntries(), endEntries(), iCategory, [this](const Entry& iEntry, const std::string& iC) {
+          return iC.compare(string(iEntry.category_)) > 0;
+        });
+    auto end = std::upper_bound(begin, endEntries(), iCategory, [this](const std::string& iC, const Entry& iEntry) {
+      return iC.compare(string(iEntry.category_)) < 0;
+    });
+    return std::make_pair(begin, end);
+  }
+
+  bool PluginIndex::hasCategory(const std::string& iCategory) const {
+    auto range = categoryRange(iCategory);
+    return range.first != range.second;
+  }
+
+  void PluginIndex::fillCategory(const std::string& iCategory,
+                                 const boost::filesystem::path& iDirectory,
+                                 std::vector<PluginInfo>& oInfos) const {
+    auto range = categoryRange(iCategory);
+    oInfos.reserve(oInfos.size() + (range.second - range.first));
+    PluginInfo info;
+    for (auto it = range.first; it != range.second; ++it) {
+      info.name_ = string(it->name_);
+      info.loadable_ = iDirectory / string(it->loadable_);
+      oInfos.push_back(info);
+    }
+  }
+
+  void PluginIndex::categories(std::set<std::string>& oCategories) const {
+    for (auto it = beginEntries(), itEnd = endEntries(); it != itEnd;) {
+      auto range = categoryRange(string(it->category_));
+      oCategories.insert(string(it->category_));
+      it = range.second;
+    }
+  }
+
+  //
+  // static member functions
+  //
+  bool PluginIndex::stampOf(const boost::filesystem::path& iFile, FileStamp& oStamp) {
+    struct stat status;
+    if (0 != ::stat(iFile.string().c_str(), &status)) {
+      return false;
+    }
+    oStamp.size_ = status.st_size;
+#ifdef __APPLE__
+    oStamp.seconds_ = status.st_mtimespec.tv_sec;
+    oStamp.nanoseconds_ = status.st_mtimespec.tv_nsec;
+#else
+    oStamp.seconds_ = status.st_mtim.tv_sec;
+    oStamp.nanoseconds_ = status.st_mtim.tv_nsec;
+#endif
+    return true;
+  }
+
+  void PluginIndex::write(const CacheParser::LoadableToPlugins& iIn, const FileStamp& iCacheStamp, std::ostream& oOut) {
+    //each distinct string is stored once, most are plugin types and file names
+    std::map<std::string, std::uint32_t> offsets;
+    std::string strings;
+    auto offsetOf = [&offsets, &strings](const std::string& iString) {
+      auto itFound = offsets.find(iString);
+      if (itFound != offsets.end()) {
+        return itFound->second;
+      }
+      std::uint32_t offset = strings.size();
+      strings.append(iString.c_str(), iString.size() + 1);
+      offsets.emplace(iString, offset);
+      return offset;
+    };
+
+    //ordered as CacheParser::read orders the plugins of one directory
+    std::vector<std::tuple<std::string, std::string, std::string>> ordered;
+    for (auto const& loadable : iIn) {
+      for (auto const& nameAndType : loadable.second) {
+        ordered.emplace_back(nameAndType.second, nameAndType.first, loadable.first.string());
+      }
+    }
+    std::sort(ordered.begin(), ordered.end());
+
+    std::vector<Entry> entries;
+    entries.reserve(ordered.size());
+    for (auto const& triplet : ordered) {
+      entries.push_back(
+          Entry{offsetOf(std::get<0>(triplet)), offsetOf(std::get<1>(triplet)), offsetOf(std::get<2>(triplet))});
+    }
+
+    Header h;
+    std::memcpy(h.magic_, kMagic, sizeof(kMagic));
+    h.cacheStamp_ = iCacheStamp;
+    h.nEntries_ = entries.size();
+    h.stringsSize_ = strings.size();
+    oOut.write(reinterpret_cast<const char*>(&h), sizeof(h));
+    oOut.write(reinterpret_cast<const char*>(entries.data()), entries.size() * sizeof(Entry));
+    oOut.write(strings.data(), strings.size());
+  }
+
+}  // namespace edmplugin
@@ -13,6 +13,7 @@
 // system include files
 #include <boost/filesystem/operations.hpp>
 
+#include <algorithm>
 #include <fstream>
 #include <functional>
 #include <set>
@@ -53,6 +54,24 @@ namespace edmplugin {
     }
     return false;
   }
+
+  //returns nullptr unless the index exists and was made from the present cacheFile
+  static std::unique_ptr<PluginIndex> openIndexFile(const boost::filesystem::path& indexFile,
+                                                    const boost::filesystem::path& cacheFile) {
+    PluginIndex::FileStamp cacheStamp;
+    if (not exists(indexFile) or not PluginIndex::stampOf(cacheFile, cacheStamp)) {
+      return std::unique_ptr<PluginIndex>();
+    }
+    try {
+      auto index = std::make_unique<PluginIndex>(indexFile);
+      if (index->cacheStamp() == cacheStamp) {
+        return index;
+      }
+    } catch (cms::Exception const&) {
+      //the cache file holds the same information
+    }
+    return std::unique_ptr<PluginIndex>();
+  }
   //
   // constructors and destructor
   //
@@ -63,6 +82,8 @@ namespace edmplugin {
     // base release and which should exists in the local area, otherwise they
     // were removed and we want to catch their usage.
     const boost::filesystem::path& kPoisonedCacheFile(standard::poisonedCachefileName());
+    // Binary form of the cache file written by edmPluginRefresh, used while it matches the cache file
+    const boost::filesystem::path& kIndexFile(standard::indexfileName());
     //NOTE: This may not be needed :/
     PluginFactoryManager* pfm = PluginFactoryManager::get();
     pfm->newFactory_.connect(std::bind(std::mem_fn(&PluginManager::newFactory), this, _1));
@@ -70,13 +91,14 @@ namespace edmplugin {
     // When building a single big executable the plugins are already registered in the
     // PluginFactoryManager, we therefore only need to populate the categoryToInfos_ map
     // with the relevant information.
+    sources_.emplace_back();
     for (PluginFactoryManager::const_iterator i = pfm->begin(), e = pfm->end(); i != e; ++i) {
-      categoryToInfos_[(*i)->category()] = (*i)->available();
+      sources_.back().infos_[(*i)->category()] = (*i)->available();
     }
 
     //read in the files
-    //Since we are looping in the 'precidence' order then the lists in categoryToInfos_ will also be
-    // in that order
+    //Since we are looping in the 'precidence' order then the sources_, and so the lists in
+    // categoryToInfos_, will also be in that order
     bool foundAtLeastOneCacheFile = false;
     std::set<std::string> alreadySeen;
     for (SearchPath::const_iterator itPath = searchPath_.begin(), itEnd = searchPath_.end(); itPath != itEnd;
@@ -94,14 +116,20 @@ namespace edmplugin {
         }
         boost::filesystem::path cacheFile = dir / kCacheFile;
 
-        if (readCacheFile(cacheFile, dir, categoryToInfos_)) {
+        sources_.emplace_back();
+        sources_.back().index_ = openIndexFile(dir / kIndexFile, cacheFile);
+        if (sources_.back().index_) {
+          sources_.back().directory_ = dir;
+          foundAtLeastOneCacheFile = true;
+        } else if (readCacheFile(cacheFile, dir, sources_.back().infos_)) {
           foundAtLeastOneCacheFile = true;
         }
 
         // We do not check for return code since we do not want to consider a
         // poison cache file as a valid cache file having been found.
         boost::filesystem::path poisonedCacheFile = dir / kPoisonedCacheFile;
-        readCacheFile(poisonedCacheFile, dir / "poisoned", categoryToInfos_);
+        sources_.emplace_back();
+        readCacheFile(poisonedCacheFile, dir / "poisoned", sources_.back().infos_);
       }
     }
     if (not foundAtLeastOneCacheFile and iConfig.mustHaveCache()) {
@@ -148,6 +176,65 @@ namespace edmplugin {
     };
   }  // namespace
 
+  const PluginManager::Infos* PluginManager::infosFor(const std::string& iCategory) const {
+    //entries of categoryToInfos_ are never changed once made, so they can be used without the lock
+    std::lock_guard<std::mutex> guard(categoryMutex_);
+    CategoryToInfos::iterator itFound = categoryToInfos_.find(iCategory);
+    if (itFound != categoryToInfos_.end()) {
+      return &(itFound->second);
+    }
+    if (madeAllCategories_) {
+      return nullptr;
+    }
+    bool found = false;
+    Infos infos;
+    for (auto const& source : sources_) {
+      if (source.index_) {
+        if (source.index_->hasCategory(iCategory)) {
+          found = true;
+          source.index_->fillCategory(iCategory, source.directory_, infos);
+        }
+      } else {
+        auto itSource = source.infos_.find(iCategory);
+        if (itSource != source.infos_.end()) {
+          found = true;
+          infos.insert(infos.end(), itSource->second.begin(), itSource->second.end());
+        }
+      }
+    }
+    if (not found) {
+      return nullptr;
+    }
+    //a sort which preserves the precidence order of the files, as CacheParser::read does
+    std::stable_sort(infos.begin(), infos.end(), PICompare());
+    return &(categoryToInfos_.emplace(iCategory, std::move(infos)).first->second);
+  }
+
+  const PluginManager::CategoryToInfos& PluginManager::categoryToInfos() const {
+    {
+      std::lock_guard<std::mutex> guard(categoryMutex_);
+      if (madeAllCategories_) {
+        return categoryToInfos_;
+      }
+    }
+    std::set<std::string> categories;
+    for (auto const& source : sources_) {
+      if (source.index_) {
+        source.index_->categories(categories);
+      } else {
+        for (auto const& category : source.infos_) {
+          categories.insert(category.first);
+        }
+      }
+    }
+    for (auto const& category : categories) {
+      infosFor(category);
+    }
+    std::lock_guard<std::mutex> guard(categoryMutex_);
+    madeAllCategories_ = true;
+    return categoryToInfos_;
+  }
+
   const boost::filesystem::path& PluginManager::loadableFor(const std::string& iCategory, const std::string& iPlugin) {
     bool throwIfFail = true;
     return loadableFor_(iCategory, iPlugin, throwIfFail);
@@ -158,8 +245,8 @@ namespace edmplugin {
                                                              bool& ioThrowIfFailElseSucceedStatus) {
     const bool throwIfFail = ioThrowIfFailElseSucceedStatus;
     ioThrowIfFailElseSucceedStatus = true;
-    CategoryToInfos::iterator itFound = categoryToInfos_.find(iCategory);
-    if (itFound == categoryToInfos_.end()) {
+    const Infos* infos = infosFor(iCategory);
+    if (nullptr == infos) {
       if (throwIfFail) {
         throw cms::Exception("PluginNotFound") << "Unable to find plugin '" << iPlugin << "' because the category '"
                                                << iCategory << "' has no known plugins";
@@ -172,8 +259,8 @@ namespace edmplugin {
 
     PluginInfo i;
     i.name_ = iPlugin;
-    typedef std::vector<PluginInfo>::iterator PIItr;
-    std::pair<PIItr, PIItr> range = std::equal_range(itFound->second.begin(), itFound->second.end(), i, PICompare());
+    typedef std::vector<PluginInfo>::const_iterator PIItr;
+    std::pair<PIItr, PIItr> range = std::equal_range(infos->begin(), infos->end(), i, PICompare());
 
     if (range.first == range.second) {
       if (throwIfFail) {
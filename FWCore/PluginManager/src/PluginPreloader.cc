@@ -0,0 +1,114 @@
+// -*- C++ -*-
+//
+// Package:     PluginManager
+// Class  :     PluginPreloader
+//
+
+// system include files
+#include <cstdio>
+#include <fstream>
+#include <mutex>
+#include <set>
+#include <utility>
+#include <vector>
+#include <unistd.h>
+
+// user include files
+#include "FWCore/PluginManager/interface/PluginPreloader.h"
+#include "FWCore/PluginManager/interface/PluginManager.h"
+
+namespace edmplugin {
+  struct PluginPreloader::Record {
+    std::mutex mutex_;
+    std::set<std::pair<std::string, std::string>> asked_;
+  };
+
+  namespace {
+    //requests made by the preloading itself are not the job's
+    thread_local bool s_preloading = false;
+
+    std::vector<std::pair<std::string, std::string>> readRecord(std::string const& iRecordFile) {
+      std::vector<std::pair<std::string, std::string>> plugins;
+      std::ifstream file(iRecordFile.c_str());
+      std::string line;
+      while (std::getline(file, line)) {
+        auto tab = line.find('\t');
+        if (tab != std::string::npos) {
+          plugins.emplace_back(line.substr(0, tab), line.substr(tab + 1));
+        }
+      }
+      return plugins;
+    }
+  }  // namespace
+
+  //
+  // constructors and destructor
+  //
+  PluginPreloader::PluginPreloader(std::string const& iRecordFile)
+      : recordFile_(iRecordFile), record_(std::make_shared<Record>()) {
+    PluginManager* pm = PluginManager::get();
+    auto record = record_;
+    pm->askedToLoadCategoryWithPlugin_.connect([record](std::string const& iCategory, std::string const& iPlugin) {
+      if (not s_preloading) {
+        std::lock_guard<std::mutex> guard(record->mutex_);
+        record->asked_.emplace(iCategory, iPlugin);
+      }
+    });
+
+    auto plugins = readRecord(recordFile_);
+    if (not plugins.empty()) {
+      thread_ = std::thread([this, pm, plugins = std::move(plugins)]() {
+        s_preloading = true;
+        for (auto const& plugin : plugins) {
+          //the job will report the problem if it really needs the plugin
+          bool loaded = false;
+          try {
+            loaded = pm->tryToLoad(plugin.first, plugin.second) != nullptr;
+          } catch (...) {
+          }
+          if (loaded) {
+            //the job finds a preloaded plugin without asking the PluginManager, so keep it in the record
+            std::lock_guard<std::mutex> guard(record_->mutex_);
+            record_->asked_.insert(plugin);
+          } else {
+            notLoaded_.push_back(plugin);
+          }
+        }
+      });
+    }
+  }
+
+  PluginPreloader::~PluginPreloader() { wait(); }
+
+  //
+  // member functions
+  //
+  void PluginPreloader::wait() {
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  //
+  // const member functions
+  //
+  void PluginPreloader::writeRecord() const {
+    //write to a temporary file first so a concurrent job never reads half a record
+    std::string temporary = recordFile_ + ".tmp" + std::to_string(::getpid());
+    {
+      std::ofstream file(temporary.c_str(), std::ios::trunc);
+      std::lock_guard<std::mutex> guard(record_->mutex_);
+      for (auto const& plugin : record_->asked_) {
+        file << plugin.first << '\t' << plugin.second << '\n';
+      }
+      file.close();
+      if (not file) {
+        std::remove(temporary.c_str());
+        return;
+      }
+    }
+    if (0 != std::rename(temporary.c_str(), recordFile_.c_str())) {
+      std::remove(temporary.c_str());
+    }
+  }
+}  // namespace edmplugin
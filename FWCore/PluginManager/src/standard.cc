@@ -54,6 +54,11 @@ namespace edmplugin {
       return s_path;
     }
 
+    const boost::filesystem::path& indexfileName() {
+      static const boost::filesystem::path s_path(".edmpluginindex");
+      return s_path;
+    }
+
     const std::string& pluginPrefix() {
       static const std::string s_prefix("plugin");
       return s_prefix;
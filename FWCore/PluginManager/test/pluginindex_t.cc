@@ -0,0 +1,123 @@
+// -*- C++ -*-
+//
+// Package:     PluginManager
+// Class  :     pluginindex_t
+//
+
+// system include files
+#include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
+#include <cppunit/extensions/HelperMacros.h>
+#include <boost/filesystem/operations.hpp>
+#include <fstream>
+#include <set>
+#include <sstream>
+#include <unistd.h>
+
+// user include files
+#include "FWCore/PluginManager/interface/CacheParser.h"
+#include "FWCore/PluginManager/interface/PluginIndex.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+class TestPluginIndex : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TestPluginIndex);
+  CPPUNIT_TEST(testSameAsCache);
+  CPPUNIT_TEST(testCorrupt);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void testSameAsCache();
+  void testCorrupt();
+  void setUp();
+  void tearDown();
+
+private:
+  boost::filesystem::path indexFile_;
+};
+
+///registration of the test so that the runner can find it
+CPPUNIT_TEST_SUITE_REGISTRATION(TestPluginIndex);
+
+namespace {
+  const char* const kCache =
+      "pluginA.so AlphaClass Cat%One\n"
+      "pluginA.so BetaClass<Itl%> Cat%Two\n"
+      "pluginB.so AlphaClass Cat%One\n"
+      "pluginB.so GammaClass Cat%One\n"
+      "pluginC.so DeltaClass Cat%Two\n";
+}
+
+void TestPluginIndex::setUp() {
+  indexFile_ = boost::filesystem::temp_directory_path() / ("pluginindex_t" + std::to_string(::getpid()));
+}
+
+void TestPluginIndex::tearDown() { boost::filesystem::remove(indexFile_); }
+
+void TestPluginIndex::testSameAsCache() {
+  using namespace edmplugin;
+  CacheParser::LoadableToPlugins loadables;
+  {
+    std::stringstream ss(kCache);
+    CacheParser::read(ss, loadables);
+  }
+  PluginIndex::FileStamp stamp;
+  stamp.size_ = 123;
+  stamp.seconds_ = 456;
+  stamp.nanoseconds_ = 789;
+  {
+    std::ofstream file(indexFile_.string().c_str(), std::ios::binary);
+    PluginIndex::write(loadables, stamp, file);
+  }
+
+  CacheParser::CategoryToInfos fromCache;
+  {
+    std::stringstream ss(kCache);
+    CacheParser::read(ss, "/a/dir", fromCache);
+  }
+
+  PluginIndex index(indexFile_);
+  CPPUNIT_ASSERT(index.cacheStamp() == stamp);
+
+  std::set<std::string> categories;
+  index.categories(categories);
+  CPPUNIT_ASSERT(categories == (std::set<std::string>{"Cat One", "Cat Two"}));
+  CPPUNIT_ASSERT(not index.hasCategory("Cat Three"));
+
+  for (auto const& category : fromCache) {
+    CPPUNIT_ASSERT(index.hasCategory(category.first));
+    std::vector<PluginInfo> infos;
+    index.fillCategory(category.first, "/a/dir", infos);
+    CPPUNIT_ASSERT(infos.size() == category.second.size());
+    for (unsigned int i = 0; i < infos.size(); ++i) {
+      CPPUNIT_ASSERT(infos[i].name_ == category.second[i].name_);
+      CPPUNIT_ASSERT(infos[i].loadable_ == category.second[i].loadable_);
+    }
+  }
+}
+
+void TestPluginIndex::testCorrupt() {
+  using namespace edmplugin;
+  CPPUNIT_ASSERT_THROW(PluginIndex index(indexFile_), cms::Exception);
+
+  CacheParser::LoadableToPlugins loadables;
+  {
+    std::stringstream ss(kCache);
+    CacheParser::read(ss, loadables);
+  }
+  std::stringstream ss;
+  PluginIndex::write(loadables, PluginIndex::FileStamp(), ss);
+  std::string good = ss.str();
+
+  //truncated
+  {
+    std::ofstream file(indexFile_.string().c_str(), std::ios::binary);
+    file.write(good.data(), good.size() - 1);
+  }
+  CPPUNIT_ASSERT_THROW(PluginIndex index(indexFile_), cms::Exception);
+
+  //not an index
+  {
+    std::ofstream file(indexFile_.string().c_str(), std::ios::binary);
+    file << kCache;
+  }
+  CPPUNIT_ASSERT_THROW(PluginIndex index(indexFile_), cms::Exception);
+}
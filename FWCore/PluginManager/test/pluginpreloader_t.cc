@@ -0,0 +1,86 @@
+// -*- C++ -*-
+//
+// Package:     PluginManager
+// Class  :     pluginpreloader_t
+//
+
+// system include files
+#include <Utilities/Testing/interface/CppUnit_testdriver.icpp>
+#include <cppunit/extensions/HelperMacros.h>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <unistd.h>
+#include <utility>
+#include <vector>
+
+// user include files
+#include "FWCore/PluginManager/interface/PluginManager.h"
+#include "FWCore/PluginManager/interface/PluginPreloader.h"
+#include "FWCore/PluginManager/interface/SharedLibrary.h"
+#include "FWCore/PluginManager/interface/standard.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "FWCore/PluginManager/test/DummyFactory.h"
+
+class TestPluginPreloader : public CppUnit::TestFixture {
+  CPPUNIT_TEST_SUITE(TestPluginPreloader);
+  CPPUNIT_TEST(test);
+  CPPUNIT_TEST_SUITE_END();
+
+public:
+  void test();
+  void setUp() {}
+  void tearDown() {}
+};
+
+///registration of the test so that the runner can find it
+CPPUNIT_TEST_SUITE_REGISTRATION(TestPluginPreloader);
+
+void TestPluginPreloader::test() {
+  using namespace testedmplugin;
+  edmplugin::PluginManager::configure(edmplugin::standard::config());
+
+  unsigned int nTimesLoaded = 0;
+  edmplugin::PluginManager::get()->justLoaded_.connect(
+      [&nTimesLoaded](const edmplugin::SharedLibrary&) { ++nTimesLoaded; });
+
+  std::string const recordFile = "pluginpreloader_t_" + std::to_string(::getpid()) + ".txt";
+  {
+    std::ofstream file(recordFile.c_str());
+    file << "Test Dummy\tDummyOne\n"
+         << "Test Dummy\tDoesNotExist\n"
+         << "No Such Category\tDummyOne\n"
+         << "a line without a tab\n";
+  }
+
+  {
+    //a missing plugin must not stop the preloading of the others
+    edmplugin::PluginPreloader preloader(recordFile);
+    CPPUNIT_ASSERT_NO_THROW(preloader.wait());
+    CPPUNIT_ASSERT(nTimesLoaded == 1);
+
+    std::vector<std::pair<std::string, std::string>> const expected = {{"Test Dummy", "DoesNotExist"},
+                                                                       {"No Such Category", "DummyOne"}};
+    CPPUNIT_ASSERT(preloader.notLoaded() == expected);
+
+    //the preloaded plugin is found without asking the PluginManager
+    std::unique_ptr<DummyBase> ptr(DummyFactory::get()->create("DummyOne"));
+    CPPUNIT_ASSERT(1 == ptr->value());
+    CPPUNIT_ASSERT(nTimesLoaded == 1);
+    //the requests of the job are recorded even when they fail
+    CPPUNIT_ASSERT_THROW(DummyFactory::get()->create("DummyThree"), cms::Exception);
+    preloader.writeRecord();
+  }
+
+  std::ifstream file(recordFile.c_str());
+  std::vector<std::string> lines;
+  std::string line;
+  while (std::getline(file, line)) {
+    lines.push_back(line);
+  }
+  file.close();
+  std::remove(recordFile.c_str());
+  CPPUNIT_ASSERT((lines == std::vector<std::string>{"Test Dummy\tDummyOne", "Test Dummy\tDummyThree"}));
+}
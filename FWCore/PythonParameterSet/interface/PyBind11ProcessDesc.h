@@ -4,8 +4,9 @@
 #include "FWCore/PythonParameterSet/interface/Python11ParameterSet.h"
 
 #include <memory>
-
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace edm {
@@ -27,6 +28,12 @@ public:
 
   PyBind11ProcessDesc(std::string const& config, int argc, char* argv[]);
 
+  /** As above. If recordInputs is true, the files the configuration
+      reads, the directories it lists and the environment variables it
+      looks at are recorded, which needs python 3.8 or later.
+  */
+  PyBind11ProcessDesc(std::string const& config, int argc, char* argv[], bool recordInputs);
+
   ~PyBind11ProcessDesc();
 
   Python11ParameterSet newPSet() const { return Python11ParameterSet(); }
@@ -42,8 +49,20 @@ public:
   // For backward compatibility only.  Remove when no longer needed.
   std::unique_ptr<edm::ProcessDesc> processDesc() const;
 
+  // the environment variables the configuration looked at, with their values or nothing if unset
+  using Environment = std::vector<std::pair<std::string, std::optional<std::string>>>;
+
+  // false if python could not record the inputs of the configuration
+  bool inputsRecorded() const;
+
+  // the python modules loaded so far, the other files read and the directories listed
+  std::vector<std::string> inputFiles() const;
+
+  Environment inputEnvironment() const;
+
 private:
   void prepareToRead();
+  void startRecordingInputs();
   void read(std::string const& config);
   void readFile(std::string const& fileName);
   void readString(std::string const& pyConfig);
@@ -6,6 +6,7 @@
 #include <pybind11/embed.h>
 #include <pybind11/pybind11.h>
 
+#include <algorithm>
 #include <sstream>
 #include <iostream>
 
@@ -20,6 +21,9 @@ PyBind11ProcessDesc::PyBind11ProcessDesc(std::string const& config)
 }
 
 PyBind11ProcessDesc::PyBind11ProcessDesc(std::string const& config, int argc, char* argv[])
+    : PyBind11ProcessDesc(config, argc, argv, false) {}
+
+PyBind11ProcessDesc::PyBind11ProcessDesc(std::string const& config, int argc, char* argv[], bool recordInputs)
     : theProcessPSet(),
       theMainModule(),
       theOwnsInterpreter(true)
@@ -28,6 +32,9 @@ PyBind11ProcessDesc::PyBind11ProcessDesc(std::string const& config, int argc, ch
   pybind11::initialize_interpreter();
   edm::python::initializePyBind11Module();
   prepareToRead();
+  if (recordInputs) {
+    startRecordingInputs();
+  }
   {
 #if PY_MAJOR_VERSION >= 3
     typedef std::unique_ptr<wchar_t[], decltype(&PyMem_RawFree)> WArgUPtr;
@@ -103,3 +110,102 @@ std::string PyBind11ProcessDesc::dump() const {
 std::unique_ptr<edm::ProcessDesc> PyBind11ProcessDesc::processDesc() const {
   return std::make_unique<edm::ProcessDesc>(parameterSet());
 }
+
+void PyBind11ProcessDesc::startRecordingInputs() {
+  // The audit hook sees the files opened for reading, including the python modules, and the
+  // directories listed, except by the import system. os.environ is patched as it raises no event.
+  std::string command(
+      "import os as _os, sys as _sys\n"
+      "if hasattr(_sys, 'addaudithook'):\n"
+      "    _inputs = {'paths': set(), 'environ': {}}\n"
+      "    _sys._edmConfigInputs = _inputs\n"
+      "    def _addPath(path):\n"
+      "        if path is None:\n"
+      "            path = '.'\n"
+      "        if isinstance(path, bytes):\n"
+      "            path = _os.fsdecode(path)\n"
+      "        if isinstance(path, str):\n"
+      "            path = _os.path.abspath(path)\n"
+      "            if not path.startswith(('/proc/', '/sys/', '/dev/')):\n"
+      "                _inputs['paths'].add(path)\n"
+      "    def _hook(event, args):\n"
+      "        try:\n"
+      "            if event == 'open':\n"
+      "                if (args[2] & _os.O_ACCMODE) == _os.O_RDONLY:\n"
+      "                    _addPath(args[0])\n"
+      "            elif event in ('os.listdir', 'os.scandir'):\n"
+      "                if not _sys._getframe(1).f_code.co_filename.startswith('<frozen'):\n"
+      "                    _addPath(args[0])\n"
+      "        except Exception:\n"
+      "            pass\n"
+      "    _getitem = _os._Environ.__getitem__\n"
+      "    def _recordedGetitem(self, key):\n"
+      "        try:\n"
+      "            value = _getitem(self, key)\n"
+      "        except KeyError:\n"
+      "            if self is _os.environ:\n"
+      "                _inputs['environ'].setdefault(key, None)\n"
+      "            raise\n"
+      "        if self is _os.environ:\n"
+      "            _inputs['environ'].setdefault(key, value)\n"
+      "        return value\n"
+      "    _os._Environ.__getitem__ = _recordedGetitem\n"
+      "    _sys.addaudithook(_hook)\n");
+  try {
+    pybind11::dict scope;
+    scope["__builtins__"] = pybind11::module::import("builtins");
+    pybind11::exec(command, scope);
+  } catch (pybind11::error_already_set const& e) {
+    edm::pythonToCppException("Configuration", e.what());
+  }
+}
+
+bool PyBind11ProcessDesc::inputsRecorded() const {
+  return pybind11::hasattr(pybind11::module::import("sys"), "_edmConfigInputs");
+}
+
+std::vector<std::string> PyBind11ProcessDesc::inputFiles() const {
+  std::string command(
+      "import os as _os, sys as _sys\n"
+      "_files = set(getattr(_sys, '_edmConfigInputs', {}).get('paths', ()))\n"
+      "for _module in list(_sys.modules.values()):\n"
+      "    _file = getattr(_module, '__file__', None)\n"
+      "    if _file:\n"
+      "        if _file.endswith('.pyc') and _os.path.exists(_file[:-1]):\n"
+      "            _file = _file[:-1]\n"
+      "        _files.add(_os.path.abspath(_file))\n"
+      "_files = sorted(_files)\n");
+  std::vector<std::string> files;
+  try {
+    pybind11::dict locals;
+    pybind11::exec(command, pybind11::globals(), locals);
+    for (auto const& file : locals["_files"]) {
+      files.push_back(file.cast<std::string>());
+    }
+  } catch (pybind11::error_already_set const& e) {
+    edm::pythonToCppException("Configuration", e.what());
+  }
+  return files;
+}
+
+PyBind11ProcessDesc::Environment PyBind11ProcessDesc::inputEnvironment() const {
+  Environment environment;
+  try {
+    auto sys = pybind11::module::import("sys");
+    if (not pybind11::hasattr(sys, "_edmConfigInputs")) {
+      return environment;
+    }
+    pybind11::dict variables = sys.attr("_edmConfigInputs")["environ"];
+    for (auto const& variable : variables) {
+      if (variable.second.is_none()) {
+        environment.emplace_back(variable.first.cast<std::string>(), std::nullopt);
+      } else {
+        environment.emplace_back(variable.first.cast<std::string>(), variable.second.cast<std::string>());
+      }
+    }
+  } catch (pybind11::error_already_set const& e) {
+    edm::pythonToCppException("Configuration", e.what());
+  }
+  std::sort(environment.begin(), environment.end());
+  return environment;
+}
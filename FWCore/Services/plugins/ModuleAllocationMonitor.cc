@@ -0,0 +1,446 @@
+// -*- C++ -*-
+//
+// Package:     Services
+// Class  :     ModuleAllocationMonitor
+//
+// Implementation:
+//     The heap allocations are counted per thread by libPerfToolsAllocMonitorPreload.so,
+//  see FWCore/Utilities/interface/AllocationCounters.h. The service takes the
+//  difference of the counters of the thread between the pre and post signals
+//  of each module transition. A module can be run on a thread which is already
+//  running another module, e.g. for unscheduled execution, so the running
+//  modules of a thread are kept on a stack and what a nested module allocates
+//  is removed from the module it is nested in.
+//
+//     For the peak memory of each Event, what the modules of a Stream keep
+//  is summed while the Event is processed. The memory given back by the
+//  framework between two modules, e.g. when products are deleted early, is
+//  given to the Stream of the module which ran last on the thread. This is
+//  only approximate, since a thread may run the framework code of another
+//  Stream before it starts a module.
+//
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <dlfcn.h>
+#include <iomanip>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "DataFormats/Provenance/interface/EventID.h"
+#include "DataFormats/Provenance/interface/ModuleDescription.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/ParameterSet/interface/ConfigurationDescriptions.h"
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
+#include "FWCore/ServiceRegistry/interface/ActivityRegistry.h"
+#include "FWCore/ServiceRegistry/interface/GlobalContext.h"
+#include "FWCore/ServiceRegistry/interface/ModuleCallingContext.h"
+#include "FWCore/ServiceRegistry/interface/ServiceMaker.h"
+#include "FWCore/ServiceRegistry/interface/StreamContext.h"
+#include "FWCore/ServiceRegistry/interface/SystemBounds.h"
+#include "FWCore/Utilities/interface/AllocationCounters.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+namespace edm {
+  namespace service {
+    class ModuleAllocationMonitor {
+    public:
+      ModuleAllocationMonitor(ParameterSet const&, ActivityRegistry&);
+
+      static void fillDescriptions(ConfigurationDescriptions& descriptions);
+
+    private:
+      enum Transition {
+        kConstruction,
+        kBeginJob,
+        kBeginStream,
+        kBeginRun,
+        kBeginLumi,
+        kEvent,
+        kEndLumi,
+        kEndRun,
+        kEndStream,
+        kEndJob,
+        kNTransitions
+      };
+
+      struct TransitionStats {
+        std::atomic<std::uint64_t> nCalls_{0};
+        std::atomic<std::uint64_t> nAllocations_{0};
+        std::atomic<std::uint64_t> nDeallocations_{0};
+        std::atomic<std::uint64_t> bytesAllocated_{0};
+        std::atomic<std::uint64_t> bytesDeallocated_{0};
+        //largest increase of the live bytes during a single call
+        std::atomic<std::int64_t> maxPeakLiveBytes_{0};
+      };
+
+      struct ModuleStats {
+        ModuleStats(std::string const& iLabel, std::string const& iType) : label_(iLabel), type_(iType) {}
+        std::string label_;
+        std::string type_;
+        std::array<TransitionStats, kNTransitions> transitions_;
+      };
+
+      //the memory kept by the modules of a Stream while processing an Event
+      struct StreamMemory {
+        std::atomic<std::int64_t> liveBytes_{0};
+        std::atomic<std::int64_t> peakLiveBytes_{0};
+        //only used from the pre and post Event signals of the Stream
+        std::uint64_t nEvents_ = 0;
+        double sumPeakLiveBytes_ = 0.;
+        std::int64_t maxPeakLiveBytes_ = 0;
+        EventID maxPeakEvent_;
+      };
+
+      struct Frame {
+        TransitionStats* stats_;
+        //negative if not an Event transition
+        int stream_;
+        AllocationCounters start_;
+        //what modules nested in this one did
+        AllocationCounters nested_;
+        std::int64_t enclosingPeakLiveBytes_;
+      };
+
+      void addModule(ModuleDescription const& iDescription);
+      TransitionStats* stats(unsigned int iModuleID, Transition iTransition) const;
+      void pre(TransitionStats* iStats, int iStream = -1);
+      void post();
+      void closeGap();
+      void addToStream(int iStream, std::int64_t iLiveBytes, std::int64_t iPeakLiveBytes);
+      void postEvent(StreamContext const& iContext);
+      void postEndJob() const;
+
+      static std::vector<Frame>& frames();
+
+      //the Stream to which the memory changes of the thread outside of a module are given
+      struct Gap {
+        int stream_ = -1;
+        std::int64_t startLiveBytes_ = 0;
+      };
+      static Gap& gap();
+
+      AllocationCountersFunction counters_;
+      //filled while the modules are constructed, which is done serially
+      std::vector<std::unique_ptr<ModuleStats>> modules_;
+      unsigned int sourceID_;
+      std::vector<StreamMemory> streams_;
+    };
+  }  // namespace service
+}  // namespace edm
+
+using namespace edm::service;
+
+namespace {
+  char const* const kTransitionNames[] = {"construction",
+                                          "beginJob",
+                                          "beginStream",
+                                          "beginRun",
+                                          "beginLumi",
+                                          "event",
+                                          "endLumi",
+                                          "endRun",
+                                          "endStream",
+                                          "endJob"};
+
+  void atomicMax(std::atomic<std::int64_t>& iMax, std::int64_t iValue) {
+    auto old = iMax.load(std::memory_order_relaxed);
+    while (old < iValue and not iMax.compare_exchange_weak(old, iValue, std::memory_order_relaxed)) {
+    }
+  }
+
+  double perCall(std::uint64_t iValue, std::uint64_t iCalls) { return iCalls == 0 ? 0. : double(iValue) / iCalls; }
+}  // namespace
+
+ModuleAllocationMonitor::ModuleAllocationMonitor(ParameterSet const&, ActivityRegistry& iReg)
+    : counters_(reinterpret_cast<AllocationCountersFunction>(dlsym(RTLD_DEFAULT, kAllocationCountersFunctionName))),
+      sourceID_(0) {
+  if (counters_ == nullptr) {
+    throw cms::Exception("Configuration")
+        << "The ModuleAllocationMonitor service needs the heap allocations to be counted, which is done by "
+           "libPerfToolsAllocMonitorPreload.so. Run the job with\n"
+           "  LD_PRELOAD=libPerfToolsAllocMonitorPreload.so cmsRun ...";
+  }
+
+  iReg.watchPreModuleConstruction([this](ModuleDescription const& iDesc) {
+    addModule(iDesc);
+    pre(stats(iDesc.id(), kConstruction));
+  });
+  iReg.watchPostModuleConstruction([this](ModuleDescription const&) { post(); });
+  iReg.watchPreSourceConstruction([this](ModuleDescription const& iDesc) {
+    addModule(iDesc);
+    sourceID_ = iDesc.id();
+    pre(stats(iDesc.id(), kConstruction));
+  });
+  iReg.watchPostSourceConstruction([this](ModuleDescription const&) { post(); });
+
+  iReg.watchPreModuleBeginJob([this](ModuleDescription const& iDesc) { pre(stats(iDesc.id(), kBeginJob)); });
+  iReg.watchPostModuleBeginJob([this](ModuleDescription const&) { post(); });
+  iReg.watchPreModuleEndJob([this](ModuleDescription const& iDesc) { pre(stats(iDesc.id(), kEndJob)); });
+  iReg.watchPostModuleEndJob([this](ModuleDescription const&) { post(); });
+
+  auto preStream = [this](Transition iTransition) {
+    return [this, iTransition](StreamContext const& iStream, ModuleCallingContext const& iContext) {
+      pre(stats(iContext.moduleDescription()->id(), iTransition),
+          iTransition == kEvent ? static_cast<int>(iStream.streamID().value()) : -1);
+    };
+  };
+  auto postStream = [this](StreamContext const&, ModuleCallingContext const&) { post(); };
+  auto preGlobal = [this](Transition iTransition) {
+    return [this, iTransition](GlobalContext const&, ModuleCallingContext const& iContext) {
+      pre(stats(iContext.moduleDescription()->id(), iTransition));
+    };
+  };
+  auto postGlobal = [this](GlobalContext const&, ModuleCallingContext const&) { post(); };
+
+  iReg.watchPreModuleBeginStream(preStream(kBeginStream));
+  iReg.watchPostModuleBeginStream(postStream);
+  iReg.watchPreModuleEndStream(preStream(kEndStream));
+  iReg.watchPostModuleEndStream(postStream);
+
+  iReg.watchPreModuleEvent(preStream(kEvent));
+  iReg.watchPostModuleEvent(postStream);
+  iReg.watchPreModuleEventAcquire(preStream(kEvent));
+  iReg.watchPostModuleEventAcquire(postStream);
+
+  iReg.watchPreModuleStreamBeginRun(preStream(kBeginRun));
+  iReg.watchPostModuleStreamBeginRun(postStream);
+  iReg.watchPreModuleStreamEndRun(preStream(kEndRun));
+  iReg.watchPostModuleStreamEndRun(postStream);
+  iReg.watchPreModuleStreamBeginLumi(preStream(kBeginLumi));
+  iReg.watchPostModuleStreamBeginLumi(postStream);
+  iReg.watchPreModuleStreamEndLumi(preStream(kEndLumi));
+  iReg.watchPostModuleStreamEndLumi(postStream);
+
+  iReg.watchPreModuleGlobalBeginRun(preGlobal(kBeginRun));
+  iReg.watchPostModuleGlobalBeginRun(postGlobal);
+  iReg.watchPreModuleGlobalEndRun(preGlobal(kEndRun));
+  iReg.watchPostModuleGlobalEndRun(postGlobal);
+  iReg.watchPreModuleGlobalBeginLumi(preGlobal(kBeginLumi));
+  iReg.watchPostModuleGlobalBeginLumi(postGlobal);
+  iReg.watchPreModuleGlobalEndLumi(preGlobal(kEndLumi));
+  iReg.watchPostModuleGlobalEndLumi(postGlobal);
+
+  iReg.watchPreSourceEvent([this](StreamID iStream) {
+    //the Event starts with the source
+    closeGap();
+    if (iStream.value() < streams_.size()) {
+      auto& stream = streams_[iStream.value()];
+      stream.liveBytes_ = 0;
+      stream.peakLiveBytes_ = 0;
+    }
+    pre(stats(sourceID_, kEvent), iStream.value());
+  });
+  iReg.watchPostSourceEvent([this](StreamID) { post(); });
+  iReg.watchPreSourceLumi([this](LuminosityBlockIndex) { pre(stats(sourceID_, kBeginLumi)); });
+  iReg.watchPostSourceLumi([this](LuminosityBlockIndex) { post(); });
+  iReg.watchPreSourceRun([this](RunIndex) { pre(stats(sourceID_, kBeginRun)); });
+  iReg.watchPostSourceRun([this](RunIndex) { post(); });
+
+  iReg.watchPreallocate([this](service::SystemBounds const& iBounds) {
+    streams_ = std::vector<StreamMemory>(iBounds.maxNumberOfStreams());
+  });
+  iReg.watchPostEvent([this](StreamContext const& iContext) { postEvent(iContext); });
+
+  iReg.watchPostEndJob([this]() { postEndJob(); });
+}
+
+void ModuleAllocationMonitor::fillDescriptions(ConfigurationDescriptions& descriptions) {
+  ParameterSetDescription desc;
+  descriptions.add("ModuleAllocationMonitor", desc);
+  descriptions.setComment(
+      "This service reports the heap allocations of each module for each kind of transition. The job must be run "
+      "with libPerfToolsAllocMonitorPreload.so in LD_PRELOAD.");
+}
+
+void ModuleAllocationMonitor::addModule(ModuleDescription const& iDescription) {
+  if (modules_.size() <= iDescription.id()) {
+    modules_.resize(iDescription.id() + 1);
+  }
+  modules_[iDescription.id()] =
+      std::make_unique<ModuleStats>(iDescription.moduleLabel(), iDescription.moduleName());
+}
+
+ModuleAllocationMonitor::TransitionStats* ModuleAllocationMonitor::stats(unsigned int iModuleID,
+                                                                         Transition iTransition) const {
+  if (iModuleID < modules_.size() and modules_[iModuleID]) {
+    return &modules_[iModuleID]->transitions_[iTransition];
+  }
+  //e.g. a module of a SubProcess constructed before the service
+  return nullptr;
+}
+
+std::vector<ModuleAllocationMonitor::Frame>& ModuleAllocationMonitor::frames() {
+  static thread_local std::vector<Frame> s_frames;
+  return s_frames;
+}
+
+ModuleAllocationMonitor::Gap& ModuleAllocationMonitor::gap() {
+  static thread_local Gap s_gap;
+  return s_gap;
+}
+
+void ModuleAllocationMonitor::closeGap() {
+  auto& threadGap = gap();
+  if (threadGap.stream_ < 0) {
+    return;
+  }
+  auto& counters = *counters_();
+  auto const change = counters.liveBytes_ - threadGap.startLiveBytes_;
+  addToStream(threadGap.stream_, change, change);
+  threadGap.stream_ = -1;
+}
+
+void ModuleAllocationMonitor::addToStream(int iStream, std::int64_t iLiveBytes, std::int64_t iPeakLiveBytes) {
+  if (static_cast<unsigned int>(iStream) >= streams_.size()) {
+    return;
+  }
+  auto& stream = streams_[iStream];
+  auto const before = stream.liveBytes_.fetch_add(iLiveBytes, std::memory_order_relaxed);
+  atomicMax(stream.peakLiveBytes_, before + std::max(iLiveBytes, iPeakLiveBytes));
+}
+
+void ModuleAllocationMonitor::postEvent(StreamContext const& iContext) {
+  auto const index = iContext.streamID().value();
+  if (gap().stream_ == static_cast<int>(index)) {
+    closeGap();
+  }
+  if (index >= streams_.size()) {
+    return;
+  }
+  auto& stream = streams_[index];
+  auto const peak = stream.peakLiveBytes_.load();
+  ++stream.nEvents_;
+  stream.sumPeakLiveBytes_ += peak;
+  if (peak > stream.maxPeakLiveBytes_ or stream.nEvents_ == 1) {
+    stream.maxPeakLiveBytes_ = peak;
+    stream.maxPeakEvent_ = iContext.eventID();
+  }
+}
+
+void ModuleAllocationMonitor::pre(TransitionStats* iStats, int iStream) {
+  auto& stack = frames();
+  if (stack.empty()) {
+    closeGap();
+  }
+  //a frame is pushed even without stats so the nested modules stay balanced
+  stack.emplace_back();
+  auto& counters = *counters_();
+  auto& frame = stack.back();
+  frame.stats_ = iStats;
+  frame.stream_ = iStream;
+  frame.start_ = counters;
+  frame.nested_ = AllocationCounters();
+  frame.enclosingPeakLiveBytes_ = counters.peakLiveBytes_;
+  counters.peakLiveBytes_ = counters.liveBytes_;
+}
+
+void ModuleAllocationMonitor::post() {
+  auto& stack = frames();
+  if (stack.empty()) {
+    return;
+  }
+  auto& counters = *counters_();
+  AllocationCounters const now = counters;
+  Frame const frame = stack.back();
+  stack.pop_back();
+  counters.peakLiveBytes_ = std::max(frame.enclosingPeakLiveBytes_, now.liveBytes_);
+
+  AllocationCounters all;
+  all.nAllocations_ = now.nAllocations_ - frame.start_.nAllocations_;
+  all.nDeallocations_ = now.nDeallocations_ - frame.start_.nDeallocations_;
+  all.bytesAllocated_ = now.bytesAllocated_ - frame.start_.bytesAllocated_;
+  all.bytesDeallocated_ = now.bytesDeallocated_ - frame.start_.bytesDeallocated_;
+  if (not stack.empty()) {
+    auto& nested = stack.back().nested_;
+    nested.nAllocations_ += all.nAllocations_;
+    nested.nDeallocations_ += all.nDeallocations_;
+    nested.bytesAllocated_ += all.bytesAllocated_;
+    nested.bytesDeallocated_ += all.bytesDeallocated_;
+  }
+  if (frame.stream_ >= 0) {
+    addToStream(frame.stream_,
+                (all.bytesAllocated_ - frame.nested_.bytesAllocated_) -
+                    (all.bytesDeallocated_ - frame.nested_.bytesDeallocated_),
+                now.peakLiveBytes_ - frame.start_.liveBytes_);
+    if (stack.empty()) {
+      auto& threadGap = gap();
+      threadGap.stream_ = frame.stream_;
+      threadGap.startLiveBytes_ = now.liveBytes_;
+    }
+  }
+
+  if (frame.stats_ == nullptr) {
+    return;
+  }
+  auto& stats = *frame.stats_;
+  stats.nCalls_.fetch_add(1, std::memory_order_relaxed);
+  stats.nAllocations_.fetch_add(all.nAllocations_ - frame.nested_.nAllocations_, std::memory_order_relaxed);
+  stats.nDeallocations_.fetch_add(all.nDeallocations_ - frame.nested_.nDeallocations_, std::memory_order_relaxed);
+  stats.bytesAllocated_.fetch_add(all.bytesAllocated_ - frame.nested_.bytesAllocated_, std::memory_order_relaxed);
+  stats.bytesDeallocated_.fetch_add(all.bytesDeallocated_ - frame.nested_.bytesDeallocated_,
+                                    std::memory_order_relaxed);
+  atomicMax(stats.maxPeakLiveBytes_, now.peakLiveBytes_ - frame.start_.liveBytes_);
+}
+
+void ModuleAllocationMonitor::postEndJob() const {
+  std::ostringstream out;
+  out << "AllocationReport> Heap allocations per module, sizes in kB\n";
+  for (unsigned int t = 0; t < kNTransitions; ++t) {
+    std::vector<ModuleStats const*> modules;
+    for (auto const& module : modules_) {
+      if (module and module->transitions_[t].nCalls_ != 0) {
+        modules.push_back(module.get());
+      }
+    }
+    if (modules.empty()) {
+      continue;
+    }
+    std::sort(modules.begin(), modules.end(), [t](ModuleStats const* iLHS, ModuleStats const* iRHS) {
+      return iLHS->transitions_[t].bytesAllocated_ > iRHS->transitions_[t].bytesAllocated_;
+    });
+
+    out << "\nAllocationReport> " << kTransitionNames[t] << "\n"
+        << std::setw(10) << "calls" << std::setw(14) << "allocs/call" << std::setw(14) << "deallocs/call"
+        << std::setw(14) << "alloc/call" << std::setw(14) << "freed/call" << std::setw(14) << "max peak"
+        << std::setw(14) << "retained"
+        << "  module\n";
+    out << std::fixed << std::setprecision(1);
+    for (auto const* module : modules) {
+      auto const& stats = module->transitions_[t];
+      auto const nCalls = stats.nCalls_.load();
+      std::int64_t retained = stats.bytesAllocated_ - stats.bytesDeallocated_;
+      out << std::setw(10) << nCalls << std::setw(14) << perCall(stats.nAllocations_, nCalls) << std::setw(14)
+          << perCall(stats.nDeallocations_, nCalls) << std::setw(14) << perCall(stats.bytesAllocated_, nCalls) / 1024
+          << std::setw(14) << perCall(stats.bytesDeallocated_, nCalls) / 1024 << std::setw(14)
+          << stats.maxPeakLiveBytes_ / 1024. << std::setw(14) << retained / 1024. << "  " << module->label_ << " ("
+          << module->type_ << ")\n";
+    }
+  }
+
+  std::uint64_t nEvents = 0;
+  double sumPeaks = 0.;
+  StreamMemory const* maxStream = nullptr;
+  for (auto const& stream : streams_) {
+    nEvents += stream.nEvents_;
+    sumPeaks += stream.sumPeakLiveBytes_;
+    if (stream.nEvents_ != 0 and (maxStream == nullptr or stream.maxPeakLiveBytes_ > maxStream->maxPeakLiveBytes_)) {
+      maxStream = &stream;
+    }
+  }
+  if (maxStream != nullptr) {
+    out << "\nAllocationReport> event peak memory, the largest amount kept by the modules of a Stream during an "
+           "Event, in kB\n"
+        << std::setw(10) << "events" << std::setw(14) << "mean peak" << std::setw(14) << "max peak"
+        << "  event of max peak\n"
+        << std::setw(10) << nEvents << std::setw(14) << sumPeaks / nEvents / 1024 << std::setw(14)
+        << maxStream->maxPeakLiveBytes_ / 1024. << "  " << maxStream->maxPeakEvent_ << "\n";
+  }
+  LogImportant("AllocationReport") << out.str();
+}
+
+DEFINE_FWK_SERVICE(ModuleAllocationMonitor);
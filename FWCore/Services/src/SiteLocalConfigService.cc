@@ -456,7 +456,11 @@ namespace edm {
       desc.addOptionalUntracked<std::string>("overrideSourceCacheHintDir");
       desc.addOptionalUntracked<std::string>("overrideSourceCloneCacheHintDir")
           ->setComment("Provide an alternate cache hint for fast cloning.");
-      desc.addOptionalUntracked<std::string>("overrideSourceReadHint");
+      desc.addOptionalUntracked<std::string>("overrideSourceReadHint")
+          ->setComment(
+              "Provide an alternate read hint: 'direct-unbuffered', 'read-ahead-buffered', 'auto-detect' or "
+              "'memory-mapped' (read local input files through a memory mapping; the files must not be truncated "
+              "while the job runs).");
       desc.addOptionalUntracked<std::vector<std::string> >("overrideSourceNativeProtocols");
       desc.addOptionalUntracked<unsigned int>("overrideSourceTTreeCacheSize");
       desc.addOptionalUntracked<unsigned int>("overrideSourceTimeout");
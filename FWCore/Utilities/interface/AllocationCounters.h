@@ -0,0 +1,50 @@
+#ifndef FWCore_Utilities_AllocationCounters_h
+#define FWCore_Utilities_AllocationCounters_h
+// -*- C++ -*-
+//
+// Package:     Utilities
+// Class  :     AllocationCounters
+//
+/**\class AllocationCounters AllocationCounters.h FWCore/Utilities/interface/AllocationCounters.h
+
+ Description: Heap allocations done by a thread
+
+ Usage:
+    The counters are kept by the malloc replacement of
+ libPerfToolsAllocMonitorPreload.so, which has to be given in LD_PRELOAD.
+ When preloaded, the library provides the function named
+ kAllocationCountersFunctionName, of type AllocationCountersFunction, which
+ returns the counters of the calling thread. The counters only ever change
+ from their own thread, so the thread may read them without synchronization.
+
+    Bytes are counted with malloc_usable_size, so an allocation and its
+ deallocation count the same number of bytes. Memory is counted as freed by
+ the thread freeing it, so liveBytes_ can be negative.
+
+*/
+
+// system include files
+#include <cstdint>
+
+// user include files
+
+// forward declarations
+namespace edm {
+  struct AllocationCounters {
+    std::uint64_t nAllocations_;
+    std::uint64_t nDeallocations_;
+    std::uint64_t bytesAllocated_;
+    std::uint64_t bytesDeallocated_;
+    std::int64_t liveBytes_;
+    ///largest liveBytes_ since the last time a user lowered it
+    std::int64_t peakLiveBytes_;
+  };
+
+  extern "C" {
+  typedef AllocationCounters* (*AllocationCountersFunction)();
+  }
+
+  constexpr char const* const kAllocationCountersFunctionName = "edmAllocationCountersOfThisThread";
+}  // namespace edm
+
+#endif
@@ -0,0 +1,36 @@
+#ifndef FWCore_Utilities_SharedReadOnlyMemory_h
+#define FWCore_Utilities_SharedReadOnlyMemory_h
+
+/*
+  Memory made once on a node and used read-only by all the processes asking for
+  it with the same name, e.g. large tables computed identically by every job.
+
+  The first process asking for a name makes a segment in iDirectory (/dev/shm is
+  shared memory on Linux), fills it with iFill and marks it complete; the others
+  wait for it to be complete and map it read-only. The name must identify the
+  content completely: a segment is never changed once complete. Only the segments
+  made by the same user, and writable by nobody else, are used. If no segment can
+  be used, e.g. the directory is not writable, the memory is private to the
+  process and filled by iFill as well.
+
+  Each process holds a shared lock on the segments it uses, and the last one to
+  release a segment removes it. The segments of processes which crashed stay;
+  they are removed by deleting the files named cmssw_shared_* in iDirectory. The
+  memory returned is aligned to 64 bytes.
+*/
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace edm {
+  std::shared_ptr<const void> sharedReadOnlyMemory(std::string const& iName,
+                                                   std::size_t iSize,
+                                                   std::function<void(void*)> const& iFill,
+                                                   std::string const& iDirectory = "/dev/shm");
+
+  ///the file of the segment used for iName
+  std::string sharedReadOnlyMemoryFile(std::string const& iName, std::string const& iDirectory = "/dev/shm");
+}  // namespace edm
+#endif
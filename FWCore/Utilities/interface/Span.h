@@ -0,0 +1,53 @@
+#ifndef FWCore_Utilities_Span_h
+#define FWCore_Utilities_Span_h
+
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+
+namespace edm {
+  /*
+   * A view of a contiguous sequence of objects, owned elsewhere: a pointer
+   * to the first one and their number. Span<T const> gives read only access.
+   * To be replaced by std::span once the code moves to C++20.
+   */
+  template <typename T>
+  class Span {
+  public:
+    typedef T element_type;
+    typedef std::remove_cv_t<T> value_type;
+    typedef T* iterator;
+
+    constexpr Span() noexcept : data_(nullptr), size_(0) {}
+    constexpr Span(T* data, std::size_t size) noexcept : data_(data), size_(size) {}
+
+    // from any contiguous container with data() and size(), including a Span of non const objects
+    template <typename C,
+              typename = std::enable_if_t<std::is_convertible<decltype(std::declval<C&>().data()), T*>::value>>
+    constexpr Span(C& container) noexcept : data_(container.data()), size_(container.size()) {}
+
+    template <typename C,
+              typename = std::enable_if_t<std::is_convertible<decltype(std::declval<C const&>().data()), T*>::value>>
+    constexpr Span(C const& container) noexcept : data_(container.data()), size_(container.size()) {}
+
+    constexpr T* data() const noexcept { return data_; }
+    constexpr std::size_t size() const noexcept { return size_; }
+    constexpr bool empty() const noexcept { return size_ == 0; }
+
+    constexpr iterator begin() const noexcept { return data_; }
+    constexpr iterator end() const noexcept { return data_ + size_; }
+
+    constexpr T& operator[](std::size_t i) const { return data_[i]; }
+
+    // the count objects starting at offset, or up to the end
+    constexpr Span subspan(std::size_t offset, std::size_t count = std::size_t(-1)) const {
+      return Span(data_ + offset, count < size_ - offset ? count : size_ - offset);
+    }
+
+  private:
+    T* data_;
+    std::size_t size_;
+  };
+}  // namespace edm
+
+#endif
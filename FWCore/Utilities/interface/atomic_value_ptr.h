@@ -64,10 +64,10 @@ namespace edm {
       return *this;
     }
 
-    atomic_value_ptr(atomic_value_ptr&& orig) : myP(orig.myP.load()) { orig.myP.store(nullptr); }
+    atomic_value_ptr(atomic_value_ptr&& orig) noexcept : myP(orig.myP.load()) { orig.myP.store(nullptr); }
 
-    atomic_value_ptr& operator=(atomic_value_ptr&& orig) {
-      atomic_value_ptr<T> local(orig);
+    atomic_value_ptr& operator=(atomic_value_ptr&& orig) noexcept {
+      atomic_value_ptr<T> local(std::move(orig));
       exchangeWithLocal(local);
       return *this;
     }
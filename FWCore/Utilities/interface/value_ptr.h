@@ -86,9 +86,9 @@ namespace edm {
     // Move constructor/move assignment:
     // --------------------------------------------------
 
-    value_ptr(value_ptr&& orig) : myP(orig.myP) { orig.myP = nullptr; }
+    value_ptr(value_ptr&& orig) noexcept : myP(orig.myP) { orig.myP = nullptr; }
 
-    value_ptr& operator=(value_ptr&& orig) {
+    value_ptr& operator=(value_ptr&& orig) noexcept {
       if (myP != orig.myP) {
         delete myP.get();
         myP = orig.myP;
@@ -0,0 +1,166 @@
+#include "FWCore/Utilities/interface/SharedReadOnlyMemory.h"
+#include "FWCore/Utilities/interface/Digest.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <fcntl.h>
+#include <sys/file.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace edm {
+  namespace {
+    //the segment is the header, followed by the memory at an offset of 64 bytes
+    struct Header {
+      char magic[8];
+      std::uint64_t size;
+      std::uint64_t complete;
+    };
+    constexpr char const kMagic[8] = {'C', 'M', 'S', 'S', 'H', 'R', 'D', '1'};
+    constexpr std::size_t kOffset = 64;
+    constexpr std::uint64_t kComplete = 0x636f6d706c657465;
+    static_assert(sizeof(Header) <= kOffset, "the header does not fit before the memory");
+
+    std::shared_ptr<const void> privateMemory(std::size_t iSize, std::function<void(void*)> const& iFill) {
+      void* address = ::operator new(std::max(iSize, std::size_t(1)), std::align_val_t(kOffset));
+      std::shared_ptr<void> memory(address, [](void* p) { ::operator delete(p, std::align_val_t(kOffset)); });
+      iFill(memory.get());
+      return memory;
+    }
+
+    void lock(int iFd, int iOperation) {
+      while (::flock(iFd, iOperation) != 0 and errno == EINTR) {
+      }
+    }
+
+    //the segment is mapped with its file kept open and share-locked, so the last process using it can remove it;
+    //the file descriptor is owned by the memory returned
+    std::shared_ptr<const void> map(int iFd, std::string const& iFile, std::size_t iSize) {
+      void* address = ::mmap(nullptr, kOffset + iSize, PROT_READ, MAP_SHARED, iFd, 0);
+      if (address == MAP_FAILED) {
+        ::close(iFd);
+        return std::shared_ptr<const void>();
+      }
+      lock(iFd, LOCK_SH);
+      std::size_t mappedSize = kOffset + iSize;
+      std::shared_ptr<const void> mapping(address, [iFd, iFile, mappedSize](const void* p) {
+        ::munmap(const_cast<void*>(p), mappedSize);
+        //the exclusive lock is only granted once no other process holds the segment; a segment already
+        //removed is not linked any more, and its name may have been reused meanwhile
+        struct stat status;
+        if (::flock(iFd, LOCK_EX | LOCK_NB) == 0 and ::fstat(iFd, &status) == 0 and status.st_nlink > 0) {
+          ::unlink(iFile.c_str());
+        }
+        ::close(iFd);
+      });
+      return std::shared_ptr<const void>(mapping, static_cast<const char*>(address) + kOffset);
+    }
+
+    bool isComplete(int iFd, std::size_t iSize) {
+      struct stat status;
+      if (::fstat(iFd, &status) != 0 or status.st_size != static_cast<off_t>(kOffset + iSize)) {
+        return false;
+      }
+      Header header;
+      if (::pread(iFd, &header, sizeof(Header), 0) != static_cast<ssize_t>(sizeof(Header))) {
+        return false;
+      }
+      return std::equal(kMagic, kMagic + 8, header.magic) and header.size == iSize and header.complete == kComplete;
+    }
+
+    //only a segment made by a process of the same user is used: the directory is writable by everyone
+    bool isTrusted(struct stat const& iStatus) {
+      mode_t permissions = iStatus.st_mode & 07777;
+      return S_ISREG(iStatus.st_mode) and iStatus.st_uid == ::geteuid() and
+             (permissions == 0600 or permissions == 0644);
+    }
+
+    //every process using a segment holds a shared lock on it, and the one filling it an exclusive lock
+    std::shared_ptr<const void> makeOrAttach(std::string const& iFile,
+                                             std::size_t iSize,
+                                             std::function<void(void*)> const& iFill) {
+      //a segment removed by its last user while waiting for the lock is made again
+      for (int attempt = 0; attempt < 3; ++attempt) {
+        int fd = ::open(iFile.c_str(), O_RDWR | O_CREAT | O_NOFOLLOW | O_CLOEXEC, 0600);
+        if (fd < 0) {
+          return std::shared_ptr<const void>();
+        }
+        lock(fd, LOCK_SH);
+        struct stat status;
+        if (::fstat(fd, &status) != 0 or not isTrusted(status)) {
+          ::close(fd);
+          return std::shared_ptr<const void>();
+        }
+        if (status.st_nlink == 0) {
+          ::close(fd);
+          continue;
+        }
+        if (isComplete(fd, iSize)) {
+          return map(fd, iFile, iSize);
+        }
+        //a segment of another size with the same name is never changed, as it may be in use
+        if (status.st_size != 0 and status.st_size != static_cast<off_t>(kOffset + iSize)) {
+          ::close(fd);
+          return std::shared_ptr<const void>();
+        }
+        lock(fd, LOCK_EX);
+        if (::fstat(fd, &status) != 0 or status.st_nlink == 0) {
+          ::close(fd);
+          continue;
+        }
+        //another process may have filled it meanwhile
+        if (not isComplete(fd, iSize)) {
+          if (::ftruncate(fd, kOffset + iSize) != 0) {
+            ::close(fd);
+            return std::shared_ptr<const void>();
+          }
+          void* address = ::mmap(nullptr, kOffset + iSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+          if (address == MAP_FAILED) {
+            ::close(fd);
+            return std::shared_ptr<const void>();
+          }
+          std::shared_ptr<void> guard(address, [iSize](void* p) { ::munmap(p, kOffset + iSize); });
+          Header* header = static_cast<Header*>(address);
+          std::copy(kMagic, kMagic + 8, header->magic);
+          header->size = iSize;
+          header->complete = 0;
+          try {
+            iFill(static_cast<char*>(address) + kOffset);
+          } catch (...) {
+            //the exclusive lock is held, so the name still refers to this segment
+            ::unlink(iFile.c_str());
+            ::close(fd);
+            throw;
+          }
+          header->complete = kComplete;
+        }
+        if (isComplete(fd, iSize)) {
+          return map(fd, iFile, iSize);
+        }
+        ::close(fd);
+        return std::shared_ptr<const void>();
+      }
+      return std::shared_ptr<const void>();
+    }
+  }  // namespace
+
+  std::string sharedReadOnlyMemoryFile(std::string const& iName, std::string const& iDirectory) {
+    //the user is part of the name, so the segments of different users never collide
+    return iDirectory + "/cmssw_shared_" + std::to_string(::geteuid()) + "_" + cms::Digest(iName).digest().toString();
+  }
+
+  std::shared_ptr<const void> sharedReadOnlyMemory(std::string const& iName,
+                                                   std::size_t iSize,
+                                                   std::function<void(void*)> const& iFill,
+                                                   std::string const& iDirectory) {
+    auto memory = makeOrAttach(sharedReadOnlyMemoryFile(iName, iDirectory), iSize, iFill);
+    if (not memory) {
+      memory = privateMemory(iSize, iFill);
+    }
+    return memory;
+  }
+}  // namespace edm
@@ -0,0 +1,117 @@
+#include "FWCore/Utilities/interface/SharedReadOnlyMemory.h"
+
+#include "catch.hpp"
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <sys/stat.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+namespace {
+  std::string testDirectory() {
+    std::string directory = "sharedReadOnlyMemory_t." + std::to_string(::getpid());
+    ::mkdir(directory.c_str(), 0755);
+    return directory;
+  }
+}  // namespace
+
+TEST_CASE("Test sharedReadOnlyMemory", "[sharedReadOnlyMemory]") {
+  std::string const directory = testDirectory();
+  int fills = 0;
+  auto fill = [&fills](std::size_t iSize, char iValue) {
+    return [&fills, iSize, iValue](void* p) {
+      ++fills;
+      std::memset(p, iValue, iSize);
+    };
+  };
+
+  SECTION("filled once") {
+    auto first = edm::sharedReadOnlyMemory("table", 1000, fill(1000, 7), directory);
+    auto second = edm::sharedReadOnlyMemory("table", 1000, fill(1000, 8), directory);
+    REQUIRE(fills == 1);
+    REQUIRE(static_cast<const char*>(second.get())[999] == 7);
+    REQUIRE(reinterpret_cast<std::uintptr_t>(first.get()) % 64 == 0);
+    std::remove(edm::sharedReadOnlyMemoryFile("table", directory).c_str());
+  }
+
+  SECTION("removed by its last user") {
+    std::string const file = edm::sharedReadOnlyMemoryFile("table", directory);
+    auto first = edm::sharedReadOnlyMemory("table", 1000, fill(1000, 7), directory);
+    auto second = edm::sharedReadOnlyMemory("table", 1000, fill(1000, 8), directory);
+    struct stat status;
+    first.reset();
+    REQUIRE(::stat(file.c_str(), &status) == 0);
+    second.reset();
+    REQUIRE(::stat(file.c_str(), &status) != 0);
+    auto third = edm::sharedReadOnlyMemory("table", 1000, fill(1000, 9), directory);
+    REQUIRE(fills == 2);
+    REQUIRE(static_cast<const char*>(third.get())[999] == 9);
+  }
+
+  SECTION("a segment writable by other users is not used") {
+    std::string const file = edm::sharedReadOnlyMemoryFile("table", directory);
+    auto first = edm::sharedReadOnlyMemory("table", 1000, fill(1000, 7), directory);
+    REQUIRE(::chmod(file.c_str(), 0666) == 0);
+    auto second = edm::sharedReadOnlyMemory("table", 1000, fill(1000, 8), directory);
+    REQUIRE(fills == 2);
+    REQUIRE(static_cast<const char*>(second.get())[999] == 8);
+    std::remove(file.c_str());
+  }
+
+  SECTION("another size gives private memory") {
+    auto first = edm::sharedReadOnlyMemory("table", 1000, fill(1000, 7), directory);
+    auto second = edm::sharedReadOnlyMemory("table", 2000, fill(2000, 8), directory);
+    REQUIRE(fills == 2);
+    REQUIRE(static_cast<const char*>(first.get())[999] == 7);
+    REQUIRE(static_cast<const char*>(second.get())[1999] == 8);
+    std::remove(edm::sharedReadOnlyMemoryFile("table", directory).c_str());
+  }
+
+  SECTION("no directory gives private memory") {
+    auto memory = edm::sharedReadOnlyMemory("table", 1000, fill(1000, 7), directory + "/missing");
+    REQUIRE(fills == 1);
+    REQUIRE(static_cast<const char*>(memory.get())[999] == 7);
+  }
+
+  SECTION("made again after a failure") {
+    REQUIRE_THROWS(edm::sharedReadOnlyMemory("table", 10, [](void*) { throw 1; }, directory));
+    auto memory = edm::sharedReadOnlyMemory("table", 10, fill(10, 3), directory);
+    REQUIRE(fills == 1);
+    REQUIRE(static_cast<const char*>(memory.get())[9] == 3);
+    std::remove(edm::sharedReadOnlyMemoryFile("table", directory).c_str());
+  }
+
+  SECTION("filled by one of several processes") {
+    constexpr int kProcesses = 4;
+    constexpr std::size_t kSize = 1 << 20;
+    for (int i = 0; i < kProcesses; ++i) {
+      if (::fork() == 0) {
+        bool filled = false;
+        auto memory = edm::sharedReadOnlyMemory(
+            "table",
+            kSize,
+            [&filled](void* p) {
+              filled = true;
+              ::usleep(100000);
+              std::memset(p, 5, kSize);
+            },
+            directory);
+        bool correct = static_cast<const char*>(memory.get())[kSize - 1] == 5;
+        ::_exit((filled ? 2 : 0) + (correct ? 1 : 0));
+      }
+    }
+    int filled = 0;
+    for (int i = 0; i < kProcesses; ++i) {
+      int status = 0;
+      ::wait(&status);
+      REQUIRE(WIFEXITED(status));
+      REQUIRE((WEXITSTATUS(status) & 1) == 1);
+      filled += WEXITSTATUS(status) / 2;
+    }
+    REQUIRE(filled == 1);
+    std::remove(edm::sharedReadOnlyMemoryFile("table", directory).c_str());
+  }
+  ::rmdir(directory.c_str());
+}
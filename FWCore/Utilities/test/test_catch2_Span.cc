@@ -0,0 +1,48 @@
+#include "FWCore/Utilities/interface/Span.h"
+
+#include "catch.hpp"
+
+#include <array>
+#include <numeric>
+#include <vector>
+
+namespace {
+  int sum(edm::Span<const int> values) { return std::accumulate(values.begin(), values.end(), 0); }
+}  // namespace
+
+TEST_CASE("test edm::Span", "[Span]") {
+  SECTION("default") {
+    edm::Span<int> empty;
+    REQUIRE(empty.empty());
+    REQUIRE(empty.size() == 0);
+    REQUIRE(empty.begin() == empty.end());
+  }
+
+  SECTION("from a container") {
+    std::vector<int> v = {1, 2, 3, 4};
+    edm::Span<int> s(v);
+    REQUIRE(s.size() == 4);
+    REQUIRE(s.data() == v.data());
+    s[1] = 20;
+    REQUIRE(v[1] == 20);
+    REQUIRE(sum(v) == 28);
+    REQUIRE(sum(s) == 28);
+
+    std::vector<int> const& cv = v;
+    edm::Span<const int> cs(cv);
+    REQUIRE(cs.size() == 4);
+    REQUIRE(&cs[3] == &v[3]);
+
+    std::array<int, 3> a = {{5, 6, 7}};
+    REQUIRE(sum(a) == 18);
+  }
+
+  SECTION("subspan") {
+    std::vector<int> v = {1, 2, 3, 4, 5};
+    edm::Span<const int> s(v);
+    REQUIRE(sum(s.subspan(1, 2)) == 5);
+    REQUIRE(sum(s.subspan(3)) == 9);
+    REQUIRE(s.subspan(2, 10).size() == 3);
+    REQUIRE(s.subspan(5).empty());
+  }
+}
@@ -32,6 +32,7 @@
 
 // local headers
 #include "memory_usage.h"
+#include "perf_counters.h"
 #include "processor_model.h"
 
 using namespace std::literals;
@@ -56,6 +57,11 @@ namespace {
 
   // convert from bytes to kilobytes, rounding down
   uint64_t kB(uint64_t bytes) { return bytes / 1024; }
+
+  // ratio of two hardware counters, e.g. instructions per cycle
+  double ratio(uint64_t numerator, uint64_t denominator, double scale = 1.) {
+    return denominator ? scale * numerator / denominator : 0.;
+  }
 }  // namespace
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -68,13 +74,15 @@ FastTimerService::Resources::Resources()
     : time_thread(boost::chrono::nanoseconds::zero()),
       time_real(boost::chrono::nanoseconds::zero()),
       allocated(0ul),
-      deallocated(0ul) {}
+      deallocated(0ul),
+      counters{} {}
 
 void FastTimerService::Resources::reset() {
   time_thread = boost::chrono::nanoseconds::zero();
   time_real = boost::chrono::nanoseconds::zero();
   allocated = 0ul;
   deallocated = 0ul;
+  counters.fill(0ul);
 }
 
 FastTimerService::Resources& FastTimerService::Resources::operator+=(Resources const& other) {
@@ -82,6 +90,8 @@ FastTimerService::Resources& FastTimerService::Resources::operator+=(Resources c
   time_real += other.time_real;
   allocated += other.allocated;
   deallocated += other.deallocated;
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    counters[i] += other.counters[i];
   return *this;
 }
 
@@ -97,19 +107,27 @@ FastTimerService::Resources FastTimerService::Resources::operator+(Resources con
 // of results should yield the correct result.
 
 FastTimerService::AtomicResources::AtomicResources()
-    : time_thread(0ul), time_real(0ul), allocated(0ul), deallocated(0ul) {}
+    : time_thread(0ul), time_real(0ul), allocated(0ul), deallocated(0ul) {
+  for (auto& counter : counters)
+    counter = 0ul;
+}
 
 FastTimerService::AtomicResources::AtomicResources(AtomicResources const& other)
     : time_thread(other.time_thread.load()),
       time_real(other.time_real.load()),
       allocated(other.allocated.load()),
-      deallocated(other.deallocated.load()) {}
+      deallocated(other.deallocated.load()) {
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    counters[i] = other.counters[i].load();
+}
 
 void FastTimerService::AtomicResources::reset() {
   time_thread = 0ul;
   time_real = 0ul;
   allocated = 0ul;
   deallocated = 0ul;
+  for (auto& counter : counters)
+    counter = 0ul;
 }
 
 FastTimerService::AtomicResources& FastTimerService::AtomicResources::operator=(AtomicResources const& other) {
@@ -117,6 +135,8 @@ FastTimerService::AtomicResources& FastTimerService::AtomicResources::operator=(
   time_real = other.time_real.load();
   allocated = other.allocated.load();
   deallocated = other.deallocated.load();
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    counters[i] = other.counters[i].load();
   return *this;
 }
 
@@ -125,6 +145,8 @@ FastTimerService::AtomicResources& FastTimerService::AtomicResources::operator+=
   time_real += other.time_real.load();
   allocated += other.allocated.load();
   deallocated += other.deallocated.load();
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    counters[i] += other.counters[i].load();
   return *this;
 }
 
@@ -273,6 +295,7 @@ void FastTimerService::Measurement::measure() noexcept {
   time_real = boost::chrono::high_resolution_clock::now();
   allocated = memory_usage::allocated();
   deallocated = memory_usage::deallocated();
+  counters = perf_counters::read();
 }
 
 void FastTimerService::Measurement::measure_and_store(Resources& store) noexcept {
@@ -283,14 +306,18 @@ void FastTimerService::Measurement::measure_and_store(Resources& store) noexcept
   auto new_time_real = boost::chrono::high_resolution_clock::now();
   auto new_allocated = memory_usage::allocated();
   auto new_deallocated = memory_usage::deallocated();
+  auto new_counters = perf_counters::read();
   store.time_thread = new_time_thread - time_thread;
   store.time_real = new_time_real - time_real;
   store.allocated = new_allocated - allocated;
   store.deallocated = new_deallocated - deallocated;
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    store.counters[i] = new_counters[i] - counters[i];
   time_thread = new_time_thread;
   time_real = new_time_real;
   allocated = new_allocated;
   deallocated = new_deallocated;
+  counters = new_counters;
 }
 
 void FastTimerService::Measurement::measure_and_accumulate(Resources& store) noexcept {
@@ -301,14 +328,18 @@ void FastTimerService::Measurement::measure_and_accumulate(Resources& store) noe
   auto new_time_real = boost::chrono::high_resolution_clock::now();
   auto new_allocated = memory_usage::allocated();
   auto new_deallocated = memory_usage::deallocated();
+  auto new_counters = perf_counters::read();
   store.time_thread += new_time_thread - time_thread;
   store.time_real += new_time_real - time_real;
   store.allocated += new_allocated - allocated;
   store.deallocated += new_deallocated - deallocated;
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    store.counters[i] += new_counters[i] - counters[i];
   time_thread = new_time_thread;
   time_real = new_time_real;
   allocated = new_allocated;
   deallocated = new_deallocated;
+  counters = new_counters;
 }
 
 void FastTimerService::Measurement::measure_and_accumulate(AtomicResources& store) noexcept {
@@ -319,14 +350,18 @@ void FastTimerService::Measurement::measure_and_accumulate(AtomicResources& stor
   auto new_time_real = boost::chrono::high_resolution_clock::now();
   auto new_allocated = memory_usage::allocated();
   auto new_deallocated = memory_usage::deallocated();
+  auto new_counters = perf_counters::read();
   store.time_thread += boost::chrono::duration_cast<boost::chrono::nanoseconds>(new_time_thread - time_thread).count();
   store.time_real += boost::chrono::duration_cast<boost::chrono::nanoseconds>(new_time_real - time_real).count();
   store.allocated += new_allocated - allocated;
   store.deallocated += new_deallocated - deallocated;
+  for (unsigned int i = 0; i < perf_counters::size; ++i)
+    store.counters[i] += new_counters[i] - counters[i];
   time_thread = new_time_thread;
   time_real = new_time_real;
   allocated = new_allocated;
   deallocated = new_deallocated;
+  counters = new_counters;
 }
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -362,6 +397,22 @@ void FastTimerService::PlotsPerElement::book(dqm::reco::DQMStore::IBooker& booke
     deallocated_->setYTitle(y_title_kB);
   }
 
+  if (perf_counters::is_enabled()) {
+    ipc_ = booker.book1D(name + " ipc", title + " instructions per cycle", 100, 0., 5.);
+    ipc_->setXTitle("instructions per cycle");
+    ipc_->setYTitle("events / 0.05");
+
+    cache_mpki_ =
+        booker.book1D(name + " cache_mpki", title + " cache misses per thousand instructions", 100, 0., 50.);
+    cache_mpki_->setXTitle("cache misses per thousand instructions");
+    cache_mpki_->setYTitle("events / 0.5");
+
+    branch_mpki_ =
+        booker.book1D(name + " branch_mpki", title + " branch misses per thousand instructions", 100, 0., 50.);
+    branch_mpki_->setXTitle("branch misses per thousand instructions");
+    branch_mpki_->setYTitle("events / 0.5");
+  }
+
   if (not byls)
     return;
 
@@ -443,6 +494,16 @@ void FastTimerService::PlotsPerElement::fill(Resources const& data, unsigned int
 
   if (deallocated_byls_)
     deallocated_byls_->Fill(lumisection, kB(data.deallocated));
+
+  auto const& counters = data.counters;
+  if (ipc_ and counters[perf_counters::cycles])
+    ipc_->Fill(ratio(counters[perf_counters::instructions], counters[perf_counters::cycles]));
+
+  if (cache_mpki_ and counters[perf_counters::instructions])
+    cache_mpki_->Fill(ratio(counters[perf_counters::cache_misses], counters[perf_counters::instructions], 1000.));
+
+  if (branch_mpki_ and counters[perf_counters::instructions])
+    branch_mpki_->Fill(ratio(counters[perf_counters::branch_misses], counters[perf_counters::instructions], 1000.));
 }
 
 void FastTimerService::PlotsPerElement::fill(AtomicResources const& data, unsigned int lumisection) {
@@ -472,6 +533,17 @@ void FastTimerService::PlotsPerElement::fill(AtomicResources const& data, unsign
 
   if (deallocated_byls_)
     deallocated_byls_->Fill(lumisection, kB(data.deallocated));
+
+  uint64_t cycles = data.counters[perf_counters::cycles];
+  uint64_t instructions = data.counters[perf_counters::instructions];
+  if (ipc_ and cycles)
+    ipc_->Fill(ratio(instructions, cycles));
+
+  if (cache_mpki_ and instructions)
+    cache_mpki_->Fill(ratio(data.counters[perf_counters::cache_misses], instructions, 1000.));
+
+  if (branch_mpki_ and instructions)
+    branch_mpki_->Fill(ratio(data.counters[perf_counters::branch_misses], instructions, 1000.));
 }
 
 void FastTimerService::PlotsPerElement::fill_fraction(Resources const& data,
@@ -514,6 +586,17 @@ void FastTimerService::PlotsPerElement::fill_fraction(Resources const& data,
 
   if (deallocated_byls_)
     deallocated_byls_->Fill(lumisection, total, fraction);
+
+  // the hardware counters are plotted as ratios, which cannot be split in fractions of the total
+  auto const& counters = part.counters;
+  if (ipc_ and counters[perf_counters::cycles])
+    ipc_->Fill(ratio(counters[perf_counters::instructions], counters[perf_counters::cycles]));
+
+  if (cache_mpki_ and counters[perf_counters::instructions])
+    cache_mpki_->Fill(ratio(counters[perf_counters::cache_misses], counters[perf_counters::instructions], 1000.));
+
+  if (branch_mpki_ and counters[perf_counters::instructions])
+    branch_mpki_->Fill(ratio(counters[perf_counters::branch_misses], counters[perf_counters::instructions], 1000.));
 }
 
 void FastTimerService::PlotsPerPath::book(dqm::reco::DQMStore::IBooker& booker,
@@ -546,6 +629,14 @@ void FastTimerService::PlotsPerPath::book(dqm::reco::DQMStore::IBooker& booker,
         booker.book1DD("module_deallocated_total", "total deallocated memory", bins, -0.5, bins - 0.5);
     module_deallocated_total_->setYTitle("memory [kB]");
   }
+  if (perf_counters::is_enabled()) {
+    for (unsigned int counter = 0; counter < perf_counters::size; ++counter) {
+      std::string name = perf_counters::name(counter);
+      module_counters_total_[counter] =
+          booker.book1DD("module_" + name + "_total", "total module " + name, bins, -0.5, bins - 0.5);
+      module_counters_total_[counter]->setYTitle(name);
+    }
+  }
   for (unsigned int bin : boost::irange(0u, bins)) {
     auto const& module = job[path.modules_and_dependencies_[bin]];
     std::string const& label =
@@ -557,6 +648,10 @@ void FastTimerService::PlotsPerPath::book(dqm::reco::DQMStore::IBooker& booker,
       module_allocated_total_->setBinLabel(bin + 1, label);
       module_deallocated_total_->setBinLabel(bin + 1, label);
     }
+    if (perf_counters::is_enabled()) {
+      for (auto counter : module_counters_total_)
+        counter->setBinLabel(bin + 1, label);
+    }
   }
   module_counter_->setBinLabel(bins + 1, "");
 
@@ -587,6 +682,10 @@ void FastTimerService::PlotsPerPath::fill(ProcessCallGraph::PathType const& desc
 
     if (module_deallocated_total_)
       module_deallocated_total_->Fill(i, kB(module.total.deallocated));
+
+    for (unsigned int counter = 0; counter < perf_counters::size; ++counter)
+      if (module_counters_total_[counter])
+        module_counters_total_[counter]->Fill(i, module.total.counters[counter]);
   }
   if (module_counter_ and path.status)
     module_counter_->Fill(path.last);
@@ -731,6 +830,8 @@ FastTimerService::FastTimerService(const edm::ParameterSet& config, edm::Activit
       print_event_summary_(config.getUntrackedParameter<bool>("printEventSummary")),
       print_run_summary_(config.getUntrackedParameter<bool>("printRunSummary")),
       print_job_summary_(config.getUntrackedParameter<bool>("printJobSummary")),
+      // hardware counters configuration
+      enable_hardware_counters_(config.getUntrackedParameter<bool>("enableHardwareCounters")),
       // dqm configuration
       enable_dqm_(config.getUntrackedParameter<bool>("enableDQM")),
       enable_dqm_bymodule_(config.getUntrackedParameter<bool>("enableDQMbyModule")),
@@ -756,6 +857,14 @@ FastTimerService::FastTimerService(const edm::ParameterSet& config, edm::Activit
       highlight_module_psets_(config.getUntrackedParameter<std::vector<edm::ParameterSet>>("highlightModules")),
       highlight_modules_(highlight_module_psets_.size())  // filled in postBeginJob()
 {
+  // the counters must be enabled before the first measurement of any thread
+  if (enable_hardware_counters_ and not perf_counters::enable()) {
+    enable_hardware_counters_ = false;
+    edm::LogWarning("FastTimerService")
+        << "The hardware performance counters are not available, they will not be measured.\n"
+        << "Check the value of /proc/sys/kernel/perf_event_paranoid, which must be 2 or lower.";
+  }
+
   // start observing when a thread enters or leaves the TBB global thread arena
   tbb::task_scheduler_observer::observe();
 
@@ -1244,6 +1353,53 @@ void FastTimerService::printSummary(T& out, ResourcesPerJob const& data, std::st
     printSummaryLine(out, data.highlight[group], data.events, highlight_modules_[group].label);
     out << '\n';
   }
+  if (enable_hardware_counters_) {
+    printCountersSummary(out, data);
+  }
+}
+
+template <typename T>
+void FastTimerService::printCountersSummaryHeader(T& out, std::string const& label) const {
+  out << "FastReport   Mcycles avg.   Minstr. avg.        IPC   cache MPKI  branch MPKI  " << label << '\n';
+  //      FastReport  ########.###   ########.###   ####.###   ########.#   ########.#  ...
+}
+
+template <typename T>
+void FastTimerService::printCountersSummaryLine(T& out,
+                                                Resources const& data,
+                                                uint64_t events,
+                                                std::string const& label) const {
+  auto const& counters = data.counters;
+  out << boost::format("FastReport  %12.3f   %12.3f   %8.3f   %10.1f   %10.1f  %s\n") %
+             (events ? counters[perf_counters::cycles] * 1.e-6 / events : 0) %
+             (events ? counters[perf_counters::instructions] * 1.e-6 / events : 0) %
+             ratio(counters[perf_counters::instructions], counters[perf_counters::cycles]) %
+             ratio(counters[perf_counters::cache_misses], counters[perf_counters::instructions], 1000.) %
+             ratio(counters[perf_counters::branch_misses], counters[perf_counters::instructions], 1000.) % label;
+}
+
+template <typename T>
+void FastTimerService::printCountersSummary(T& out, ResourcesPerJob const& data) const {
+  printCountersSummaryHeader(out, "Modules (hardware counters)");
+  auto const& source_d = callgraph_.source();
+  printCountersSummaryLine(out, data.modules[source_d.id()].total, data.events, source_d.moduleLabel());
+  for (unsigned int i = 0; i < callgraph_.processes().size(); ++i) {
+    auto const& proc_d = callgraph_.processDescription(i);
+    auto const& proc = data.processes[i];
+    printCountersSummaryLine(out, proc.total, data.events, "process " + proc_d.name_);
+    for (unsigned int m : proc_d.modules_) {
+      auto const& module_d = callgraph_.module(m);
+      printCountersSummaryLine(out, data.modules[m].total, data.events, "  " + module_d.moduleLabel());
+    }
+    for (unsigned int p = 0; p < proc.paths.size(); ++p) {
+      printCountersSummaryLine(out, proc.paths[p].total, data.events, "  path " + proc_d.paths_[p].name_);
+    }
+    for (unsigned int p = 0; p < proc.endpaths.size(); ++p) {
+      printCountersSummaryLine(out, proc.endpaths[p].total, data.events, "  endpath " + proc_d.endPaths_[p].name_);
+    }
+  }
+  printCountersSummaryLine(out, data.total, data.events, "total");
+  out << '\n';
 }
 
 template <typename T>
@@ -1524,6 +1680,10 @@ void FastTimerService::fillDescriptions(edm::ConfigurationDescriptions& descript
   desc.addUntracked<bool>("printEventSummary", false);
   desc.addUntracked<bool>("printRunSummary", true);
   desc.addUntracked<bool>("printJobSummary", true);
+  desc.addUntracked<bool>("enableHardwareCounters", false)
+      ->setComment(
+          "Measure the cycles, instructions, cache misses and branch misses of each module with the Linux perf_event "
+          "interface.");
   desc.addUntracked<bool>("enableDQM", true);
   desc.addUntracked<bool>("enableDQMbyModule", false);
   desc.addUntracked<bool>("enableDQMbyPath", false);
@@ -5,6 +5,7 @@
 #include <unistd.h>
 
 // C++ headers
+#include <array>
 #include <chrono>
 #include <cmath>
 #include <map>
@@ -40,6 +41,9 @@
 #include "DQMServices/Core/interface/DQMStore.h"
 #include "HLTrigger/Timer/interface/ProcessCallGraph.h"
 
+// local headers
+#include "perf_counters.h"
+
 /*
 procesing time is divided into
  - source
@@ -200,6 +204,7 @@ private:
     boost::chrono::high_resolution_clock::time_point time_real;
     uint64_t allocated;
     uint64_t deallocated;
+    perf_counters::values counters;
   };
 
   // highlight a group of modules
@@ -222,6 +227,7 @@ private:
     boost::chrono::nanoseconds time_real;
     uint64_t allocated;
     uint64_t deallocated;
+    perf_counters::values counters;
   };
 
   // atomic version of Resources
@@ -240,6 +246,7 @@ private:
     std::atomic<boost::chrono::nanoseconds::rep> time_real;
     std::atomic<uint64_t> allocated;
     std::atomic<uint64_t> deallocated;
+    std::array<std::atomic<uint64_t>, perf_counters::size> counters;
   };
 
   struct ResourcesPerModule {
@@ -332,6 +339,10 @@ private:
     dqm::reco::MonitorElement* allocated_byls_;    // TProfile
     dqm::reco::MonitorElement* deallocated_;       // TH1F
     dqm::reco::MonitorElement* deallocated_byls_;  // TProfile
+    // hardware counters, only if enabled
+    dqm::reco::MonitorElement* ipc_;               // TH1F
+    dqm::reco::MonitorElement* cache_mpki_;        // TH1F
+    dqm::reco::MonitorElement* branch_mpki_;       // TH1F
   };
 
   // plots associated to each path or endpath
@@ -366,6 +377,8 @@ private:
     dqm::reco::MonitorElement* module_time_real_total_;    // TH1D
     dqm::reco::MonitorElement* module_allocated_total_;    // TH1D
     dqm::reco::MonitorElement* module_deallocated_total_;  // TH1D
+    // hardware counters in each module and their dependencies, only if enabled
+    std::array<dqm::reco::MonitorElement*, perf_counters::size> module_counters_total_;  // TH1D
   };
 
   class PlotsPerProcess {
@@ -465,6 +478,9 @@ private:
   const bool print_run_summary_;    // print the time spent in each process, path and module for each run
   const bool print_job_summary_;    // print the time spent in each process, path and module for the whole job
 
+  // hardware counters configuration
+  bool enable_hardware_counters_;  // non const, depends on the availability of the perf_event counters
+
   // dqm configuration
   bool enable_dqm_;  // non const, depends on the availability of the DQMStore
   const bool enable_dqm_bymodule_;
@@ -523,6 +539,15 @@ private:
   template <typename T>
   void printTransition(T& out, AtomicResources const& data, std::string const& label) const;
 
+  template <typename T>
+  void printCountersSummaryHeader(T& out, std::string const& label) const;
+
+  template <typename T>
+  void printCountersSummaryLine(T& out, Resources const& data, uint64_t events, std::string const& label) const;
+
+  template <typename T>
+  void printCountersSummary(T& out, ResourcesPerJob const& data) const;
+
   // check if this is the first process being signalled
   bool isFirstSubprocess(edm::StreamContext const&);
   bool isFirstSubprocess(edm::GlobalContext const&);
@@ -0,0 +1,124 @@
+#include <atomic>
+#include <cstring>
+#include <boost/predef/os.h>
+
+#if BOOST_OS_LINUX
+// Linux
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif  // BOOST_OS_LINUX
+
+#include "perf_counters.h"
+
+namespace {
+  std::atomic<bool> enabled{false};
+
+#if BOOST_OS_LINUX
+  // the counters of one thread, opened as a single group so they are read together with one system call
+  class thread_counters {
+  public:
+    thread_counters() {
+      static const std::array<std::pair<uint32_t, uint64_t>, perf_counters::size> events{
+          {{PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES},
+           {PERF_TYPE_HARDWARE, PERF_COUNT_HW_INSTRUCTIONS},
+           {PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES},
+           {PERF_TYPE_HARDWARE, PERF_COUNT_HW_BRANCH_MISSES}}};
+
+      for (unsigned int i = 0; i < perf_counters::size; ++i) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        attr.type = events[i].first;
+        attr.config = events[i].second;
+        attr.read_format = PERF_FORMAT_GROUP;
+        // count only the user space, which is allowed for unprivileged processes with perf_event_paranoid up to 2
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.disabled = (leader_ < 0) ? 1 : 0;
+        // measure the calling thread, on any cpu
+        int fd = syscall(__NR_perf_event_open, &attr, 0, -1, leader_, 0);
+        if (fd < 0) {
+          // without cycles there is no group; other counters may be missing e.g. inside a virtual machine
+          if (leader_ < 0)
+            return;
+          continue;
+        }
+        if (leader_ < 0)
+          leader_ = fd;
+        fds_[i] = fd;
+        position_[i] = opened_++;
+      }
+      ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+      ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    }
+
+    ~thread_counters() {
+      // every counter of the group holds its own file descriptor; the leader is closed last
+      for (int fd : fds_)
+        if (fd >= 0 and fd != leader_)
+          close(fd);
+      if (leader_ >= 0)
+        close(leader_);
+    }
+
+    thread_counters(thread_counters const &) = delete;
+    thread_counters &operator=(thread_counters const &) = delete;
+
+    bool is_open() const { return leader_ >= 0; }
+
+    perf_counters::values read() const {
+      perf_counters::values result{};
+      if (leader_ < 0)
+        return result;
+
+      // with PERF_FORMAT_GROUP the kernel returns the number of counters, followed by their values
+      std::array<uint64_t, perf_counters::size + 1> buffer;
+      if (::read(leader_, buffer.data(), sizeof(buffer)) < static_cast<ssize_t>(sizeof(uint64_t) * (opened_ + 1)))
+        return result;
+      for (unsigned int i = 0; i < perf_counters::size; ++i)
+        if (position_[i] >= 0)
+          result[i] = buffer[position_[i] + 1];
+      return result;
+    }
+
+  private:
+    int leader_ = -1;
+    int opened_ = 0;
+    std::array<int, perf_counters::size> fds_{{-1, -1, -1, -1}};
+    std::array<int, perf_counters::size> position_{{-1, -1, -1, -1}};
+  };
+
+  thread_counters const &this_thread_counters() {
+    // opened lazily, the first time a thread reads the counters after they have been enabled
+    thread_local const thread_counters counters;
+    return counters;
+  }
+#endif  // BOOST_OS_LINUX
+
+  const char *const names[perf_counters::size] = {"cycles", "instructions", "cache_misses", "branch_misses"};
+}  // namespace
+
+bool perf_counters::enable() {
+#if BOOST_OS_LINUX
+  if (not this_thread_counters().is_open())
+    return false;
+  enabled = true;
+  return true;
+#else
+  return false;
+#endif  // BOOST_OS_LINUX
+}
+
+bool perf_counters::is_enabled() { return enabled.load(std::memory_order_relaxed); }
+
+perf_counters::values perf_counters::read() {
+#if BOOST_OS_LINUX
+  if (is_enabled())
+    return this_thread_counters().read();
+#endif  // BOOST_OS_LINUX
+  return values{};
+}
+
+const char *perf_counters::name(unsigned int counter) { return names[counter]; }
@@ -0,0 +1,21 @@
+#ifndef perf_counters_h
+#define perf_counters_h
+
+#include <array>
+#include <cstdint>
+
+// per-thread hardware performance counters, read via the Linux perf_event interface
+class perf_counters {
+public:
+  enum counter { cycles, instructions, cache_misses, branch_misses, size };
+  using values = std::array<uint64_t, size>;
+
+  // start counting on every thread that reads the counters; return false if the kernel does not allow it
+  static bool enable();
+  static bool is_enabled();
+  // the counters of the current thread since it first read them, zero if not enabled or not available
+  static values read();
+  static const char *name(unsigned int counter);
+};
+
+#endif  // perf_counters_h
@@ -0,0 +1,80 @@
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+
+#include <linux/perf_event.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#include "catch.hpp"
+
+#include "HLTrigger/Timer/plugins/perf_counters.h"
+
+namespace {
+  // false if the kernel does not let this process count its own cycles, e.g. because of
+  // perf_event_paranoid, a seccomp profile, or a virtual machine without a PMU
+  bool perf_events_allowed() {
+    perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = PERF_COUNT_HW_CPU_CYCLES;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.disabled = 1;
+    int fd = syscall(__NR_perf_event_open, &attr, 0, -1, -1, 0);
+    if (fd < 0) {
+      WARN("perf_event_open is not allowed (" << std::strerror(errno) << "), skipping the test");
+      return false;
+    }
+    close(fd);
+    return true;
+  }
+
+  uint64_t busy_loop(unsigned int iterations) {
+    volatile uint64_t sum = 0;
+    for (unsigned int i = 0; i < iterations; ++i)
+      sum += i * i;
+    return sum;
+  }
+}  // namespace
+
+TEST_CASE("perf_counters", "[perf_counters]") {
+  if (not perf_events_allowed())
+    return;
+  REQUIRE(perf_counters::enable());
+  REQUIRE(perf_counters::is_enabled());
+
+  SECTION("the counters increase on a busy loop") {
+    auto before = perf_counters::read();
+    busy_loop(10000000);
+    auto after = perf_counters::read();
+    REQUIRE(after[perf_counters::cycles] > before[perf_counters::cycles]);
+    // each iteration takes at least a load, an add and a store
+    REQUIRE(after[perf_counters::instructions] - before[perf_counters::instructions] > 10000000);
+  }
+
+  SECTION("the per module attribution adds up") {
+    // as FastTimerService does, each module is measured from the end of the previous one
+    const unsigned int iterations[] = {1000000, 4000000, 2000000};
+    perf_counters::values modules[3];
+    auto start = perf_counters::read();
+    auto last = start;
+    for (unsigned int m = 0; m < 3; ++m) {
+      busy_loop(iterations[m]);
+      auto now = perf_counters::read();
+      for (unsigned int i = 0; i < perf_counters::size; ++i)
+        modules[m][i] = now[i] - last[i];
+      last = now;
+    }
+    for (unsigned int i = 0; i < perf_counters::size; ++i) {
+      uint64_t sum = 0;
+      for (auto const& module : modules)
+        sum += module[i];
+      REQUIRE(sum == last[i] - start[i]);
+    }
+    // the module running the longest loop gets the most instructions
+    REQUIRE(modules[1][perf_counters::instructions] > modules[2][perf_counters::instructions]);
+    REQUIRE(modules[2][perf_counters::instructions] > modules[0][perf_counters::instructions]);
+  }
+}
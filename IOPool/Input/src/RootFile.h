@@ -219,6 +219,9 @@ namespace edm {
     // RunNumber_t const& runNumber() const {return indexIntoFileIter().run();}
     EventID const& eventID() const { return eventAux().id(); }
     RootTree const& eventTree() const { return eventTree_; }
+    void setCacheTraining(std::shared_ptr<roottree::CacheTraining> cacheTraining) {
+      eventTree_.setCacheTraining(std::move(cacheTraining));
+    }
     RootTree const& lumiTree() const { return lumiTree_; }
     RootTree const& runTree() const { return runTree_; }
     FileFormatVersion fileFormatVersion() const { return fileFormatVersion_; }
@@ -15,8 +15,14 @@
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "FWCore/ServiceRegistry/interface/Service.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
+#include "FWCore/Utilities/interface/EDMException.h"
 #include "Utilities/StorageFactory/interface/StorageFactory.h"
 
+#include "TTreeCacheUnzip.h"
+
+#include <fstream>
+
 namespace edm {
   RootPrimaryFileSequence::RootPrimaryFileSequence(ParameterSet const& pset,
                                                    PoolSource& input,
@@ -33,7 +39,9 @@ namespace edm {
         duplicateChecker_(new DuplicateChecker(pset)),
         usingGoToEvent_(false),
         enablePrefetching_(false),
-        enforceGUIDInFileName_(pset.getUntrackedParameter<bool>("enforceGUIDInFileName")) {
+        enforceGUIDInFileName_(pset.getUntrackedParameter<bool>("enforceGUIDInFileName")),
+        cacheTrainingFile_(pset.getUntrackedParameter<std::string>("cacheTrainingFile")),
+        cacheTraining_() {
     // The SiteLocalConfig controls the TTreeCache size and the prefetching settings.
     Service<SiteLocalConfig> pSLC;
     if (pSLC.isAvailable()) {
@@ -43,6 +51,21 @@ namespace edm {
       enablePrefetching_ = pSLC->enablePrefetching();
     }
 
+    // TTree::SetCacheSize creates a TTreeCacheUnzip rather than a TTreeCache according to a
+    // process-wide ROOT setting. It is set once, while the job is configured and before any file
+    // is opened: changing it around the creation of each cache would race with the other files
+    // and threads.
+    if (pset.getUntrackedParameter<bool>("enableParallelUnzip")) {
+      TTreeCacheUnzip::SetParallelUnzip(TTreeCacheUnzip::kEnable);
+    }
+
+    if (pset.getUntrackedParameter<bool>("reuseCacheTraining") || !cacheTrainingFile_.empty()) {
+      cacheTraining_ = std::make_shared<roottree::CacheTraining>();
+      if (!cacheTrainingFile_.empty()) {
+        readCacheTraining();
+      }
+    }
+
     std::string branchesMustMatch =
         pset.getUntrackedParameter<std::string>("branchesMustMatch", std::string("permissive"));
     if (branchesMustMatch == std::string("strict"))
@@ -68,7 +91,47 @@ namespace edm {
 
   RootPrimaryFileSequence::~RootPrimaryFileSequence() {}
 
-  void RootPrimaryFileSequence::endJob() { closeFile_(); }
+  void RootPrimaryFileSequence::endJob() {
+    closeFile_();
+    if (!cacheTrainingFile_.empty()) {
+      writeCacheTraining();
+    }
+  }
+
+  // The cache training file has one line per branch: "trained <branch name>" or "trigger <branch name>".
+  void RootPrimaryFileSequence::readCacheTraining() {
+    std::ifstream file(cacheTrainingFile_);
+    if (!file) {
+      // No file yet, it will be written at the end of this job.
+      return;
+    }
+    std::string kind;
+    std::string branchName;
+    while (file >> kind >> branchName) {
+      if (kind == "trained") {
+        cacheTraining_->trainedBranches_.insert(branchName);
+      } else if (kind == "trigger") {
+        cacheTraining_->triggerBranches_.insert(branchName);
+      } else {
+        throw Exception(errors::Configuration, "RootPrimaryFileSequence::readCacheTraining()")
+            << "Unexpected entry '" << kind << "' in cache training file " << cacheTrainingFile_ << "\n";
+      }
+    }
+  }
+
+  void RootPrimaryFileSequence::writeCacheTraining() const {
+    std::ofstream file(cacheTrainingFile_);
+    if (!file) {
+      LogWarning("RootPrimaryFileSequence") << "Could not write the cache training file " << cacheTrainingFile_;
+      return;
+    }
+    for (auto const& branchName : cacheTraining_->trainedBranches_) {
+      file << "trained " << branchName << '\n';
+    }
+    for (auto const& branchName : cacheTraining_->triggerBranches_) {
+      file << "trigger " << branchName << '\n';
+    }
+  }
 
   std::unique_ptr<FileBlock> RootPrimaryFileSequence::readFile_() {
     if (firstFile_) {
@@ -110,36 +173,40 @@ namespace edm {
 
   RootPrimaryFileSequence::RootFileSharedPtr RootPrimaryFileSequence::makeRootFile(std::shared_ptr<InputFile> filePtr) {
     size_t currentIndexIntoFile = sequenceNumberOfFile();
-    return std::make_shared<RootFile>(fileName(),
-                                      input_.processConfiguration(),
-                                      logicalFileName(),
-                                      filePtr,
-                                      eventSkipperByID(),
-                                      initialNumberOfEventsToSkip_ != 0,
-                                      remainingEvents(),
-                                      remainingLuminosityBlocks(),
-                                      input_.nStreams(),
-                                      treeCacheSize_,
-                                      input_.treeMaxVirtualSize(),
-                                      input_.processingMode(),
-                                      input_.runHelper(),
-                                      noEventSort_,
-                                      input_.productSelectorRules(),
-                                      InputType::Primary,
-                                      input_.branchIDListHelper(),
-                                      input_.thinnedAssociationsHelper(),
-                                      nullptr,  // associationsFromSecondary
-                                      duplicateChecker(),
-                                      input_.dropDescendants(),
-                                      input_.processHistoryRegistryForUpdate(),
-                                      indexesIntoFiles(),
-                                      currentIndexIntoFile,
-                                      orderedProcessHistoryIDs_,
-                                      input_.bypassVersionCheck(),
-                                      input_.labelRawDataLikeMC(),
-                                      usingGoToEvent_,
-                                      enablePrefetching_,
-                                      enforceGUIDInFileName_);
+    auto file = std::make_shared<RootFile>(fileName(),
+                                           input_.processConfiguration(),
+                                           logicalFileName(),
+                                           filePtr,
+                                           eventSkipperByID(),
+                                           initialNumberOfEventsToSkip_ != 0,
+                                           remainingEvents(),
+                                           remainingLuminosityBlocks(),
+                                           input_.nStreams(),
+                                           treeCacheSize_,
+                                           input_.treeMaxVirtualSize(),
+                                           input_.processingMode(),
+                                           input_.runHelper(),
+                                           noEventSort_,
+                                           input_.productSelectorRules(),
+                                           InputType::Primary,
+                                           input_.branchIDListHelper(),
+                                           input_.thinnedAssociationsHelper(),
+                                           nullptr,  // associationsFromSecondary
+                                           duplicateChecker(),
+                                           input_.dropDescendants(),
+                                           input_.processHistoryRegistryForUpdate(),
+                                           indexesIntoFiles(),
+                                           currentIndexIntoFile,
+                                           orderedProcessHistoryIDs_,
+                                           input_.bypassVersionCheck(),
+                                           input_.labelRawDataLikeMC(),
+                                           usingGoToEvent_,
+                                           enablePrefetching_,
+                                           enforceGUIDInFileName_);
+    if (cacheTraining_) {
+      file->setCacheTraining(cacheTraining_);
+    }
+    return file;
   }
 
   bool RootPrimaryFileSequence::nextFile() {
@@ -319,6 +386,24 @@ namespace edm {
             "Note 3: Any sorting occurs independently in each input file (no sorting across input files).");
     desc.addUntracked<unsigned int>("cacheSize", roottree::defaultCacheSize)
         ->setComment("Size of ROOT TTree prefetch cache.  Affects performance.");
+    desc.addUntracked<bool>("enableParallelUnzip", false)
+        ->setComment(
+            "True:  When a new cluster of the Events tree is read into the cache, decompress the baskets of all "
+            "cached branches concurrently as TBB tasks, so products are handed to the framework already unzipped.\n"
+            "False: Each basket is decompressed when its product is requested.\n"
+            "Only has an effect if 'cacheSize' is non-zero and ROOT implicit multi-threading is enabled. "
+            "This is a setting of ROOT for the whole job: it also applies to the other trees and TTreeCaches "
+            "of the job, e.g. the Run and Lumi trees and the files of a secondary source.");
+    desc.addUntracked<bool>("reuseCacheTraining", false)
+        ->setComment(
+            "True:  The set of branches the TTreeCache learned to read from the first input file (and the branches "
+            "read through the trigger cache) is used for all following files, which then skip the learning phase.\n"
+            "False: The TTreeCache is trained again for each input file.");
+    desc.addUntracked<std::string>("cacheTrainingFile", std::string())
+        ->setComment(
+            "If not empty, the name of a file holding the learned TTreeCache branch sets. If the file exists, "
+            "it seeds the cache of the first input file; at the end of the job the learned sets are written back. "
+            "Implies 'reuseCacheTraining'.");
     std::string defaultString("permissive");
     desc.addUntracked<std::string>("branchesMustMatch", defaultString)
         ->setComment(
@@ -31,6 +31,10 @@ namespace edm {
   class PoolSource;
   class RootFile;
 
+  namespace roottree {
+    struct CacheTraining;
+  }
+
   class RootPrimaryFileSequence : public RootInputFileSequence {
   public:
     explicit RootPrimaryFileSequence(ParameterSet const& pset, PoolSource& input, InputFileCatalog const& catalog);
@@ -57,6 +61,9 @@ namespace edm {
     bool previousFile();
     void rewindFile();
 
+    void readCacheTraining();
+    void writeCacheTraining() const;
+
     int remainingEvents() const;
     int remainingLuminosityBlocks() const;
 
@@ -78,6 +85,8 @@ namespace edm {
     bool usingGoToEvent_;
     bool enablePrefetching_;
     bool enforceGUIDInFileName_;
+    std::string cacheTrainingFile_;
+    std::shared_ptr<roottree::CacheTraining> cacheTraining_;
   };  // class RootPrimaryFileSequence
 }  // namespace edm
 #endif
@@ -1,5 +1,6 @@
 #include "RootTree.h"
 #include "RootDelayedReader.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "FWCore/Utilities/interface/Exception.h"
 #include "DataFormats/Provenance/interface/BranchDescription.h"
@@ -7,6 +8,7 @@
 #include "TTree.h"
 #include "TTreeIndex.h"
 #include "TTreeCache.h"
+#include "TTreeCacheUnzip.h"
 #include "TLeaf.h"
 
 #include <cassert>
@@ -47,6 +49,7 @@ namespace edm {
         rawTriggerTreeCache_(),
         trainedSet_(),
         triggerSet_(),
+        cacheTraining_(),
         entries_(tree_ ? tree_->GetEntries() : 0),
         entryNumber_(-1),
         entryNumberForIndex_(new std::vector<EntryNumber>(nIndexes, IndexIntoFile::invalidEntry)),
@@ -178,10 +181,21 @@ namespace edm {
 
   void RootTree::setCacheSize(unsigned int cacheSize) {
     cacheSize_ = cacheSize;
+    // TTree::SetCacheSize creates a TTreeCacheUnzip if the PoolSource enabled parallel unzipping
     tree_->SetCacheSize(static_cast<Long64_t>(cacheSize));
     treeCache_.reset(dynamic_cast<TTreeCache*>(filePtr_->GetCacheRead()));
+    if (branchType_ == InEvent && dynamic_cast<TTreeCacheUnzip*>(treeCache_.get())) {
+      LogInfo("PoolSource") << "The baskets of the Events tree are unzipped in parallel";
+    }
     if (treeCache_)
       treeCache_->SetEnablePrefetching(enablePrefetching_);
+    if (enableTriggerCache_ && treeCache_ && treeCache_->IsAsyncReading()) {
+      // The trigger caches are not made for asynchronous reading, which the storage may
+      // ask for (e.g. the AdaptorConfig readAhead option): the branches not learned by the
+      // TTreeCache are then read without them.
+      enableTriggerCache_ = false;
+      LogInfo("PoolSource") << "The Events tree is read asynchronously, without the trigger cache";
+    }
     filePtr_->SetCacheRead(nullptr);
     rawTreeCache_.reset();
   }
@@ -240,11 +254,15 @@ namespace edm {
     tree_->LoadTree(entryNumber_);
     filePtr_->SetCacheRead(nullptr);
     if (treeCache_ && trainNow_ && entryNumber_ >= 0) {
-      startTraining();
-      trainNow_ = false;
       trainedSet_.clear();
       triggerSet_.clear();
       rawTriggerSwitchOverEntry_ = -1;
+      if (cacheTraining_ && !cacheTraining_->trainedBranches_.empty()) {
+        useCacheTraining();
+      } else {
+        startTraining();
+      }
+      trainNow_ = false;
     }
     if (treeCache_ && treeCache_->IsLearning() && switchOverEntry_ >= 0 && entryNumber_ >= switchOverEntry_) {
       stopTraining();
@@ -254,6 +272,7 @@ namespace edm {
   // The actual implementation is done below; it's split in this strange
   // manner in order to keep a by-definition-rare code path out of the instruction cache.
   inline TTreeCache* RootTree::checkTriggerCache(TBranch* branch, EntryNumber entryNumber) const {
+    // enableTriggerCache_ is false if the Events tree is read asynchronously, see setCacheSize()
     if (!treeCache_->IsAsyncReading() && enableTriggerCache_ && (trainedSet_.find(branch) == trainedSet_.end())) {
       return checkTriggerCacheImpl(branch, entryNumber);
     } else {
@@ -400,6 +419,8 @@ namespace edm {
     assert(treeCache_);
     assert(branchType_ == InEvent);
     assert(!rawTreeCache_);
+    LogInfo("PoolSource") << "The TTreeCache of the Events tree learns the branches to read in the next "
+                          << learningEntries_ << " entries";
     treeCache_->SetLearnEntries(learningEntries_);
     tree_->SetCacheSize(static_cast<Long64_t>(cacheSize_));
     rawTreeCache_.reset(dynamic_cast<TTreeCache*>(filePtr_->GetCacheRead()));
@@ -430,6 +451,40 @@ namespace edm {
     assert(treeCache_->GetTree() == tree_);
   }
 
+  void RootTree::useCacheTraining() {
+    if (cacheSize_ == 0) {
+      return;
+    }
+    assert(treeCache_);
+    assert(branchType_ == InEvent);
+    assert(!rawTreeCache_);
+    // Skip the learning phase: the branch set learned on previous files is used right away.
+    filePtr_->SetCacheRead(treeCache_.get());
+    treeCache_->StartLearningPhase();
+    treeCache_->SetEntryRange(entryNumber_, tree_->GetEntries());
+    for (auto const& branchName : cacheTraining_->trainedBranches_) {
+      TBranch* branch = tree_->GetBranch(branchName.c_str());
+      if (branch != nullptr) {
+        treeCache_->AddBranch(branch, kTRUE);
+        trainedSet_.insert(branch);
+      }
+    }
+    treeCache_->StopLearningPhase();
+    filePtr_->SetCacheRead(nullptr);
+    LogInfo("PoolSource") << "The TTreeCache of the Events tree reads the " << trainedSet_.size()
+                          << " branches learned before, without a learning phase";
+    // Branches not in the trained set go through the trigger caches.  Knowing the trigger set
+    // up front means the trigger cache is trained with all of them when it is first created.
+    for (auto const& branchName : cacheTraining_->triggerBranches_) {
+      TBranch* branch = tree_->GetBranch(branchName.c_str());
+      if (branch != nullptr && trainedSet_.find(branch) == trainedSet_.end()) {
+        triggerSet_.insert(branch);
+      }
+    }
+    switchOverEntry_ = entryNumber_;
+    assert(treeCache_->GetTree() == tree_);
+  }
+
   void RootTree::stopTraining() {
     filePtr_->SetCacheRead(treeCache_.get());
     treeCache_->StopLearningPhase();
@@ -438,6 +493,15 @@ namespace edm {
   }
 
   void RootTree::close() {
+    // Remember what was learned in this file for the next one, while the branches still exist.
+    if (cacheTraining_) {
+      for (auto const* branch : trainedSet_) {
+        cacheTraining_->trainedBranches_.insert(branch->GetName());
+      }
+      for (auto const* branch : triggerSet_) {
+        cacheTraining_->triggerBranches_.insert(branch->GetName());
+      }
+    }
     // The TFile is about to be closed, and destructed.
     // Just to play it safe, zero all pointers to quantities that are owned by the TFile.
     auxBranch_ = branchEntryInfoBranch_ = nullptr;
@@ -18,6 +18,7 @@ RootTree.h // used by ROOT input sources
 #include "TBranch.h"
 
 #include <memory>
+#include <set>
 #include <string>
 #include <vector>
 #include <unordered_set>
@@ -90,6 +91,14 @@ namespace edm {
       std::unordered_map<unsigned int, BranchInfo> map_;
     };
 
+    // Names of the Events tree branches the TTreeCache was trained to read, and of the
+    // branches read through the trigger cache.  Shared by the files of one file sequence,
+    // so that a new file can fill its cache from its first event instead of learning again.
+    struct CacheTraining {
+      std::set<std::string> trainedBranches_;
+      std::set<std::string> triggerBranches_;
+    };
+
     Int_t getEntry(TBranch* branch, EntryNumber entryNumber);
     Int_t getEntry(TTree* tree, EntryNumber entryNumber);
     std::unique_ptr<TTreeCache> trainCache(TTree* tree,
@@ -190,6 +199,9 @@ namespace edm {
     inline TTreeCache* selectCache(TBranch* branch, EntryNumber entryNumber) const;
     void trainCache(char const* branchNames);
     void resetTraining() { trainNow_ = true; }
+    void setCacheTraining(std::shared_ptr<roottree::CacheTraining> cacheTraining) {
+      cacheTraining_ = std::move(cacheTraining);
+    }
 
     BranchType branchType() const { return branchType_; }
 
@@ -202,6 +214,7 @@ namespace edm {
     void setTreeMaxVirtualSize(int treeMaxVirtualSize);
     void startTraining();
     void stopTraining();
+    void useCacheTraining();
 
     std::shared_ptr<InputFile> filePtr_;
     // We use bare pointers for pointers to some ROOT entities.
@@ -220,6 +233,7 @@ namespace edm {
     mutable std::shared_ptr<TTreeCache> rawTriggerTreeCache_;
     mutable std::unordered_set<TBranch*> trainedSet_;
     mutable std::unordered_set<TBranch*> triggerSet_;
+    std::shared_ptr<roottree::CacheTraining> cacheTraining_;
     EntryNumber entries_;
     EntryNumber entryNumber_;
     std::unique_ptr<std::vector<EntryNumber> > entryNumberForIndex_;
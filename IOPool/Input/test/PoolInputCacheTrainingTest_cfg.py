@@ -0,0 +1,28 @@
+# Configuration file for PoolInputCacheTrainingTest
+# Reads two files carrying the TTreeCache training from the first file to the second.
+# The learned branch sets are saved to, and on a second run seeded from, a file.
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTRECO")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.MessageLogger.categories.append('PoolSource')
+process.MessageLogger.cerr.PoolSource = cms.untracked.PSet(limit = cms.untracked.int32(-1))
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(-1)
+)
+process.OtherThing = cms.EDProducer("OtherThingProducer")
+
+process.Analysis = cms.EDAnalyzer("OtherThingAnalyzer")
+
+process.source = cms.Source("PoolSource",
+    setRunNumber = cms.untracked.uint32(621),
+    fileNames = cms.untracked.vstring('file:PoolInputTest.root', 
+        'file:PoolInputOther.root'),
+    reuseCacheTraining = cms.untracked.bool(True),
+    cacheTrainingFile = cms.untracked.string('PoolInputCacheTraining.txt')
+)
+
+process.p = cms.Path(process.OtherThing*process.Analysis)
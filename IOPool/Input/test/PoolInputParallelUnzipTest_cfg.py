@@ -0,0 +1,32 @@
+# Configuration file for PoolInputParallelUnzipTest
+# Reads two files with several threads, the baskets of the Events tree being
+# unzipped in parallel when a cluster is read into the TTreeCache.
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTRECO")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.MessageLogger.categories.append('PoolSource')
+process.MessageLogger.cerr.PoolSource = cms.untracked.PSet(limit = cms.untracked.int32(-1))
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(4),
+    numberOfStreams = cms.untracked.uint32(0)
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(-1)
+)
+process.OtherThing = cms.EDProducer("OtherThingProducer")
+
+process.Analysis = cms.EDAnalyzer("OtherThingAnalyzer")
+
+process.source = cms.Source("PoolSource",
+    setRunNumber = cms.untracked.uint32(621),
+    fileNames = cms.untracked.vstring('file:PoolInputTest.root', 
+        'file:PoolInputOther.root'),
+    enableParallelUnzip = cms.untracked.bool(True)
+)
+
+process.p = cms.Path(process.OtherThing*process.Analysis)
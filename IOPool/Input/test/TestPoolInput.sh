@@ -23,6 +23,21 @@ cmsRun --parameter-set ${LOCAL_TEST_DIR}/PoolInputTest_cfg.py || die 'Failure us
 cmsRun  ${LOCAL_TEST_DIR}/PoolInputTest_noDelay_cfg.py >& ${LOCAL_TMP_DIR}/PoolInputTest_noDelay_cfg.txt || die 'Failure using PoolInputTest_noDelay_cfg.py' $?
 grep 'event delayed read from source' ${LOCAL_TMP_DIR}/PoolInputTest_noDelay_cfg.txt && die 'Failure in PoolInputTest_noDelay_cfg.py, found delay reads from source' 1
 
+cmsRun ${LOCAL_TEST_DIR}/PoolInputParallelUnzipTest_cfg.py >& ${LOCAL_TMP_DIR}/PoolInputParallelUnzipTest_cfg.txt || die 'Failure using PoolInputParallelUnzipTest_cfg.py' $?
+#one TTreeCacheUnzip for the Events tree of each of the two files
+test $(grep -c 'The baskets of the Events tree are unzipped in parallel' ${LOCAL_TMP_DIR}/PoolInputParallelUnzipTest_cfg.txt) -eq 2 || die 'PoolInputParallelUnzipTest_cfg.py did not unzip in parallel' 1
+
+rm -f PoolInputCacheTraining.txt
+cmsRun ${LOCAL_TEST_DIR}/PoolInputCacheTrainingTest_cfg.py >& ${LOCAL_TMP_DIR}/PoolInputCacheTrainingTest_cfg.txt || die 'Failure using PoolInputCacheTrainingTest_cfg.py' $?
+grep -q '^trained ' PoolInputCacheTraining.txt || die 'PoolInputCacheTrainingTest_cfg.py did not write the cache training file' 1
+#only the first file learns, the second one uses what it learned
+test $(grep -c 'The TTreeCache of the Events tree learns' ${LOCAL_TMP_DIR}/PoolInputCacheTrainingTest_cfg.txt) -eq 1 || die 'PoolInputCacheTrainingTest_cfg.py did not train the cache on the first file only' 1
+test $(grep -c 'branches learned before, without a learning phase' ${LOCAL_TMP_DIR}/PoolInputCacheTrainingTest_cfg.txt) -eq 1 || die 'PoolInputCacheTrainingTest_cfg.py did not reuse the training on the second file' 1
+#reads the cache training file written above: no file learns
+cmsRun ${LOCAL_TEST_DIR}/PoolInputCacheTrainingTest_cfg.py >& ${LOCAL_TMP_DIR}/PoolInputCacheTrainingTest2_cfg.txt || die 'Failure using PoolInputCacheTrainingTest_cfg.py with cache training file' $?
+grep 'The TTreeCache of the Events tree learns' ${LOCAL_TMP_DIR}/PoolInputCacheTrainingTest2_cfg.txt && die 'PoolInputCacheTrainingTest_cfg.py trained the cache despite the cache training file' 1
+test $(grep -c 'branches learned before, without a learning phase' ${LOCAL_TMP_DIR}/PoolInputCacheTrainingTest2_cfg.txt) -eq 2 || die 'PoolInputCacheTrainingTest_cfg.py did not use the cache training file' 1
+
 cmsRun ${LOCAL_TEST_DIR}/PrePool2FileInputTest_cfg.py || die 'Failure using PrePool2FileInputTest_cfg.py' $?
 cmsRun ${LOCAL_TEST_DIR}/Pool2FileInputTest_cfg.py || die 'Failure using Pool2FileInputTest_cfg.py' $?
 
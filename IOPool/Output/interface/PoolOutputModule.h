@@ -52,6 +52,7 @@ namespace edm {
     int const& splitLevel() const { return splitLevel_; }
     std::string const& basketOrder() const { return basketOrder_; }
     int const& treeMaxVirtualSize() const { return treeMaxVirtualSize_; }
+    bool serialBasketCompression() const { return serialBasketCompression_; }
     bool const& overrideInputFileSplitLevels() const { return overrideInputFileSplitLevels_; }
     DropMetaData const& dropMetaData() const { return dropMetaData_; }
     std::string const& catalog() const { return catalog_; }
@@ -87,7 +88,12 @@ namespace edm {
 
       OutputItem();
 
-      explicit OutputItem(BranchDescription const* bd, EDGetToken const& token, int splitLevel, int basketSize);
+      explicit OutputItem(BranchDescription const* bd,
+                          EDGetToken const& token,
+                          int splitLevel,
+                          int basketSize,
+                          std::string const& compressionAlgorithm = std::string(),
+                          int compressionLevel = -1);
 
       ~OutputItem() {}
 
@@ -101,6 +107,9 @@ namespace edm {
       mutable void const* product_;
       int splitLevel_;
       int basketSize_;
+      // An empty algorithm means the branch uses the file's compression settings.
+      std::string compressionAlgorithm_;
+      int compressionLevel_;
     };
 
     typedef std::vector<OutputItem> OutputItemList;
@@ -119,6 +128,17 @@ namespace edm {
       int splitLevel_;
     };
 
+    struct SpecialCompressionForBranch {
+      SpecialCompressionForBranch(std::string const& iBranchName,
+                                  std::string const& iCompressionAlgorithm,
+                                  int iCompressionLevel);
+      bool match(std::string const& iBranchName) const;
+
+      std::regex branch_;
+      std::string compressionAlgorithm_;
+      int compressionLevel_;
+    };
+
     OutputItemListArray const& selectedOutputItemList() const { return selectedOutputItemList_; }
 
     BranchChildren const& branchChildren() const { return branchChildren_; }
@@ -174,6 +194,7 @@ namespace edm {
     AuxItemArray auxItems_;
     OutputItemListArray selectedOutputItemList_;
     std::vector<SpecialSplitLevelForBranch> specialSplitLevelForBranches_;
+    std::vector<SpecialCompressionForBranch> specialCompressionForBranches_;
     std::string const fileName_;
     std::string const logicalFileName_;
     std::string const catalog_;
@@ -185,6 +206,7 @@ namespace edm {
     int const splitLevel_;
     std::string basketOrder_;
     int const treeMaxVirtualSize_;
+    bool const serialBasketCompression_;
     int whyNotFastClonable_;
     DropMetaData dropMetaData_;
     std::string const moduleLabel_;
@@ -33,6 +33,15 @@
 #include "boost/algorithm/string.hpp"
 
 namespace edm {
+  namespace {
+    std::regex globToRegex(std::string const& iGlobBranchExpression) {
+      std::string tmp(iGlobBranchExpression);
+      boost::replace_all(tmp, "*", ".*");
+      boost::replace_all(tmp, "?", ".");
+      return std::regex(tmp);
+    }
+  }  // namespace
+
   PoolOutputModule::PoolOutputModule(ParameterSet const& pset)
       : edm::one::OutputModuleBase::OutputModuleBase(pset),
         one::OutputModule<WatchInputFiles>(pset),
@@ -50,6 +59,7 @@ namespace edm {
         splitLevel_(std::min<int>(pset.getUntrackedParameter<int>("splitLevel") + 1, 99)),
         basketOrder_(pset.getUntrackedParameter<std::string>("sortBaskets")),
         treeMaxVirtualSize_(pset.getUntrackedParameter<int>("treeMaxVirtualSize")),
+        serialBasketCompression_(pset.getUntrackedParameter<bool>("serialBasketCompression")),
         whyNotFastClonable_(pset.getUntrackedParameter<bool>("fastCloning") ? FileBlock::CanFastClone
                                                                             : FileBlock::DisabledInConfigFile),
         dropMetaData_(DropNone),
@@ -99,6 +109,15 @@ namespace edm {
                                                  s.getUntrackedParameter<int>("splitLevel"));
     }
 
+    auto const& specialCompression{pset.getUntrackedParameterSetVector("overrideBranchesCompression")};
+
+    specialCompressionForBranches_.reserve(specialCompression.size());
+    for (auto const& s : specialCompression) {
+      specialCompressionForBranches_.emplace_back(s.getUntrackedParameter<std::string>("branch"),
+                                                  s.getUntrackedParameter<std::string>("compressionAlgorithm"),
+                                                  s.getUntrackedParameter<int>("compressionLevel"));
+    }
+
     // We don't use this next parameter, but we read it anyway because it is part
     // of the configuration of this module.  An external parser creates the
     // configuration by reading this source code.
@@ -124,13 +143,23 @@ namespace edm {
         token_(),
         product_(nullptr),
         splitLevel_(BranchDescription::invalidSplitLevel),
-        basketSize_(BranchDescription::invalidBasketSize) {}
+        basketSize_(BranchDescription::invalidBasketSize),
+        compressionAlgorithm_(),
+        compressionLevel_(-1) {}
 
   PoolOutputModule::OutputItem::OutputItem(BranchDescription const* bd,
                                            EDGetToken const& token,
                                            int splitLevel,
-                                           int basketSize)
-      : branchDescription_(bd), token_(token), product_(nullptr), splitLevel_(splitLevel), basketSize_(basketSize) {}
+                                           int basketSize,
+                                           std::string const& compressionAlgorithm,
+                                           int compressionLevel)
+      : branchDescription_(bd),
+        token_(token),
+        product_(nullptr),
+        splitLevel_(splitLevel),
+        basketSize_(basketSize),
+        compressionAlgorithm_(compressionAlgorithm),
+        compressionLevel_(compressionLevel) {}
 
   PoolOutputModule::OutputItem::Sorter::Sorter(TTree* tree) : treeMap_(new std::map<std::string, int>) {
     // Fill a map mapping branch names to an index specifying the order in the tree.
@@ -169,10 +198,18 @@ namespace edm {
   }
 
   std::regex PoolOutputModule::SpecialSplitLevelForBranch::convert(std::string const& iGlobBranchExpression) const {
-    std::string tmp(iGlobBranchExpression);
-    boost::replace_all(tmp, "*", ".*");
-    boost::replace_all(tmp, "?", ".");
-    return std::regex(tmp);
+    return globToRegex(iGlobBranchExpression);
+  }
+
+  PoolOutputModule::SpecialCompressionForBranch::SpecialCompressionForBranch(std::string const& iBranchName,
+                                                                             std::string const& iCompressionAlgorithm,
+                                                                             int iCompressionLevel)
+      : branch_(globToRegex(iBranchName)),
+        compressionAlgorithm_(iCompressionAlgorithm),
+        compressionLevel_(iCompressionLevel) {}
+
+  inline bool PoolOutputModule::SpecialCompressionForBranch::match(std::string const& iBranchName) const {
+    return std::regex_match(iBranchName, branch_);
   }
 
   void PoolOutputModule::fillSelectedItemList(BranchType branchType, TTree* theInputTree) {
@@ -214,7 +251,17 @@ namespace edm {
         }
         basketSize = (prod.basketSize() == BranchDescription::invalidBasketSize ? basketSize_ : prod.basketSize());
       }
-      outputItemList.emplace_back(&prod, kept.second, splitLevel, basketSize);
+      // The last matching entry wins, as for the split level. A file is not fast cloned if the
+      // compression of such a branch differs from the one of the input file.
+      std::string compressionAlgorithm;
+      int compressionLevel = -1;
+      for (auto const& b : specialCompressionForBranches_) {
+        if (b.match(prod.branchName())) {
+          compressionAlgorithm = b.compressionAlgorithm_;
+          compressionLevel = b.compressionLevel_;
+        }
+      }
+      outputItemList.emplace_back(&prod, kept.second, splitLevel, basketSize, compressionAlgorithm, compressionLevel);
     }
 
     // Sort outputItemList to allow fast copying.
@@ -440,7 +487,8 @@ namespace edm {
             "If over maximum, new output file will be started at next input file transition.");
     desc.addUntracked<int>("compressionLevel", 9)->setComment("ROOT compression level of output file.");
     desc.addUntracked<std::string>("compressionAlgorithm", "ZLIB")
-        ->setComment("Algorithm used to compress data in the ROOT output file, allowed values are ZLIB and LZMA");
+        ->setComment(
+            "Algorithm used to compress data in the ROOT output file, allowed values are ZLIB, LZMA, LZ4 and ZSTD");
     desc.addUntracked<int>("basketSize", 16384)->setComment("Default ROOT basket size in output file.");
     desc.addUntracked<int>("eventAutoFlushCompressedSize", 20 * 1024 * 1024)
         ->setComment(
@@ -455,6 +503,13 @@ namespace edm {
             "Used by ROOT when fast copying. Affects performance.");
     desc.addUntracked<int>("treeMaxVirtualSize", -1)
         ->setComment("Size of ROOT TTree TBasket cache.  Affects performance.");
+    desc.addUntracked<bool>("serialBasketCompression", false)
+        ->setComment(
+            "True:  Baskets are compressed one after the other by the thread running the output module.\n"
+            "False: ROOT's default: if ROOT implicit multi-threading is enabled, the baskets filled for an event "
+            "are compressed concurrently in TBB tasks, only writing them to the file is serialized.\n"
+            "Only turns the concurrent compression off, e.g. to compare or to keep the threads for other modules. "
+            "Affects performance, not the content of the output file.");
     desc.addUntracked<bool>("fastCloning", true)
         ->setComment(
             "True:  Allow fast copying, if possible.\n"
@@ -487,6 +542,20 @@ namespace edm {
       specialSplit.addUntracked<int>("splitLevel")->setComment("The special split level for the branch");
       desc.addVPSetUntracked("overrideBranchesSplitLevel", specialSplit, std::vector<ParameterSet>());
     }
+    {
+      ParameterSetDescription specialCompression;
+      specialCompression.addUntracked<std::string>("branch")->setComment(
+          "Name of branch needing a special compression. The name can contain wildcards '*' and '?', so e.g. "
+          "'recoVertexs_*' selects all branches of a given product type.");
+      specialCompression.addUntracked<std::string>("compressionAlgorithm")
+          ->setComment("The compression algorithm for the branch, allowed values are ZLIB, LZMA, LZ4 and ZSTD");
+      specialCompression.addUntracked<int>("compressionLevel")->setComment("The compression level for the branch");
+      desc.addVPSetUntracked("overrideBranchesCompression", specialCompression, std::vector<ParameterSet>())
+          ->setComment(
+              "Per branch compression settings overriding 'compressionAlgorithm' and 'compressionLevel'. "
+              "If several entries match a branch, the last one is used. An input file in which such a branch "
+              "has other compression settings is not fast cloned.");
+    }
     OutputModule::fillDescription(desc);
   }
 
@@ -67,6 +67,36 @@ namespace edm {
                                                : lh->processName() < rh->processName() ? true : false;
     }
 
+    ROOT::ECompressionAlgorithm compressionAlgorithmFromName(std::string const& algorithm) {
+      if (algorithm == std::string("ZLIB")) {
+        return ROOT::kZLIB;
+      } else if (algorithm == std::string("LZMA")) {
+        return ROOT::kLZMA;
+      } else if (algorithm == std::string("LZ4")) {
+        return ROOT::kLZ4;
+      } else if (algorithm == std::string("ZSTD")) {
+        return ROOT::kZSTD;
+      }
+      throw Exception(errors::Configuration)
+          << "PoolOutputModule configured with unknown compression algorithm '" << algorithm << "'\n"
+          << "Allowed compression algorithms are ZLIB, LZMA, LZ4 and ZSTD\n";
+    }
+
+    char const* compressionAlgorithmName(int algorithm) {
+      switch (algorithm) {
+        case ROOT::kZLIB:
+          return "ZLIB";
+        case ROOT::kLZMA:
+          return "LZMA";
+        case ROOT::kLZ4:
+          return "LZ4";
+        case ROOT::kZSTD:
+          return "ZSTD";
+        default:
+          return "UNKNOWN";
+      }
+    }
+
     TFile* openTFile(char const* name, int compressionLevel) {
       TFile* file = TFile::Open(name, "recreate", "", compressionLevel);
       std::exception_ptr e = edm::threadLocalException::getException();
@@ -108,24 +138,16 @@ namespace edm {
         pEventEntryInfoVector_(&eventEntryInfoVector_),
         pBranchListIndexes_(nullptr),
         pEventSelectionIDs_(nullptr),
-        eventTree_(filePtr(), InEvent, om_->splitLevel(), om_->treeMaxVirtualSize()),
-        lumiTree_(filePtr(), InLumi, om_->splitLevel(), om_->treeMaxVirtualSize()),
-        runTree_(filePtr(), InRun, om_->splitLevel(), om_->treeMaxVirtualSize()),
+        eventTree_(filePtr(), InEvent, om_->splitLevel(), om_->treeMaxVirtualSize(), om_->serialBasketCompression()),
+        lumiTree_(filePtr(), InLumi, om_->splitLevel(), om_->treeMaxVirtualSize(), om_->serialBasketCompression()),
+        runTree_(filePtr(), InRun, om_->splitLevel(), om_->treeMaxVirtualSize(), om_->serialBasketCompression()),
         treePointers_(),
         dataTypeReported_(false),
         processHistoryRegistry_(),
         parentageIDs_(),
         branchesWithStoredHistory_(),
         wrapperBaseTClass_(TClass::GetClass("edm::WrapperBase")) {
-    if (om_->compressionAlgorithm() == std::string("ZLIB")) {
-      filePtr_->SetCompressionAlgorithm(ROOT::kZLIB);
-    } else if (om_->compressionAlgorithm() == std::string("LZMA")) {
-      filePtr_->SetCompressionAlgorithm(ROOT::kLZMA);
-    } else {
-      throw Exception(errors::Configuration)
-          << "PoolOutputModule configured with unknown compression algorithm '" << om_->compressionAlgorithm() << "'\n"
-          << "Allowed compression algorithms are ZLIB and LZMA\n";
-    }
+    filePtr_->SetCompressionAlgorithm(compressionAlgorithmFromName(om_->compressionAlgorithm()));
     if (-1 != om->eventAutoFlushSize()) {
       eventTree_.setAutoFlush(-1 * om->eventAutoFlushSize());
     }
@@ -155,11 +177,17 @@ namespace edm {
       for (auto const& item : om_->selectedOutputItemList()[branchType]) {
         item.product_ = nullptr;
         BranchDescription const& desc = *item.branchDescription_;
+        int compressionSettings = -1;
+        if (!item.compressionAlgorithm_.empty()) {
+          compressionSettings = ROOT::CompressionSettings(compressionAlgorithmFromName(item.compressionAlgorithm_),
+                                                          item.compressionLevel_);
+        }
         theTree->addBranch(desc.branchName(),
                            desc.wrappedName(),
                            item.product_,
                            item.splitLevel_,
                            item.basketSize_,
+                           compressionSettings,
                            item.branchDescription_->produced());
         //make sure we always store product registry info for all branches we create
         branchesWithStoredHistory_.insert(item.branchID());
@@ -292,6 +320,10 @@ namespace edm {
         message << "The format of a data product has changed.\n";
         whyNotFastClonable &= ~(FileBlock::BranchMismatch);
       }
+      if ((whyNotFastClonable & FileBlock::CompressionMismatch) != 0) {
+        message << "the compression of a branch or branches was changed by 'overrideBranchesCompression'.\n";
+        whyNotFastClonable &= ~(FileBlock::CompressionMismatch);
+      }
       assert(whyNotFastClonable == FileBlock::CanFastClone);
       if (isWarning) {
         LogWarning("FastCloningDisabled") << message.str();
@@ -333,6 +365,10 @@ namespace edm {
         }
       }
 
+      if (!eventTree_.checkCompression(fb.tree())) {
+        whyNotFastClonable_ |= FileBlock::CompressionMismatch;
+      }
+
       // Since this check can be time consuming, we do it only if we would otherwise fast clone.
       if (whyNotFastClonable_ == FileBlock::CanFastClone) {
         if (!eventTree_.checkIfFastClonable(fb.tree())) {
@@ -627,6 +663,8 @@ namespace edm {
       treePointers_[branchType]->writeTree();
     }
 
+    reportBranchCompression();
+
     // close the file -- mfp
     // Just to play it safe, zero all pointers to objects in the TFile to be closed.
     metaDataTree_ = parentageTree_ = nullptr;
@@ -642,6 +680,31 @@ namespace edm {
     reportSvc->outputFileClosed(reportToken_);
   }
 
+  void RootOutputFile::reportBranchCompression() const {
+    // Report the codec and the achieved compression ratio of each event product branch.
+    // The baskets copied by fast cloning keep the compression of the input file, which may differ
+    // from the settings reported here, except for the branches with their own settings (see
+    // RootOutputTree::checkCompression).
+    Service<JobReport> reportSvc;
+    auto report = [this, &reportSvc](std::vector<TBranch*> const& branches) {
+      for (auto const* branch : branches) {
+        Long64_t const totBytes = branch->GetTotBytes("*");
+        Long64_t const zipBytes = branch->GetZipBytes("*");
+        std::map<std::string, std::string> metrics;
+        metrics["Algorithm"] = compressionAlgorithmName(branch->GetCompressionAlgorithm());
+        metrics["Level"] = std::to_string(branch->GetCompressionLevel());
+        metrics["TotBytes"] = std::to_string(totBytes);
+        metrics["ZipBytes"] = std::to_string(zipBytes);
+        metrics["CompressionRatio"] =
+            std::to_string(zipBytes > 0 ? static_cast<double>(totBytes) / static_cast<double>(zipBytes) : 0.);
+        reportSvc->reportPerformanceForModule(
+            "BranchCompression", om_->moduleLabel() + ":" + branch->GetName(), metrics);
+      }
+    };
+    report(eventTree_.producedBranches());
+    report(eventTree_.readBranches());
+  }
+
   void RootOutputFile::setBranchAliases(TTree* tree, SelectedProducts const& branches) const {
     if (tree && tree->GetNbranches() != 0) {
       for (auto const& selection : branches) {
@@ -85,6 +85,8 @@ namespace edm {
 
     void setBranchAliases(TTree* tree, SelectedProducts const& branches) const;
 
+    void reportBranchCompression() const;
+
     void fillBranches(BranchType const& branchType,
                       OccurrenceForOutput const& occurrence,
                       StoredProductProvenanceVector* productProvenanceVecPtr = nullptr,
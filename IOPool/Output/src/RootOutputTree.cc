@@ -96,11 +96,13 @@ namespace edm {
   RootOutputTree::RootOutputTree(std::shared_ptr<TFile> filePtr,
                                  BranchType const& branchType,
                                  int splitLevel,
-                                 int treeMaxVirtualSize)
+                                 int treeMaxVirtualSize,
+                                 bool serialBasketCompression)
       : filePtr_(filePtr),
         tree_(makeTTree(filePtr.get(), BranchTypeToProductTreeName(branchType), splitLevel)),
         producedBranches_(),
         readBranches_(),
+        readBranchesWithCompression_(),
         auxBranches_(),
         unclonedReadBranches_(),
         clonedReadBranchNames_(),
@@ -108,6 +110,11 @@ namespace edm {
         fastCloneAuxBranches_(false) {
     if (treeMaxVirtualSize >= 0)
       tree_->SetMaxVirtualSize(treeMaxVirtualSize);
+    // With ROOT implicit multi-threading enabled, TTree::Fill compresses each basket that becomes
+    // full in its own TBB task, and only serializes writing it to the file.  This turns that off.
+    if (serialBasketCompression) {
+      tree_->SetImplicitMT(false);
+    }
   }
 
   TTree* RootOutputTree::assignTTree(TFile* filePtr, TTree* tree) {
@@ -148,6 +155,20 @@ namespace edm {
     return true;
   }
 
+  bool RootOutputTree::checkCompression(TTree* inputTree) const {
+    assert(inputTree != nullptr);
+
+    // Fast cloning copies the baskets as they are, so a branch with its own compression settings
+    // can be fast cloned only if the input file already uses them.
+    for (auto const& outputBranch : readBranchesWithCompression_) {
+      TBranch* inputBranch = inputTree->GetBranch(outputBranch->GetName());
+      if (inputBranch != nullptr && inputBranch->GetCompressionSettings() != outputBranch->GetCompressionSettings()) {
+        return false;
+      }
+    }
+    return true;
+  }
+
   namespace {
     bool checkMatchingBranches(TBranchElement* inputBranch, TBranchElement* outputBranch) {
       if (inputBranch->GetStreamerType() != outputBranch->GetStreamerType()) {
@@ -330,11 +351,16 @@ namespace edm {
                                  void const*& pProd,
                                  int splitLevel,
                                  int basketSize,
+                                 int compressionSettings,
                                  bool produced) {
     assert(splitLevel != BranchDescription::invalidSplitLevel);
     assert(basketSize != BranchDescription::invalidBasketSize);
     TBranch* branch = tree_->Branch(branchName.c_str(), className.c_str(), &pProd, basketSize, splitLevel);
     assert(branch != nullptr);
+    if (compressionSettings >= 0) {
+      // Also applies to all the sub-branches of a split branch.
+      branch->SetCompressionSettings(compressionSettings);
+    }
     /*
       if(pProd != nullptr) {
         // Delete the product that ROOT has allocated.
@@ -347,6 +373,9 @@ namespace edm {
       producedBranches_.push_back(branch);
     } else {
       readBranches_.push_back(branch);
+      if (compressionSettings >= 0) {
+        readBranchesWithCompression_.push_back(branch);
+      }
     }
   }
 
@@ -357,6 +386,7 @@ namespace edm {
     unclonedAuxBranches_.clear();
     producedBranches_.clear();
     readBranches_.clear();
+    readBranchesWithCompression_.clear();
     unclonedReadBranches_.clear();
     tree_ = nullptr;     // propagate_const<T> has no reset() function
     filePtr_ = nullptr;  // propagate_const<T> has no reset() function
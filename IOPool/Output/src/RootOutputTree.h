@@ -23,7 +23,11 @@ class TBranch;
 namespace edm {
   class RootOutputTree {
   public:
-    RootOutputTree(std::shared_ptr<TFile> filePtr, BranchType const& branchType, int splitLevel, int treeMaxVirtualSize);
+    RootOutputTree(std::shared_ptr<TFile> filePtr,
+                   BranchType const& branchType,
+                   int splitLevel,
+                   int treeMaxVirtualSize,
+                   bool serialBasketCompression);
 
     ~RootOutputTree() {}
 
@@ -63,10 +67,13 @@ namespace edm {
                    void const*& pProd,
                    int splitLevel,
                    int basketSize,
+                   int compressionSettings,
                    bool produced);
 
     bool checkSplitLevelsAndBasketSizes(TTree* inputTree) const;
 
+    bool checkCompression(TTree* inputTree) const;
+
     bool checkIfFastClonable(TTree* inputTree) const;
 
     bool checkEntriesInReadBranches(Long64_t expectedNumberOfEntries) const;
@@ -96,6 +103,10 @@ namespace edm {
 
     void setAutoFlush(Long64_t size) { tree_->SetAutoFlush(size); }
 
+    std::vector<TBranch*> const& producedBranches() const { return producedBranches_; }
+
+    std::vector<TBranch*> const& readBranches() const { return readBranches_; }
+
   private:
     static void fillTTree(std::vector<TBranch*> const& branches);
     // We use bare pointers for pointers to some ROOT entities.
@@ -106,6 +117,7 @@ namespace edm {
 
     std::vector<TBranch*> producedBranches_;  // does not include cloned branches
     std::vector<TBranch*> readBranches_;
+    std::vector<TBranch*> readBranchesWithCompression_;  // read branches with their own compression settings
     std::vector<TBranch*> auxBranches_;
     std::vector<TBranch*> unclonedAuxBranches_;
     std::vector<TBranch*> unclonedReadBranches_;
@@ -0,0 +1,64 @@
+# Throughput benchmark for PoolOutputModule with the baskets compressed concurrently
+# (ROOT implicit multi-threading, the default) or one after the other.
+#
+# Usage: cmsRun PoolOutputBasketFlushBenchmark_cfg.py <serialBasketCompression: 0|1> [nThreads] [nEvents]
+#
+# The products mimic a MINIAOD-like event content: a few large collections and
+# many small ones.  Compare the 'Timing' summary (event throughput) and the
+# 'TimeReport' line of the output module between the two modes.
+
+import FWCore.ParameterSet.Config as cms
+import sys
+
+argv = []
+foundpy = False
+for a in sys.argv:
+    if foundpy:
+        argv.append(a)
+    if ".py" in a:
+        foundpy = True
+
+serialBasketCompression = bool(int(argv[0])) if len(argv) > 0 else False
+nThreads = int(argv[1]) if len(argv) > 1 else 8
+nEvents = int(argv[2]) if len(argv) > 2 else 2000
+
+process = cms.Process("BENCHMARK")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(nEvents)
+)
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(nThreads),
+    numberOfStreams = cms.untracked.uint32(0),
+    wantSummary = cms.untracked.bool(True)
+)
+
+process.source = cms.Source("EmptySource")
+
+process.Timing = cms.Service("Timing",
+    summaryOnly = cms.untracked.bool(True)
+)
+
+# (number of products, entries per product)
+productSizes = [(4, 20000), (16, 2000), (80, 50)]
+
+process.t = cms.Task()
+for iSize, (nProducts, count) in enumerate(productSizes):
+    for i in range(nProducts):
+        label = "intVector%d_%d" % (iSize, i)
+        setattr(process, label, cms.EDProducer("IntVectorProducer",
+            count = cms.int32(count),
+            ivalue = cms.int32(i),
+            delta = cms.int32(iSize + 1)
+        ))
+        process.t.add(getattr(process, label))
+
+process.output = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('file:PoolOutputBasketFlushBenchmark.root'),
+    compressionAlgorithm = cms.untracked.string("LZMA"),
+    compressionLevel = cms.untracked.int32(4),
+    serialBasketCompression = cms.untracked.bool(serialBasketCompression)
+)
+
+process.ep = cms.EndPath(process.output, process.t)
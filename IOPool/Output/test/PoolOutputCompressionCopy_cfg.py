@@ -0,0 +1,41 @@
+# Copies the file written by PoolOutputCompressionTest_cfg.py, changing the
+# compression of some branches or not.  The input file cannot be fast cloned
+# if the compression of one of these branches differs from the input.
+#
+#   cmsRun PoolOutputCompressionCopy_cfg.py <output file> <algorithm of edmtestThings_*> <level>
+
+import FWCore.ParameterSet.Config as cms
+import sys
+
+argv = []
+foundpy = False
+for a in sys.argv:
+    if foundpy:
+        argv.append(a)
+    if ".py" in a:
+        foundpy = True
+
+process = cms.Process("TESTOUTPUTCOMPRESSIONCOPY")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(-1)
+)
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring('file:PoolOutputCompressionTest.root')
+)
+
+process.output = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('file:' + argv[0]),
+    compressionAlgorithm = cms.untracked.string("LZMA"),
+    compressionLevel = cms.untracked.int32(4),
+    overrideBranchesCompression = cms.untracked.VPSet(
+        cms.untracked.PSet(
+            branch = cms.untracked.string("edmtestThings_*"),
+            compressionAlgorithm = cms.untracked.string(argv[1]),
+            compressionLevel = cms.untracked.int32(int(argv[2]))
+        )
+    )
+)
+
+process.ep = cms.EndPath(process.output)
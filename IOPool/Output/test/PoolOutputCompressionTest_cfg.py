@@ -0,0 +1,34 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTOUTPUTCOMPRESSION")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(20)
+)
+process.Thing = cms.EDProducer("ThingProducer")
+
+process.OtherThing = cms.EDProducer("OtherThingProducer")
+
+process.output = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('file:PoolOutputCompressionTest.root'),
+    compressionAlgorithm = cms.untracked.string("LZMA"),
+    compressionLevel = cms.untracked.int32(4),
+    overrideBranchesCompression = cms.untracked.VPSet(
+        cms.untracked.PSet(
+            branch = cms.untracked.string("edmtestThings_*"),
+            compressionAlgorithm = cms.untracked.string("ZSTD"),
+            compressionLevel = cms.untracked.int32(5)
+        ),
+        cms.untracked.PSet(
+            branch = cms.untracked.string("edmtestOtherThings_OtherThing_testUserTag_*"),
+            compressionAlgorithm = cms.untracked.string("LZ4"),
+            compressionLevel = cms.untracked.int32(4)
+        )
+    )
+)
+
+process.source = cms.Source("EmptySource")
+
+process.p = cms.Path(process.Thing*process.OtherThing)
+process.ep = cms.EndPath(process.output)
@@ -0,0 +1,19 @@
+# Reads the two files written by PoolOutputSerialCompressionTest_cfg.py.
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TESTOUTPUTSERIALCOMPRESSIONREAD")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(-1)
+)
+process.source = cms.Source("PoolSource",
+    fileNames = cms.untracked.vstring('file:PoolOutputParallelCompression.root',
+        'file:PoolOutputSerialCompression.root'),
+    duplicateCheckMode = cms.untracked.string('noDuplicateCheck')
+)
+
+process.Analysis = cms.EDAnalyzer("OtherThingAnalyzer")
+
+process.p = cms.Path(process.Analysis)
@@ -0,0 +1,43 @@
+# Writes the same events with the baskets compressed concurrently (ROOT implicit
+# multi-threading) or one after the other.  With a single stream the events are
+# written in the same order, so both files must have the same content and the
+# same compressed branch sizes.
+#
+#   cmsRun -j <job report> PoolOutputSerialCompressionTest_cfg.py <output file> <serialBasketCompression: 0|1>
+
+import FWCore.ParameterSet.Config as cms
+import sys
+
+argv = []
+foundpy = False
+for a in sys.argv:
+    if foundpy:
+        argv.append(a)
+    if ".py" in a:
+        foundpy = True
+
+process = cms.Process("TESTOUTPUTSERIALCOMPRESSION")
+process.load("FWCore.Framework.test.cmsExceptionsFatal_cff")
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(4),
+    numberOfStreams = cms.untracked.uint32(1)
+)
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(200)
+)
+process.Thing = cms.EDProducer("ThingProducer")
+
+process.OtherThing = cms.EDProducer("OtherThingProducer")
+
+process.output = cms.OutputModule("PoolOutputModule",
+    fileName = cms.untracked.string('file:' + argv[0]),
+    basketSize = cms.untracked.int32(1024),
+    serialBasketCompression = cms.untracked.bool(bool(int(argv[1])))
+)
+
+process.source = cms.Source("EmptySource")
+
+process.p = cms.Path(process.Thing*process.OtherThing)
+process.ep = cms.EndPath(process.output)
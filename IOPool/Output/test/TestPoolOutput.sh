@@ -33,4 +33,25 @@ cmsRun ${LOCAL_TEST_DIR}/TestProvC_cfg.py || die 'Failure using TestProvC_cfg.py
 cmsRun ${LOCAL_TEST_DIR}/PoolOutputTestUnscheduled_cfg.py || die 'Failure using PoolOutputTestUnscheduled_cfg.py' $?
 cmsRun ${LOCAL_TEST_DIR}/PoolOutputTestUnscheduledRead_cfg.py || die 'Failure using PoolOutputTestUnscheduledRead_cfg.py' $?
 
+cmsRun -j PoolOutputCompressionTest_jobreport.xml ${LOCAL_TEST_DIR}/PoolOutputCompressionTest_cfg.py || die 'Failure using PoolOutputCompressionTest_cfg.py' $?
+python ${LOCAL_TEST_DIR}/checkBranchCompression.py PoolOutputCompressionTest_jobreport.xml '*=LZMA:4' 'edmtestThings_*=ZSTD:5' 'edmtestOtherThings_OtherThing_testUserTag_*=LZ4:4' || die 'Wrong branch compression in PoolOutputCompressionTest_jobreport.xml' $?
+#reads file from above
+cmsRun ${LOCAL_TEST_DIR}/PoolOutputCompressionRead_cfg.py || die 'Failure using PoolOutputCompressionRead_cfg.py' $?
+#copies it keeping the compression: fast cloned
+cmsRun -j PoolOutputCompressionSame_jobreport.xml ${LOCAL_TEST_DIR}/PoolOutputCompressionCopy_cfg.py PoolOutputCompressionSame.root ZSTD 5 || die 'Failure using PoolOutputCompressionCopy_cfg.py' $?
+python ${LOCAL_TEST_DIR}/checkBranchCompression.py PoolOutputCompressionSame_jobreport.xml --fastCopying 1 '*=LZMA:4' 'edmtestThings_*=ZSTD:5' || die 'Wrong fast copying or compression in PoolOutputCompressionSame_jobreport.xml' $?
+#copies it changing the compression of some branches: not fast cloned
+cmsRun -j PoolOutputCompressionChanged_jobreport.xml ${LOCAL_TEST_DIR}/PoolOutputCompressionCopy_cfg.py PoolOutputCompressionChanged.root ZLIB 1 || die 'Failure using PoolOutputCompressionCopy_cfg.py' $?
+python ${LOCAL_TEST_DIR}/checkBranchCompression.py PoolOutputCompressionChanged_jobreport.xml --fastCopying 0 '*=LZMA:4' 'edmtestThings_*=ZLIB:1' || die 'Wrong fast copying or compression in PoolOutputCompressionChanged_jobreport.xml' $?
+
+cmsRun -j PoolOutputParallelCompression_jobreport.xml ${LOCAL_TEST_DIR}/PoolOutputSerialCompressionTest_cfg.py PoolOutputParallelCompression.root 0 || die 'Failure using PoolOutputSerialCompressionTest_cfg.py' $?
+cmsRun -j PoolOutputSerialCompression_jobreport.xml ${LOCAL_TEST_DIR}/PoolOutputSerialCompressionTest_cfg.py PoolOutputSerialCompression.root 1 || die 'Failure using PoolOutputSerialCompressionTest_cfg.py with serialBasketCompression' $?
+#the compressed size of each branch must not depend on where the baskets were compressed
+grep -o 'Module="[^"]*"\|Name="ZipBytes" Value="[^"]*"' PoolOutputParallelCompression_jobreport.xml > PoolOutputParallelCompression_zipBytes.txt
+grep -o 'Module="[^"]*"\|Name="ZipBytes" Value="[^"]*"' PoolOutputSerialCompression_jobreport.xml > PoolOutputSerialCompression_zipBytes.txt
+test -s PoolOutputSerialCompression_zipBytes.txt || die 'No branch sizes in PoolOutputSerialCompression_jobreport.xml' 1
+diff PoolOutputParallelCompression_zipBytes.txt PoolOutputSerialCompression_zipBytes.txt || die 'Different branch sizes with serialBasketCompression' $?
+#reads files from above
+cmsRun ${LOCAL_TEST_DIR}/PoolOutputSerialCompressionRead_cfg.py || die 'Failure using PoolOutputSerialCompressionRead_cfg.py' $?
+
 popd
@@ -0,0 +1,52 @@
+#!/usr/bin/env python
+# Checks the 'BranchCompression' entries and the fast copying status of a job report.
+#
+#   checkBranchCompression.py <job report> [--fastCopying 0|1] <branch glob>=<algorithm>:<level> ...
+#
+# The last matching glob gives the expected compression of a branch, as in PoolOutputModule.
+
+from __future__ import print_function
+import fnmatch
+import sys
+import xml.etree.ElementTree as ET
+
+args = sys.argv[1:]
+report = ET.parse(args.pop(0)).getroot()
+fastCopying = None
+if args and args[0] == '--fastCopying':
+    args.pop(0)
+    fastCopying = args.pop(0)
+expected = []
+for a in args:
+    glob, setting = a.split('=')
+    algorithm, level = setting.split(':')
+    expected.append((glob, algorithm, level))
+
+failures = 0
+if fastCopying is not None:
+    for status in report.iter('FastCopying'):
+        if status.text.strip() != fastCopying:
+            print('FastCopying is', status.text.strip(), 'instead of', fastCopying)
+            failures += 1
+
+branches = 0
+for module in report.iter('PerformanceModule'):
+    if module.get('Metric') != 'BranchCompression':
+        continue
+    branches += 1
+    branch = module.get('Module').split(':', 1)[1]
+    metrics = dict((m.get('Name'), m.get('Value')) for m in module.iter('Metric'))
+    for glob, algorithm, level in expected:
+        if fnmatch.fnmatchcase(branch, glob):
+            want = (algorithm, level)
+    if (metrics['Algorithm'], metrics['Level']) != want:
+        print(branch, 'is compressed with', metrics['Algorithm'], metrics['Level'], 'instead of', want[0], want[1])
+        failures += 1
+    if int(metrics['ZipBytes']) <= 0 or float(metrics['CompressionRatio']) <= 0.:
+        print(branch, 'has no compressed bytes')
+        failures += 1
+
+if branches == 0:
+    print('no BranchCompression entry in the job report')
+    failures += 1
+sys.exit(1 if failures else 0)
@@ -11,6 +11,8 @@
 #include "TBufferFile.h"
 
 #include <cstdint>
+#include <cstdlib>
+#include <new>
 #include <vector>
 
 #include "DataFormats/Provenance/interface/BranchIDList.h"
@@ -28,10 +30,17 @@ struct SerializeDataBuffer {
       : comp_buf_(reserve_size + init_size),
         curr_event_size_(),
         curr_space_used_(),
-        rootbuf_(TBuffer::kWrite, init_size),
+        curr_bytes_copied_(),
+        rootbuf_(TBuffer::kWrite, init_size, allocateFramed(init_size), kFALSE, &reallocFramed),
         ptr_((unsigned char *)rootbuf_.Buffer()),
         header_buf_(),
-        adler32_chksum_(0) {}
+        adler32_chksum_(0),
+        run_(),
+        event_(),
+        lumi_() {}
+  ~SerializeDataBuffer() { std::free(rootbuf_.Buffer() - reserve_size); }
+  SerializeDataBuffer(SerializeDataBuffer const &) = delete;
+  SerializeDataBuffer &operator=(SerializeDataBuffer const &) = delete;
 
   // This object caches the results of the last INIT or event
   // serialization operation.  You get access to the data using the
@@ -42,6 +51,8 @@ struct SerializeDataBuffer {
   unsigned int currentSpaceUsed() const { return curr_space_used_; }
   unsigned int currentEventSize() const { return curr_event_size_; }
   uint32_t adler32_chksum() const { return adler32_chksum_; }
+  // bytes of the last event message copied after serialization (header and, if any, event data)
+  unsigned int currentBytesCopied() const { return curr_bytes_copied_; }
 
   void clearHeaderBuffer() {
     header_buf_.clear();
@@ -52,11 +63,35 @@ struct SerializeDataBuffer {
 
   std::vector<unsigned char> comp_buf_;  // space for compressed data
   unsigned int curr_event_size_;
-  unsigned int curr_space_used_;  // less than curr_event_size_ if compressed
-  TBufferFile rootbuf_;
+  unsigned int curr_space_used_;    // less than curr_event_size_ if compressed
+  unsigned int curr_bytes_copied_;  // see currentBytesCopied()
+  TBufferFile rootbuf_;             // preceded by reserve_size bytes, see allocateFramed()
   edm::propagate_const<unsigned char *> ptr_;  // set to the place where the last event stored
   SBuffer header_buf_;                         // place for INIT message creation and streamer event header
   uint32_t adler32_chksum_;                    // adler32 check sum for the (compressed) data
+
+  // event message header fields of the last serialized event, kept here so that
+  // the message can be framed after the event itself is gone
+  uint32_t run_;
+  uint64_t event_;
+  uint32_t lumi_;
+  std::vector<unsigned char> hltbits_;
+
+private:
+  // The memory of rootbuf_ starts reserve_size bytes before the ROOT buffer, the same
+  // space comp_buf_ keeps in front of the compressed data: an uncompressed event is
+  // framed by writing its message header just before it, without copying the event.
+  // ROOT only sees the part after the reserved space, so its offsets are unchanged.
+  static char *allocateFramed(size_t size) {
+    auto *memory = static_cast<char *>(std::malloc(reserve_size + size));
+    if (memory == nullptr)
+      throw std::bad_alloc();
+    return memory + reserve_size;
+  }
+  static char *reallocFramed(char *buffer, size_t size, size_t) {
+    auto *memory = static_cast<char *>(std::realloc(buffer - reserve_size, reserve_size + size));
+    return memory == nullptr ? nullptr : memory + reserve_size;
+  }
 };
 
 class EventMsgBuilder;
@@ -83,6 +118,21 @@ namespace edm {
                        int compression_level,
                        unsigned int reserveSize) const;
 
+    /**
+     * The two halves of serializeEvent(): serializeEventData() streams the
+     * event into data_buffer.rootbuf_ and needs the event, compressEvent()
+     * compresses it (or, if uncompressed, just points at it) and computes
+     * the checksum, and can run later on any thread.
+     */
+    int serializeEventData(SerializeDataBuffer &data_buffer,
+                           EventForOutput const &event,
+                           ParameterSetID const &selectorConfig) const;
+
+    static unsigned int compressEvent(SerializeDataBuffer &data_buffer,
+                                      StreamerCompressionAlgo compressionAlgo,
+                                      int compression_level,
+                                      unsigned int reserveSize);
+
     /**
      * Compresses the data in the specified input buffer into the
      * specified output buffer.  Returns the size of the compressed data
@@ -6,7 +6,13 @@
 #include "FWCore/Utilities/interface/EDGetToken.h"
 #include "IOPool/Streamer/interface/MsgTools.h"
 //#include "IOPool/Streamer/interface/StreamSerializer.h"
-//#include <memory>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
 //#include <vector>
 
 class InitMsgBuilder;
@@ -39,9 +45,38 @@ namespace edm {
 
     Trig getTriggerResults(EDGetTokenT<TriggerResults> const& token, EventForOutput const& e) const;
 
+    // An event serialized in write() and compressed in a TBB task. The event goes from
+    // kQueued to kCompressing to kDone; it is compressed by whichever of its task and
+    // the module claims it first.
+    struct PendingEvent {
+      enum State { kQueued, kCompressing, kDone };
+      bool claim() {
+        int expected = kQueued;
+        return state_.compare_exchange_strong(expected, kCompressing);
+      }
+      std::shared_ptr<SerializeDataBuffer> buffer_;
+      std::unique_ptr<EventMsgBuilder> msg_;  // points into buffer_
+      std::exception_ptr exception_;
+      std::atomic<int> state_{kQueued};
+      std::mutex mutex_;
+      std::condition_variable done_;
+    };
+    void compressPendingEvent(PendingEvent& pending);
+    void waitForPendingEvent(PendingEvent& pending);
+    void writeCompressedEvents(std::size_t maxPending);
+    void countWrittenEvent(SerializeDataBuffer const& sbuf);
+
   private:
     edm::EDGetTokenT<edm::TriggerResults> trToken_;
 
+    unsigned int maxConcurrentCompressions_;
+    std::deque<std::shared_ptr<PendingEvent>> pendingEvents_;  // in the order the events were serialized
+
+    unsigned long long eventsWritten_ = 0;
+    unsigned long long bytesCopied_ = 0;
+    std::chrono::steady_clock::time_point firstWrite_;
+    std::chrono::steady_clock::time_point lastWrite_;
+
   };  //end-of-class-def
 
 }  // namespace edm
@@ -5,6 +5,7 @@
 #include "FWCore/Common/interface/TriggerNames.h"
 #include "IOPool/Streamer/interface/StreamSerializer.h"
 #include "DataFormats/Common/interface/Handle.h"
+#include "FWCore/Utilities/interface/ReusableObjectHolder.h"
 #include <memory>
 #include <vector>
 
@@ -35,10 +36,23 @@ namespace edm {
                                                     Handle<TriggerResults> const& triggerResults,
                                                     ParameterSetID const& selectorCfg);
 
+    // serializeEvent() in two steps: serializeEventData() needs the event,
+    // compressAndFrameEvent() only needs sbuf and may run concurrently with
+    // other calls for different buffers
+    void serializeEventData(SerializeDataBuffer& sbuf,
+                            EventForOutput const& e,
+                            Handle<TriggerResults> const& triggerResults,
+                            ParameterSetID const& selectorCfg) const;
+    std::unique_ptr<EventMsgBuilder> compressAndFrameEvent(SerializeDataBuffer& sbuf) const;
+
     SerializeDataBuffer* getSerializerBuffer();
+    // a buffer from a pool, for events serialized or compressed concurrently;
+    // it goes back to the pool when the last shared_ptr to it is released
+    std::shared_ptr<SerializeDataBuffer> getPooledSerializerBuffer();
 
   protected:
     std::unique_ptr<SerializeDataBuffer> serializerBuffer_;
+    edm::ReusableObjectHolder<SerializeDataBuffer> serializerBufferPool_;
 
   private:
     void setHltMask(EventForOutput const& e,
@@ -130,6 +130,13 @@ namespace edm {
                                        StreamerCompressionAlgo compressionAlgo,
                                        int compression_level,
                                        unsigned int reserveSize) const {
+    serializeEventData(data_buffer, event, selectorConfig);
+    return compressEvent(data_buffer, compressionAlgo, compression_level, reserveSize);
+  }
+
+  int StreamSerializer::serializeEventData(SerializeDataBuffer &data_buffer,
+                                           EventForOutput const &event,
+                                           ParameterSetID const &selectorConfig) const {
     EventSelectionIDVector selectionIDs = event.eventSelectionIDs();
     selectionIDs.push_back(selectorConfig);
     SendEvent se(event.eventAuxiliary(), event.processHistory(), selectionIDs, event.branchListIndexes());
@@ -211,6 +218,13 @@ namespace edm {
     // eventMessage.eventAddr());
     // eventMessage.setEventLength(rootbuf.Length());
 
+    return data_buffer.curr_event_size_;
+  }
+
+  unsigned int StreamSerializer::compressEvent(SerializeDataBuffer &data_buffer,
+                                               StreamerCompressionAlgo compressionAlgo,
+                                               int compression_level,
+                                               unsigned int reserveSize) {
     // compress before return if we need to
     // should test if compressed already - should never be?
     //   as double compression can have problems
@@ -238,16 +252,16 @@ namespace edm {
                                        reserveSize);
         break;
       default:
+        // the ROOT buffer has the same reserved space in front of it as comp_buf_, so the
+        // uncompressed event is used in place instead of being copied into comp_buf_
         dest_size = data_buffer.rootbuf_.Length();
-        if (data_buffer.comp_buf_.size() < dest_size + reserveSize)
-          data_buffer.comp_buf_.resize(dest_size + reserveSize);
-        std::copy((char *)data_buffer.rootbuf_.Buffer(),
-                  (char *)data_buffer.rootbuf_.Buffer() + dest_size,
-                  (char *)(&data_buffer.comp_buf_[SerializeDataBuffer::reserve_size]));
         break;
     };
 
-    data_buffer.ptr_ = &data_buffer.comp_buf_[reserveSize];  // reset to point at compressed area
+    if (compressionAlgo == UNCOMPRESSED)
+      data_buffer.ptr_ = (unsigned char *)data_buffer.rootbuf_.Buffer();
+    else
+      data_buffer.ptr_ = &data_buffer.comp_buf_[reserveSize];  // reset to point at compressed area
     data_buffer.curr_space_used_ = dest_size;
 
     // calculate the adler32 checksum and fill it into the struct
@@ -3,7 +3,9 @@
 
 #include "IOPool/Streamer/interface/InitMsgBuilder.h"
 #include "IOPool/Streamer/interface/EventMsgBuilder.h"
+#include "FWCore/Concurrency/interface/FunctorTask.h"
 #include "FWCore/Framework/interface/EventForOutput.h"
+#include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
 #include "FWCore/ParameterSet/interface/ParameterSetDescription.h"
 #include "DataFormats/Common/interface/TriggerResults.h"
@@ -17,9 +19,17 @@ namespace edm {
       : one::OutputModuleBase::OutputModuleBase(ps),
         one::OutputModule<one::WatchRuns, one::WatchLuminosityBlocks>(ps),
         StreamerOutputModuleCommon(ps, &keptProducts()[InEvent]),
-        trToken_(consumes<edm::TriggerResults>(edm::InputTag("TriggerResults"))) {}
-
-  StreamerOutputModuleBase::~StreamerOutputModuleBase() {}
+        trToken_(consumes<edm::TriggerResults>(edm::InputTag("TriggerResults"))),
+        maxConcurrentCompressions_(ps.getUntrackedParameter<unsigned int>("concurrentCompressions")) {}
+
+  StreamerOutputModuleBase::~StreamerOutputModuleBase() {
+    // if the job stopped with an exception, events may still be pending: claim those whose
+    // task has not started, so that it does not use this module, and wait for those being compressed
+    for (auto const& pending : pendingEvents_) {
+      if (not pending->claim())
+        waitForPendingEvent(*pending);
+    }
+  }
 
   void StreamerOutputModuleBase::beginRun(RunForOutput const&) {
     start();
@@ -35,21 +45,109 @@ namespace edm {
     serializerBuffer_->clearHeaderBuffer();
   }
 
-  void StreamerOutputModuleBase::endRun(RunForOutput const&) { stop(); }
+  void StreamerOutputModuleBase::endRun(RunForOutput const&) {
+    writeCompressedEvents(0);
+    stop();
+  }
 
   void StreamerOutputModuleBase::beginJob() {}
 
-  void StreamerOutputModuleBase::endJob() { stop(); }
+  void StreamerOutputModuleBase::endJob() {
+    writeCompressedEvents(0);
+    stop();
+
+    if (eventsWritten_ > 0) {
+      std::chrono::duration<double> elapsed = lastWrite_ - firstWrite_;
+      LogInfo("StreamerOutputModule") << description().moduleLabel() << ": " << eventsWritten_ << " events written, "
+                                      << double(bytesCopied_) / eventsWritten_
+                                      << " bytes copied per event after serialization, "
+                                      << (elapsed.count() > 0. ? (eventsWritten_ - 1) / elapsed.count() : 0.)
+                                      << " events/s";
+    }
+  }
 
   void StreamerOutputModuleBase::writeRun(RunForOutput const&) {}
 
-  void StreamerOutputModuleBase::writeLuminosityBlock(LuminosityBlockForOutput const&) {}
+  void StreamerOutputModuleBase::writeLuminosityBlock(LuminosityBlockForOutput const&) {
+    // all the events of the luminosity block go out before it ends, as when compressing in write()
+    writeCompressedEvents(0);
+  }
 
   void StreamerOutputModuleBase::write(EventForOutput const& e) {
     Handle<TriggerResults> const& triggerResults = getTriggerResults(trToken_, e);
 
-    std::unique_ptr<EventMsgBuilder> msg = serializeEvent(*getSerializerBuffer(), e, triggerResults, selectorConfig());
-    doOutputEvent(*msg);  // You can't use msg in StreamerOutputModuleBase after this point
+    if (maxConcurrentCompressions_ == 0) {
+      std::unique_ptr<EventMsgBuilder> msg =
+          serializeEvent(*getSerializerBuffer(), e, triggerResults, selectorConfig());
+      doOutputEvent(*msg);  // You can't use msg in StreamerOutputModuleBase after this point
+      countWrittenEvent(*getSerializerBuffer());
+      return;
+    }
+
+    // Only the serialization needs the event. The compression and the framing of the message
+    // run in a task, so that this module can take the next event, possibly from another stream,
+    // meanwhile; the compressed messages are written in order by later calls.
+    auto pending = std::make_shared<PendingEvent>();
+    pending->buffer_ = getPooledSerializerBuffer();
+    serializeEventData(*pending->buffer_, e, triggerResults, selectorConfig());
+    pendingEvents_.push_back(pending);
+    auto task = make_functor_task(tbb::task::allocate_root(), [this, pending]() {
+      if (pending->claim())
+        compressPendingEvent(*pending);
+    });
+    tbb::task::spawn(*task);
+
+    writeCompressedEvents(maxConcurrentCompressions_);
+  }
+
+  void StreamerOutputModuleBase::compressPendingEvent(PendingEvent& pending) {
+    try {
+      pending.msg_ = compressAndFrameEvent(*pending.buffer_);
+    } catch (...) {
+      pending.exception_ = std::current_exception();
+    }
+    {
+      std::lock_guard<std::mutex> guard(pending.mutex_);
+      pending.state_ = PendingEvent::kDone;
+    }
+    pending.done_.notify_all();
+  }
+
+  void StreamerOutputModuleBase::waitForPendingEvent(PendingEvent& pending) {
+    std::unique_lock<std::mutex> lock(pending.mutex_);
+    pending.done_.wait(lock, [&pending]() { return pending.state_ == PendingEvent::kDone; });
+  }
+
+  void StreamerOutputModuleBase::writeCompressedEvents(std::size_t maxPending) {
+    // Writes the compressed events at the head of the queue, and then the next ones until at
+    // most maxPending are left. This does not wait for the TBB tasks, which would let this
+    // thread run unrelated framework tasks meanwhile: an event whose task has not started is
+    // compressed here, and only an event being compressed on another thread is waited for.
+    while (not pendingEvents_.empty()) {
+      auto& pending = *pendingEvents_.front();
+      if (pending.state_ != PendingEvent::kDone) {
+        if (pendingEvents_.size() <= maxPending)
+          break;
+        if (pending.claim())
+          compressPendingEvent(pending);
+        else
+          waitForPendingEvent(pending);
+      }
+      auto written = std::move(pendingEvents_.front());
+      pendingEvents_.pop_front();
+      if (written->exception_)
+        std::rethrow_exception(written->exception_);
+      doOutputEvent(*written->msg_);
+      countWrittenEvent(*written->buffer_);
+    }
+  }
+
+  void StreamerOutputModuleBase::countWrittenEvent(SerializeDataBuffer const& sbuf) {
+    lastWrite_ = std::chrono::steady_clock::now();
+    if (eventsWritten_ == 0)
+      firstWrite_ = lastWrite_;
+    ++eventsWritten_;
+    bytesCopied_ += sbuf.currentBytesCopied();
   }
 
   Trig StreamerOutputModuleBase::getTriggerResults(EDGetTokenT<TriggerResults> const& token,
@@ -61,6 +159,11 @@ namespace edm {
 
   void StreamerOutputModuleBase::fillDescription(ParameterSetDescription& desc) {
     StreamerOutputModuleCommon::fillDescription(desc);
+    desc.addUntracked<unsigned int>("concurrentCompressions", 0)
+        ->setComment(
+            "If 0, each event is serialized and compressed in the call writing it.\n"
+            "If not 0, events are compressed in TBB tasks while the module takes the next events, and are "
+            "written once compressed; this is the maximum number of events being compressed at a time.");
     OutputModule::fillDescription(desc);
   }
 }  // namespace edm
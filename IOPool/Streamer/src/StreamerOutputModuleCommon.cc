@@ -196,18 +196,17 @@ namespace edm {
       EventForOutput const& e,
       Handle<TriggerResults> const& triggerResults,
       ParameterSetID const& selectorCfg) {
-    constexpr unsigned int reserve_size = SerializeDataBuffer::reserve_size;
-    //Lets Build the Event Message first
-
-    //Following is strictly DUMMY Data for L! Trig and will be replaced with actual
-    // once figured out, there is no logic involved here.
-    std::vector<bool> l1bit = {true, true, false};
-    //End of dummy data
+    serializeEventData(sbuf, e, triggerResults, selectorCfg);
+    return compressAndFrameEvent(sbuf);
+  }
 
-    std::vector<unsigned char> hltbits;
-    setHltMask(e, triggerResults, hltbits);
+  void StreamerOutputModuleCommon::serializeEventData(SerializeDataBuffer& sbuf,
+                                                      EventForOutput const& e,
+                                                      Handle<TriggerResults> const& triggerResults,
+                                                      ParameterSetID const& selectorCfg) const {
+    setHltMask(e, triggerResults, sbuf.hltbits_);
 
-    uint32 lumi;
+    uint32 lumi = 0;
     if (lumiSectionInterval_ == 0) {
       lumi = e.luminosityBlock();
     } else {
@@ -220,8 +219,23 @@ namespace edm {
       if (lumiSectionInterval_ > 0)
         lumi = static_cast<uint32>(timeInSec / lumiSectionInterval_) + 1;
     }
+    sbuf.run_ = e.id().run();
+    sbuf.event_ = e.id().event();
+    sbuf.lumi_ = lumi;
+
+    serializer_.serializeEventData(sbuf, e, selectorCfg);
+  }
 
-    serializer_.serializeEvent(sbuf, e, selectorCfg, compressionAlgo_, compressionLevel_, reserve_size);
+  std::unique_ptr<EventMsgBuilder> StreamerOutputModuleCommon::compressAndFrameEvent(SerializeDataBuffer& sbuf) const {
+    constexpr unsigned int reserve_size = SerializeDataBuffer::reserve_size;
+    //Lets Build the Event Message first
+
+    //Following is strictly DUMMY Data for L! Trig and will be replaced with actual
+    // once figured out, there is no logic involved here.
+    std::vector<bool> l1bit = {true, true, false};
+    //End of dummy data
+
+    StreamSerializer::compressEvent(sbuf, compressionAlgo_, compressionLevel_, reserve_size);
 
     // resize header_buf_ to reserved size on first written event
     if (sbuf.header_buf_.size() < reserve_size)
@@ -229,27 +243,30 @@ namespace edm {
 
     auto msg = std::make_unique<EventMsgBuilder>(&sbuf.header_buf_[0],
                                                  sbuf.comp_buf_.size(),
-                                                 e.id().run(),
-                                                 e.id().event(),
-                                                 lumi,
+                                                 sbuf.run_,
+                                                 sbuf.event_,
+                                                 sbuf.lumi_,
                                                  outputModuleId_,
                                                  0,
                                                  l1bit,
-                                                 (uint8*)&hltbits[0],
+                                                 sbuf.hltbits_.data(),
                                                  hltsize_,
                                                  (uint32)sbuf.adler32_chksum(),
                                                  host_name_);
 
-    // 50000 bytes is reserved for header as has been the case with previous version which did one extra copy of event data
+    // 50000 bytes is reserved for header in front of both the compressed and the uncompressed
+    // event data, so that only the header is copied to frame the message
     uint32 headerSize = msg->headerSize();
     if (headerSize > reserve_size)
       throw cms::Exception("StreamerOutputModuleCommon", "Header Overflow")
           << " header of size " << headerSize << "bytes is too big to fit into the reserved buffer space";
 
     //set addresses to other buffer and copy constructed header there
-    msg->setBufAddr(&sbuf.comp_buf_[reserve_size - headerSize]);
-    msg->setEventAddr(sbuf.bufferPointer());
-    std::copy(&sbuf.header_buf_[0], &sbuf.header_buf_[headerSize], (char*)(&sbuf.comp_buf_[reserve_size - headerSize]));
+    unsigned char* eventData = sbuf.bufferPointer();
+    msg->setBufAddr(eventData - headerSize);
+    msg->setEventAddr(eventData);
+    std::copy(&sbuf.header_buf_[0], &sbuf.header_buf_[headerSize], (char*)(eventData - headerSize));
+    sbuf.curr_bytes_copied_ = headerSize;
 
     unsigned int src_size = sbuf.currentSpaceUsed();
     msg->setEventLength(src_size);  //compressed size
@@ -283,4 +300,8 @@ namespace edm {
     }
     return ptr;
   }
+
+  std::shared_ptr<SerializeDataBuffer> StreamerOutputModuleCommon::getPooledSerializerBuffer() {
+    return serializerBufferPool_.makeOrGet([]() { return new SerializeDataBuffer; });
+  }
 }  // namespace edm
@@ -9,6 +9,12 @@ options.register ('compAlgo',
                   VarParsing.VarParsing.varType.string,
                   "Compression Algorithm")
 
+options.register ('concurrentCompressions',
+                  0, # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.int,
+                  "Maximum number of events compressed concurrently, 0 to compress in write()")
+
 options.parseArguments()
 
 
@@ -16,6 +22,9 @@ process = cms.Process("HLT")
 
 import FWCore.Framework.test.cmsExceptionsFatal_cff
 process.options = FWCore.Framework.test.cmsExceptionsFatal_cff.options
+if options.concurrentCompressions > 0:
+    process.options.numberOfThreads = cms.untracked.uint32(4)
+    process.options.numberOfStreams = cms.untracked.uint32(0)
 
 process.load("FWCore.MessageLogger.MessageLogger_cfi")
 
@@ -43,6 +52,7 @@ process.out = cms.OutputModule("EventStreamFileWriter",
     compression_level = cms.untracked.int32(1),
     use_compression = cms.untracked.bool(True),
     compression_algorithm = cms.untracked.string(options.compAlgo),
+    concurrentCompressions = cms.untracked.uint32(options.concurrentCompressions),
     max_event_size = cms.untracked.int32(7000000)
 )
 
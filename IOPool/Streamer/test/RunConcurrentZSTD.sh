@@ -0,0 +1,5 @@
+#!/bin/bash
+SCRIPTDIR="$( cd "$( dirname "${BASH_SOURCE[0]}" )" && pwd )"
+export TEST_COMPRESSION_ALGO="ZSTD"
+export TEST_CONCURRENT_COMPRESSIONS=4
+exec ${SCRIPTDIR}/RunSimple_NewStreamer.sh
@@ -17,6 +17,11 @@ TEST_COMPRESSION_ALGO="ZLIB"
 fi
 echo "TEST_COMPRESSION_ALGO = $TEST_COMPRESSION_ALGO"
 
+if [ -z  $TEST_CONCURRENT_COMPRESSIONS ]; then
+TEST_CONCURRENT_COMPRESSIONS=0
+fi
+echo "TEST_CONCURRENT_COMPRESSIONS = $TEST_CONCURRENT_COMPRESSIONS"
+
 cd $LOCAL_TEST_DIR
 
 RC=0
@@ -28,7 +33,7 @@ mkdir ${OUTDIR}
 cp *_cfg.py ${OUTDIR}
 cd ${OUTDIR}
 
-cmsRun NewStreamOut_cfg.py compAlgo=${TEST_COMPRESSION_ALGO} > out 2>&1 || die "cmsRun NewStreamOut_cfg.py compAlgo=${TEST_COMPRESSION_ALGO}" $?
+cmsRun NewStreamOut_cfg.py compAlgo=${TEST_COMPRESSION_ALGO} concurrentCompressions=${TEST_CONCURRENT_COMPRESSIONS} > out 2>&1 || die "cmsRun NewStreamOut_cfg.py compAlgo=${TEST_COMPRESSION_ALGO} concurrentCompressions=${TEST_CONCURRENT_COMPRESSIONS}" $?
 cmsRun --parameter-set NewStreamIn_cfg.py  > in  2>&1 || die "cmsRun NewStreamIn_cfg.py" $?
 cmsRun --parameter-set NewStreamIn2_cfg.py  > in2  2>&1 || die "cmsRun NewStreamIn2_cfg.py" $?
 cmsRun --parameter-set NewStreamCopy_cfg.py  > copy  2>&1 || die "cmsRun NewStreamCopy_cfg.py" $?
@@ -0,0 +1,73 @@
+# Throughput benchmark for the streamer output module, compressing the events
+# either in write() or concurrently in TBB tasks.
+#
+# Usage: cmsRun StreamerOutputBenchmark_cfg.py concurrentCompressions=<0|N> [compAlgo=ZSTD] [nThreads=8] [maxEvents=5000]
+#
+# Compare the 'Timing' summary (event throughput) between the modes; the output
+# module also reports its own events/s and the bytes copied per event after
+# serialization (only the message header unless the events are copied).
+
+import FWCore.ParameterSet.Config as cms
+import FWCore.ParameterSet.VarParsing as VarParsing
+
+options = VarParsing.VarParsing('analysis')
+
+options.register ('compAlgo',
+                  'ZSTD', # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.string,
+                  "Compression Algorithm")
+
+options.register ('concurrentCompressions',
+                  0, # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.int,
+                  "Maximum number of events compressed concurrently, 0 to compress in write()")
+
+options.register ('nThreads',
+                  8, # default value
+                  VarParsing.VarParsing.multiplicity.singleton,
+                  VarParsing.VarParsing.varType.int,
+                  "Number of threads and streams")
+
+options.setDefault('maxEvents', 5000)
+options.parseArguments()
+
+process = cms.Process("HLT")
+
+process.load("FWCore.MessageLogger.MessageLogger_cfi")
+process.MessageLogger.categories.append('StreamerOutputModule')
+process.MessageLogger.cerr.StreamerOutputModule = cms.untracked.PSet(limit = cms.untracked.int32(-1))
+
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(options.maxEvents)
+)
+
+process.options = cms.untracked.PSet(
+    numberOfThreads = cms.untracked.uint32(options.nThreads),
+    numberOfStreams = cms.untracked.uint32(0),
+    wantSummary = cms.untracked.bool(True)
+)
+
+process.Timing = cms.Service("Timing",
+    summaryOnly = cms.untracked.bool(True)
+)
+
+process.source = cms.Source("EmptySource")
+
+# about 1 MB of serialized products per event, as for the larger HLT output streams
+process.m1 = cms.EDProducer("StreamThingProducer",
+    instance_count = cms.int32(10),
+    array_size = cms.int32(25000)
+)
+
+process.out = cms.OutputModule("EventStreamFileWriter",
+    fileName = cms.untracked.string('StreamerOutputBenchmark.dat'),
+    compression_level = cms.untracked.int32(3),
+    use_compression = cms.untracked.bool(True),
+    compression_algorithm = cms.untracked.string(options.compAlgo),
+    concurrentCompressions = cms.untracked.uint32(options.concurrentCompressions)
+)
+
+process.t = cms.Task(process.m1)
+process.end = cms.EndPath(process.out, process.t)
@@ -3,13 +3,16 @@
 
 #include <vector>
 #include <memory>
+#include <mutex>
 
 #include "TFile.h"
 
 #include "Utilities/StorageFactory/interface/IOPosBuffer.h"
+#include "Utilities/StorageFactory/interface/StorageAccount.h"
 #include "FWCore/Utilities/interface/get_underlying_safe.h"
 
 class Storage;
+class ReadAhead;
 
 /** TFile wrapper around #StorageFactory and #Storage.  */
 class TStorageFactoryFile : public TFile {
@@ -55,9 +58,17 @@ private:
 
   void releaseStorage() { get_underlying_safe(storage_).release(); }
 
+  // Gap between two reads worth reading over to merge them.
+  IOSize coalesceSize() const;
+
+  // Serialises the storage calls with the background read-ahead, if any.
+  std::unique_lock<std::mutex> lockStorage();
+
   TStorageFactoryFile(void);
 
-  edm::propagate_const<std::unique_ptr<Storage>> storage_;  //< Real underlying storage
+  edm::propagate_const<std::unique_ptr<Storage>> storage_;      //< Real underlying storage
+  edm::propagate_const<std::unique_ptr<ReadAhead>> readAhead_;  //! Background reads of the announced baskets
+  StorageAccount::Counter readStats_;                           //! Actual reads of this file
 };
 
 #endif  // TFILE_ADAPTOR_TSTORAGE_FACTORY_FILE_H
@@ -0,0 +1,188 @@
+#include <algorithm>
+#include <cstring>
+
+#include "ReadAhead.h"
+#include "ReadRepacker.h"
+#include "Utilities/StorageFactory/interface/Storage.h"
+
+ReadAhead::ReadAhead(Storage &storage, StorageAccount::Counter &actual, StorageAccount::Counter &measured)
+    : m_storage(storage),
+      m_actual(actual),
+      m_measured(measured),
+      m_ready(0),
+      m_failed(false),
+      m_stop(false),
+      m_pending(false),
+      m_busy(false),
+      m_exit(false),
+      m_coalesce_size(0) {}
+
+ReadAhead::~ReadAhead() {
+  stop();
+  if (m_thread.joinable()) {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      m_exit = true;
+    }
+    m_cond.notify_all();
+    m_thread.join();
+  }
+}
+
+void ReadAhead::start(const long long int *pos, const int *len, int nbuf, IOSize coalesce_size) {
+  stop();
+
+  m_ranges.reserve(nbuf);
+  for (int i = 0; i < nbuf; ++i) {
+    if (len[i] > 0) {
+      m_ranges.push_back(Range{pos[i], static_cast<IOSize>(len[i]), nullptr});
+    }
+  }
+  std::sort(m_ranges.begin(), m_ranges.end(), [](const Range &a, const Range &b) { return a.offset < b.offset; });
+
+  // The repacker wants disjoint ranges; an overlapping one is left to the
+  // caller to read.
+  size_t kept = 0;
+  for (const auto &range : m_ranges) {
+    if (kept == 0 || range.offset >= m_ranges[kept - 1].offset + static_cast<IOOffset>(m_ranges[kept - 1].size)) {
+      m_ranges[kept++] = range;
+    }
+  }
+  m_ranges.erase(m_ranges.begin() + kept, m_ranges.end());
+  if (m_ranges.empty()) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> guard(m_mutex);
+    m_ready = 0;
+    m_failed = false;
+    m_stop = false;
+    m_pending = true;
+    m_coalesce_size = coalesce_size;
+  }
+  if (not m_thread.joinable()) {
+    m_thread = std::thread(&ReadAhead::loop, this);
+  } else {
+    m_cond.notify_all();
+  }
+}
+
+void ReadAhead::stop() {
+  {
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_stop = true;
+    m_pending = false;
+    m_cond.notify_all();
+    m_cond.wait(lock, [this]() { return not m_busy; });
+  }
+  m_ranges.clear();
+  m_chunks.clear();
+}
+
+void ReadAhead::loop() {
+  std::unique_lock<std::mutex> lock(m_mutex);
+  while (true) {
+    m_cond.wait(lock, [this]() { return m_pending || m_exit; });
+    if (m_exit) {
+      return;
+    }
+    m_pending = false;
+    m_busy = true;
+    IOSize coalesce_size = m_coalesce_size;
+    lock.unlock();
+    run(coalesce_size);
+    lock.lock();
+    m_busy = false;
+    m_cond.notify_all();
+  }
+}
+
+void ReadAhead::run(IOSize coalesce_size) {
+  std::vector<long long int> pos;
+  std::vector<int> len;
+  pos.reserve(m_ranges.size());
+  len.reserve(m_ranges.size());
+  for (const auto &range : m_ranges) {
+    pos.push_back(range.offset);
+    len.push_back(range.size);
+  }
+
+  ReadRepacker repacker(coalesce_size);
+  int nbuf = m_ranges.size();
+  int done = 0;
+  while (done < nbuf) {
+    {
+      std::lock_guard<std::mutex> guard(m_mutex);
+      if (m_stop) {
+        return;
+      }
+    }
+
+    // The repacker may also fill its spare buffer, whose data is unpacked
+    // after the data of the chunk; leave room for it.
+    IOSize size = CHUNK_SIZE;
+    if (static_cast<IOSize>(len[done]) > size) {
+      size = len[done];
+    }
+    std::unique_ptr<char[]> chunk(new char[size + ReadRepacker::TEMPORARY_BUFFER_SIZE]);
+    int count = repacker.pack(&pos[done], &len[done], nbuf - done, chunk.get(), size);
+
+    bool ok = false;
+    try {
+      auto lock = lockStorage();
+      StorageAccount::Stamp stats(m_actual);
+      StorageAccount::Stamp mstats(m_measured);
+      std::vector<IOPosBuffer> &iov = repacker.iov();
+      IOSize expected = repacker.bufferUsed();
+      ok = (m_storage.readv(iov.data(), iov.size()) == expected);
+      if (ok) {
+        stats.tick(expected);
+        mstats.tick(expected);
+      }
+    } catch (...) {
+      // The caller reads the range again by itself, and reports the error.
+      ok = false;
+    }
+    if (ok) {
+      repacker.unpack(chunk.get());
+    }
+
+    std::lock_guard<std::mutex> guard(m_mutex);
+    if (not ok) {
+      m_failed = true;
+      m_cond.notify_all();
+      return;
+    }
+    const char *data = chunk.get();
+    for (int i = done; i < done + count; ++i) {
+      m_ranges[i].data = data;
+      data += len[i];
+    }
+    m_chunks.push_back(std::move(chunk));
+    done += count;
+    m_ready = done;
+    m_cond.notify_all();
+  }
+}
+
+bool ReadAhead::read(char *buf, IOOffset pos, IOSize len) {
+  auto it = std::upper_bound(
+      m_ranges.begin(), m_ranges.end(), pos, [](IOOffset pos, const Range &range) { return pos < range.offset; });
+  if (it == m_ranges.begin()) {
+    return false;
+  }
+  --it;
+  if (pos + static_cast<IOOffset>(len) > it->offset + static_cast<IOOffset>(it->size)) {
+    return false;
+  }
+
+  size_t index = it - m_ranges.begin();
+  std::unique_lock<std::mutex> lock(m_mutex);
+  m_cond.wait(lock, [&]() { return m_ready > index || m_failed; });
+  if (m_ready <= index) {
+    return false;
+  }
+  memcpy(buf, it->data + (pos - it->offset), len);
+  return true;
+}
@@ -0,0 +1,91 @@
+#ifndef TFILE_ADAPTOR_READ_AHEAD_H
+#define TFILE_ADAPTOR_READ_AHEAD_H
+
+/**
+ * Read ahead the baskets that the TTreeCache is about to use, for a storage
+ * that cannot prefetch by itself.
+ *
+ * In asynchronous mode, the TTreeCache announces all the baskets of the
+ * cluster it is entering with a vector read without a buffer, and then asks
+ * for the baskets one at a time as the events are processed.  Here the
+ * announced reads are sorted, coalesced by a ReadRepacker and read by a
+ * background thread in chunks of about CHUNK_SIZE bytes, in file order; a
+ * basket is served as soon as the chunk holding it is in memory, so that
+ * the later chunks are still in flight while the first baskets are being
+ * used.
+ *
+ * The background thread is started with the first cluster and then waits
+ * for the next one, until the ReadAhead is destroyed.
+ *
+ * The storage is not required to support concurrent calls: the background
+ * thread holds the storage lock while it reads a chunk, and the file takes
+ * the same lock around all its other storage calls.
+ */
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "Utilities/StorageFactory/interface/IOTypes.h"
+#include "Utilities/StorageFactory/interface/StorageAccount.h"
+
+class Storage;
+
+class ReadAhead {
+public:
+  // Bytes read by the background thread in one storage request.
+  static const IOSize CHUNK_SIZE = 4 * 1024 * 1024;
+
+  ReadAhead(Storage &storage, StorageAccount::Counter &actual, StorageAccount::Counter &measured);
+  ~ReadAhead();
+
+  ReadAhead(const ReadAhead &) = delete;
+  ReadAhead &operator=(const ReadAhead &) = delete;
+
+  // Starts reading the nbuf given ranges in the background, dropping the
+  // ranges read ahead before.
+  void start(const long long int *pos, const int *len, int nbuf, IOSize coalesce_size);
+
+  // Drops the ranges read ahead, waiting for the background thread to
+  // stop reading them.
+  void stop();
+
+  // Copies [pos, pos + len) into buf if it is part of a range read ahead,
+  // waiting for it if needed.  Returns false if the range is not read
+  // ahead, or if reading it failed; the caller then reads it by itself.
+  bool read(char *buf, IOOffset pos, IOSize len);
+
+  std::unique_lock<std::mutex> lockStorage() { return std::unique_lock<std::mutex>(m_storage_mutex); }
+
+private:
+  struct Range {
+    IOOffset offset;
+    IOSize size;
+    const char *data;  // Set when the range is in memory.
+  };
+
+  void loop();
+  void run(IOSize coalesce_size);
+
+  Storage &m_storage;
+  StorageAccount::Counter &m_actual;    // Accounting of all the actual reads of the file.
+  StorageAccount::Counter &m_measured;  // Reads used to choose the coalesce size.
+  std::mutex m_storage_mutex;
+
+  std::vector<Range> m_ranges;                    // Sorted by offset.
+  std::vector<std::unique_ptr<char[]>> m_chunks;  // Memory of the ranges read so far.
+  std::mutex m_mutex;                             // Protects the state below.
+  std::condition_variable m_cond;
+  size_t m_ready;          // Ranges [0, m_ready) are in memory.
+  bool m_failed;           // Reading stopped on an error.
+  bool m_stop;             // The reads are no longer needed.
+  bool m_pending;          // The ranges are set, but the thread has not started reading them.
+  bool m_busy;             // The thread is reading the ranges.
+  bool m_exit;             // The thread should return.
+  IOSize m_coalesce_size;  // For the pending ranges.
+  std::thread m_thread;
+};
+
+#endif  // TFILE_ADAPTOR_READ_AHEAD_H
@@ -1,12 +1,34 @@
 
+#include <algorithm>
 #include <cassert>
 #include <cstring>
 
 #include "ReadRepacker.h"
 
+ReadRepacker::ReadRepacker(IOSize coalesce_size)
+    : m_len(nullptr), m_coalesce_size(coalesce_size), m_buffer_used(0), m_extra_bytes(0) {}
+
+/**
+ * Estimate the latency as the time of the fastest read, and the bandwidth as
+ * the average over all the reads; their product is the number of bytes that
+ * could have been transferred while waiting for a separate request.
+ */
+IOSize ReadRepacker::coalesceSizeFor(const StorageAccount::Counter &reads) {
+  uint64_t measured = reads.successes;
+  double time = reads.timeTotal;  // ns
+  if (measured < MIN_MEASURED_READS || time <= 0.) {
+    return READ_COALESCE_SIZE;
+  }
+
+  double latency = reads.timeMin;          // ns
+  double bandwidth = reads.amount / time;  // bytes per ns
+  double size = latency * bandwidth;
+  return static_cast<IOSize>(std::clamp<double>(size, MIN_COALESCE_SIZE, MAX_COALESCE_SIZE));
+}
+
 /**
    Given a list of offsets and positions, pack them into a vector of IOPosBuffer (an "IO Vector").
-   This function will coalesce reads that are within READ_COALESCE_SIZE into a IOPosBuffer.
+   This function will coalesce reads that are within the coalesce size into a IOPosBuffer.
    This function will not create an IO vector whose summed buffer size is larger than TEMPORARY_BUFFER_SIZE. 
    The IOPosBuffer in iov all point to a location inside buf.
     
@@ -82,7 +104,7 @@ int ReadRepacker::packInternal(long long int *pos, int *len, int nbuf, char *buf
     IOSize extra_bytes = static_cast<IOSize>(extra_bytes_signed);
 
     if (((static_cast<IOSize>(len[idx]) < BIG_READ_SIZE) || (iopb.size() < BIG_READ_SIZE)) &&
-        (extra_bytes < READ_COALESCE_SIZE) && (buffer_used + len[idx] + extra_bytes <= buffer_size)) {
+        (extra_bytes < m_coalesce_size) && (buffer_used + len[idx] + extra_bytes <= buffer_size)) {
       // The space between the two reads is small enough we can coalesce.
 
       // We enforce that the current read or the current iopb must be small.
@@ -28,10 +28,14 @@
 #include <vector>
 
 #include "Utilities/StorageFactory/interface/IOPosBuffer.h"
+#include "Utilities/StorageFactory/interface/StorageAccount.h"
 #include "FWCore/Utilities/interface/propagate_const.h"
 
 class ReadRepacker {
 public:
+  // Reads separated by less than coalesce_size bytes are merged.
+  explicit ReadRepacker(IOSize coalesce_size = READ_COALESCE_SIZE);
+
   // Returns the number of input buffers it was able to pack into the IO operation.
   int pack(long long int *pos,   // An array of file offsets to read.
            int *len,             // An array of lengths to read.
@@ -63,6 +67,19 @@ public:
   // The size of the temporary holding buffer for read-coalescing.
   static const IOSize BIG_READ_SIZE = 256 * 1024;
 
+  // Bounds of the coalesce size chosen from the measured reads.
+  static const IOSize MIN_COALESCE_SIZE = 4 * 1024;
+  static const IOSize MAX_COALESCE_SIZE = TEMPORARY_BUFFER_SIZE / 2;
+
+  // Number of reads to measure before trusting the measurement.
+  static const uint64_t MIN_MEASURED_READS = 16;
+
+  // Returns the gap worth reading over, for the storage whose actual reads
+  // are accounted in 'reads': reading the gap costs gap/bandwidth, while a
+  // separate request costs at least the latency of the fastest read.  Before
+  // enough reads are measured, this is READ_COALESCE_SIZE.
+  static IOSize coalesceSizeFor(const StorageAccount::Counter &reads);
+
 private:
   int packInternal(long long int *pos,
                    int *len,
@@ -78,6 +95,7 @@ private:
       m_idx_to_iopb_offset;        // Mapping from idx in the input array to the data offset in the results of the iopb.
   std::vector<IOPosBuffer> m_iov;  // Vector of IO for the storage system to perform.
   edm::propagate_const<int *> m_len;  // Pointed to the array of read sizes.
+  IOSize m_coalesce_size;             // Largest gap between two reads that are merged.
   IOSize m_buffer_used;               // Bytes in the temporary buffer used.
   IOSize m_extra_bytes;               // Number of bytes read from storage that will be discarded.
   std::vector<char> m_spare_buffer;  // The spare buffer; allocated if we cannot fit the I/O results into the ROOT buffer.
@@ -72,6 +72,8 @@ TFileAdaptor::TFileAdaptor(edm::ParameterSet const& pset, edm::ActivityRegistry&
       enablePrefetching_(false),
       cacheHint_("auto-detect"),
       readHint_("auto-detect"),
+      readCoalesceSize_(0U),
+      readAhead_(false),
       tempDir_(),
       minFree_(0),
       timeout_(0U),
@@ -89,6 +91,8 @@ TFileAdaptor::TFileAdaptor(edm::ParameterSet const& pset, edm::ActivityRegistry&
   // for WMDM tools until we switch to only using the site local config for this info.
   cacheHint_ = pset.getUntrackedParameter<std::string>("cacheHint", cacheHint_);
   readHint_ = pset.getUntrackedParameter<std::string>("readHint", readHint_);
+  readCoalesceSize_ = pset.getUntrackedParameter<unsigned int>("readCoalesceSize", readCoalesceSize_);
+  readAhead_ = pset.getUntrackedParameter<bool>("readAhead", readAhead_);
   tempDir_ = pset.getUntrackedParameter<std::string>("tempDir", f->tempPath());
   minFree_ = pset.getUntrackedParameter<double>("tempMinFree", f->tempMinFree());
   native_ = pset.getUntrackedParameter<std::vector<std::string> >("native", native_);
@@ -145,11 +149,15 @@ TFileAdaptor::TFileAdaptor(edm::ParameterSet const& pset, edm::ActivityRegistry&
     f->setReadHint(StorageFactory::READ_HINT_READAHEAD);
   else if (readHint_ == "auto-detect")
     f->setReadHint(StorageFactory::READ_HINT_AUTO);
+  else if (readHint_ == "memory-mapped")
+    f->setReadHint(StorageFactory::READ_HINT_MEMORY_MAPPED);
   else
     throw cms::Exception("TFileAdaptor") << "Unrecognised 'readHint' value '" << readHint_
                                          << "', recognised values are 'direct-unbuffered',"
-                                         << " 'read-ahead-buffered', 'auto-detect'";
+                                         << " 'read-ahead-buffered', 'auto-detect', 'memory-mapped'";
 
+  f->setReadCoalesceSize(readCoalesceSize_);
+  f->setReadAhead(readAhead_);
   f->setTimeout(timeout_);
   f->setDebugLevel(debugLevel_);
 
@@ -203,6 +211,15 @@ void TFileAdaptor::fillDescriptions(edm::ConfigurationDescriptions& descriptions
   desc.addOptionalUntracked<bool>("stats");
   desc.addOptionalUntracked<std::string>("cacheHint");
   desc.addOptionalUntracked<std::string>("readHint");
+  desc.addOptionalUntracked<unsigned int>("readCoalesceSize")
+      ->setComment(
+          "Largest gap in bytes read over to merge two ROOT reads into one storage request. "
+          "By default it is chosen from the latency and bandwidth measured for each file.");
+  desc.addOptionalUntracked<bool>("readAhead")
+      ->setComment(
+          "Read the baskets that the TTreeCache announces in a background thread when the storage "
+          "cannot prefetch them itself, so that they are in memory when ROOT asks for them. "
+          "ROOT then reads the files asynchronously, so the PoolSource does not use its trigger cache.");
   desc.addOptionalUntracked<std::string>("tempDir");
   desc.addOptionalUntracked<double>("tempMinFree");
   desc.addOptionalUntracked<std::vector<std::string> >("native");
@@ -229,6 +246,8 @@ void TFileAdaptor::stats(std::ostream& o) const {
     << " Prefetching:" << (enablePrefetching_ ? "true" : "false") << '\n'
     << " Cache hint:" << cacheHint_ << '\n'
     << " Read hint:" << readHint_ << '\n'
+    << " Read coalesce size:" << readCoalesceSize_ << '\n'
+    << " Read ahead:" << (readAhead_ ? "true" : "false") << '\n'
     << "Storage statistics: " << StorageAccount::summaryText() << "; tfile/read=?/?/"
     << (TFile::GetFileBytesRead() / oneMeg) << "MB/?ms/?ms/?ms"
     << "; tfile/write=?/?/" << (TFile::GetFileBytesWritten() / oneMeg) << "MB/?ms/?ms/?ms";
@@ -244,6 +263,8 @@ void TFileAdaptor::statsXML(std::map<std::string, std::string>& data) const {
   data.insert(std::make_pair("Parameter-untracked-bool-prefetching", (enablePrefetching_ ? "true" : "false")));
   data.insert(std::make_pair("Parameter-untracked-string-cacheHint", cacheHint_));
   data.insert(std::make_pair("Parameter-untracked-string-readHint", readHint_));
+  data.insert(std::make_pair("Parameter-untracked-uint32-readCoalesceSize", std::to_string(readCoalesceSize_)));
+  data.insert(std::make_pair("Parameter-untracked-bool-readAhead", (readAhead_ ? "true" : "false")));
   StorageAccount::fillSummary(data);
   std::ostringstream r;
   std::ostringstream w;
@@ -42,6 +42,8 @@ private:
   bool enablePrefetching_;
   std::string cacheHint_;
   std::string readHint_;
+  unsigned int readCoalesceSize_;
+  bool readAhead_;
   std::string tempDir_;
   double minFree_;
   unsigned int timeout_;
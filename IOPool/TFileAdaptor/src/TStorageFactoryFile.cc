@@ -6,6 +6,7 @@
 #include "FWCore/ServiceRegistry/interface/Service.h"
 #include "FWCore/Utilities/interface/EDMException.h"
 #include "FWCore/Utilities/interface/ExceptionPropagate.h"
+#include "ReadAhead.h"
 #include "ReadRepacker.h"
 #include "TFileCacheRead.h"
 #include "TSystem.h"
@@ -214,6 +215,16 @@ void TStorageFactoryFile::Initialize(const char *path, Option_t *option /* = ""
 
 TStorageFactoryFile::~TStorageFactoryFile(void) { Close(); }
 
+IOSize TStorageFactoryFile::coalesceSize() const {
+  if (IOSize size = StorageFactory::get()->readCoalesceSize())
+    return size;
+  return ReadRepacker::coalesceSizeFor(readStats_);
+}
+
+std::unique_lock<std::mutex> TStorageFactoryFile::lockStorage() {
+  return readAhead_ ? readAhead_->lockStorage() : std::unique_lock<std::mutex>();
+}
+
 //////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////////////////////////////////
@@ -284,10 +295,25 @@ Bool_t TStorageFactoryFile::ReadBuffer(char *buf, Int_t len) {
   // FIXME: Re-enable read-ahead if the data wasn't in cache.
   // if (! st) storage_->caching(true, -1, s_readahead);
 
+  // A basket announced by the TTreeCache may already be read ahead.
+  if (readAhead_) {
+    Long64_t here = GetRelOffset();
+    StorageAccount::Stamp cstats(storageCounter(s_statsCRead, StorageAccount::Operation::readViaCache));
+    if (readAhead_->read(buf, here, len)) {
+      Seek(here + len);
+      cstats.tick(len);
+      stats.tick(len);
+      return kFALSE;
+    }
+  }
+
   // A real read
+  auto lock = lockStorage();
   StorageAccount::Stamp xstats(storageCounter(s_statsXRead, StorageAccount::Operation::readActual));
+  StorageAccount::Stamp mstats(readStats_);
   IOSize n = storage_->xread(buf, len);
   xstats.tick(n);
+  mstats.tick(n);
   stats.tick(n);
   if (n < static_cast<IOSize>(len)) {
     Error("ReadBuffer",
@@ -334,12 +360,20 @@ Bool_t TStorageFactoryFile::ReadBufferAsync(Long64_t off, Int_t len) {
     ;
   }
 
+  auto lock = lockStorage();
   IOPosBuffer iov(off, (void *)nullptr, len ? len : PREFETCH_PROBE_LENGTH);
   if (storage_->prefetch(&iov, 1)) {
     stats.tick(len);
     return kFALSE;
   }
 
+  // Otherwise ReadBuffers() reads the announced baskets ahead by itself.
+  // Answering the probe this way makes ROOT read the file asynchronously
+  // (TFileCacheRead::IsAsyncReading()), which also turns off the trigger
+  // cache of the PoolSource (RootTree::setCacheSize()).
+  if (f->readAhead())
+    return kFALSE;
+
   // Always ask ROOT to use async reads in storage-only mode,
   // regardless of whether the storage system supports it.
   if (f->cacheHint() == StorageFactory::CACHE_HINT_STORAGE)
@@ -368,8 +402,47 @@ Bool_t TStorageFactoryFile::ReadBuffersSync(char *buf, Long64_t *pos, Int_t *len
    *  the number of bytes transferred over the network increases modestly
    *  (around 10%), and the single application request becomes one-to-two
    *  I/O transactions.  A clear win for all cases except high-latency WAN.
+   *
+   *  How far apart two reads may be and still be merged is measured: it is
+   *  the number of bytes the storage delivers in the time of one request
+   *  (see ReadRepacker::coalesceSizeFor), unless fixed in the configuration.
    */
 
+  // Take the leading requests that were read ahead from memory.
+  if (readAhead_) {
+    while (nbuf > 0 && readAhead_->read(buf, *pos, *len)) {
+      buf += *len;
+      ++pos;
+      ++len;
+      --nbuf;
+    }
+    if (nbuf == 0)
+      return kFALSE;
+  }
+
+  // A memory mapped file copies each request straight out of the mapping (and
+  // tells the kernel about all of them first), so repacking would only add the
+  // copy of the gaps between the requests and of the repacked buffer.
+  if (storage_->memoryMapped()) {
+    std::vector<IOPosBuffer> iov;
+    iov.reserve(nbuf);
+    IOSize total = 0;
+    for (Int_t i = 0; i < nbuf; ++i) {
+      iov.emplace_back(pos[i], buf + total, len[i]);
+      total += len[i];
+    }
+
+    auto lock = lockStorage();
+    StorageAccount::Stamp xstats(storageCounter(s_statsXRead, StorageAccount::Operation::readActual));
+    IOSize result = storage_->readv(iov.data(), iov.size());
+    if (result != total) {
+      Error("ReadBuffersSync", "Storage::readv returned different size result=%ld expected=%ld", result, total);
+      return kTRUE;
+    }
+    xstats.tick(total);
+    return kFALSE;
+  }
+
   Int_t remaining = nbuf;  // Number of read requests left to process.
   Int_t pack_count;        // Number of read requests processed by this iteration.
 
@@ -383,7 +456,7 @@ Bool_t TStorageFactoryFile::ReadBuffersSync(char *buf, Long64_t *pos, Int_t *len
   Long64_t *current_pos = pos;
   Int_t *current_len = len;
 
-  ReadRepacker repacker;
+  ReadRepacker repacker(coalesceSize());
 
   while (remaining > 0) {
     pack_count = repacker.pack(
@@ -393,7 +466,9 @@ Bool_t TStorageFactoryFile::ReadBuffersSync(char *buf, Long64_t *pos, Int_t *len
     IOSize io_buffer_used = repacker.bufferUsed();
 
     // Issue readv, then unpack buffers.
+    auto lock = lockStorage();
     StorageAccount::Stamp xstats(storageCounter(s_statsXRead, StorageAccount::Operation::readActual));
+    StorageAccount::Stamp mstats(readStats_);
     std::vector<IOPosBuffer> &iov = repacker.iov();
     IOSize result = storage_->readv(&iov[0], iov.size());
     if (result != io_buffer_used) {
@@ -402,6 +477,7 @@ Bool_t TStorageFactoryFile::ReadBuffersSync(char *buf, Long64_t *pos, Int_t *len
       return kTRUE;
     }
     xstats.tick(io_buffer_used);
+    mstats.tick(io_buffer_used);
     repacker.unpack(current_buffer);
 
     // Update the location of the unused part of the input buffer.
@@ -451,9 +527,23 @@ Bool_t TStorageFactoryFile::ReadBuffers(char *buf, Long64_t *pos, Int_t *len, In
   StorageAccount::Stamp astats(storageCounter(s_statsARead, StorageAccount::Operation::readAsync));
   // Synchronise low-level cache with the supposed cache in TFile.
   // storage_->caching(true, -1, 0);
-  success = storage_->prefetch(iov.data(), nbuf);
+  {
+    auto lock = lockStorage();
+    success = storage_->prefetch(iov.data(), nbuf);
+  }
   astats.tick(total);
 
+  // If the storage cannot prefetch, read the requests ahead in our own
+  // background thread; this replaces the requests of the previous cluster.
+  if (not success && StorageFactory::get()->readAhead()) {
+    if (!readAhead_) {
+      readAhead_ = std::make_unique<ReadAhead>(
+          *storage_, storageCounter(s_statsXRead, StorageAccount::Operation::readActual), readStats_);
+    }
+    readAhead_->start(static_cast<long long int *>(pos), len, nbuf, coalesceSize());
+    return kFALSE;
+  }
+
   // If it didn't suceeed, pass down to the base class.
   if (not success) {
     if (TFile::ReadBuffers(buf, pos, len, nbuf)) {
@@ -490,6 +580,7 @@ Bool_t TStorageFactoryFile::WriteBuffer(const char *buf, Int_t len) {
     case 0:
       // Actual write.
       {
+        auto lock = lockStorage();
         StorageAccount::Stamp xstats(storageCounter(s_statsXWrite, StorageAccount::Operation::writeActual));
         IOSize n = storage_->xwrite(buf, len);
         xstats.tick(n);
@@ -524,6 +615,7 @@ Bool_t TStorageFactoryFile::WriteBuffer(const char *buf, Int_t len) {
 Int_t TStorageFactoryFile::SysOpen(const char *pathname, Int_t flags, UInt_t /* mode */) {
   StorageAccount::Stamp stats(storageCounter(s_statsOpen, StorageAccount::Operation::open));
 
+  get_underlying_safe(readAhead_).reset();
   if (storage_) {
     storage_->close();
   }
@@ -557,6 +649,7 @@ Int_t TStorageFactoryFile::SysOpen(const char *pathname, Int_t flags, UInt_t /*
 Int_t TStorageFactoryFile::SysClose(Int_t /* fd */) {
   StorageAccount::Stamp stats(storageCounter(s_statsClose, StorageAccount::Operation::close));
 
+  get_underlying_safe(readAhead_).reset();
   if (storage_) {
     storage_->close();
     releaseStorage();
@@ -570,6 +663,7 @@ Long64_t TStorageFactoryFile::SysSeek(Int_t /* fd */, Long64_t offset, Int_t whe
   StorageAccount::Stamp stats(storageCounter(s_statsSeek, StorageAccount::Operation::seek));
   Storage::Relative rel = (whence == SEEK_SET ? Storage::SET : whence == SEEK_CUR ? Storage::CURRENT : Storage::END);
 
+  auto lock = lockStorage();
   offset = storage_->position(offset, rel);
   stats.tick();
   return offset;
@@ -577,6 +671,7 @@ Long64_t TStorageFactoryFile::SysSeek(Int_t /* fd */, Long64_t offset, Int_t whe
 
 Int_t TStorageFactoryFile::SysSync(Int_t /* fd */) {
   StorageAccount::Stamp stats(storageCounter(s_statsFlush, StorageAccount::Operation::flush));
+  auto lock = lockStorage();
   storage_->flush();
   stats.tick();
   return 0;
@@ -586,6 +681,7 @@ Int_t TStorageFactoryFile::SysStat(Int_t /* fd */, Long_t *id, Long64_t *size, L
   StorageAccount::Stamp stats(storageCounter(s_statsStat, StorageAccount::Operation::stat));
   // FIXME: Most of this is unsupported or makes no sense with Storage
   *id = ::Hash(fRealName);
+  auto lock = lockStorage();
   *size = storage_->size();
   *flags = 0;
   *modtime = 0;
@@ -0,0 +1,95 @@
+#include "IOPool/TFileAdaptor/src/ReadAhead.h"
+#include "IOPool/TFileAdaptor/src/ReadRepacker.h"
+#include "Utilities/StorageFactory/interface/File.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+// Reads scattered baskets of a scratch file through the read-ahead and
+// directly, and checks that both give the same bytes; then checks that the
+// coalesce size follows the measured latency and bandwidth.
+namespace {
+  bool check(bool condition, const char *what) {
+    if (not condition)
+      std::cerr << "Failed: " << what << std::endl;
+    return condition;
+  }
+}  // namespace
+
+int main() try {
+  bool ok = true;
+
+  std::string path = "readAheadTest.dat";
+  IOSize const size = 3 * ReadAhead::CHUNK_SIZE + 12345;
+  {
+    std::vector<char> content(size);
+    for (IOSize i = 0; i < size; ++i)
+      content[i] = static_cast<char>((i * 131) ^ (i >> 12));
+    File out(path, IOFlags::OpenWrite | IOFlags::OpenCreate | IOFlags::OpenTruncate);
+    out.write(content.data(), content.size());
+    out.close();
+  }
+
+  // baskets of growing size separated by gaps, announced out of order, and
+  // one overlapping basket that is left to the caller
+  std::vector<long long int> pos;
+  std::vector<int> len;
+  for (IOOffset offset = 0, basket = 1000; offset + basket < size; offset += basket + basket / 3, basket += 997) {
+    pos.insert(pos.begin(), offset);
+    len.insert(len.begin(), basket);
+  }
+  pos.push_back(pos.back() + 900);
+  len.push_back(200);
+
+  File file(path);
+  StorageAccount::Counter actual, measured;
+  ReadAhead readAhead(file, actual, measured);
+  readAhead.start(pos.data(), len.data(), pos.size(), ReadRepacker::READ_COALESCE_SIZE);
+
+  int served = 0;
+  for (size_t i = 0; i < pos.size(); ++i) {
+    std::vector<char> ahead(len[i]), direct(len[i]);
+    if (readAhead.read(ahead.data(), pos[i], len[i])) {
+      ++served;
+      auto lock = readAhead.lockStorage();
+      file.read(direct.data(), direct.size(), pos[i]);
+      ok &= check(ahead == direct, "a basket read ahead has the bytes of the file");
+    }
+  }
+  ok &= check(served + 1 == static_cast<int>(pos.size()), "all the disjoint baskets are read ahead");
+  ok &= check(measured.successes > 1, "the baskets are read in several chunks");
+
+  // a part of a basket, and a range that was not announced
+  char part[10];
+  ok &= check(readAhead.read(part, pos[0] + 5, sizeof(part)), "a part of a basket is read ahead");
+  ok &= check(not readAhead.read(part, size - 5, 5), "a range that was not announced is not read ahead");
+  readAhead.stop();
+  ok &= check(not readAhead.read(part, pos[0], sizeof(part)), "nothing is read ahead after stop()");
+  file.close();
+  std::remove(path.c_str());
+
+  // 0.8 ms per request at 125 bytes per us is worth reading over 100 kB
+  StorageAccount::Counter reads;
+  ok &= check(ReadRepacker::coalesceSizeFor(reads) == ReadRepacker::READ_COALESCE_SIZE,
+              "the default coalesce size is used before any measurement");
+  reads.successes = ReadRepacker::MIN_MEASURED_READS;
+  reads.timeMin = 8e5;
+  reads.timeTotal = 1e8;
+  reads.amount = 12500000;
+  ok &= check(ReadRepacker::coalesceSizeFor(reads) == 100000, "the coalesce size is latency times bandwidth");
+  reads.timeMin = 1e3;
+  ok &= check(ReadRepacker::coalesceSizeFor(reads) == ReadRepacker::MIN_COALESCE_SIZE,
+              "the coalesce size is not smaller than MIN_COALESCE_SIZE");
+  reads.timeMin = 1e8;
+  ok &= check(ReadRepacker::coalesceSizeFor(reads) == ReadRepacker::MAX_COALESCE_SIZE,
+              "the coalesce size is not larger than MAX_COALESCE_SIZE");
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+} catch (cms::Exception const &e) {
+  std::cerr << e.explainSelf() << std::endl;
+  return EXIT_FAILURE;
+}
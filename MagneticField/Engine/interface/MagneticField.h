@@ -14,6 +14,7 @@
 #include "DataFormats/GeometryVector/interface/GlobalPoint.h"
 #include "FWCore/Utilities/interface/Visibility.h"
 #include "FWCore/Utilities/interface/Likely.h"
+#include "FWCore/Utilities/interface/Span.h"
 #include "FWCore/Utilities/interface/thread_safety_macros.h"
 
 class MagneticField {
@@ -29,6 +30,10 @@ public:
   /// Field value ad specified global point, in Tesla
   virtual GlobalVector inTesla(const GlobalPoint& gp) const = 0;
 
+  /// Field values at a batch of global points, in Tesla: b[i] = inTesla(gp[i]).
+  /// b must hold at least as many vectors as there are points.
+  void inTesla(edm::Span<const GlobalPoint> gp, edm::Span<GlobalVector> b) const;
+
   /// Field value ad specified global point, in KGauss
   GlobalVector inKGauss(const GlobalPoint& gp) const { return inTesla(gp) * 10.F; }
 
@@ -53,6 +58,10 @@ public:
   }
 
 private:
+  /// Batched evaluation, for the engines with kernels faster than one point at a time.
+  /// The default implementation calls inTesla for each point.
+  virtual void batchInTesla(edm::Span<const GlobalPoint> gp, edm::Span<GlobalVector> b) const;
+
   //nominal field value
   virtual int computeNominalValue() const;
   mutable std::atomic<char> nominalValueCompiuted;
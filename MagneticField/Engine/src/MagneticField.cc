@@ -4,6 +4,7 @@
  */
 
 #include "MagneticField/Engine/interface/MagneticField.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 MagneticField::MagneticField() : nominalValueCompiuted(kUnset), theNominalValue(0) {}
 
@@ -16,6 +17,18 @@ MagneticField::MagneticField(const MagneticField& orig) : nominalValueCompiuted(
 
 MagneticField::~MagneticField() {}
 
+void MagneticField::inTesla(edm::Span<const GlobalPoint> gp, edm::Span<GlobalVector> b) const {
+  if (b.size() < gp.size())
+    throw cms::Exception("MagneticField") << "inTesla: " << gp.size() << " points but room for " << b.size()
+                                          << " field values";
+  batchInTesla(gp, b.subspan(0, gp.size()));
+}
+
+void MagneticField::batchInTesla(edm::Span<const GlobalPoint> gp, edm::Span<GlobalVector> b) const {
+  for (size_t i = 0; i < gp.size(); ++i)
+    b[i] = inTesla(gp[i]);
+}
+
 int MagneticField::computeNominalValue() const {
   int tmp = int((inTesla(GlobalPoint(0.f, 0.f, 0.f))).z() * 10.f + 0.5f);
 
@@ -0,0 +1,157 @@
+/** \file
+ *  Compares the time to evaluate the field one point at a time and in batches,
+ *  on the points of track propagation: helices from the beam line, sampled
+ *  in steps of fixed length, as the propagators do.
+ *  Also checks that the two ways give the same values.
+ *
+ *  numberOfTracks: number of helices
+ *  step: step length along the helices (cm)
+ *  maxR, maxZ: end of the propagation (cm)
+ *  minPt, maxPt: range of transverse momentum (GeV), log-uniform
+ *  maxEta: range of pseudorapidity, uniform
+ *  requireIdentical: throw if any value differs from the single point one, for the unit test
+ */
+
+#include "FWCore/Framework/interface/Frameworkfwd.h"
+#include "FWCore/Framework/interface/EDAnalyzer.h"
+
+#include "FWCore/Framework/interface/Event.h"
+#include "FWCore/Framework/interface/MakerMacros.h"
+
+#include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include "MagneticField/Engine/interface/MagneticField.h"
+#include "MagneticField/Records/interface/IdealMagneticFieldRecord.h"
+
+#include "FWCore/Framework/interface/ESHandle.h"
+#include "FWCore/Framework/interface/EventSetup.h"
+
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+#include <vector>
+
+using namespace edm;
+using namespace std;
+
+class batchFieldBenchmark : public edm::EDAnalyzer {
+public:
+  batchFieldBenchmark(const edm::ParameterSet& pset)
+      : numberOfTracks(pset.getUntrackedParameter<unsigned int>("numberOfTracks", 1000)),
+        step(pset.getUntrackedParameter<double>("step", 5.)),
+        maxR(pset.getUntrackedParameter<double>("maxR", 750.)),
+        maxZ(pset.getUntrackedParameter<double>("maxZ", 1100.)),
+        minPt(pset.getUntrackedParameter<double>("minPt", 0.7)),
+        maxPt(pset.getUntrackedParameter<double>("maxPt", 50.)),
+        maxEta(pset.getUntrackedParameter<double>("maxEta", 2.5)),
+        requireIdentical(pset.getUntrackedParameter<bool>("requireIdentical", false)) {}
+
+  void analyze(const edm::Event& event, const edm::EventSetup& setup) override {
+    ESHandle<MagneticField> magfield;
+    setup.get<IdealMagneticFieldRecord>().get(magfield);
+    const MagneticField* field = magfield.product();
+
+    // the points of each track, in the order of the propagation
+    vector<vector<GlobalPoint>> tracks = generateTracks(field->nominalValue() / 10.);
+    vector<GlobalPoint> points;
+    for (auto const& t : tracks)
+      points.insert(points.end(), t.begin(), t.end());
+    unsigned int outside = 0;
+    for (auto const& p : points)
+      if (!field->isDefined(p))
+        ++outside;
+    cout << tracks.size() << " tracks, " << points.size() << " points, " << outside
+         << " outside the validity region" << endl;
+
+    vector<GlobalVector> single(points.size());
+    auto start = chrono::steady_clock::now();
+    for (unsigned int i = 0; i < points.size(); ++i)
+      single[i] = field->inTesla(points[i]);
+    report("one point at a time", start, points.size());
+
+    // a batch for each track
+    vector<GlobalVector> perTrack(points.size());
+    start = chrono::steady_clock::now();
+    unsigned int first = 0;
+    for (auto const& t : tracks) {
+      field->inTesla(t, edm::Span<GlobalVector>(perTrack.data() + first, t.size()));
+      first += t.size();
+    }
+    report("a batch per track", start, points.size());
+
+    // one batch for all the tracks
+    vector<GlobalVector> all(points.size());
+    start = chrono::steady_clock::now();
+    field->inTesla(points, all);
+    report("one batch", start, points.size());
+
+    unsigned int different = compare("a batch per track", single, perTrack) + compare("one batch", single, all);
+    if (requireIdentical && different > 0)
+      throw cms::Exception("batchFieldBenchmark")
+          << different << " values of the batches differ from the ones of one point at a time";
+  }
+
+private:
+  vector<vector<GlobalPoint>> generateTracks(double bNominal) const {
+    std::mt19937 generator(12345);
+    std::uniform_real_distribution<double> flat(0., 1.);
+    vector<vector<GlobalPoint>> tracks;
+    for (unsigned int n = 0; n < numberOfTracks; ++n) {
+      double pt = minPt * pow(maxPt / minPt, flat(generator));
+      double eta = maxEta * (2. * flat(generator) - 1.);
+      double phi0 = 2. * M_PI * flat(generator);
+      double charge = flat(generator) < 0.5 ? -1. : 1.;
+      double theta = 2. * atan(exp(-eta));
+      // radius of the helix in cm, and its center
+      double radius = pt / (0.299792458 * bNominal) * 100.;
+      double cx = charge * radius * sin(phi0);
+      double cy = -charge * radius * cos(phi0);
+      vector<GlobalPoint> track;
+      // curling tracks stop after three turns
+      double maxPath = min(6. * M_PI * radius / sin(theta), 1.e4);
+      for (double s = 0.; s < maxPath; s += step) {
+        double phi = phi0 - charge * s * sin(theta) / radius;
+        GlobalPoint p(cx - charge * radius * sin(phi), cy + charge * radius * cos(phi), s * cos(theta));
+        if (p.perp() > maxR || fabs(p.z()) > maxZ)
+          break;
+        track.push_back(p);
+      }
+      tracks.push_back(track);
+    }
+    return tracks;
+  }
+
+  static void report(const char* name, chrono::steady_clock::time_point start, size_t n) {
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+    cout << name << ": " << seconds * 1.e9 / n << " ns per point" << endl;
+  }
+
+  static unsigned int compare(const char* name,
+                              vector<GlobalVector> const& reference,
+                              vector<GlobalVector> const& values) {
+    unsigned int different = 0;
+    double maxDifference = 0.;
+    for (unsigned int i = 0; i < reference.size(); ++i) {
+      if (reference[i].x() != values[i].x() || reference[i].y() != values[i].y() || reference[i].z() != values[i].z()) {
+        ++different;
+        maxDifference = max(maxDifference, double((reference[i] - values[i]).mag()));
+      }
+    }
+    cout << name << ": " << different << " values differ from one point at a time, by up to " << maxDifference
+         << " T" << endl;
+    return different;
+  }
+
+  unsigned int numberOfTracks;
+  double step;
+  double maxR;
+  double maxZ;
+  double minPt;
+  double maxPt;
+  double maxEta;
+  bool requireIdentical;
+};
+
+DEFINE_FWK_MODULE(batchFieldBenchmark);
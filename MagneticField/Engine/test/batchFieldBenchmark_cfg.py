@@ -0,0 +1,31 @@
+# Compares the time to evaluate the field one point at a time and in batches,
+# on the points of helices from the beam line.
+# The map is chosen with the standard sequence; the parametrized engines can be
+# tested by loading their cfi instead, e.g.
+# MagneticField.ParametrizedEngine.parametrizedMagneticField_OAE_3_8T_cfi,
+# with maxR and maxZ within their validity region (115 and 280 cm).
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("MAGNETICFIELDTEST")
+
+process.source = cms.Source("EmptySource",
+    firstRun = cms.untracked.uint32(300000)
+)
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(1)
+)
+
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, 'auto:run2_data', '')
+
+process.load("Configuration.StandardSequences.MagneticField_cff")
+
+process.benchmark = cms.EDAnalyzer("batchFieldBenchmark",
+    numberOfTracks = cms.untracked.uint32(1000),
+    step = cms.untracked.double(5.),
+    maxR = cms.untracked.double(750.),
+    maxZ = cms.untracked.double(1100.)
+)
+process.p = cms.Path(process.benchmark)
@@ -0,0 +1,31 @@
+# Unit test of the batched MagneticField::inTesla for the volume based map:
+# the values of the batches must be bit-identical to the ones of one point at
+# a time. The helices go beyond the map (r < 900 cm, |z| < 2400 cm), so the
+# points outside it are tested as well. The parametrized engines are tested
+# by MagneticField/ParametrizedEngine/test.
+
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("MAGNETICFIELDTEST")
+
+process.source = cms.Source("EmptySource",
+    firstRun = cms.untracked.uint32(300000)
+)
+process.maxEvents = cms.untracked.PSet(
+    input = cms.untracked.int32(1)
+)
+
+process.load("Configuration.StandardSequences.FrontierConditions_GlobalTag_cff")
+from Configuration.AlCa.GlobalTag import GlobalTag
+process.GlobalTag = GlobalTag(process.GlobalTag, 'auto:run2_data', '')
+
+process.load("Configuration.StandardSequences.MagneticField_cff")
+
+process.batchInTesla = cms.EDAnalyzer("batchFieldBenchmark",
+    numberOfTracks = cms.untracked.uint32(200),
+    step = cms.untracked.double(5.),
+    maxR = cms.untracked.double(1000.),
+    maxZ = cms.untracked.double(2600.),
+    requireIdentical = cms.untracked.bool(True)
+)
+process.p = cms.Path(process.batchInTesla)
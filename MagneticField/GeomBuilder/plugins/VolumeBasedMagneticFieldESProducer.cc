@@ -35,6 +35,8 @@ namespace magneticfield {
     const VolumeBasedMagneticFieldESProducer& operator=(const VolumeBasedMagneticFieldESProducer&) = delete;
 
     const bool debug_;
+    const bool shareGrids_;
+    const bool useVolumeIndex_;
     const bool useParametrizedTrackerField_;
     const MagFieldConfig conf_;
     const std::string version_;
@@ -48,6 +50,9 @@ using namespace magneticfield;
 
 VolumeBasedMagneticFieldESProducer::VolumeBasedMagneticFieldESProducer(const edm::ParameterSet& iConfig)
     : debug_{iConfig.getUntrackedParameter<bool>("debugBuilder", false)},
+      // the grid tables are shared with the other jobs of the node building the same map
+      shareGrids_{iConfig.getUntrackedParameter<bool>("shareGridsAcrossProcesses", false)},
+      useVolumeIndex_{iConfig.getUntrackedParameter<bool>("useVolumeIndex", false)},
       useParametrizedTrackerField_{iConfig.getParameter<bool>("useParametrizedTrackerField")},
       conf_{iConfig, debug_},
       version_{iConfig.getParameter<std::string>("version")} {
@@ -76,6 +81,7 @@ std::unique_ptr<MagneticField> VolumeBasedMagneticFieldESProducer::produce(const
   if (!conf_.gridFiles.empty()) {
     builder.setGridFiles(conf_.gridFiles);
   }
+  builder.setShareGrids(shareGrids_);
 
   builder.build(*cpv);
 
@@ -92,7 +98,8 @@ std::unique_ptr<MagneticField> VolumeBasedMagneticFieldESProducer::produce(const
                                                     builder.maxR(),
                                                     builder.maxZ(),
                                                     paramField,
-                                                    false);
+                                                    false,
+                                                    useVolumeIndex_);
 }
 
 DEFINE_FWK_EVENTSETUP_MODULE(VolumeBasedMagneticFieldESProducer);
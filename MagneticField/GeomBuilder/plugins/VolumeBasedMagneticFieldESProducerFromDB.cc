@@ -75,11 +75,15 @@ namespace magneticfield {
 
     edm::ESGetToken<FileBlob, MFGeometryFileRcd> mayConsumeBlobToken_;
     const bool debug_;
+    const bool shareGrids_;
+    const bool useVolumeIndex_;
   };
 }  // namespace magneticfield
 
 VolumeBasedMagneticFieldESProducerFromDB::VolumeBasedMagneticFieldESProducerFromDB(const edm::ParameterSet& iConfig)
-    : debug_(iConfig.getUntrackedParameter<bool>("debugBuilder")) {
+    : debug_(iConfig.getUntrackedParameter<bool>("debugBuilder")),
+      shareGrids_(iConfig.getUntrackedParameter<bool>("shareGridsAcrossProcesses")),
+      useVolumeIndex_(iConfig.getUntrackedParameter<bool>("useVolumeIndex")) {
   std::string const myConfigLabel = "VBMFESChoice";
 
   //Based on configuration, pick algorithm to produce the proper MagFieldConfig with a specific label
@@ -171,6 +175,7 @@ std::unique_ptr<MagneticField> VolumeBasedMagneticFieldESProducerFromDB::produce
   if (!conf->gridFiles.empty()) {
     builder.setGridFiles(conf->gridFiles);
   }
+  builder.setShareGrids(shareGrids_);
 
   // Build the geometry (DDDCompactView) from the DB blob
   // (code taken from GeometryReaders/XMLIdealGeometryESSource/src/XMLIdealMagneticFieldGeometryESProducer.cc)
@@ -196,7 +201,8 @@ std::unique_ptr<MagneticField> VolumeBasedMagneticFieldESProducerFromDB::produce
                                                     builder.maxR(),
                                                     builder.maxZ(),
                                                     paramField.release(),
-                                                    true);
+                                                    true,
+                                                    useVolumeIndex_);
 }
 
 std::string_view VolumeBasedMagneticFieldESProducerFromDB::closerNominalLabel(float current) {
@@ -214,6 +220,13 @@ std::string_view VolumeBasedMagneticFieldESProducerFromDB::closerNominalLabel(fl
 void VolumeBasedMagneticFieldESProducerFromDB::fillDescriptions(edm::ConfigurationDescriptions& descriptions) {
   edm::ParameterSetDescription desc;
   desc.addUntracked<bool>("debugBuilder", false);
+  desc.addUntracked<bool>("shareGridsAcrossProcesses", false)
+      ->setComment(
+          "Keep the field values of the grid tables in shared memory (/dev/shm), used by all the jobs of the node "
+          "building the same map.");
+  desc.addUntracked<bool>("useVolumeIndex", false)
+      ->setComment(
+          "Find the volumes of the points with a grid built with the field, rather than searching the layers.");
   desc.add<int>("valueOverride", -1)->setComment("Force value of current (in A); take the value from DB if < 0.");
   desc.addUntracked<std::string>("label", "");
 
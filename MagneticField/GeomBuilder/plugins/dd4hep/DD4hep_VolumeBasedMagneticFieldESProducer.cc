@@ -39,6 +39,8 @@ namespace magneticfield {
   private:
     edm::ParameterSet pset_;
     const bool debug_;
+    const bool shareGrids_;
+    const bool useVolumeIndex_;
     const bool useParametrizedTrackerField_;
     const MagFieldConfig conf_;
     const std::string version_;
@@ -52,6 +54,9 @@ using namespace magneticfield;
 DD4hep_VolumeBasedMagneticFieldESProducer::DD4hep_VolumeBasedMagneticFieldESProducer(const edm::ParameterSet& iConfig)
     : pset_{iConfig},
       debug_{iConfig.getUntrackedParameter<bool>("debugBuilder", false)},
+      // the grid tables are shared with the other jobs of the node building the same map
+      shareGrids_{iConfig.getUntrackedParameter<bool>("shareGridsAcrossProcesses", false)},
+      useVolumeIndex_{iConfig.getUntrackedParameter<bool>("useVolumeIndex", false)},
       useParametrizedTrackerField_{iConfig.getParameter<bool>("useParametrizedTrackerField")},
       conf_{iConfig, debug_},
       version_{iConfig.getParameter<std::string>("version")} {
@@ -85,6 +90,7 @@ std::unique_ptr<MagneticField> DD4hep_VolumeBasedMagneticFieldESProducer::produc
   if (!conf_.gridFiles.empty()) {
     builder.setGridFiles(conf_.gridFiles);
   }
+  builder.setShareGrids(shareGrids_);
 
   auto cpv = iRecord.getTransientHandle(cpvToken_);
   const cms::DDCompactView* cpvPtr = cpv.product();
@@ -106,7 +112,8 @@ std::unique_ptr<MagneticField> DD4hep_VolumeBasedMagneticFieldESProducer::produc
                                                     builder.maxR(),
                                                     builder.maxZ(),
                                                     paramField,
-                                                    false);
+                                                    false,
+                                                    useVolumeIndex_);
 }
 
 DEFINE_FWK_EVENTSETUP_MODULE(DD4hep_VolumeBasedMagneticFieldESProducer);
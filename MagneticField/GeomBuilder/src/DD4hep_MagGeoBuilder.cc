@@ -47,7 +47,11 @@ using namespace edm;
 using namespace angle_units::operators;
 
 MagGeoBuilder::MagGeoBuilder(string tableSet, int geometryVersion, bool debug)
-    : tableSet_(tableSet), geometryVersion_(geometryVersion), theGridFiles_(nullptr), debug_(debug) {
+    : tableSet_(tableSet),
+      geometryVersion_(geometryVersion),
+      theGridFiles_(nullptr),
+      shareGrids_(false),
+      debug_(debug) {
   LogTrace("MagGeoBuilder") << "Constructing a MagGeoBuilder";
 }
 
@@ -481,7 +485,7 @@ void MagGeoBuilder::buildInterpolator(const volumeHandle* vol, map<string, MagPr
                                        vol->placement()->rotation() * rot);
       }
 
-      interpolators[vol->magFile] = MFGridFactory::build(fullPath, rf);
+      interpolators[vol->magFile] = MFGridFactory::build(fullPath, rf, shareGrids_);
     }
   } catch (MagException& exc) {
     LogTrace("MagGeoBuilder") << exc.what();
@@ -600,3 +604,5 @@ void MagGeoBuilder::setScaling(const std::vector<int>& keys, const std::vector<d
 }
 
 void MagGeoBuilder::setGridFiles(const TableFileMap& gridFiles) { theGridFiles_ = &gridFiles; }
+
+void MagGeoBuilder::setShareGrids(bool share) { shareGrids_ = share; }
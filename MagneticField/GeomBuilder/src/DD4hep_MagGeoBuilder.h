@@ -48,6 +48,9 @@ namespace magneticfield {
 
     void setGridFiles(const TableFileMap& gridFiles);
 
+    /// Keep the field values of the grid tables in memory shared by the processes of the node
+    void setShareGrids(bool share);
+
     /// Get barrel layers
     std::vector<MagBLayer*> barrelLayers() const;
 
@@ -85,6 +88,7 @@ namespace magneticfield {
 
     std::map<int, double> theScalingFactors_;
     const TableFileMap* theGridFiles_;  // Non-owned pointer assumed to be valid until build() is called
+    bool shareGrids_;
 
     const bool debug_;
   };
@@ -55,7 +55,7 @@ using namespace std;
 using namespace magneticfield;
 
 MagGeoBuilderFromDDD::MagGeoBuilderFromDDD(string tableSet_, int geometryVersion_, bool debug_)
-    : tableSet(tableSet_), geometryVersion(geometryVersion_), theGridFiles(nullptr), debug(debug_) {
+    : tableSet(tableSet_), geometryVersion(geometryVersion_), theGridFiles(nullptr), shareGrids(false), debug(debug_) {
   if (debug)
     cout << "Constructing a MagGeoBuilderFromDDD" << endl;
 }
@@ -551,7 +551,7 @@ void MagGeoBuilderFromDDD::buildInterpolator(const volumeHandle* vol,
                                        vol->placement()->rotation() * rot);
       }
 
-      interpolators[vol->magFile] = MFGridFactory::build(fullPath, rf);
+      interpolators[vol->magFile] = MFGridFactory::build(fullPath, rf, shareGrids);
     }
   } catch (MagException& exc) {
     cout << exc.what() << endl;
@@ -668,3 +668,5 @@ void MagGeoBuilderFromDDD::setScaling(const std::vector<int>& keys, const std::v
 }
 
 void MagGeoBuilderFromDDD::setGridFiles(const TableFileMap& gridFiles) { theGridFiles = &gridFiles; }
+
+void MagGeoBuilderFromDDD::setShareGrids(bool share) { shareGrids = share; }
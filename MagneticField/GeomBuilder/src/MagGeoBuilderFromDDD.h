@@ -44,6 +44,9 @@ public:
 
   void setGridFiles(const magneticfield::TableFileMap& gridFiles);
 
+  /// Keep the field values of the grid tables in memory shared by the processes of the node
+  void setShareGrids(bool share);
+
   /// Get barrel layers
   std::vector<MagBLayer*> barrelLayers() const;
 
@@ -95,6 +98,7 @@ private:
 
   std::map<int, double> theScalingFactors;
   const magneticfield::TableFileMap* theGridFiles;  // Non-owned pointer assumed to be valid until build() is called
+  bool shareGrids;
 
   const bool debug;
 };
@@ -4,7 +4,7 @@ process = cms.Process("MagneticFieldTest")
 
 process.source = cms.Source("EmptySource")
 process.maxEvents = cms.untracked.PSet(
-    input = cms.untracked.int32(2)
+    input = cms.untracked.int32(1)
     )
 
 process.load("FWCore.MessageLogger.MessageLogger_cfi")
@@ -55,6 +55,7 @@ process.MagneticFieldESProducer = cms.ESProducer("DD4hep_VolumeBasedMagneticFiel
                                               geometryVersion = cms.int32(160812),
                                               debugBuilder = cms.untracked.bool(True),
                                               cacheLastVolume = cms.untracked.bool(True),
+                                              useVolumeIndex = cms.untracked.bool(True),
                                               scalingVolumes = cms.vint32(),
                                               scalingFactors = cms.vdouble(),
 
@@ -85,8 +86,13 @@ process.DDCompactViewMFESProducer = cms.ESProducer("DDCompactViewMFESProducer",
                                                  appendToDataLabel = cms.string('magfield')
                                                 )
 
+# fewer and coarser points than by default, to keep the unit test short
 process.test = cms.EDAnalyzer("testMagGeometryAnalyzer",
-                              DDDetector = cms.ESInputTag('', 'magfield')
+                              DDDetector = cms.ESInputTag('', 'magfield'),
+                              nRandomPoints = cms.untracked.int32(100000),
+                              indexScanStep = cms.untracked.double(20.),
+                              indexScanPhiBins = cms.untracked.int32(90),
+                              benchmarkPoints = cms.untracked.int32(100000)
                               )
 
 process.p = cms.Path(process.test)
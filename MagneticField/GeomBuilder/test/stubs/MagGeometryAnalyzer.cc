@@ -7,6 +7,7 @@
 #include "FWCore/Framework/interface/EventSetup.h"
 #include "FWCore/Framework/interface/ESHandle.h"
 #include "FWCore/ParameterSet/interface/ParameterSet.h"
+#include "FWCore/Utilities/interface/Exception.h"
 
 #include "MagneticField/VolumeBasedEngine/interface/MagGeometry.h"
 #include "MagneticField/GeomBuilder/test/stubs/MagGeometryExerciser.h"
@@ -24,7 +25,11 @@ using namespace std;
 class testMagGeometryAnalyzer : public edm::EDAnalyzer {
 public:
   /// Constructor
-  testMagGeometryAnalyzer(const edm::ParameterSet& pset){};
+  testMagGeometryAnalyzer(const edm::ParameterSet& pset)
+      : nRandomPoints(pset.getUntrackedParameter<int>("nRandomPoints", 10000000)),
+        indexScanStep(pset.getUntrackedParameter<double>("indexScanStep", 5.)),
+        indexScanPhiBins(pset.getUntrackedParameter<int>("indexScanPhiBins", 360)),
+        benchmarkPoints(pset.getUntrackedParameter<int>("benchmarkPoints", 0)){};
 
   /// Destructor
   virtual ~testMagGeometryAnalyzer(){};
@@ -36,6 +41,11 @@ public:
 
 private:
   void testGrids(const vector<MagVolume6Faces const*>& bvol);
+
+  int nRandomPoints;        // findVolume(random) test, skipped if 0
+  double indexScanStep;     // R and Z spacing of the volume index test, in cm
+  int indexScanPhiBins;     // phi bins of the volume index test
+  int benchmarkPoints;      // findVolume benchmark, skipped if 0
 };
 
 using namespace edm;
@@ -50,7 +60,18 @@ void testMagGeometryAnalyzer::analyze(const edm::Event& event, const edm::EventS
   MagGeometryExerciser exe(field);
 
   //FIXME: the region to be tested is specified inside.
-  exe.testFindVolume(10000000);
+  if (nRandomPoints > 0)
+    exe.testFindVolume(nRandomPoints);
+
+  // Test that the volume index agrees with the hierarchical search (if built)
+  long nDifferent = exe.testVolumeIndex(indexScanStep, indexScanPhiBins, indexScanStep);
+  if (nDifferent != 0)
+    throw cms::Exception("testMagGeometryAnalyzer")
+        << "the volume index differs from the hierarchical search at " << nDifferent << " points";
+
+  // Time findVolume with and without the volume index
+  if (benchmarkPoints > 0)
+    exe.benchmarkFindVolume(benchmarkPoints);
 
   // Test that random points are inside one and only one volume
   // exe.testInside(100000,0.03);
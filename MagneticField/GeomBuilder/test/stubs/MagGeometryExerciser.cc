@@ -12,6 +12,8 @@
 #include "GlobalPointProvider.h"
 
 #include <algorithm>
+#include <chrono>
+#include <cstring>
 
 using namespace std;
 
@@ -55,6 +57,103 @@ void MagGeometryExerciser::testFindVolume(int ntry) {
        << "-----------------------------------------------------" << endl;
 }
 
+//----------------------------------------------------------------------
+// Check that the volume index gives the same volume, and the same field,
+// as the hierarchical search, on a lattice of points covering the geometry.
+// Requires the index to be built (useVolumeIndex in the ESProducer).
+// Returns the number of points where the volumes differ.
+long MagGeometryExerciser::testVolumeIndex(float dR, int nPhi, float dZ) {
+  cout << endl << "-----------------------------------------------------" << endl << " volume index test" << endl;
+
+  if (!theGeometry->hasVolumeIndex()) {
+    cout << "No volume index, set useVolumeIndex = true to test it" << endl
+         << "-----------------------------------------------------" << endl;
+    return 0;
+  }
+
+  float maxZ = 2000.;
+  if (theGeometry->geometryVersion >= 160812)
+    maxZ = 2400.;
+
+  long nPoints = 0, nIndexed = 0, nDifferentVolume = 0, nDifferentField = 0;
+  for (float z = -maxZ + dZ / 2.f; z < maxZ; z += dZ) {
+    for (int iPhi = 0; iPhi < nPhi; ++iPhi) {
+      float phi = -Geom::pi() + (iPhi + 0.5) * Geom::twoPi() / nPhi;
+      for (float r = dR / 2.f; r < 900.; r += dR) {
+        GlobalPoint gp(GlobalPoint::Cylindrical(r, phi, z));
+        ++nPoints;
+        MagVolume const* ref = theGeometry->findVolumeHierarchical(gp);
+        MagVolume const* vol = theGeometry->findVolumeIndexed(gp);
+        if (vol == nullptr)
+          continue;
+        ++nIndexed;
+        if (vol == ref)
+          continue;
+        ++nDifferentVolume;
+        GlobalVector b = vol->fieldInTesla(gp);
+        GlobalVector bRef = ref ? ref->fieldInTesla(gp) : GlobalVector();
+        float c[3] = {b.x(), b.y(), b.z()}, cRef[3] = {bRef.x(), bRef.y(), bRef.z()};
+        bool sameField = ref != nullptr && memcmp(c, cRef, sizeof(c)) == 0;
+        if (!sameField)
+          ++nDifferentField;
+        if (nDifferentVolume <= 20) {
+          cout << "Test ERROR: index volume " << static_cast<MagVolume6Faces const*>(vol)->volumeNo
+               << ", findVolume: " << (ref ? int(static_cast<MagVolume6Faces const*>(ref)->volumeNo) : -1)
+               << (sameField ? " (same field)" : " (different field)") << " at " << gp << " R " << gp.perp()
+               << endl;
+        }
+      }
+    }
+  }
+
+  cout << " Tested " << nPoints << " (" << nIndexed << " found by the index, " << nPoints - nIndexed
+       << " by the hierarchical search) Different volumes: " << nDifferentVolume
+       << " Different fields: " << nDifferentField << endl
+       << "-----------------------------------------------------" << endl;
+  return nDifferentVolume;
+}
+
+//----------------------------------------------------------------------
+// Time the lookup of random points by the hierarchical search alone, by the
+// volume index falling back to the hierarchical search, and by findVolume,
+// which also tries the volume of the previous point first.
+void MagGeometryExerciser::benchmarkFindVolume(int ntry) {
+  cout << endl << "-----------------------------------------------------" << endl << " findVolume benchmark" << endl;
+
+  float maxZ = 2000.;
+  if (theGeometry->geometryVersion >= 160812)
+    maxZ = 2400.;
+
+  GlobalPointProvider p(0., 900., -Geom::pi(), Geom::pi(), -maxZ, maxZ);
+  vector<GlobalPoint> points;
+  points.reserve(ntry);
+  for (int i = 0; i < ntry; ++i) {
+    points.push_back(p.getPoint());
+  }
+
+  auto time = [&points](const char* name, auto find) {
+    long found = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (auto const& gp : points) {
+      found += (find(gp) != nullptr);
+    }
+    std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+    cout << " " << name << ": " << elapsed.count() / points.size() << " ns/point, " << found << " found" << endl;
+  };
+
+  time("hierarchical", [this](GlobalPoint const& gp) { return theGeometry->findVolumeHierarchical(gp); });
+  if (theGeometry->hasVolumeIndex()) {
+    time("volume index", [this](GlobalPoint const& gp) {
+      MagVolume const* vol = theGeometry->findVolumeIndexed(gp);
+      return vol != nullptr ? vol : theGeometry->findVolumeHierarchical(gp);
+    });
+  } else {
+    cout << " No volume index, set useVolumeIndex = true to time it" << endl;
+  }
+  time("findVolume", [this](GlobalPoint const& gp) { return theGeometry->findVolume(gp); });
+  cout << "-----------------------------------------------------" << endl;
+}
+
 //----------------------------------------------------------------------
 // Check if findVolume succeeds for the given point.
 bool MagGeometryExerciser::testFindVolume(const GlobalPoint& gp) {
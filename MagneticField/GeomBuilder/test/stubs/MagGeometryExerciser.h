@@ -23,6 +23,8 @@ public:
 
   void testFindVolume(int ntry = 100000);                    // findVolume(random) test
   void testInside(int ntry = 100000, float tolerance = 0.);  // inside(random) test
+  long testVolumeIndex(float dR = 5., int nPhi = 360, float dZ = 5.);  // volume index vs. findVolume (dense scan)
+  void benchmarkFindVolume(int ntry = 1000000);  // time of findVolume(random) with and without the volume index
 
   //  void testFieldRandom(int ntry = 1000);// fieldInTesla vs MagneticField::inTesla (random)
   //  void testFieldVol1();  // fieldInTesla within vol 1 (tiny region)
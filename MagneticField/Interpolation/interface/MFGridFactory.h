@@ -18,6 +18,10 @@ public:
   /// Build interpolator for a binary grid file
   static MFGrid* build(const std::string& name, const GloballyPositioned<float>& vol);
 
+  /// Build interpolator for a binary grid file, with the field values in memory shared read-only
+  /// by all the processes of the node building the same grid if shareAcrossProcesses is true
+  static MFGrid* build(const std::string& name, const GloballyPositioned<float>& vol, bool shareAcrossProcesses);
+
   /// Build a 2pi phi-symmetric interpolator for a binary grid file
   static MFGrid* build(const std::string& name, const GloballyPositioned<float>& vol, double phiMin, double phiMax);
 };
@@ -1,4 +1,6 @@
 #include "Grid3D.h"
+#include "FWCore/Utilities/interface/SharedReadOnlyMemory.h"
+#include <cstring>
 #include <iostream>
 
 /*
@@ -24,3 +26,10 @@ void Grid3D::dump() const {
     }
   }
 }
+
+void Grid3D::shareValues(const std::string& name) {
+  const BVector* values = data_.get();
+  size_t bytes = size_ * sizeof(BVector);
+  auto shared = edm::sharedReadOnlyMemory(name, bytes, [values, bytes](void* p) { std::memcpy(p, values, bytes); });
+  data_ = std::shared_ptr<const BVector>(shared, static_cast<const BVector*>(shared.get()));
+}
@@ -11,6 +11,8 @@
 #include "DataFormats/GeometryVector/interface/Basic3DVector.h"
 // #include "DataFormats/Math/interface/SIMDVec.h"
 #include "Grid1D.h"
+#include <memory>
+#include <string>
 #include <vector>
 #include "FWCore/Utilities/interface/Visibility.h"
 
@@ -40,11 +42,17 @@ public:
 
   Grid3D(const Grid1D& ga, const Grid1D& gb, const Grid1D& gc, std::vector<BVector>& data)
       : grida_(ga), gridb_(gb), gridc_(gc) {
-    data_.swap(data);
+    auto values = std::make_shared<Container>();
+    values->swap(data);
+    data_ = std::shared_ptr<const BVector>(values, values->data());
+    size_ = values->size();
     stride1_ = gridb_.nodes() * gridc_.nodes();
     stride2_ = gridc_.nodes();
   }
 
+  /// Moves the field values to memory shared read-only by the processes of the node using the same name
+  void shareValues(const std::string& name);
+
   //  Grid3D( const Grid1D& ga, const Grid1D& gb, const Grid1D& gc,
   //	  std::vector<ValueType> const & data);
 
@@ -52,7 +60,10 @@ public:
   int stride1() const { return stride1_; }
   int stride2() const { return stride2_; }
   int stride3() const { return 1; }
-  ValueType operator()(int i) const { return ValueType(data_[i][0], data_[i][1], data_[i][2]); }
+  ValueType operator()(int i) const {
+    const BVector& v = data_.get()[i];
+    return ValueType(v[0], v[1], v[2]);
+  }
 
   ValueType operator()(int i, int j, int k) const { return (*this)(index(i, j, k)); }
 
@@ -60,7 +71,7 @@ public:
   const Grid1D& gridb() const { return gridb_; }
   const Grid1D& gridc() const { return gridc_; }
 
-  const Container& data() const { return data_; }
+  size_t size() const { return size_; }
 
   void dump() const;
 
@@ -69,7 +80,9 @@ private:
   Grid1D gridb_;
   Grid1D gridc_;
 
-  Container data_;
+  // never modified once set: the copies of a grid share the values
+  std::shared_ptr<const BVector> data_;
+  size_t size_ = 0;
 
   int stride1_;
   int stride2_;
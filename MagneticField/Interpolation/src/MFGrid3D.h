@@ -52,6 +52,9 @@ public:
   /// Interpolated field value at given point; does not check for exceptions
   virtual LocalVector uncheckedValueInTesla(const LocalPoint& p) const = 0;
 
+  /// Moves the field values to memory shared by the processes of the node building the same grid
+  void shareValues(const std::string& name) { grid_.shareValues(name); }
+
 protected:
   using GridType = Grid3D;
   using BVector = Grid3D::BVector;
@@ -9,11 +9,18 @@
 #include "SpecialCylindricalMFGrid.h"
 #include "CylinderFromSectorMFGrid.h"
 
+#include <iomanip>
 #include <iostream>
+#include <sstream>
+#include <sys/stat.h>
 
 using namespace std;
 
 MFGrid* MFGridFactory::build(const string& name, const GloballyPositioned<float>& vol) {
+  return build(name, vol, false);
+}
+
+MFGrid* MFGridFactory::build(const string& name, const GloballyPositioned<float>& vol, bool shareAcrossProcesses) {
   binary_ifstream inFile(name);
   int gridType;
   inFile >> gridType;
@@ -45,6 +52,23 @@ MFGrid* MFGridFactory::build(const string& name, const GloballyPositioned<float>
       break;
   }
   inFile.close();
+
+  if (shareAcrossProcesses && result != nullptr) {
+    // the values depend on the file and, for the grids in local coordinates, on the frame
+    struct stat status;
+    std::ostringstream key;
+    key << std::setprecision(9) << "MFGrid " << name;
+    // the modification time to the nanosecond, so that a file rewritten within a second is not taken for the old one
+    if (::stat(name.c_str(), &status) == 0)
+      key << " " << status.st_dev << " " << status.st_ino << " " << status.st_size << " " << status.st_mtim.tv_sec
+          << " " << status.st_mtim.tv_nsec;
+    const auto& p = vol.position();
+    const auto& r = vol.rotation();
+    key << " " << p.x() << " " << p.y() << " " << p.z();
+    key << " " << r.xx() << " " << r.xy() << " " << r.xz() << " " << r.yx() << " " << r.yy() << " " << r.yz() << " "
+        << r.zx() << " " << r.zy() << " " << r.zz();
+    static_cast<MFGrid3D*>(result)->shareValues(key.str());
+  }
   return result;
 }
 
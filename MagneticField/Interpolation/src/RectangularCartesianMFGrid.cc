@@ -75,7 +75,7 @@ void RectangularCartesianMFGrid::dump() const {
   cout << "Basic Distance from Grid1D " << grid_.grida().step() << " " << grid_.gridb().step() << " "
        << grid_.gridc().step() << endl;
 
-  cout << "Dumping " << grid_.data().size() << " field values " << endl;
+  cout << "Dumping " << grid_.size() << " field values " << endl;
   // grid_.dump();
 }
 
@@ -70,7 +70,7 @@ namespace magfieldparam {
     void operator()(T r2, T z, T& Br, T& Bz) const { compute(r2, z, Br, Bz); }
 
     // in meters and T  (Br needs to be multiplied by r)
-    void compute(T r2, T z, T& Br, T& Bz) const {
+    inline void compute(T r2, T z, T& Br, T& Bz) const __attribute__((always_inline)) {
       using namespace bcylDetails;
       //  if (r<1.15&&fabs(z)<2.8) // NOTE: check omitted, is done already by the wrapper! (NA)
       z -= pars.prm[3];  // max Bz point is shifted in z
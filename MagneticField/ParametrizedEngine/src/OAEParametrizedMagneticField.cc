@@ -9,6 +9,8 @@
 
 #include "TkBfield.h"
 
+#include <algorithm>
+
 using namespace std;
 using namespace magfieldparam;
 
@@ -42,6 +44,31 @@ GlobalVector OAEParametrizedMagneticField::inTeslaUnchecked(const GlobalPoint& g
   return GlobalVector(B[0], B[1], B[2]);
 }
 
+// The points are converted to arrays of coordinates in blocks, evaluated by the vectorized TkBfield kernel
+void OAEParametrizedMagneticField::batchInTesla(edm::Span<const GlobalPoint> gp, edm::Span<GlobalVector> b) const {
+  constexpr size_t kBlock = 64;
+  float x[kBlock], y[kBlock], z[kBlock];
+  float bx[kBlock], by[kBlock], bz[kBlock];
+  for (size_t first = 0; first < gp.size(); first += kBlock) {
+    size_t n = std::min(kBlock, gp.size() - first);
+    for (size_t i = 0; i < n; ++i) {
+      x[i] = gp[first + i].x() * ooh;
+      y[i] = gp[first + i].y() * ooh;
+      z[i] = gp[first + i].z() * ooh;
+    }
+    theParam.getBxyz(n, x, y, z, bx, by, bz);
+    for (size_t i = 0; i < n; ++i) {
+      if (isDefined(gp[first + i])) {
+        b[first + i] = GlobalVector(bx[i], by[i], bz[i]);
+      } else {
+        edm::LogWarning("MagneticField|FieldOutsideValidity")
+            << " Point " << gp[first + i] << " is outside the validity region of OAEParametrizedMagneticField";
+        b[first + i] = GlobalVector();
+      }
+    }
+  }
+}
+
 bool OAEParametrizedMagneticField::isDefined(const GlobalPoint& gp) const {
   return (gp.perp2() < (115.f * 115.f) && fabs(gp.z()) < 280.f);
 }
@@ -43,6 +43,8 @@ public:
   bool isDefined(const GlobalPoint& gp) const override;
 
 private:
+  void batchInTesla(edm::Span<const GlobalPoint> gp, edm::Span<GlobalVector> b) const override;
+
   magfieldparam::TkBfield theParam;
 };
 #endif
@@ -7,6 +7,8 @@
 #include <FWCore/ParameterSet/interface/ParameterSet.h>
 #include <FWCore/MessageLogger/interface/MessageLogger.h>
 
+#include <algorithm>
+
 using namespace std;
 
 // Default parameters are the best fit of 3.8T to the OAEParametrizedMagneticField parametrization.
@@ -32,10 +34,31 @@ GlobalVector ParabolicParametrizedMagneticField::inTeslaUnchecked(const GlobalPo
   return GlobalVector(0, 0, B0Z(gp.z()) * Kr(gp.perp2()));
 }
 
+// A branch free loop the compiler vectorizes; the points outside the validity region get a null field,
+// and are reported once for the whole batch
+void ParabolicParametrizedMagneticField::batchInTesla(edm::Span<const GlobalPoint> gp,
+                                                      edm::Span<GlobalVector> b) const {
+  size_t outside = 0;
+  for (size_t i = 0; i < gp.size(); ++i) {
+    float z = gp[i].z();
+    float r2 = gp[i].perp2();
+    float bz = B0Z(z) * Kr(r2);
+    bool inside = r2 < maxR2 && std::abs(z) < maxZ;
+    outside += !inside;
+    b[i] = GlobalVector(0, 0, inside ? bz : 0.f);
+  }
+  if (outside > 0) {
+    auto first = std::find_if(gp.begin(), gp.end(), [this](const GlobalPoint& p) { return !isDefined(p); });
+    LogDebug("MagneticField|FieldOutsideValidity")
+        << " Point " << *first << " and " << outside - 1
+        << " other points of the batch are outside the validity region of ParabolicParametrizedMagneticField";
+  }
+}
+
 inline float ParabolicParametrizedMagneticField::B0Z(const float z) const { return b0 * z * z + b1 * z + c1; }
 
 inline float ParabolicParametrizedMagneticField::Kr(const float R2) const { return a * R2 + 1.; }
 
 inline bool ParabolicParametrizedMagneticField::isDefined(const GlobalPoint& gp) const {
-  return (gp.perp2() < (13225.f) && fabs(gp.z()) < 280.f);
+  return (gp.perp2() < maxR2 && fabs(gp.z()) < maxZ);
 }
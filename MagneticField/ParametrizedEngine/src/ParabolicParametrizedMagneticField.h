@@ -38,6 +38,12 @@ public:
   inline bool isDefined(const GlobalPoint& gp) const override;
 
 private:
+  void batchInTesla(edm::Span<const GlobalPoint> gp, edm::Span<GlobalVector> b) const override;
+
+  // the validity region: r < 115 cm, |z| < 280 cm
+  static constexpr float maxR2 = 13225.f;
+  static constexpr float maxZ = 280.f;
+
   float c1;
   float b0;
   float b1;
@@ -67,3 +67,22 @@ void TkBfield::getBxyz(float const* __restrict__ x, float* __restrict__ Bxyz) co
   Bxyz[1] = br * x[1];
   Bxyz[2] = bz;
 }
+
+// same computation as above, in a loop the compiler vectorizes
+void TkBfield::getBxyz(int n,
+                       float const* __restrict__ x,
+                       float const* __restrict__ y,
+                       float const* __restrict__ z,
+                       float* __restrict__ bx,
+                       float* __restrict__ by,
+                       float* __restrict__ bz) const {
+  for (int i = 0; i < n; ++i) {
+    float br;
+    float b;
+    float r2 = x[i] * x[i] + y[i] * y[i];
+    bcyl.compute(r2, z[i], br, b);
+    bx[i] = br * x[i];
+    by[i] = br * y[i];
+    bz[i] = b;
+  }
+}
@@ -31,6 +31,14 @@ namespace magfieldparam {
 
     /// B out in cartesian
     void getBxyz(float const* __restrict__ x, float* __restrict__ Bxyz) const;
+    /// B out in cartesian for n points, coordinates and field components in separate arrays
+    void getBxyz(int n,
+                 float const* __restrict__ x,
+                 float const* __restrict__ y,
+                 float const* __restrict__ z,
+                 float* __restrict__ bx,
+                 float* __restrict__ by,
+                 float* __restrict__ bz) const;
     /// B out in cylindrical
     void getBrfz(float const* __restrict__ x, float* __restrict__ Brfz) const;
 
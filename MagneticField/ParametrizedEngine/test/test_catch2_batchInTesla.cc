@@ -0,0 +1,62 @@
+#include "MagneticField/ParametrizedEngine/src/OAEParametrizedMagneticField.h"
+#include "MagneticField/ParametrizedEngine/src/ParabolicParametrizedMagneticField.h"
+
+#include "catch.hpp"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+  // points inside and outside the validity region of the parametrizations (r < 115 cm, |z| < 280 cm),
+  // including its boundary; their number is not a multiple of the blocks of the batched evaluation
+  std::vector<GlobalPoint> testPoints() {
+    std::vector<GlobalPoint> points;
+    for (float r = 0.f; r <= 150.f; r += 2.5f) {
+      for (float z = -320.f; z <= 320.f; z += 10.f) {
+        float phi = 0.1f * r + 0.01f * z;
+        points.emplace_back(r * std::cos(phi), r * std::sin(phi), z);
+      }
+    }
+    points.emplace_back(115.f, 0.f, 0.f);
+    points.emplace_back(0.f, 0.f, 280.f);
+    points.emplace_back(0.f, 0.f, -280.f);
+    return points;
+  }
+
+  bool identical(GlobalVector const& a, GlobalVector const& b) {
+    return a.x() == b.x() and a.y() == b.y() and a.z() == b.z();
+  }
+
+  // the values of one batch and of one point at a time must be bit-identical
+  void checkBatch(MagneticField const& field) {
+    std::vector<GlobalPoint> points = testPoints();
+    std::vector<GlobalVector> batch(points.size());
+    field.inTesla(points, batch);
+    unsigned int outside = 0;
+    unsigned int different = 0;
+    for (unsigned int i = 0; i < points.size(); ++i) {
+      if (not field.isDefined(points[i]))
+        ++outside;
+      if (not identical(batch[i], field.inTesla(points[i])))
+        ++different;
+    }
+    REQUIRE(outside > 0);
+    REQUIRE(outside < points.size());
+    REQUIRE(different == 0);
+
+    // the same values from batches of any size
+    std::vector<GlobalVector> small(points.size());
+    for (unsigned int first = 0; first < points.size(); first += 7) {
+      unsigned int n = std::min(7u, static_cast<unsigned int>(points.size()) - first);
+      field.inTesla(edm::Span<const GlobalPoint>(points.data() + first, n),
+                    edm::Span<GlobalVector>(small.data() + first, n));
+    }
+    for (unsigned int i = 0; i < points.size(); ++i)
+      REQUIRE(identical(small[i], batch[i]));
+  }
+}  // namespace
+
+TEST_CASE("Batched inTesla of the parametrized fields", "[batchInTesla]") {
+  SECTION("OAEParametrizedMagneticField") { checkBatch(OAEParametrizedMagneticField("3_8T")); }
+  SECTION("ParabolicParametrizedMagneticField") { checkBatch(ParabolicParametrizedMagneticField()); }
+}
@@ -9,14 +9,16 @@
 
 #include "DataFormats/GeometrySurface/interface/BoundPlane.h"
 #include "MagneticField/Layers/src/MagBinFinders.h"
+#include "FWCore/Utilities/interface/Span.h"
 
+#include <memory>
 #include <vector>
-#include <atomic>
 
 class MagBLayer;
 class MagESector;
 class MagVolume;
 class MagVolume6Faces;
+class MagVolumeIndex;
 template <class T>
 class PeriodicBinFinderInPhi;
 
@@ -43,9 +45,17 @@ public:
   /// Return field vector at the specified global point
   GlobalVector fieldInTesla(const GlobalPoint& gp) const;
 
+  /// Return field vectors at a batch of global points, evaluated volume by volume
+  void fieldInTesla(edm::Span<const GlobalPoint> gp, edm::Span<GlobalVector> b) const;
+
   /// Find a volume
   MagVolume const* findVolume(const GlobalPoint& gp, double tolerance = 0.) const;
 
+  /// Build a grid of the volumes covering R < maxR and |Z| < maxZ, to find
+  /// the volumes without the hierarchical search. To be called once, before
+  /// the geometry is used.
+  void buildVolumeIndex(float maxR, float maxZ);
+
   // Deprecated, will be removed
   bool isZSymmetric() const { return false; }
 
@@ -59,9 +69,19 @@ private:
   // Linear search (for debug purposes only)
   MagVolume const* findVolume1(const GlobalPoint& gp, double tolerance = 0.) const;
 
+  // Search through the layers and sectors, without the cache and the index
+  MagVolume const* findVolumeHierarchical(const GlobalPoint& gp, double tolerance = 0.) const;
+
+  // Search with the index only: null where the index defers to the hierarchical search, or if it is not built
+  MagVolume const* findVolumeIndexed(const GlobalPoint& gp) const;
+  bool hasVolumeIndex() const { return theVolumeIndex != nullptr; }
+
   bool inBarrel(const GlobalPoint& gp) const;
 
-  mutable std::atomic<MagVolume const*> lastVolume;  // Cache last volume found
+  // Identifies the geometry in the per-thread cache of the last volume found
+  const unsigned long long theCacheId;
+
+  std::unique_ptr<MagVolumeIndex const> theVolumeIndex;
 
   std::vector<MagBLayer const*> theBLayers;
   std::vector<MagESector const*> theESectors;
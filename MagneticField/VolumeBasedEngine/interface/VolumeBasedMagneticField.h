@@ -30,7 +30,8 @@ public:
                            float rMax,
                            float zMax,
                            const MagneticField* param = nullptr,
-                           bool isParamFieldOwned = false);
+                           bool isParamFieldOwned = false,
+                           bool useVolumeIndex = false);
   ~VolumeBasedMagneticField() override;
 
   /// Copy constructor implement a shallow copy (ie no ownership of actual engines)
@@ -50,6 +51,8 @@ public:
   bool isZSymmetric() const;
 
 private:
+  void batchInTesla(edm::Span<const GlobalPoint> gp, edm::Span<GlobalVector> b) const override;
+
   const MagGeometry* field;
   float maxR;
   float maxZ;
@@ -5,6 +5,7 @@
  */
 
 #include "MagneticField/VolumeBasedEngine/interface/MagGeometry.h"
+#include "MagVolumeIndex.h"
 #include "MagneticField/VolumeGeometry/interface/MagVolume.h"
 #include "MagneticField/VolumeGeometry/interface/MagVolume6Faces.h"
 #include "MagneticField/Layers/interface/MagBLayer.h"
@@ -18,11 +19,26 @@
 #include "MagneticField/Layers/interface/MagVerbosity.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 
+#include <algorithm>
+#include <atomic>
+#include <functional>
 #include <iostream>
 
 using namespace std;
 using namespace edm;
 
+namespace {
+  // The last volume found by each thread, and the geometry it belongs to.
+  // A geometry is identified by a number never reused, rather than by its address.
+  struct LastVolume {
+    unsigned long long geometry = 0;
+    MagVolume const* volume = nullptr;
+  };
+  thread_local LastVolume lastVolume;
+
+  std::atomic<unsigned long long> nextCacheId{1};
+}  // namespace
+
 MagGeometry::MagGeometry(int geomVersion,
                          const std::vector<MagBLayer*>& tbl,
                          const std::vector<MagESector*>& tes,
@@ -39,7 +55,7 @@ MagGeometry::MagGeometry(int geomVersion,
                          const std::vector<MagESector const*>& tes,
                          const std::vector<MagVolume6Faces const*>& tbv,
                          const std::vector<MagVolume6Faces const*>& tev)
-    : lastVolume(nullptr),
+    : theCacheId(nextCacheId++),
       theBLayers(tbl),
       theESectors(tes),
       theBVolumes(tbv),
@@ -105,6 +121,46 @@ GlobalVector MagGeometry::fieldInTesla(const GlobalPoint& gp) const {
   return GlobalVector();
 }
 
+// Return field vectors at a batch of global points.
+// The volume of the previous point is tried first, as consecutive points along a trajectory are usually in the
+// same volume; the points are then sorted by volume so that each grid is read once for all its points.
+void MagGeometry::fieldInTesla(edm::Span<const GlobalPoint> gp, edm::Span<GlobalVector> b) const {
+  std::vector<std::pair<MagVolume const*, unsigned int>> volumes;
+  volumes.reserve(gp.size());
+  MagVolume const* previous = nullptr;
+  for (unsigned int i = 0; i < gp.size(); ++i) {
+    MagVolume const* v = (previous != nullptr && previous->inside(gp[i])) ? previous : findVolume(gp[i]);
+    if (v != nullptr)
+      previous = v;
+    volumes.emplace_back(v, i);
+  }
+  std::stable_sort(volumes.begin(), volumes.end(), [](auto const& a, auto const& b) {
+    return std::less<MagVolume const*>()(a.first, b.first);
+  });
+
+  unsigned int notFound = 0;
+  for (auto const& v : volumes) {
+    if (v.first != nullptr) {
+      b[v.second] = v.first->fieldInTesla(gp[v.second]);
+    } else {
+      // fall-back case: a null field, with the warning for a single point given once for the batch
+      b[v.second] = GlobalVector();
+      if (notFound++ == 0) {
+        if (edm::isNotFinite(gp[v.second].mag())) {
+          LogWarning("InvalidInput") << "Input value invalid (not a number): " << gp[v.second] << endl;
+        } else {
+          LogWarning("MagneticField") << "MagGeometry::fieldInTesla: failed to find volume for " << gp[v.second]
+                                      << endl;
+        }
+      }
+    }
+  }
+  if (notFound > 1) {
+    LogWarning("MagneticField") << "MagGeometry::fieldInTesla: failed to find volume for " << notFound - 1
+                                << " more points of the batch" << endl;
+  }
+}
+
 // Linear search implementation (just for testing)
 MagVolume const* MagGeometry::findVolume1(const GlobalPoint& gp, double tolerance) const {
   MagVolume6Faces const* found = nullptr;
@@ -146,14 +202,32 @@ MagVolume const* MagGeometry::findVolume1(const GlobalPoint& gp, double toleranc
   return found;
 }
 
-// Use hierarchical structure for fast lookup.
+// Use the volume cache, then the index, then the hierarchical structure.
 MagVolume const* MagGeometry::findVolume(const GlobalPoint& gp, double tolerance) const {
-  // Check volume cache
-  auto lastVolumeCheck = lastVolume.load(std::memory_order_acquire);
-  if (lastVolumeCheck != nullptr && lastVolumeCheck->inside(gp)) {
-    return lastVolumeCheck;
+  // Check the volume cache of this thread
+  LastVolume& last = lastVolume;
+  if (last.geometry == theCacheId && last.volume != nullptr && last.volume->inside(gp)) {
+    return last.volume;
   }
 
+  MagVolume const* result = nullptr;
+  if (theVolumeIndex != nullptr && tolerance == 0.) {
+    result = theVolumeIndex->findVolume(gp);
+  }
+  if (result == nullptr) {
+    result = findVolumeHierarchical(gp, tolerance);
+  }
+
+  if (cacheLastVolume) {
+    last.geometry = theCacheId;
+    last.volume = result;
+  }
+
+  return result;
+}
+
+// Use hierarchical structure for fast lookup.
+MagVolume const* MagGeometry::findVolumeHierarchical(const GlobalPoint& gp, double tolerance) const {
   MagVolume const* result = nullptr;
   if (inBarrel(gp)) {  // Barrel
     double R = gp.perp();
@@ -189,15 +263,25 @@ MagVolume const* MagGeometry::findVolume(const GlobalPoint& gp, double tolerance
     // which will not be present anymore once surfaces are matched.
     if (verbose::debugOut)
       cout << "Increasing the tolerance to 0.03" << endl;
-    result = findVolume(gp, 0.03);
+    result = findVolumeHierarchical(gp, 0.03);
   }
 
-  if (cacheLastVolume)
-    lastVolume.store(result, std::memory_order_release);
-
   return result;
 }
 
+// Cells of 10 cm in R and Z and of 5 degrees in phi: the volumes are searched at about
+// 3 million corners for the full map, once when the field is built.
+void MagGeometry::buildVolumeIndex(float maxR, float maxZ) {
+  theVolumeIndex = std::make_unique<MagVolumeIndex>(
+      maxR, maxZ, 10.f, 72, 10.f, [this](const GlobalPoint& gp) { return findVolumeHierarchical(gp); });
+  LogInfo("MagneticField") << "MagGeometry: volume index of " << theVolumeIndex->numberOfCells() << " cells, "
+                           << theVolumeIndex->numberOfLists() << " distinct lists of volumes";
+}
+
+MagVolume const* MagGeometry::findVolumeIndexed(const GlobalPoint& gp) const {
+  return theVolumeIndex != nullptr ? theVolumeIndex->findVolume(gp) : nullptr;
+}
+
 bool MagGeometry::inBarrel(const GlobalPoint& gp) const {
   float Z = fabs(gp.z());
   float R = gp.perp();
@@ -0,0 +1,108 @@
+/*
+ *  See header file for a description of this class.
+ */
+
+#include "MagVolumeIndex.h"
+#include "MagneticField/VolumeGeometry/interface/MagVolume.h"
+#include "DataFormats/GeometryVector/interface/Pi.h"
+#include "FWCore/Utilities/interface/Exception.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+
+namespace {
+  constexpr uint16_t noVolume = std::numeric_limits<uint16_t>::max();
+}
+
+MagVolumeIndex::MagVolumeIndex(float maxR,
+                               float maxZ,
+                               float dR,
+                               int nPhi,
+                               float dZ,
+                               const std::function<MagVolume const*(const GlobalPoint&)>& find)
+    : theMaxR(maxR),
+      theMaxZ(maxZ),
+      theNR(std::max(1, int(std::ceil(maxR / dR)))),
+      theNPhi(std::max(1, nPhi)),
+      theNZ(std::max(1, int(std::ceil(2.f * maxZ / dZ)))),
+      theInvDR(theNR / maxR),
+      theInvDPhi(theNPhi / Geom::ftwoPi()),
+      theInvDZ(theNZ / (2.f * maxZ)) {
+  // the volume at each corner; phi is periodic, so there are as many corners as cells in phi
+  std::map<MagVolume const*, uint16_t> volumeIndices;
+  std::vector<uint16_t> corners((theNR + 1) * theNPhi * (theNZ + 1), noVolume);
+  for (int iz = 0; iz <= theNZ; ++iz) {
+    float z = -maxZ + iz / theInvDZ;
+    for (int iphi = 0; iphi < theNPhi; ++iphi) {
+      float phi = -Geom::fpi() + iphi / theInvDPhi;
+      for (int ir = 0; ir <= theNR; ++ir) {
+        float r = ir / theInvDR;
+        MagVolume const* v = find(GlobalPoint(r * std::cos(phi), r * std::sin(phi), z));
+        if (v == nullptr)
+          continue;
+        auto inserted = volumeIndices.emplace(v, theVolumes.size());
+        if (inserted.second) {
+          if (theVolumes.size() == noVolume)
+            throw cms::Exception("MagVolumeIndex") << "too many volumes";
+          theVolumes.push_back(v);
+        }
+        corners[(iz * theNPhi + iphi) * (theNR + 1) + ir] = inserted.first->second;
+      }
+    }
+  }
+
+  // the distinct lists of the volumes at the 8 corners of each cell
+  std::map<std::vector<uint16_t>, uint32_t> listIndices;
+  theListOffsets.push_back(0);
+  theCells.resize(theNR * theNPhi * theNZ);
+  std::vector<uint16_t> list;
+  for (int iz = 0; iz < theNZ; ++iz) {
+    for (int iphi = 0; iphi < theNPhi; ++iphi) {
+      for (int ir = 0; ir < theNR; ++ir) {
+        list.clear();
+        for (int jz = iz; jz <= iz + 1; ++jz) {
+          for (int jphi : {iphi, (iphi + 1) % theNPhi}) {
+            for (int jr = ir; jr <= ir + 1; ++jr) {
+              uint16_t v = corners[(jz * theNPhi + jphi) * (theNR + 1) + jr];
+              if (v != noVolume)
+                list.push_back(v);
+            }
+          }
+        }
+        std::sort(list.begin(), list.end());
+        list.erase(std::unique(list.begin(), list.end()), list.end());
+        auto inserted = listIndices.emplace(list, theListOffsets.size() - 1);
+        if (inserted.second) {
+          theLists.insert(theLists.end(), list.begin(), list.end());
+          theListOffsets.push_back(theLists.size());
+        }
+        theCells[(iz * theNPhi + iphi) * theNR + ir] = inserted.first->second;
+      }
+    }
+  }
+}
+
+MagVolume const* MagVolumeIndex::findVolume(const GlobalPoint& gp) const {
+  float r = gp.perp();
+  float z = gp.z();
+  // also excludes NaNs
+  if (!(r < theMaxR && std::abs(z) < theMaxZ))
+    return nullptr;
+  int ir = std::min(int(r * theInvDR), theNR - 1);
+  int iphi = std::min(int((gp.barePhi() + Geom::fpi()) * theInvDPhi), theNPhi - 1);
+  int iz = std::min(int((z + theMaxZ) * theInvDZ), theNZ - 1);
+  uint32_t list = theCells[(iz * theNPhi + std::max(iphi, 0)) * theNR + ir];
+
+  MagVolume const* found = nullptr;
+  for (uint32_t i = theListOffsets[list]; i < theListOffsets[list + 1]; ++i) {
+    MagVolume const* v = theVolumes[theLists[i]];
+    if (v->inside(gp)) {
+      if (found != nullptr)
+        return nullptr;
+      found = v;
+    }
+  }
+  return found;
+}
@@ -0,0 +1,56 @@
+#ifndef MagVolumeIndex_H
+#define MagVolumeIndex_H
+
+/** \class MagVolumeIndex
+ *  A uniform grid in (R, phi, Z) listing for each cell the volumes found at its
+ *  corners, to find the volume of a point without the search through layers
+ *  and sectors of MagGeometry.
+ *  The index answers only when exactly one of the volumes listed for the cell
+ *  contains the point. At boundaries, in volumes thinner than a cell and
+ *  outside the grid, it returns nullptr and the caller falls back to the
+ *  hierarchical search, so that both give the same volume.
+ */
+
+#include "DataFormats/GeometryVector/interface/GlobalPoint.h"
+
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+class MagVolume;
+
+class MagVolumeIndex {
+public:
+  /// Build the grid of cells of size dR x 2pi/nPhi x dZ covering R < maxR and |Z| < maxZ;
+  /// find returns the volume at a corner of a cell, or nullptr.
+  MagVolumeIndex(float maxR,
+                 float maxZ,
+                 float dR,
+                 int nPhi,
+                 float dZ,
+                 const std::function<MagVolume const*(const GlobalPoint&)>& find);
+
+  /// The only volume listed for the cell of gp which contains gp, nullptr if none or several.
+  MagVolume const* findVolume(const GlobalPoint& gp) const;
+
+  int numberOfCells() const { return theCells.size(); }
+  int numberOfLists() const { return theListOffsets.size() - 1; }
+
+private:
+  float theMaxR;
+  float theMaxZ;
+  int theNR;
+  int theNPhi;
+  int theNZ;
+  float theInvDR;
+  float theInvDPhi;
+  float theInvDZ;
+
+  std::vector<MagVolume const*> theVolumes;
+  // the distinct lists of volumes, as indices in theVolumes
+  std::vector<uint16_t> theLists;
+  std::vector<uint32_t> theListOffsets;
+  // the list of each cell, R varying fastest, then phi, then Z
+  std::vector<uint32_t> theCells;
+};
+#endif
@@ -1,6 +1,8 @@
 #include "MagneticField/VolumeBasedEngine/interface/VolumeBasedMagneticField.h"
 #include "DataFormats/GeometryVector/interface/GlobalVector.h"
 
+#include <algorithm>
+
 VolumeBasedMagneticField::VolumeBasedMagneticField(int geomVersion,
                                                    const std::vector<MagBLayer*>& theBLayers,
                                                    const std::vector<MagESector*>& theESectors,
@@ -9,13 +11,19 @@ VolumeBasedMagneticField::VolumeBasedMagneticField(int geomVersion,
                                                    float rMax,
                                                    float zMax,
                                                    const MagneticField* param,
-                                                   bool isParamFieldOwned)
-    : field(new MagGeometry(geomVersion, theBLayers, theESectors, theBVolumes, theEVolumes)),
+                                                   bool isParamFieldOwned,
+                                                   bool useVolumeIndex)
+    : field(nullptr),
       maxR(rMax),
       maxZ(zMax),
       paramField(param),
       magGeomOwned(true),
-      paramFieldOwned(isParamFieldOwned) {}
+      paramFieldOwned(isParamFieldOwned) {
+  MagGeometry* geometry = new MagGeometry(geomVersion, theBLayers, theESectors, theBVolumes, theEVolumes);
+  if (useVolumeIndex)
+    geometry->buildVolumeIndex(rMax, zMax);
+  field = geometry;
+}
 
 VolumeBasedMagneticField::VolumeBasedMagneticField(const VolumeBasedMagneticField& vbf)
     : MagneticField::MagneticField(vbf),
@@ -56,6 +64,36 @@ GlobalVector VolumeBasedMagneticField::inTeslaUnchecked(const GlobalPoint& gp) c
   return field->fieldInTesla(gp);
 }
 
+// The points of the inner region go in one batch to the parametrization, the other points in the map to the volumes
+void VolumeBasedMagneticField::batchInTesla(edm::Span<const GlobalPoint> gp, edm::Span<GlobalVector> b) const {
+  std::vector<GlobalPoint> paramPoints, volumePoints;
+  std::vector<unsigned int> paramIndices, volumeIndices;
+  for (unsigned int i = 0; i < gp.size(); ++i) {
+    if (paramField && paramField->isDefined(gp[i])) {
+      paramPoints.push_back(gp[i]);
+      paramIndices.push_back(i);
+    } else if (isDefined(gp[i])) {
+      volumePoints.push_back(gp[i]);
+      volumeIndices.push_back(i);
+    } else {
+      // outside the map, a null field is not an error, as for a single point
+      b[i] = GlobalVector();
+    }
+  }
+
+  std::vector<GlobalVector> values(std::max(paramPoints.size(), volumePoints.size()));
+  if (!paramPoints.empty()) {
+    paramField->inTesla(paramPoints, values);
+    for (unsigned int i = 0; i < paramIndices.size(); ++i)
+      b[paramIndices[i]] = values[i];
+  }
+  if (!volumePoints.empty()) {
+    field->fieldInTesla(volumePoints, values);
+    for (unsigned int i = 0; i < volumeIndices.size(); ++i)
+      b[volumeIndices[i]] = values[i];
+  }
+}
+
 const MagVolume* VolumeBasedMagneticField::findVolume(const GlobalPoint& gp) const { return field->findVolume(gp); }
 
 bool VolumeBasedMagneticField::isDefined(const GlobalPoint& gp) const {
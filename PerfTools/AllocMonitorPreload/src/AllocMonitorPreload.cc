@@ -0,0 +1,335 @@
+// -*- C++ -*-
+//
+// Package:     PerfTools/AllocMonitorPreload
+//
+// Implementation:
+//     Replaces the malloc family of functions to count, for each thread, the
+//  heap allocations and deallocations it does. The real functions are those
+//  of the next library in the lookup order, so this also works on top of a
+//  preloaded or linked jemalloc or tcmalloc. The replaceable operator new and
+//  delete are replaced as well, since those libraries provide their own which
+//  do not go through malloc. The counters are read through
+//  edmAllocationCountersOfThisThread, see FWCore/Utilities/interface/AllocationCounters.h.
+//
+//  Use with
+//    LD_PRELOAD=libPerfToolsAllocMonitorPreload.so cmsRun ...
+//
+
+// system include files
+#include <atomic>
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <dlfcn.h>
+#include <malloc.h>
+#include <new>
+#include <unistd.h>
+
+// user include files
+#include "FWCore/Utilities/interface/AllocationCounters.h"
+
+namespace {
+  typedef void* (*MallocFunction)(std::size_t);
+  typedef void* (*CallocFunction)(std::size_t, std::size_t);
+  typedef void* (*ReallocFunction)(void*, std::size_t);
+  typedef void* (*AlignedAllocFunction)(std::size_t, std::size_t);
+  typedef int (*PosixMemalignFunction)(void**, std::size_t, std::size_t);
+  typedef void (*FreeFunction)(void*);
+  typedef std::size_t (*UsableSizeFunction)(void*);
+
+  MallocFunction s_malloc = nullptr;
+  CallocFunction s_calloc = nullptr;
+  ReallocFunction s_realloc = nullptr;
+  AlignedAllocFunction s_alignedAlloc = nullptr;
+  AlignedAllocFunction s_memalign = nullptr;
+  PosixMemalignFunction s_posixMemalign = nullptr;
+  MallocFunction s_valloc = nullptr;
+  MallocFunction s_pvalloc = nullptr;
+  FreeFunction s_free = nullptr;
+  UsableSizeFunction s_usableSize = nullptr;
+
+  //dlsym may allocate, those requests are served from here and never freed
+  alignas(16) char s_bootstrapBuffer[8192];
+  std::atomic<std::size_t> s_bootstrapUsed{0};
+  std::atomic<bool> s_initializing{false};
+
+  //initial-exec avoids the allocation the general dynamic model may do on first access
+  __attribute__((tls_model("initial-exec"))) thread_local edm::AllocationCounters t_counters = {};
+
+  void* bootstrapAllocate(std::size_t iSize, std::size_t iAlignment = 16) {
+    if (iSize > sizeof(s_bootstrapBuffer) or iAlignment > sizeof(s_bootstrapBuffer) or
+        (iAlignment & (iAlignment - 1)) != 0) {
+      return nullptr;
+    }
+    iAlignment = iAlignment < 16 ? 16 : iAlignment;
+    std::size_t used = s_bootstrapUsed.load();
+    std::size_t offset;
+    do {
+      auto address = reinterpret_cast<std::uintptr_t>(s_bootstrapBuffer) + used;
+      offset = used + ((iAlignment - address % iAlignment) % iAlignment);
+      if (offset + iSize > sizeof(s_bootstrapBuffer)) {
+        return nullptr;
+      }
+    } while (not s_bootstrapUsed.compare_exchange_weak(used, offset + ((iSize + 15) & ~std::size_t(15))));
+    return s_bootstrapBuffer + offset;
+  }
+
+  //posix_memalign is the only aligned allocation all the implementations provide
+  void* alignedAllocate(std::size_t iAlignment, std::size_t iSize) {
+    void* ptr = nullptr;
+    if (s_posixMemalign(&ptr, iAlignment < sizeof(void*) ? sizeof(void*) : iAlignment, iSize) != 0) {
+      return nullptr;
+    }
+    return ptr;
+  }
+
+  bool isBootstrap(void* iPtr) {
+    return static_cast<char*>(iPtr) >= s_bootstrapBuffer and
+           static_cast<char*>(iPtr) < s_bootstrapBuffer + sizeof(s_bootstrapBuffer);
+  }
+
+  template <typename T>
+  T next(char const* iName) {
+    return reinterpret_cast<T>(dlsym(RTLD_NEXT, iName));
+  }
+
+  __attribute__((constructor)) void init() {
+    if (s_free) {
+      return;
+    }
+    s_initializing = true;
+    s_calloc = next<CallocFunction>("calloc");
+    s_malloc = next<MallocFunction>("malloc");
+    s_realloc = next<ReallocFunction>("realloc");
+    s_alignedAlloc = next<AlignedAllocFunction>("aligned_alloc");
+    s_memalign = next<AlignedAllocFunction>("memalign");
+    s_posixMemalign = next<PosixMemalignFunction>("posix_memalign");
+    s_valloc = next<MallocFunction>("valloc");
+    s_pvalloc = next<MallocFunction>("pvalloc");
+    s_usableSize = next<UsableSizeFunction>("malloc_usable_size");
+    s_free = next<FreeFunction>("free");
+    s_initializing = false;
+  }
+
+  inline bool ready() {
+    if (s_free) {
+      return true;
+    }
+    if (s_initializing) {
+      return false;
+    }
+    init();
+    return true;
+  }
+
+  inline void countAllocation(void* iPtr) {
+    if (iPtr) {
+      std::int64_t size = s_usableSize(iPtr);
+      auto& counters = t_counters;
+      ++counters.nAllocations_;
+      counters.bytesAllocated_ += size;
+      counters.liveBytes_ += size;
+      if (counters.liveBytes_ > counters.peakLiveBytes_) {
+        counters.peakLiveBytes_ = counters.liveBytes_;
+      }
+    }
+  }
+
+  inline void countDeallocation(void* iPtr) {
+    if (iPtr) {
+      std::int64_t size = s_usableSize(iPtr);
+      auto& counters = t_counters;
+      ++counters.nDeallocations_;
+      counters.bytesDeallocated_ += size;
+      counters.liveBytes_ -= size;
+    }
+  }
+}  // namespace
+
+extern "C" {
+__attribute__((visibility("default"))) edm::AllocationCounters* edmAllocationCountersOfThisThread() {
+  return &t_counters;
+}
+
+void* malloc(std::size_t iSize) noexcept {
+  if (not ready()) {
+    return bootstrapAllocate(iSize);
+  }
+  void* ptr = s_malloc(iSize);
+  countAllocation(ptr);
+  return ptr;
+}
+
+void* calloc(std::size_t iN, std::size_t iSize) noexcept {
+  if (iSize != 0 and iN > SIZE_MAX / iSize) {
+    errno = ENOMEM;
+    return nullptr;
+  }
+  if (not ready()) {
+    //the buffer is static so already zeroed
+    return bootstrapAllocate(iN * iSize);
+  }
+  void* ptr = s_calloc(iN, iSize);
+  countAllocation(ptr);
+  return ptr;
+}
+
+void* realloc(void* iPtr, std::size_t iSize) noexcept {
+  if (isBootstrap(iPtr)) {
+    void* ptr = malloc(iSize);
+    if (ptr) {
+      std::size_t available = s_bootstrapBuffer + sizeof(s_bootstrapBuffer) - static_cast<char*>(iPtr);
+      std::memcpy(ptr, iPtr, iSize < available ? iSize : available);
+    }
+    return ptr;
+  }
+  if (not ready()) {
+    return iPtr ? nullptr : bootstrapAllocate(iSize);
+  }
+  std::int64_t oldSize = iPtr ? s_usableSize(iPtr) : 0;
+  void* ptr = s_realloc(iPtr, iSize);
+  if (ptr or iSize == 0) {
+    if (iPtr) {
+      auto& counters = t_counters;
+      ++counters.nDeallocations_;
+      counters.bytesDeallocated_ += oldSize;
+      counters.liveBytes_ -= oldSize;
+    }
+    countAllocation(ptr);
+  }
+  return ptr;
+}
+
+void* aligned_alloc(std::size_t iAlignment, std::size_t iSize) noexcept {
+  if (not ready()) {
+    return bootstrapAllocate(iSize, iAlignment);
+  }
+  void* ptr = s_alignedAlloc ? s_alignedAlloc(iAlignment, iSize) : alignedAllocate(iAlignment, iSize);
+  countAllocation(ptr);
+  return ptr;
+}
+
+void* memalign(std::size_t iAlignment, std::size_t iSize) noexcept {
+  if (not ready()) {
+    return bootstrapAllocate(iSize, iAlignment);
+  }
+  void* ptr = s_memalign ? s_memalign(iAlignment, iSize) : alignedAllocate(iAlignment, iSize);
+  countAllocation(ptr);
+  return ptr;
+}
+
+int posix_memalign(void** oPtr, std::size_t iAlignment, std::size_t iSize) noexcept {
+  if (not ready()) {
+    *oPtr = bootstrapAllocate(iSize, iAlignment);
+    return *oPtr ? 0 : ENOMEM;
+  }
+  int result = s_posixMemalign(oPtr, iAlignment, iSize);
+  if (result == 0) {
+    countAllocation(*oPtr);
+  }
+  return result;
+}
+
+void* valloc(std::size_t iSize) noexcept {
+  std::size_t pageSize = sysconf(_SC_PAGESIZE);
+  if (not ready()) {
+    return bootstrapAllocate(iSize, pageSize);
+  }
+  void* ptr = s_valloc ? s_valloc(iSize) : alignedAllocate(pageSize, iSize);
+  countAllocation(ptr);
+  return ptr;
+}
+
+void* pvalloc(std::size_t iSize) noexcept {
+  std::size_t pageSize = sysconf(_SC_PAGESIZE);
+  if (not ready()) {
+    return bootstrapAllocate(iSize, pageSize);
+  }
+  void* ptr = s_pvalloc ? s_pvalloc(iSize) : alignedAllocate(pageSize, (iSize + pageSize - 1) & ~(pageSize - 1));
+  countAllocation(ptr);
+  return ptr;
+}
+
+void free(void* iPtr) noexcept {
+  if (not iPtr or isBootstrap(iPtr)) {
+    return;
+  }
+  ready();
+  countDeallocation(iPtr);
+  s_free(iPtr);
+}
+}
+
+// The replaceable allocation functions. They go through the malloc and
+// posix_memalign above, so they are counted whichever library provides
+// the allocator.
+namespace {
+  template <typename F>
+  void* newAllocate(F iAllocate) {
+    while (true) {
+      void* ptr = iAllocate();
+      if (ptr) {
+        return ptr;
+      }
+      std::new_handler handler = std::get_new_handler();
+      if (not handler) {
+        throw std::bad_alloc();
+      }
+      handler();
+    }
+  }
+
+  void* newAllocate(std::size_t iSize) {
+    return newAllocate([iSize]() { return malloc(iSize == 0 ? 1 : iSize); });
+  }
+
+  void* newAllocate(std::size_t iSize, std::align_val_t iAlignment) {
+    return newAllocate([iSize, iAlignment]() {
+      void* ptr = nullptr;
+      std::size_t alignment = static_cast<std::size_t>(iAlignment);
+      posix_memalign(&ptr, alignment < sizeof(void*) ? sizeof(void*) : alignment, iSize == 0 ? 1 : iSize);
+      return ptr;
+    });
+  }
+
+  template <typename F>
+  void* newAllocateNoThrow(F iAllocate) noexcept {
+    try {
+      return iAllocate();
+    } catch (...) {
+      return nullptr;
+    }
+  }
+}  // namespace
+
+void* operator new(std::size_t iSize) { return newAllocate(iSize); }
+void* operator new[](std::size_t iSize) { return newAllocate(iSize); }
+void* operator new(std::size_t iSize, std::nothrow_t const&) noexcept {
+  return newAllocateNoThrow([iSize]() { return newAllocate(iSize); });
+}
+void* operator new[](std::size_t iSize, std::nothrow_t const&) noexcept {
+  return newAllocateNoThrow([iSize]() { return newAllocate(iSize); });
+}
+void* operator new(std::size_t iSize, std::align_val_t iAlignment) { return newAllocate(iSize, iAlignment); }
+void* operator new[](std::size_t iSize, std::align_val_t iAlignment) { return newAllocate(iSize, iAlignment); }
+void* operator new(std::size_t iSize, std::align_val_t iAlignment, std::nothrow_t const&) noexcept {
+  return newAllocateNoThrow([iSize, iAlignment]() { return newAllocate(iSize, iAlignment); });
+}
+void* operator new[](std::size_t iSize, std::align_val_t iAlignment, std::nothrow_t const&) noexcept {
+  return newAllocateNoThrow([iSize, iAlignment]() { return newAllocate(iSize, iAlignment); });
+}
+
+void operator delete(void* iPtr) noexcept { free(iPtr); }
+void operator delete[](void* iPtr) noexcept { free(iPtr); }
+void operator delete(void* iPtr, std::nothrow_t const&) noexcept { free(iPtr); }
+void operator delete[](void* iPtr, std::nothrow_t const&) noexcept { free(iPtr); }
+void operator delete(void* iPtr, std::size_t) noexcept { free(iPtr); }
+void operator delete[](void* iPtr, std::size_t) noexcept { free(iPtr); }
+void operator delete(void* iPtr, std::align_val_t) noexcept { free(iPtr); }
+void operator delete[](void* iPtr, std::align_val_t) noexcept { free(iPtr); }
+void operator delete(void* iPtr, std::align_val_t, std::nothrow_t const&) noexcept { free(iPtr); }
+void operator delete[](void* iPtr, std::align_val_t, std::nothrow_t const&) noexcept { free(iPtr); }
+void operator delete(void* iPtr, std::size_t, std::align_val_t) noexcept { free(iPtr); }
+void operator delete[](void* iPtr, std::size_t, std::align_val_t) noexcept { free(iPtr); }
@@ -0,0 +1,23 @@
+#!/bin/bash
+
+# Pass in name and status
+function die { echo $1: status $2 ;  exit $2; }
+
+F1=${LOCAL_TEST_DIR}/test_moduleallocationmonitor_cfg.py
+
+(cmsRun $F1 ) && die "ModuleAllocationMonitor did not fail without the preload library" 1
+(LD_PRELOAD=libPerfToolsAllocMonitorPreload.so cmsRun $F1 > moduleallocationmonitor.log 2>&1) || die "Failure using $F1" $?
+grep -q "AllocationReport> event" moduleallocationmonitor.log || die "No event allocations were reported" 1
+grep -q "  intProducer (IntProducer)" moduleallocationmonitor.log || die "The allocations of intProducer were not reported" 1
+
+# the event row of intVectorProducer: 10 calls, at least one allocation and 39 kB allocated per call
+awk '/^AllocationReport> / { inEvent = ($2 == "event") }
+     inEvent && /  intVectorProducer \(IntVectorProducer\)$/ { found = 1; if ($1 == 10 && $2 >= 1 && $4 >= 39) ok = 1 }
+     END { exit !(found && ok) }' moduleallocationmonitor.log ||
+  die "The operator new allocations of intVectorProducer were not counted" 1
+
+# the per-Event peak: 10 events, each holding at least the 40 kB of intVectorProducer until its end
+awk '/^AllocationReport> event peak memory/ { inPeak = 1; next }
+     inPeak && $1 ~ /^[0-9]+$/ { found = 1; if ($1 == 10 && $2 >= 39 && $3 >= $2 && / event: [0-9]+/) ok = 1; exit }
+     END { exit !(found && ok) }' moduleallocationmonitor.log ||
+  die "The per-Event peak memory was not reported" 1
@@ -0,0 +1,16 @@
+import FWCore.ParameterSet.Config as cms
+
+process = cms.Process("TEST")
+
+process.source = cms.Source("EmptySource")
+
+process.maxEvents = cms.untracked.PSet(input = cms.untracked.int32(10))
+
+process.intProducer = cms.EDProducer("IntProducer", ivalue = cms.int32(1))
+
+# allocates its 40 kB product with operator new
+process.intVectorProducer = cms.EDProducer("IntVectorProducer", ivalue = cms.int32(1), count = cms.int32(10000))
+
+process.p = cms.Path(process.intProducer + process.intVectorProducer)
+
+process.add_(cms.Service("ModuleAllocationMonitor"))
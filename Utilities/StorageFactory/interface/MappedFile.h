@@ -0,0 +1,55 @@
+#ifndef STORAGE_FACTORY_MAPPED_FILE_H
+#define STORAGE_FACTORY_MAPPED_FILE_H
+
+#include "Utilities/StorageFactory/interface/Storage.h"
+#include "Utilities/StorageFactory/interface/File.h"
+#include "FWCore/Utilities/interface/propagate_const.h"
+#include <string>
+#include <memory>
+
+/** Read-only local file accessed through a memory mapping of the whole
+    file.  Reads are copies out of the mapping, without system calls;
+    vector reads and prefetch requests tell the kernel which ranges are
+    about to be used (madvise), so that it reads them ahead.
+
+    The file must not be truncated while it is mapped: reading a page of
+    the mapping past the new end of the file raises SIGBUS, which stops
+    the job rather than failing the read.  Neither MAP_PRIVATE nor a size
+    check before each read would prevent this, so memory mapping is only
+    meant for input files that are not modified while the job runs.  */
+class MappedFile : public Storage {
+public:
+  MappedFile(const std::string &name);
+  ~MappedFile(void) override;
+
+  using Storage::read;
+  using Storage::write;
+
+  bool prefetch(const IOPosBuffer *what, IOSize n) override;
+  IOSize read(void *into, IOSize n) override;
+  IOSize read(void *into, IOSize n, IOOffset pos) override;
+  IOSize readv(IOBuffer *into, IOSize n) override;
+  IOSize readv(IOPosBuffer *into, IOSize n) override;
+  IOSize write(const void *from, IOSize n) override;
+  IOSize write(const void *from, IOSize n, IOOffset pos) override;
+  IOSize writev(const IOBuffer *from, IOSize n) override;
+  IOSize writev(const IOPosBuffer *from, IOSize n) override;
+
+  bool memoryMapped(void) const override { return true; }
+  IOOffset size(void) const override { return size_; }
+  IOOffset position(IOOffset offset, Relative whence = SET) override;
+  void resize(IOOffset size) override;
+  void flush(void) override;
+  void close(void) override;
+
+private:
+  IOSize copy(void *into, IOSize n, IOOffset pos) const;
+  void advise(IOOffset offset, IOSize n, int advice) const;
+
+  edm::propagate_const<std::unique_ptr<File>> file_;
+  IOOffset size_;
+  IOOffset position_;
+  edm::propagate_const<char *> image_;
+};
+
+#endif  // STORAGE_FACTORY_MAPPED_FILE_H
@@ -37,6 +37,10 @@ public:
   IOSize write(IOBuffer from, IOOffset pos);
   virtual IOSize writev(const IOPosBuffer *from, IOSize buffers);
 
+  /** True if reads are copies from memory, so that there is nothing to
+      gain by merging nearby requests into fewer, larger reads.  */
+  virtual bool memoryMapped(void) const;
+
   virtual bool eof(void) const;
   virtual IOOffset size(void) const;
   virtual IOOffset position(void) const;
@@ -33,6 +33,7 @@ public:
   IOSize writev(const IOBuffer *from, IOSize n) override;
   IOSize writev(const IOPosBuffer *from, IOSize n) override;
 
+  bool memoryMapped(void) const override;
   IOOffset position(IOOffset offset, Relative whence = SET) override;
   void resize(IOOffset size) override;
   void flush(void) override;
@@ -14,7 +14,7 @@ class StorageFactory {
 public:
   enum CacheHint { CACHE_HINT_APPLICATION, CACHE_HINT_STORAGE, CACHE_HINT_LAZY_DOWNLOAD, CACHE_HINT_AUTO_DETECT };
 
-  enum ReadHint { READ_HINT_UNBUFFERED, READ_HINT_READAHEAD, READ_HINT_AUTO };
+  enum ReadHint { READ_HINT_UNBUFFERED, READ_HINT_READAHEAD, READ_HINT_AUTO, READ_HINT_MEMORY_MAPPED };
 
   static const StorageFactory *get(void);
   static StorageFactory *getToModify(void);
@@ -30,6 +30,16 @@ public:
   void setReadHint(ReadHint value);
   ReadHint readHint(void) const;
 
+  // Largest gap between two ROOT reads that is read over to merge them
+  // into one storage request; zero chooses it from the measured latency.
+  void setReadCoalesceSize(IOSize value);
+  IOSize readCoalesceSize(void) const;
+
+  // Read ROOT's asynchronous prefetch requests in the background when the
+  // storage cannot prefetch by itself.
+  void setReadAhead(bool value);
+  bool readAhead(void) const;
+
   bool enableAccounting(bool enabled);
   bool accounting(void) const;
 
@@ -63,6 +73,8 @@ private:
   mutable MakerTable m_makers;
   CacheHint m_cacheHint;
   ReadHint m_readHint;
+  IOSize m_readCoalesceSize;
+  bool m_readAhead;
   bool m_accounting;
   double m_tempfree;
   std::string m_temppath;
@@ -4,6 +4,7 @@
 #include "Utilities/StorageFactory/interface/StorageMakerFactory.h"
 #include "Utilities/StorageFactory/interface/StorageFactory.h"
 #include "Utilities/StorageFactory/interface/File.h"
+#include "Utilities/StorageFactory/interface/MappedFile.h"
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -18,6 +19,10 @@ public:
     StorageFactory::ReadHint readHint = f->readHint();
     StorageFactory::CacheHint cacheHint = f->cacheHint();
 
+    // only files opened just for reading can be mapped
+    if (readHint == StorageFactory::READ_HINT_MEMORY_MAPPED && (mode & IOFlags::OpenWrite) == 0)
+      return std::make_unique<MappedFile>(path);
+
     if (readHint != StorageFactory::READ_HINT_UNBUFFERED || cacheHint == StorageFactory::CACHE_HINT_STORAGE)
       mode &= ~IOFlags::OpenUnbuffered;
     else
@@ -0,0 +1,142 @@
+#include "Utilities/StorageFactory/interface/MappedFile.h"
+#include "Utilities/StorageFactory/src/Throw.h"
+#include "FWCore/Utilities/interface/EDMException.h"
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <sys/mman.h>
+
+static void nowrite(const std::string &why) {
+  cms::Exception ex("MappedFile");
+  ex << "Cannot change file but operation '" << why << "' was called";
+  ex.addContext("MappedFile::" + why + "()");
+  throw ex;
+}
+
+MappedFile::MappedFile(const std::string &name)
+    : file_(std::make_unique<File>(name, IOFlags::OpenRead)), size_(file_->size()), position_(0), image_(nullptr) {
+  // mmap() refuses empty mappings; an empty file just reads nothing
+  if (size_ == 0)
+    return;
+
+  // a read-only mapping does not need MAP_PRIVATE, which would not protect the reads
+  // against a truncation of the file either (see MappedFile.h)
+  void *image = mmap(nullptr, size_, PROT_READ, MAP_SHARED, file_->fd(), 0);
+  if (image == MAP_FAILED) {
+    int error = errno;
+    file_->close();
+    throwStorageError(edm::errors::FileOpenError, "Calling MappedFile::MappedFile()", "mmap()", error);
+  }
+  image_ = static_cast<char *>(image);
+}
+
+MappedFile::~MappedFile(void) {
+  if (image_)
+    munmap(image_, size_);
+}
+
+IOSize MappedFile::copy(void *into, IOSize n, IOOffset pos) const {
+  assert(pos >= 0);
+  if (pos >= size_)
+    return 0;
+
+  n = std::min<IOOffset>(n, size_ - pos);
+  std::memcpy(into, image_.get() + pos, n);
+  return n;
+}
+
+void MappedFile::advise(IOOffset offset, IOSize n, int advice) const {
+  if (offset >= size_ or n == 0)
+    return;
+
+  // madvise() wants a page aligned address
+  static const IOOffset pageSize = sysconf(_SC_PAGESIZE);
+  IOOffset start = (offset / pageSize) * pageSize;
+  IOOffset end = std::min<IOOffset>(offset + n, size_);
+  // the hint is only an optimisation, so a failure is not an error
+  madvise(const_cast<char *>(image_.get()) + start, end - start, advice);
+}
+
+IOSize MappedFile::read(void *into, IOSize n) {
+  IOSize s = copy(into, n, position_);
+  position_ += s;
+  return s;
+}
+
+IOSize MappedFile::read(void *into, IOSize n, IOOffset pos) { return copy(into, n, pos); }
+
+IOSize MappedFile::readv(IOBuffer *into, IOSize n) {
+  IOSize total = 0;
+  for (IOSize i = 0; i < n; ++i) {
+    IOSize s = read(into[i].data(), into[i].size());
+    total += s;
+    if (s < into[i].size())
+      break;
+  }
+  return total;
+}
+
+IOSize MappedFile::readv(IOPosBuffer *into, IOSize n) {
+  // Ask for all the ranges first, so that the kernel reads the pages of
+  // the later ones while the first ones are being copied.
+  for (IOSize i = 0; i < n; ++i)
+    advise(into[i].offset(), into[i].size(), MADV_WILLNEED);
+
+  IOSize total = 0;
+  for (IOSize i = 0; i < n; ++i)
+    total += copy(into[i].data(), into[i].size(), into[i].offset());
+  return total;
+}
+
+bool MappedFile::prefetch(const IOPosBuffer *what, IOSize n) {
+  for (IOSize i = 0; i < n; ++i)
+    advise(what[i].offset(), what[i].size(), MADV_WILLNEED);
+  return true;
+}
+
+IOSize MappedFile::write(const void * /*from*/, IOSize) {
+  nowrite("write");
+  return 0;
+}
+
+IOSize MappedFile::write(const void * /*from*/, IOSize, IOOffset /*pos*/) {
+  nowrite("write");
+  return 0;
+}
+
+IOSize MappedFile::writev(const IOBuffer * /*from*/, IOSize) {
+  nowrite("writev");
+  return 0;
+}
+
+IOSize MappedFile::writev(const IOPosBuffer * /*from*/, IOSize) {
+  nowrite("writev");
+  return 0;
+}
+
+IOOffset MappedFile::position(IOOffset offset, Relative whence) {
+  IOOffset result = (whence == SET ? 0 : whence == CURRENT ? position_ : size_) + offset;
+  if (result < 0) {
+    cms::Exception ex("MappedFile");
+    ex << "Cannot move the file position to " << result;
+    ex.addContext("Calling MappedFile::position()");
+    throw ex;
+  }
+  position_ = result;
+  return position_;
+}
+
+void MappedFile::resize(IOOffset /*size*/) { nowrite("resize"); }
+
+void MappedFile::flush(void) { nowrite("flush"); }
+
+void MappedFile::close(void) {
+  if (image_) {
+    munmap(image_, size_);
+    image_ = nullptr;
+    size_ = 0;
+  }
+  file_->close();
+}
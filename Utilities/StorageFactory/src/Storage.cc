@@ -95,4 +95,6 @@ void Storage::flush(void) {}
 void Storage::close(void) {}
 
 //////////////////////////////////////////////////////////////////////
+bool Storage::memoryMapped(void) const { return false; }
+
 bool Storage::eof(void) const { return position() == size(); }
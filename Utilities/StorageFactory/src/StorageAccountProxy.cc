@@ -75,6 +75,8 @@ IOSize StorageAccountProxy::writev(const IOPosBuffer *from, IOSize n) {
   return result;
 }
 
+bool StorageAccountProxy::memoryMapped(void) const { return m_baseStorage->memoryMapped(); }
+
 IOOffset StorageAccountProxy::position(IOOffset offset, Relative whence) {
   StorageAccount::Stamp stats(m_statsPosition);
   IOOffset result = m_baseStorage->position(offset, whence);
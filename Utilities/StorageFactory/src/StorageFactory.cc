@@ -3,6 +3,7 @@
 #include "Utilities/StorageFactory/interface/StorageAccount.h"
 #include "Utilities/StorageFactory/interface/StorageAccountProxy.h"
 #include "Utilities/StorageFactory/interface/LocalCacheFile.h"
+#include "Utilities/StorageFactory/interface/MappedFile.h"
 #include "FWCore/MessageLogger/interface/MessageLogger.h"
 #include "FWCore/PluginManager/interface/PluginManager.h"
 #include "FWCore/PluginManager/interface/standard.h"
@@ -13,6 +14,8 @@ StorageFactory StorageFactory::s_instance;
 StorageFactory::StorageFactory(void)
     : m_cacheHint(CACHE_HINT_AUTO_DETECT),
       m_readHint(READ_HINT_AUTO),
+      m_readCoalesceSize(0),
+      m_readAhead(false),
       m_accounting(false),
       m_tempfree(4.),  // GB
       m_temppath(".:$TMPDIR"),
@@ -43,6 +46,14 @@ void StorageFactory::setReadHint(ReadHint value) { m_readHint = value; }
 
 StorageFactory::ReadHint StorageFactory::readHint(void) const { return m_readHint; }
 
+void StorageFactory::setReadCoalesceSize(IOSize value) { m_readCoalesceSize = value; }
+
+IOSize StorageFactory::readCoalesceSize(void) const { return m_readCoalesceSize; }
+
+void StorageFactory::setReadAhead(bool value) { m_readAhead = value; }
+
+bool StorageFactory::readAhead(void) const { return m_readAhead; }
+
 void StorageFactory::setTimeout(unsigned int timeout) { m_timeout = timeout; }
 
 unsigned int StorageFactory::timeout(void) const { return m_timeout; }
@@ -134,6 +145,8 @@ std::unique_ptr<Storage> StorageFactory::open(const std::string &url, int mode /
               protocol, rest, mode, StorageMaker::AuxSettings{}.setDebugLevel(m_debugLevel).setTimeout(m_timeout))) {
         if (dynamic_cast<LocalCacheFile *>(storage.get()))
           protocol = "local-cache";
+        else if (dynamic_cast<MappedFile *>(storage.get()))
+          protocol = "file-mmap";
 
         if (m_accounting)
           ret = std::make_unique<StorageAccountProxy>(protocol, std::move(storage));
@@ -0,0 +1,86 @@
+#include "Utilities/StorageFactory/test/Test.h"
+#include "Utilities/StorageFactory/interface/Storage.h"
+#include "FWCore/Utilities/interface/Exception.h"
+#include <cerrno>
+#include <cstring>
+#include <unistd.h>
+#include <vector>
+
+// Reads the same file with pread()/readv() and through a memory mapping,
+// and checks that both give the same bytes; the accounting summary shows
+// the two as the "file" and "file-mmap" storage classes.
+namespace {
+  // a file of this test, which is not changed while it is mapped
+  std::string makeFile(IOOffset size) {
+    char pattern[] = "mmap-test-XXXXXX";
+    int fd = mkstemp(pattern);
+    if (fd == -1) {
+      throw cms::Exception("TemporaryFile")
+          << "Cannot create temporary file '" << pattern << "': " << strerror(errno) << " (error " << errno << ")";
+    }
+    std::vector<char> data(size);
+    for (IOOffset i = 0; i < size; ++i)
+      data[i] = static_cast<char>((i * 131) % 251);
+    ssize_t written = ::write(fd, data.data(), data.size());
+    ::close(fd);
+    if (written != size) {
+      unlink(pattern);
+      throw cms::Exception("TemporaryFile") << "Cannot write temporary file '" << pattern << "'";
+    }
+    return pattern;
+  }
+
+  std::vector<char> readAll(std::string const& path, std::vector<IOPosBuffer>& iov) {
+    auto s = StorageFactory::get()->open(path);
+    std::vector<char> all(s->size());
+    IOSize n = s->read(all.data(), all.size(), 0);
+    all.resize(n);
+
+    s->readv(iov.data(), iov.size());
+    s->close();
+    return all;
+  }
+}  // namespace
+
+int main(int, char**) try {
+  initTest();
+
+  std::string path = makeFile(1000003);
+  IOOffset size = 0;
+  if (not StorageFactory::get()->check(path, &size) or size == 0) {
+    std::cerr << "Cannot find a non-empty file " << path << std::endl;
+    unlink(path.c_str());
+    return EXIT_FAILURE;
+  }
+
+  // scattered requests, as from TStorageFactoryFile::ReadBuffers
+  std::vector<char> vectored(size);
+  std::vector<IOPosBuffer> iov;
+  for (IOOffset offset = 0; offset < size; offset += 3 * (size / 16 + 1))
+    iov.emplace_back(offset, vectored.data() + offset, std::min<IOOffset>(size / 16 + 1, size - offset));
+
+  std::vector<char> fileVectored(size);
+  std::vector<IOPosBuffer> fileIov = iov;
+  for (auto& buffer : fileIov)
+    buffer.set_data(fileVectored.data() + buffer.offset());
+
+  std::vector<char> fromFile = readAll(path, fileIov);
+
+  StorageFactory::getToModify()->setReadHint(StorageFactory::READ_HINT_MEMORY_MAPPED);
+  std::vector<char> fromMapping = readAll(path, iov);
+  unlink(path.c_str());
+
+  if (fromFile != fromMapping or fileVectored != vectored) {
+    std::cerr << "The memory mapped file does not read the same bytes as the file" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::cout << StorageAccount::summaryText(true) << std::endl;
+  return EXIT_SUCCESS;
+} catch (cms::Exception const& e) {
+  std::cerr << e.explainSelf() << std::endl;
+  return EXIT_FAILURE;
+} catch (std::exception const& e) {
+  std::cerr << e.what() << std::endl;
+  return EXIT_FAILURE;
+}